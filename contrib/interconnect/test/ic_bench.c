@@ -5,6 +5,8 @@
 #include <stdlib.h>
 #include <signal.h>
 #include <getopt.h>
+#include <time.h>
+#include <sys/resource.h>
 
 #include "postgres.h"
 #include "ic_modules.h"
@@ -17,13 +19,19 @@
 
 #define MTU_LESS_LEN (sizeof(struct icpkthdr) + TUPLE_CHUNK_HEADER_SIZE) + 1
 
+/* latency histogram, 1us per bucket, the last one counts everything above */
+#define LATENCY_BUCKETS 100000
+
+#define MAX_SENDERS 64
+
 const char *progname = NULL;
 static MemoryContext testMemoryContext = NULL;
 
 volatile bool interrupt_flag = false;
 bool		am_client_side = false;
 pid_t		server_side_pid = -1;
-pid_t		client_side_pid = -1;
+pid_t		client_side_pids[MAX_SENDERS];
+int			num_client_sides = 0;
 
 pid_t		server_ic_proxy_pid = -1;
 pid_t		client_ic_proxy_pid = -1;
@@ -35,6 +43,11 @@ static struct option long_options[] = {
 	{"verify", optional_argument, NULL, 'v'},
 	{"mtu", required_argument, NULL, 'm'},
 	{"direct", required_argument, NULL, 'd'},
+	{"recv-batch", required_argument, NULL, 'r'},
+	{"bsize", required_argument, NULL, 'b'},
+	{"senders", required_argument, NULL, 's'},
+	{"loss", required_argument, NULL, 'l'},
+	{"output", required_argument, NULL, 'o'},
 	{NULL, 0, NULL, 0}
 };
 
@@ -47,10 +60,30 @@ struct bench_options
 	int			mtu;
 	int			bsize;
 	bool		direct_buffer;
+	/* max packets received per system call, only valid for udpifc */
+	int			recv_batch;
+	/* number of sender processes, all sending to the one receiver */
+	int			senders;
+	/* percentage of dropped packets and acks, only valid for udpifc */
+	int			loss;
+	/* csv file the results are appended to */
+	char	   *output;
 
 	MotionIPCLayer *ipc_layer;
 };
 
+struct bench_result
+{
+	double		elapsed_time;	/* ms */
+	uint32		loop_times;
+	uint64		total_recv_size;
+	uint64		total_recv_chunk_item_counts;
+	uint64		latency_p50;	/* us */
+	uint64		latency_p99;	/* us */
+	double		recv_cpu_time;	/* ms */
+	double		send_cpu_time;	/* ms */
+};
+
 static inline void
 usage()
 {
@@ -69,6 +102,48 @@ usage()
 	printf("  -m, --mtu                           The MTU setting. default is \"1500\"\n");
 	printf("  -b, --bsize                         The each buffer send size. default is \"200\"\n");
 	printf("  -d, --direct                        Use direct buffer in sender. default is \"false\"\n");
+	printf("  -r, --recv-batch                    The max packets received per system call (udpifc). default is \"16\"\n");
+	printf("  -s, --senders                       The number of sender processes (tcp, udpifc). default is \"1\"\n");
+	printf("  -l, --loss                          The percentage of packets and acks dropped (udpifc, needs\n"
+		   "                                      --enable-cassert). default is \"0\"\n");
+	printf("  -o, --output <file>                 Append the results to a csv file\n");
+	printf("\n");
+	printf("The latency of each chunk is measured from a timestamp written into its payload, so it is\n"
+		   "not reported with -v.\n");
+}
+
+static inline int64
+get_monotonic_ns()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int64) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static inline double
+get_cpu_time_ms(int who)
+{
+	struct rusage usage;
+
+	getrusage(who, &usage);
+	return (double) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+		(double) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+}
+
+static inline bool
+should_measure_latency(const struct bench_options *options)
+{
+	return !options->should_verify && options->bsize >= sizeof(int64);
+}
+
+static void
+set_loss_injection(const struct bench_options *options)
+{
+#ifdef USE_ASSERT_CHECKING
+	gp_udpic_dropxmit_percent = options->loss;
+	gp_udpic_dropacks_percent = options->loss;
+#endif
 }
 
 static void
@@ -99,17 +174,23 @@ destroy_memory_context()
 }
 
 static EState *
-client_side_setup(const struct bench_options *options, int stc[2], int cts[2])
+client_side_setup(const struct bench_options *options, int sender_index,
+				  int stc[2], int cts[2])
 {
 	int32		listen_port = 0;
 	int32		server_listen_port = 0;
+	int32		sender_listen_ports[MAX_SENDERS];
+	pid_t		sender_pids[MAX_SENDERS];
 	pid_t		c_pid = 0;
 	int8		already_setup = 1;
 	EState	   *estate;
 
 	am_client_side = true;
-	client_side_global_var_init(options->ipc_layer, &client_ic_proxy_pid);
+	client_side_global_var_init_content(options->ipc_layer, &client_ic_proxy_pid,
+										sender_index);
 	Gp_max_packet_size = options->mtu;
+	Gp_interconnect_recv_batch_size = options->recv_batch;
+	set_loss_injection(options);
 
 	CurrentMotionIPCLayer->InitMotionLayerIPC();
 
@@ -120,17 +201,25 @@ client_side_setup(const struct bench_options *options, int stc[2], int cts[2])
 		return NULL;
 	}
 
-	write_data_to_pipe(cts, listen_port, int32);
-	read_data_from_pipe(stc, &server_listen_port, int32);
-
 	c_pid = getpid();
+	write_data_to_pipe(cts, listen_port, int32);
 	write_data_to_pipe(cts, c_pid, pid_t);
+
+	/* the server sends back its own address, then the ones of all senders */
+	read_data_from_pipe(stc, &server_listen_port, int32);
 	read_data_from_pipe(stc, &server_side_pid, pid_t);
+	for (int i = 0; i < options->senders; i++)
+	{
+		read_data_from_pipe(stc, &sender_listen_ports[i], int32);
+		read_data_from_pipe(stc, &sender_pids[i], pid_t);
+	}
 
-	estate = prepare_estate( /* local_slice */ 1, server_listen_port,
-							listen_port,
-							server_side_pid,
-							c_pid);
+	estate = prepare_estate_multi_children( /* local_slice */ 1,
+										   server_listen_port,
+										   server_side_pid,
+										   options->senders,
+										   sender_listen_ports,
+										   sender_pids);
 
 	CurrentMotionIPCLayer->SetupInterconnect(estate);
 	if (!estate->es_interconnect_is_setup || !estate->interconnect_context)
@@ -146,11 +235,11 @@ client_side_setup(const struct bench_options *options, int stc[2], int cts[2])
 
 EState *
 server_side_setup(const struct bench_options *options,
-				  int stc[2],
-				  int cts[2])
+				  int stc[][2],
+				  int cts[][2])
 {
 	int32		listen_port = 0;
-	int32		client_listen_port = 0;
+	int32		client_listen_ports[MAX_SENDERS];
 	int8		already_setup = 0;
 	pid_t		c_pid = 0;
 	EState	   *estate;
@@ -158,6 +247,8 @@ server_side_setup(const struct bench_options *options,
 	am_client_side = false;
 	server_side_global_var_init(options->ipc_layer, &server_ic_proxy_pid);
 	Gp_max_packet_size = options->mtu;
+	Gp_interconnect_recv_batch_size = options->recv_batch;
+	set_loss_injection(options);
 
 	CurrentMotionIPCLayer->InitMotionLayerIPC();
 
@@ -168,18 +259,31 @@ server_side_setup(const struct bench_options *options,
 		return NULL;
 	}
 
-	read_data_from_pipe(cts, &client_listen_port, int32);
-	write_data_to_pipe(stc, listen_port, int32);
-
 	c_pid = getpid();
-	read_data_from_pipe(cts, &client_side_pid, pid_t);
-	write_data_to_pipe(stc, c_pid, pid_t);
+	num_client_sides = options->senders;
+	for (int i = 0; i < options->senders; i++)
+	{
+		read_data_from_pipe(cts[i], &client_listen_ports[i], int32);
+		read_data_from_pipe(cts[i], &client_side_pids[i], pid_t);
+	}
 
-	estate = prepare_estate( /* local_slice */ 0,
-							listen_port,
-							client_listen_port,
-							c_pid,
-							client_side_pid);
+	for (int i = 0; i < options->senders; i++)
+	{
+		write_data_to_pipe(stc[i], listen_port, int32);
+		write_data_to_pipe(stc[i], c_pid, pid_t);
+		for (int j = 0; j < options->senders; j++)
+		{
+			write_data_to_pipe(stc[i], client_listen_ports[j], int32);
+			write_data_to_pipe(stc[i], client_side_pids[j], pid_t);
+		}
+	}
+
+	estate = prepare_estate_multi_children( /* local_slice */ 0,
+										   listen_port,
+										   c_pid,
+										   options->senders,
+										   client_listen_ports,
+										   client_side_pids);
 
 	CurrentMotionIPCLayer->SetupInterconnect(estate);
 	if (!estate->es_interconnect_is_setup || !estate->interconnect_context)
@@ -190,12 +294,16 @@ server_side_setup(const struct bench_options *options,
 	}
 
 	/* waiting for client setup */
-	read_data_from_pipe(cts, &already_setup, int8);
-	if (already_setup != 1)
+	for (int i = 0; i < options->senders; i++)
 	{
-		printf("failed to recv client setup signal");
-		cleanup_estate(estate);
-		return NULL;
+		already_setup = 0;
+		read_data_from_pipe(cts[i], &already_setup, int8);
+		if (already_setup != 1)
+		{
+			printf("failed to recv client setup signal");
+			cleanup_estate(estate);
+			return NULL;
+		}
 	}
 
 	return estate;
@@ -231,8 +339,9 @@ sig_stop()
 	}
 	else
 	{
-		assert(client_side_pid != -1);
-		kill(client_side_pid, SIGUSR1);
+		assert(num_client_sides > 0);
+		for (int i = 0; i < num_client_sides; i++)
+			kill(client_side_pids[i], SIGUSR1);
 	}
 }
 
@@ -250,11 +359,13 @@ build_chunk_tuple_slot(EState *estate, size_t size)
 
 static bool
 measure_chunk_tuple_list(char *verify_buffer, int verify_buff_len, TupleChunkListItem tc_item,
-						 uint64 *total_recv_size, uint64 *total_recv_chunk_item_counts)
+						 uint64 *total_recv_size, uint64 *total_recv_chunk_item_counts,
+						 uint64 *latency_hist)
 {
 
 	TupleChunkListItem p_curr = tc_item;
 	TupleChunkListItem p_last;
+	int64		now = latency_hist ? get_monotonic_ns() : 0;
 
 	if (!p_curr)
 	{
@@ -270,6 +381,16 @@ measure_chunk_tuple_list(char *verify_buffer, int verify_buff_len, TupleChunkLis
 			return false;
 		}
 
+		if (latency_hist)
+		{
+			int64		sent;
+			int64		latency_us;
+
+			memcpy(&sent, (char *) GetChunkDataPtr(p_curr) + TUPLE_CHUNK_HEADER_SIZE, sizeof(sent));
+			latency_us = Max(now - sent, 0) / 1000;
+			latency_hist[Min(latency_us, LATENCY_BUCKETS)]++;
+		}
+
 		*total_recv_size = *total_recv_size + p_curr->chunk_length;
 		(*total_recv_chunk_item_counts)++;
 		p_last = p_curr;
@@ -304,7 +425,7 @@ print_direct_mode_summary(const struct bench_options *options,
 
 
 void
-client_loop(const struct bench_options *options, int stc[2], int cts[2])
+client_loop(const struct bench_options *options, int sender_index, int stc[2], int cts[2])
 {
 	EState	   *estate;
 	struct itimerval timeout_val;
@@ -315,9 +436,11 @@ client_loop(const struct bench_options *options, int stc[2], int cts[2])
 
 	uint64		direct_hit = 0;
 	uint64		non_direct_hit = 0;
+	bool		measure_latency = should_measure_latency(options);
+	uint8	   *stamp;
 
 	init_memory_context();
-	estate = client_side_setup(options, stc, cts);
+	estate = client_side_setup(options, sender_index, stc, cts);
 	if (!estate)
 	{
 		/* can not use signal to notify server side now */
@@ -329,6 +452,7 @@ client_loop(const struct bench_options *options, int stc[2], int cts[2])
 	signal(SIGUSR1, sig_handler);
 
 	tc_list_raw_buffer = build_chunk_tuple_slot(estate, options->bsize);
+	stamp = tc_list_raw_buffer->p_first->chunk_data + TUPLE_CHUNK_HEADER_SIZE;
 
 	timeout_val.it_value.tv_sec = options->interval;
 	timeout_val.it_value.tv_usec = 0;
@@ -366,6 +490,13 @@ client_loop(const struct bench_options *options, int stc[2], int cts[2])
 			break;
 		}
 
+		if (measure_latency)
+		{
+			int64		now = get_monotonic_ns();
+
+			memcpy(stamp, &now, sizeof(now));
+		}
+
 		if (options->direct_buffer)
 		{
 			CurrentMotionIPCLayer->GetTransportDirectBuffer(estate->interconnect_context, 1, 0, &direct_buffer);
@@ -404,12 +535,50 @@ client_loop(const struct bench_options *options, int stc[2], int cts[2])
 	destroy_memory_context();
 }
 
+static const char *
+ic_type_name(int ic_type)
+{
+	switch (ic_type)
+	{
+		case INTERCONNECT_TYPE_TCP:
+			return "tcp";
+		case INTERCONNECT_TYPE_UDPIFC:
+			return "udpifc";
+		case INTERCONNECT_TYPE_PROXY:
+			return "proxy";
+		default:
+			return "unknown";
+	}
+}
+
+static uint64
+latency_percentile(const uint64 *latency_hist, uint64 total, double percent)
+{
+	uint64		target = (uint64) (total * percent);
+	uint64		seen = 0;
+
+	if (target < total * percent)
+		target++;
+
+	for (int i = 0; i < LATENCY_BUCKETS; i++)
+	{
+		seen += latency_hist[i];
+		if (seen >= target)
+			return i;
+	}
+
+	return LATENCY_BUCKETS;
+}
+
 static void
-print_summary(const double elapsed_time, const uint32 loop_times,
-			  const uint64 total_recv_size, const uint64 total_recv_chunk_item_counts)
+print_summary(const struct bench_result *result)
 {
 	char		pbuff[1024 * 100];
 	int			n = 0;
+	double		elapsed_time = result->elapsed_time;
+	uint32		loop_times = result->loop_times;
+	uint64		total_recv_size = result->total_recv_size;
+	uint64		total_recv_chunk_item_counts = result->total_recv_chunk_item_counts;
 
 	setbuf(stdout, NULL);
 	n = sprintf(pbuff, "+----------------+------------+\n");
@@ -420,24 +589,67 @@ print_summary(const double elapsed_time, const uint32 loop_times,
 	n += sprintf(pbuff + n, "| %-14s | %10.3f |\n", "TPS(mb/s)", (double) (total_recv_size / (elapsed_time / 1000) / 1024 / 1024));
 	n += sprintf(pbuff + n, "| %-14s | %10ld |\n", "Recv counts", total_recv_chunk_item_counts);
 	n += sprintf(pbuff + n, "| %-14s | %10.3f |\n", "Items ops/ms", (double) (total_recv_chunk_item_counts / (elapsed_time)));
+	n += sprintf(pbuff + n, "| %-14s | %10ld |\n", "p50 lat(us)", result->latency_p50);
+	n += sprintf(pbuff + n, "| %-14s | %10ld |\n", "p99 lat(us)", result->latency_p99);
+	n += sprintf(pbuff + n, "| %-14s | %10.3f |\n", "Recv cpu ns/b", total_recv_size == 0
+				 ? 0 : result->recv_cpu_time * 1000000 / total_recv_size);
+	n += sprintf(pbuff + n, "| %-14s | %10.3f |\n", "Send cpu ns/b", total_recv_size == 0
+				 ? 0 : result->send_cpu_time * 1000000 / total_recv_size);
 	sprintf(pbuff + n, "+----------------+------------+\n");
 	printf("%s", pbuff);
 }
 
-void
-server_loop(const struct bench_options *options, int stc[2], int cts[2])
+/*
+ * Append the results as one csv line, so that runs can be collected and
+ * compared between builds. The header is written when the file is empty.
+ */
+static void
+append_result_csv(const struct bench_options *options, const struct bench_result *result)
+{
+	FILE	   *fp;
+	double		elapsed_s = result->elapsed_time / 1000;
+	uint64		bytes = result->total_recv_size;
+
+	fp = fopen(options->output, "a");
+	if (fp == NULL)
+	{
+		printf("could not open output file \"%s\": %s\n", options->output, strerror(errno));
+		return;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	if (ftell(fp) == 0)
+		fprintf(fp, "type,senders,mtu,bsize,loss,direct,recv_batch,"
+				"seconds,recv_bytes,recv_chunks,mb_per_sec,p50_us,p99_us,"
+				"recv_cpu_ns_per_byte,send_cpu_ns_per_byte\n");
+
+	fprintf(fp, "%s,%d,%d,%d,%d,%d,%d,%.3f," UINT64_FORMAT "," UINT64_FORMAT ",%.3f,"
+			UINT64_FORMAT "," UINT64_FORMAT ",%.3f,%.3f\n",
+			ic_type_name(options->ic_type), options->senders, options->mtu,
+			options->bsize, options->loss, options->direct_buffer ? 1 : 0,
+			options->recv_batch, elapsed_s, bytes,
+			result->total_recv_chunk_item_counts,
+			elapsed_s == 0 ? 0 : bytes / elapsed_s / 1024 / 1024,
+			result->latency_p50, result->latency_p99,
+			bytes == 0 ? 0 : result->recv_cpu_time * 1000000 / bytes,
+			bytes == 0 ? 0 : result->send_cpu_time * 1000000 / bytes);
+	fclose(fp);
+}
+
+bool
+server_loop(const struct bench_options *options, int stc[][2], int cts[][2],
+			struct bench_result *result)
 {
 	EState	   *estate;
 	struct timeval start_time,
 				end_time;
-	double		elapsed_time;
+	double		start_cpu_time;
 	TupleChunkListItem tc_item;
+	int16		src_route = 0;
 	bool		has_error = false;
-	uint32		loop_times = 0;
-	uint64		total_recv_size = 0;
-	uint64		total_recv_chunk_item_counts = 0;
-	char	   *tc_item_raw_verify_buff;
+	char	   *tc_item_raw_verify_buff = NULL;
 	int			tc_item_raw_verify_buff_len = 0;
+	uint64	   *latency_hist = NULL;
 	int8		already_stop = 1;
 
 	init_memory_context();
@@ -446,7 +658,7 @@ server_loop(const struct bench_options *options, int stc[2], int cts[2])
 	{
 		/* can not use signal to notify client side now */
 		printf("server side setup failed.\n");
-		return;
+		return false;
 	}
 
 	signal(SIGALRM, sig_handler);
@@ -459,38 +671,58 @@ server_loop(const struct bench_options *options, int stc[2], int cts[2])
 		generate_seq_buffer(tc_item_raw_verify_buff, tc_item_raw_verify_buff_len);
 	}
 
+	if (should_measure_latency(options))
+		latency_hist = palloc0(sizeof(uint64) * (LATENCY_BUCKETS + 1));
+
+	memset(result, 0, sizeof(*result));
+	start_cpu_time = get_cpu_time_ms(RUSAGE_SELF);
 	gettimeofday(&start_time, NULL);
 	while (true)
 	{
 		if (interrupt_flag)
 		{
-			write_data_to_pipe(stc, already_stop, int8);
+			for (int i = 0; i < options->senders; i++)
+				write_data_to_pipe(stc[i], already_stop, int8);
 			break;
 		}
 
-		tc_item = CurrentMotionIPCLayer->RecvTupleChunkFrom(estate->interconnect_context, 1, 0);
+		if (options->senders > 1)
+			tc_item = CurrentMotionIPCLayer->RecvTupleChunkFromAny(estate->interconnect_context, 1, &src_route);
+		else
+			tc_item = CurrentMotionIPCLayer->RecvTupleChunkFrom(estate->interconnect_context, 1, 0);
 		if (!measure_chunk_tuple_list(tc_item_raw_verify_buff,
 									  tc_item_raw_verify_buff_len,
 									  tc_item,
-									  &total_recv_size,
-									  &total_recv_chunk_item_counts))
+									  &result->total_recv_size,
+									  &result->total_recv_chunk_item_counts,
+									  latency_hist))
 		{
 			sig_stop();
 		}
 
 		if (CurrentMotionIPCLayer->ic_type == INTERCONNECT_TYPE_UDPIFC)
 		{
-			CurrentMotionIPCLayer->DirectPutRxBuffer(estate->interconnect_context, 1, 0);
+			CurrentMotionIPCLayer->DirectPutRxBuffer(estate->interconnect_context, 1, src_route);
 		}
 
-		loop_times++;
+		result->loop_times++;
 	}
 
 	gettimeofday(&end_time, NULL);
-	elapsed_time = (double) (end_time.tv_sec - start_time.tv_sec) * 1000 +
+	result->recv_cpu_time = get_cpu_time_ms(RUSAGE_SELF) - start_cpu_time;
+	result->elapsed_time = (double) (end_time.tv_sec - start_time.tv_sec) * 1000 +
 		(double) (end_time.tv_usec - start_time.tv_usec) / 1000;
 
-	print_summary(elapsed_time, loop_times, total_recv_size, total_recv_chunk_item_counts);
+	if (latency_hist)
+	{
+		uint64		total = 0;
+
+		for (int i = 0; i <= LATENCY_BUCKETS; i++)
+			total += latency_hist[i];
+		result->latency_p50 = latency_percentile(latency_hist, total, 0.5);
+		result->latency_p99 = latency_percentile(latency_hist, total, 0.99);
+		pfree(latency_hist);
+	}
 
 	if (options->should_verify)
 	{
@@ -505,15 +737,20 @@ server_loop(const struct bench_options *options, int stc[2], int cts[2])
 
 	cleanup_estate(estate);
 	destroy_memory_context();
+
+	return true;
 }
 
 
 int
 main(int argc, char *argv[])
 {
-	int			stc[2],
-				cts[2];
-	pid_t		f_pid;
+	int			stc[MAX_SENDERS][2],
+				cts[MAX_SENDERS][2];
+	pid_t		sender_pids[MAX_SENDERS];
+	struct bench_result result;
+	int			npipes;
+	bool		ok;
 	int			c;
 
 	struct bench_options options = {
@@ -526,7 +763,11 @@ main(int argc, char *argv[])
 		.mtu = 1500,
 		.bsize = TUPLE_CHUNK_RAW_BUFFER_LEN,
 		.ipc_layer = NULL,
-		.direct_buffer = false
+		.direct_buffer = false,
+		.recv_batch = 16,
+		.senders = 1,
+		.loss = 0,
+		.output = NULL
 	};
 
 	progname = get_progname(argv[0]);
@@ -543,7 +784,7 @@ main(int argc, char *argv[])
 	optind = 1;
 	while (optind < argc)
 	{
-		while ((c = getopt_long(argc, argv, "t:i:vm:b:d",
+		while ((c = getopt_long(argc, argv, "t:i:vm:b:dr:s:l:o:",
 								long_options, NULL)) != -1)
 		{
 			switch (c)
@@ -594,6 +835,30 @@ main(int argc, char *argv[])
 						options.direct_buffer = true;
 						break;
 					}
+				case 'r':
+					{
+						char	   *recv_batch_c;
+
+						recv_batch_c = strdup(optarg);
+						options.recv_batch = atoi(recv_batch_c);
+						free(recv_batch_c);
+						break;
+					}
+				case 's':
+					{
+						options.senders = atoi(optarg);
+						break;
+					}
+				case 'l':
+					{
+						options.loss = atoi(optarg);
+						break;
+					}
+				case 'o':
+					{
+						options.output = strdup(optarg);
+						break;
+					}
 				default:
 					{
 						/* do nothing */
@@ -656,49 +921,127 @@ main(int argc, char *argv[])
 		return -1;
 	}
 
-	if (pipe(stc) < 0)
+	if (options.recv_batch < 1 || options.recv_batch > MAX_INTERCONNECT_RECV_BATCH)
 	{
-		printf("pipe created failed. errno: %d\n", errno);
+		printf("invalid of args -r/--recv-batch %d, should be in [1-%d].\n", options.recv_batch, MAX_INTERCONNECT_RECV_BATCH);
+		usage();
+		return -1;
+	}
+
+	if (options.senders < 1 || options.senders > MAX_SENDERS)
+	{
+		printf("invalid of args -s/--senders %d, should be in [1-%d].\n", options.senders, MAX_SENDERS);
+		usage();
 		return -1;
 	}
 
-	if (pipe(cts) < 0)
+	if (options.ic_type == INTERCONNECT_TYPE_PROXY && options.senders != 1)
 	{
-		printf("pipe created failed. errno: %d\n", errno);
-		close(stc[0]);
-		close(stc[1]);
+		printf("invalid of args -s/--senders %d, proxy only allows one sender.\n", options.senders);
+		usage();
 		return -1;
 	}
 
-	f_pid = fork();
+	if (options.loss < 0 || options.loss >= 100)
+	{
+		printf("invalid of args -l/--loss %d, should be in [0-99].\n", options.loss);
+		usage();
+		return -1;
+	}
 
-	if (f_pid < 0)
+	if (options.loss != 0 && options.ic_type != INTERCONNECT_TYPE_UDPIFC)
 	{
-		printf("fork failed. errno: %d\n", errno);
-		close(stc[0]);
-		close(stc[1]);
-		close(cts[0]);
-		close(cts[1]);
+		printf("invalid of args -l/--loss %d, only udpifc allows packet loss.\n", options.loss);
+		usage();
 		return -1;
 	}
 
-	if (f_pid == 0)
+#ifndef USE_ASSERT_CHECKING
+	if (options.loss != 0)
 	{
-		client_loop(&options, stc, cts);
-		close(stc[0]);
-		close(stc[1]);
-		close(cts[0]);
-		close(cts[1]);
+		printf("invalid of args -l/--loss %d, packet loss needs a build with --enable-cassert.\n", options.loss);
+		usage();
+		return -1;
 	}
-	else
+#endif
+
+	for (npipes = 0; npipes < options.senders; npipes++)
+	{
+		if (pipe(stc[npipes]) < 0)
+		{
+			printf("pipe created failed. errno: %d\n", errno);
+			break;
+		}
+
+		if (pipe(cts[npipes]) < 0)
+		{
+			printf("pipe created failed. errno: %d\n", errno);
+			close(stc[npipes][0]);
+			close(stc[npipes][1]);
+			break;
+		}
+	}
+
+	if (npipes < options.senders)
+	{
+		for (int i = 0; i < npipes; i++)
+		{
+			close(stc[i][0]);
+			close(stc[i][1]);
+			close(cts[i][0]);
+			close(cts[i][1]);
+		}
+		return -1;
+	}
+
+	for (int i = 0; i < options.senders; i++)
+	{
+		sender_pids[i] = fork();
+
+		if (sender_pids[i] < 0)
+		{
+			printf("fork failed. errno: %d\n", errno);
+			for (int j = 0; j < i; j++)
+			{
+				kill(sender_pids[j], SIGKILL);
+				waitpid(sender_pids[j], NULL, 0);
+			}
+			return -1;
+		}
+
+		if (sender_pids[i] == 0)
+		{
+			client_loop(&options, i, stc[i], cts[i]);
+			exit(0);
+		}
+	}
+
+	ok = server_loop(&options, stc, cts, &result);
+
+	for (int i = 0; i < options.senders; i++)
+	{
+		if (!ok)
+			kill(sender_pids[i], SIGKILL);
+		waitpid(sender_pids[i], NULL, 0);
+	}
+
+	if (ok)
+	{
+		/* the senders are our children, and all have been waited for */
+		result.send_cpu_time = get_cpu_time_ms(RUSAGE_CHILDREN);
+
+		print_summary(&result);
+		if (options.output)
+			append_result_csv(&options, &result);
+	}
+
+	for (int i = 0; i < options.senders; i++)
 	{
-		server_loop(&options, stc, cts);
+		close(stc[i][0]);
+		close(stc[i][1]);
+		close(cts[i][0]);
+		close(cts[i][1]);
 	}
 
-	wait(NULL);
-	close(stc[0]);
-	close(stc[1]);
-	close(cts[0]);
-	close(cts[1]);
-	return 0;
+	return ok ? 0 : -1;
 }
@@ -0,0 +1,87 @@
+#!/usr/bin/env bash
+#
+# Run ic_bench over a matrix of interconnect settings, and collect one csv
+# line per run. When a baseline csv from an earlier build is given, the
+# throughput of every run is compared with the baseline run of the same
+# settings, and the script fails if any of them dropped by more than
+# IC_BENCH_TOLERANCE percent.
+#
+# usage: ic_bench_matrix.sh <ic_bench> <output.csv> [baseline.csv]
+#
+# The matrix can be narrowed with the following environment variables:
+#   IC_TYPES     interconnect types, 0 - tcp, 1 - udpifc, 2 - proxy ("0 1 2")
+#   MTUS         packet sizes ("1500 8192")
+#   BSIZES       tuple widths ("200 1000")
+#   SENDERS      number of senders, not used for proxy ("1 4")
+#   LOSSES       dropped packet percentages, udpifc only ("0")
+#   INTERVAL     duration of each run in seconds ("10")
+#
+
+set -u
+
+if [ $# -lt 2 ]; then
+	echo "usage: $0 <ic_bench> <output.csv> [baseline.csv]" >&2
+	exit 2
+fi
+
+IC_BENCH=$1
+OUTPUT=$2
+BASELINE=${3:-}
+
+IC_TYPES=${IC_TYPES:-"0 1 2"}
+MTUS=${MTUS:-"1500 8192"}
+BSIZES=${BSIZES:-"200 1000"}
+SENDERS=${SENDERS:-"1 4"}
+LOSSES=${LOSSES:-"0"}
+INTERVAL=${INTERVAL:-10}
+IC_BENCH_TOLERANCE=${IC_BENCH_TOLERANCE:-10}
+
+rm -f "$OUTPUT"
+failed=0
+
+for type in $IC_TYPES; do
+	for mtu in $MTUS; do
+		# the proxy does not allow setting the mtu
+		if [ "$type" = 2 ] && [ "$mtu" != 1500 ]; then
+			continue
+		fi
+		for bsize in $BSIZES; do
+			for senders in $SENDERS; do
+				if [ "$type" = 2 ] && [ "$senders" != 1 ]; then
+					continue
+				fi
+				for loss in $LOSSES; do
+					if [ "$type" != 1 ] && [ "$loss" != 0 ]; then
+						continue
+					fi
+					echo "ic_bench -t $type -m $mtu -b $bsize -s $senders -l $loss -i $INTERVAL"
+					if ! "$IC_BENCH" -t "$type" -m "$mtu" -b "$bsize" -s "$senders" \
+						-l "$loss" -i "$INTERVAL" -o "$OUTPUT" > /dev/null; then
+						echo "  failed" >&2
+						failed=1
+					fi
+				done
+			done
+		done
+	done
+done
+
+if [ -n "$BASELINE" ]; then
+	# the first 7 columns are the settings, the 11th one the throughput
+	if ! awk -F, -v tolerance="$IC_BENCH_TOLERANCE" '
+		FNR == 1 { next }
+		{ key = $1 "," $2 "," $3 "," $4 "," $5 "," $6 "," $7 }
+		FILENAME == ARGV[1] { base[key] = $11; next }
+		(key in base) && base[key] > 0 {
+			change = ($11 - base[key]) * 100 / base[key]
+			printf "%-40s %12.3f mb/s %+8.2f%%\n", key, $11, change
+			if (change < -tolerance)
+				regressed = 1
+		}
+		END { exit regressed }' "$BASELINE" "$OUTPUT"; then
+		echo "throughput dropped by more than $IC_BENCH_TOLERANCE% against $BASELINE" >&2
+		failed=1
+	fi
+fi
+
+exit $failed
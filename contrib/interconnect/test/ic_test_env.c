@@ -160,19 +160,18 @@ static void
 init_exec_slices(ExecSlice * parent_exec_slice,
 				 ExecSlice * child_exec_slice,
 				 int32 parent_listen_port,
-				 int32 child_listen_port,
 				 pid_t parent_pid,
-				 pid_t child_pid)
+				 int num_children,
+				 const int32 *child_listen_ports,
+				 const pid_t *child_pids)
 {
 
 	CdbProcess *parent_process;
-	CdbProcess *child_process;
 
 	memset(parent_exec_slice, 0, sizeof(ExecSlice));
 	memset(child_exec_slice, 0, sizeof(ExecSlice));
 
 	parent_process = (CdbProcess *) palloc0(sizeof(CdbProcess));
-	child_process = (CdbProcess *) palloc0(sizeof(CdbProcess));
 
 	parent_process->type = T_CdbProcess;
 	parent_process->listenerAddr = "127.0.1.1";
@@ -182,14 +181,6 @@ init_exec_slices(ExecSlice * parent_exec_slice,
 	parent_process->pid = parent_pid;
 	parent_process->contentid = -1;
 
-	child_process->type = T_CdbProcess;
-	child_process->listenerAddr = "127.0.1.1";
-	child_process->listenerPort = child_listen_port;
-
-	child_process->dbid = 2;
-	child_process->pid = child_pid;
-	child_process->contentid = 0;
-
 	parent_exec_slice->sliceIndex = 0;
 	parent_exec_slice->rootIndex = 0;
 	parent_exec_slice->planNumSegments = 1;
@@ -205,12 +196,26 @@ init_exec_slices(ExecSlice * parent_exec_slice,
 
 	child_exec_slice->sliceIndex = 1;
 	child_exec_slice->rootIndex = 0;
-	child_exec_slice->planNumSegments = 1;
+	child_exec_slice->planNumSegments = num_children;
 	child_exec_slice->gangType = GANGTYPE_PRIMARY_READER;
 	child_exec_slice->segments = 0;
 	child_exec_slice->primaryGang = 0;
 
-	child_exec_slice->primaryProcesses = lappend(child_exec_slice->primaryProcesses, child_process);
+	/* the i-th child runs as content i, see client_side_global_var_init() */
+	for (int i = 0; i < num_children; i++)
+	{
+		CdbProcess *child_process = (CdbProcess *) palloc0(sizeof(CdbProcess));
+
+		child_process->type = T_CdbProcess;
+		child_process->listenerAddr = "127.0.1.1";
+		child_process->listenerPort = child_listen_ports[i];
+
+		child_process->dbid = i + 2;
+		child_process->pid = child_pids[i];
+		child_process->contentid = i;
+
+		child_exec_slice->primaryProcesses = lappend(child_exec_slice->primaryProcesses, child_process);
+	}
 	child_exec_slice->processesMap = 0;
 
 	child_exec_slice->children = NIL;
@@ -224,6 +229,22 @@ prepare_estate(const int local_slice,
 			   const int32 child_listen_port,
 			   const pid_t parent_pid,
 			   const pid_t child_pid)
+{
+	return prepare_estate_multi_children(local_slice,
+										 parent_listen_port,
+										 parent_pid,
+										 1,
+										 &child_listen_port,
+										 &child_pid);
+}
+
+extern EState *
+prepare_estate_multi_children(const int local_slice,
+							  const int32 parent_listen_port,
+							  const pid_t parent_pid,
+							  const int num_children,
+							  const int32 *child_listen_ports,
+							  const pid_t *child_pids)
 {
 	EState	   *estate;
 	SliceTable *slice_table;
@@ -241,9 +262,10 @@ prepare_estate(const int local_slice,
 	init_exec_slices(&estate->es_sliceTable->slices[0],
 					 &estate->es_sliceTable->slices[1],
 					 parent_listen_port,
-					 child_listen_port,
 					 parent_pid,
-					 child_pid);
+					 num_children,
+					 child_listen_ports,
+					 child_pids);
 
 	return estate;
 }
@@ -312,11 +334,18 @@ verify_chunk_list_raw_data(const TupleChunkListItem tc_item_raw,
 
 void
 client_side_global_var_init(MotionIPCLayer * motion_ipc_layer, pid_t *ic_proxy_pid)
+{
+	client_side_global_var_init_content(motion_ipc_layer, ic_proxy_pid, 0);
+}
+
+void
+client_side_global_var_init_content(MotionIPCLayer * motion_ipc_layer, pid_t *ic_proxy_pid,
+									int content)
 {
 	Gp_max_packet_size = 1500;
 
-	GpIdentity.segindex = 0;
-	GpIdentity.dbid = 2;
+	GpIdentity.segindex = content;
+	GpIdentity.dbid = content + 2;
 
 	MyProcPid = getpid();
 
@@ -46,9 +46,17 @@ extern EState *prepare_estate(const int local_slice,
 							  const int32 child_listen_port,
 							  const pid_t parent_pid,
 							  const pid_t child_pid);
+extern EState *prepare_estate_multi_children(const int local_slice,
+											 const int32 parent_listen_port,
+											 const pid_t parent_pid,
+											 const int num_children,
+											 const int32 *child_listen_ports,
+											 const pid_t *child_pids);
 extern void cleanup_estate(EState *estate);
 
 extern void client_side_global_var_init(MotionIPCLayer * motion_ipc_layer, pid_t *ic_proxy_pid);
+extern void client_side_global_var_init_content(MotionIPCLayer * motion_ipc_layer, pid_t *ic_proxy_pid,
+												int content);
 extern void server_side_global_var_init(MotionIPCLayer * motion_ipc_layer, pid_t *ic_proxy_pid);
 extern void shutdown_ic_proxy_if_need(pid_t ic_proxy_pid);
 
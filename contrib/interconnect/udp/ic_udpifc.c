@@ -322,15 +322,19 @@ struct RxBufferPool
 
 	/* The list of free buffers. */
 	char	   *freeList;
+
+	/* The part of maxCount kept for the batches of the receive thread. */
+	int			batchCount;
 };
 
 /*
  * The buffer pool used for keeping data packets.
  *
- * maxCount is set to 1 to make sure there is always a buffer
- * for picking packets from OS buffer.
+ * maxCount starts at batchCount, gp_interconnect_recv_batch_size when the
+ * interconnect is set up, to make sure there are always enough buffers for
+ * the receive thread to pick a batch of packets from OS buffer.
  */
-static RxBufferPool rx_buffer_pool = {1, 0, NULL};
+static RxBufferPool rx_buffer_pool = {1, 0, NULL, 1};
 
 /*
  * SendBufferPool
@@ -699,6 +703,7 @@ static inline void sendControlMessage(icpkthdr *pkt, int fd, struct sockaddr *ad
 static void putRxBufferAndSendAck(MotionConn *conn, AckSendParam *param);
 static inline void putRxBufferToFreeList(RxBufferPool *p, icpkthdr *buf);
 static inline icpkthdr *getRxBufferFromFreeList(RxBufferPool *p);
+static void setRxBufferBatchCount(RxBufferPool *p);
 static icpkthdr *getRxBuffer(RxBufferPool *p);
 
 /* ICBufferList functions. */
@@ -743,6 +748,12 @@ static void checkQDConnectionAlive(void);
 
 
 static void *rxThreadFunc(void *arg);
+static int	rxThreadReceive(icpkthdr **pkts, int npkts,
+							struct sockaddr_storage *peers,
+							socklen_t *peerlens, int *lens);
+static bool rxThreadHandlePacket(icpkthdr *pkt, int read_count,
+								 struct sockaddr_storage *peer,
+								 socklen_t *peerlen);
 
 static bool handleMismatch(icpkthdr *pkt, struct sockaddr_storage *peer, int peer_len);
 static void handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now);
@@ -1460,8 +1471,10 @@ InitMotionUDPIFC(int *listenerSocketFd, int32 *listenerPort)
 
 	/* Initialize receive buffer pool */
 	rx_buffer_pool.count = 0;
-	rx_buffer_pool.maxCount = 1;
+	rx_buffer_pool.maxCount = 0;
 	rx_buffer_pool.freeList = NULL;
+	rx_buffer_pool.batchCount = 0;
+	setRxBufferBatchCount(&rx_buffer_pool);
 
 	/* Initialize send control data */
 	snd_control_info.cwnd = 0;
@@ -2028,6 +2041,24 @@ putRxBufferAndSendAck(MotionConn *mConn, AckSendParam *param)
 	}
 }
 
+/*
+ * setRxBufferBatchCount
+ * 		Size the buffers kept for the receive thread from
+ * 		gp_interconnect_recv_batch_size.
+ *
+ * SHOULD BE CALLED WITH ic_control_info.lock *LOCKED*, once the receive
+ * thread runs.
+ */
+static void
+setRxBufferBatchCount(RxBufferPool *p)
+{
+	int			batchCount = Max(1, Min(Gp_interconnect_recv_batch_size,
+										MAX_INTERCONNECT_RECV_BATCH));
+
+	p->maxCount += batchCount - p->batchCount;
+	p->batchCount = batchCount;
+}
+
 /*
  * getRxBuffer
  * 		Get a receive buffer.
@@ -3069,6 +3100,8 @@ SetupUDPIFCInterconnect_Internal(SliceTable *sliceTable)
 
 	Assert(sliceTable->ic_instance_id > 0);
 
+	setRxBufferBatchCount(&rx_buffer_pool);
+
 	if (Gp_role == GP_ROLE_DISPATCH)
 	{
 		Assert(gp_interconnect_id == sliceTable->ic_instance_id);
@@ -3674,7 +3707,14 @@ TeardownUDPIFCInterconnect_Internal(ChunkTransportState *transportStates,
 	{
 		icpkthdr   *buf = NULL;
 
-		/* If this happened, there are some memory leaks.. */
+		/*
+		 * The receive thread may still hold the buffers of a larger batch,
+		 * it frees them itself before its next receive.  Anything more
+		 * means some memory leaks..
+		 */
+		if (rx_buffer_pool.freeList == NULL &&
+			rx_buffer_pool.count - rx_buffer_pool.maxCount <= MAX_INTERCONNECT_RECV_BATCH)
+			break;
 		if (rx_buffer_pool.freeList == NULL)
 		{
 			pthread_mutex_unlock(&ic_control_info.lock);
@@ -6470,10 +6510,186 @@ handleDataPacket(MotionConn *mConn, icpkthdr *pkt, struct sockaddr_storage *peer
 	return true;
 }
 
+/*
+ * rxThreadReceive
+ * 		Receive up to npkts datagrams from the listener socket into pkts.
+ *
+ * On Linux all of them are read with a single recvmmsg() call; elsewhere
+ * one datagram is read with recvfrom(). The lengths and the sender addresses
+ * of the datagrams are returned in lens, peers and peerlens.
+ *
+ * Returns the number of datagrams received, or -1 with errno set.
+ *
+ * NOTE: This function MUST NOT contain elog or ereport statements.
+ */
+static int
+rxThreadReceive(icpkthdr **pkts, int npkts, struct sockaddr_storage *peers,
+				socklen_t *peerlens, int *lens)
+{
+#ifdef __linux__
+	if (npkts > 1)
+	{
+		struct mmsghdr msgs[MAX_INTERCONNECT_RECV_BATCH];
+		struct iovec iovs[MAX_INTERCONNECT_RECV_BATCH];
+		int			n;
+
+		for (int i = 0; i < npkts; i++)
+		{
+			iovs[i].iov_base = pkts[i];
+			iovs[i].iov_len = Gp_max_packet_size;
+
+			memset(&msgs[i], 0, sizeof(struct mmsghdr));
+			msgs[i].msg_hdr.msg_name = &peers[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		/* Return whatever is queued, at least one datagram */
+		n = recvmmsg(UDP_listenerFd, msgs, npkts, MSG_DONTWAIT, NULL);
+		if (n < 0)
+			return n;
+
+		for (int i = 0; i < n; i++)
+		{
+			lens[i] = msgs[i].msg_len;
+			peerlens[i] = msgs[i].msg_hdr.msg_namelen;
+		}
+		return n;
+	}
+#endif
+
+	peerlens[0] = sizeof(struct sockaddr_storage);
+	lens[0] = recvfrom(UDP_listenerFd, (char *) pkts[0], Gp_max_packet_size, 0,
+					   (struct sockaddr *) &peers[0], &peerlens[0]);
+
+	return lens[0] < 0 ? -1 : 1;
+}
+
+/*
+ * rxThreadHandlePacket
+ * 		Handle a datagram received by the receive background thread.
+ *
+ * Returns true if the packet buffer was taken over by a connection or by the
+ * mismatch handling, false if the caller can reuse it.
+ *
+ * NOTE: This function MUST NOT contain elog or ereport statements.
+ */
+static bool
+rxThreadHandlePacket(icpkthdr *pkt, int read_count,
+					 struct sockaddr_storage *peer, socklen_t *peerlen)
+{
+	MotionConn *conn = NULL;
+	bool		consumed = false;
+	bool		wakeup_mainthread = false;
+	AckSendParam param;
+
+	if (read_count < sizeof(icpkthdr))
+	{
+		if (DEBUG1 >= log_min_messages)
+			write_log("Interconnect error: short conn receive (%d)", read_count);
+		return false;
+	}
+
+	/* length must be >= 0 */
+	if (pkt->len < 0)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound with negative length");
+		return false;
+	}
+
+	if (pkt->len != read_count)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
+		return false;
+	}
+
+	/*
+	 * check the CRC of the payload.
+	 */
+	if (gp_interconnect_full_crc)
+	{
+		if (!checkCRC(pkt))
+		{
+			pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.crcErrors, 1);
+			if (DEBUG2 >= log_min_messages)
+				write_log("received network data error, dropping bad packet, user data unaffected.");
+			return false;
+		}
+	}
+
+#ifdef AMS_VERBOSE_LOGGING
+	logPkt("GOT MESSAGE", pkt);
+#endif
+
+	memset(&param, 0, sizeof(AckSendParam));
+
+	/*
+	 * Get the connection for the pkt.
+	 *
+	 * The connection hash table should be locked until finishing the
+	 * processing of the packet to avoid the connection addition/removal from
+	 * the hash table during the mean time.
+	 */
+
+	pthread_mutex_lock(&ic_control_info.lock);
+	conn = findConnByHeader(&ic_control_info.connHtab, pkt);
+
+	if (conn != NULL)
+	{
+		/* Handling a regular packet */
+		if (handleDataPacket(conn, pkt, peer, peerlen, &param, &wakeup_mainthread))
+			consumed = true;
+		ic_statistics.recvPktNum++;
+	}
+	else
+	{
+		/*
+		 * There may have two kinds of Mismatched packets: a) Past packets
+		 * from previous command after I was torn down b) Future packets from
+		 * current command before my connections are built.
+		 *
+		 * The handling logic is to "Ack the past and Nak the future".
+		 */
+		if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
+		{
+			if (DEBUG1 >= log_min_messages)
+				write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
+
+#ifdef AMS_VERBOSE_LOGGING
+			logPkt("Got a Mismatched Packet", pkt);
+#endif
+
+			if (handleMismatch(pkt, peer, *peerlen))
+				consumed = true;
+			ic_statistics.mismatchNum++;
+		}
+	}
+	pthread_mutex_unlock(&ic_control_info.lock);
+
+	if (wakeup_mainthread)
+		SetLatch(&ic_control_info.latch);
+
+	/*
+	 * real ack sending is after lock release to decrease the lock holding
+	 * time.
+	 */
+	if (param.msg.len != 0)
+		sendAckWithParam(&param);
+
+	return consumed;
+}
+
 /*
  * rxThreadFunc
  * 		Main function of the receive background thread.
  *
+ * The thread keeps up to rx_buffer_pool.batchCount receive buffers at
+ * hand, so that all the datagrams queued on the socket can be picked up
+ * with a single system call.
+ *
  * NOTE: This function MUST NOT contain elog or ereport statements.
  * elog is NOT thread-safe.  Developers should instead use something like:
  *
@@ -6485,13 +6701,18 @@ handleDataPacket(MotionConn *mConn, icpkthdr *pkt, struct sockaddr_storage *peer
 static void *
 rxThreadFunc(void *arg)
 {
-	icpkthdr   *pkt = NULL;
+	icpkthdr   *pkts[MAX_INTERCONNECT_RECV_BATCH];
+	struct sockaddr_storage peers[MAX_INTERCONNECT_RECV_BATCH];
+	socklen_t	peerlens[MAX_INTERCONNECT_RECV_BATCH];
+	int			lens[MAX_INTERCONNECT_RECV_BATCH];
+	int			npkts = 0;
 	bool		skip_poll = false;
 
 	for (;;)
 	{
 		struct pollfd nfd;
 		int			n;
+		int			batch_size;
 
 		/* check shutdown condition */
 		if (pg_atomic_read_u32(&ic_control_info.shutdown) == 1)
@@ -6503,14 +6724,29 @@ rxThreadFunc(void *arg)
 			break;
 		}
 
-		/* Try to get a buffer */
-		if (pkt == NULL)
+		/* Give back the buffers of a larger batch, or try to get buffers */
+		batch_size = rx_buffer_pool.batchCount;
+		if (npkts > batch_size)
 		{
 			pthread_mutex_lock(&ic_control_info.lock);
-			pkt = getRxBuffer(&rx_buffer_pool);
+			while (npkts > batch_size)
+				freeRxBuffer(&rx_buffer_pool, pkts[--npkts]);
 			pthread_mutex_unlock(&ic_control_info.lock);
+		}
+		else if (npkts < batch_size)
+		{
+			pthread_mutex_lock(&ic_control_info.lock);
+			while (npkts < batch_size)
+			{
+				icpkthdr   *pkt = getRxBuffer(&rx_buffer_pool);
 
-			if (pkt == NULL)
+				if (pkt == NULL)
+					break;
+				pkts[npkts++] = pkt;
+			}
+			pthread_mutex_unlock(&ic_control_info.lock);
+
+			if (npkts == 0)
 			{
 				setRxThreadError(ENOMEM);
 				continue;
@@ -6560,15 +6796,11 @@ rxThreadFunc(void *arg)
 			/* we've got something interesting to read */
 			/* handle incoming */
 			/* ready to read on our socket */
-			MotionConn *conn = NULL;
-			int			read_count = 0;
-
-			struct sockaddr_storage peer;
-			socklen_t	peerlen;
+			int			nrecv;
+			int			nkept;
 
-			peerlen = sizeof(peer);
-			read_count = recvfrom(UDP_listenerFd, (char *) pkt, Gp_max_packet_size, 0,
-								  (struct sockaddr *) &peer, &peerlen);
+			nrecv = rxThreadReceive(pkts, Min(npkts, batch_size),
+									peers, peerlens, lens);
 
 			if (pg_atomic_read_u32(&ic_control_info.shutdown) == 1)
 			{
@@ -6580,9 +6812,9 @@ rxThreadFunc(void *arg)
 			}
 
 			if (DEBUG5 >= log_min_messages)
-				write_log("received inbound len %d", read_count);
+				write_log("received %d inbound packets", nrecv);
 
-			if (read_count < 0)
+			if (nrecv < 0)
 			{
 				skip_poll = false;
 
@@ -6603,121 +6835,38 @@ rxThreadFunc(void *arg)
 				continue;
 			}
 
-			if (read_count < sizeof(icpkthdr))
-			{
-				if (DEBUG1 >= log_min_messages)
-					write_log("Interconnect error: short conn receive (%d)", read_count);
-				continue;
-			}
-
 			/*
 			 * when we get a "good" recvfrom() result, we can skip poll()
 			 * until we get a bad one.
 			 */
 			skip_poll = true;
 
-			/* length must be >= 0 */
-			if (pkt->len < 0)
-			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound with negative length");
-				continue;
-			}
-
-			if (pkt->len != read_count)
+			for (int i = 0; i < nrecv; i++)
 			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
-				continue;
+				if (rxThreadHandlePacket(pkts[i], lens[i], &peers[i], &peerlens[i]))
+					pkts[i] = NULL;
 			}
 
-			/*
-			 * check the CRC of the payload.
-			 */
-			if (gp_interconnect_full_crc)
+			/* Keep the buffers that were not taken over */
+			nkept = 0;
+			for (int i = 0; i < npkts; i++)
 			{
-				if (!checkCRC(pkt))
-				{
-					pg_atomic_add_fetch_u32((pg_atomic_uint32 *) &ic_statistics.crcErrors, 1);
-					if (DEBUG2 >= log_min_messages)
-						write_log("received network data error, dropping bad packet, user data unaffected.");
-					continue;
-				}
+				if (pkts[i] != NULL)
+					pkts[nkept++] = pkts[i];
 			}
-
-#ifdef AMS_VERBOSE_LOGGING
-			logPkt("GOT MESSAGE", pkt);
-#endif
-
-			bool		wakeup_mainthread = false;
-			AckSendParam param;
-
-			memset(&param, 0, sizeof(AckSendParam));
-
-			/*
-			 * Get the connection for the pkt.
-			 *
-			 * The connection hash table should be locked until finishing the
-			 * processing of the packet to avoid the connection
-			 * addition/removal from the hash table during the mean time.
-			 */
-
-			pthread_mutex_lock(&ic_control_info.lock);
-			conn = findConnByHeader(&ic_control_info.connHtab, pkt);
-
-			if (conn != NULL)
-			{
-				/* Handling a regular packet */
-				if (handleDataPacket(conn, pkt, &peer, &peerlen, &param, &wakeup_mainthread))
-					pkt = NULL;
-				ic_statistics.recvPktNum++;
-			}
-			else
-			{
-				/*
-				 * There may have two kinds of Mismatched packets: a) Past
-				 * packets from previous command after I was torn down b)
-				 * Future packets from current command before my connections
-				 * are built.
-				 *
-				 * The handling logic is to "Ack the past and Nak the future".
-				 */
-				if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
-				{
-					if (DEBUG1 >= log_min_messages)
-						write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
-
-#ifdef AMS_VERBOSE_LOGGING
-					logPkt("Got a Mismatched Packet", pkt);
-#endif
-
-					if (handleMismatch(pkt, &peer, peerlen))
-						pkt = NULL;
-					ic_statistics.mismatchNum++;
-				}
-			}
-			pthread_mutex_unlock(&ic_control_info.lock);
-
-			if (wakeup_mainthread)
-				SetLatch(&ic_control_info.latch);
-
-			/*
-			 * real ack sending is after lock release to decrease the lock
-			 * holding time.
-			 */
-			if (param.msg.len != 0)
-				sendAckWithParam(&param);
+			npkts = nkept;
 		}
 
 		/* pthread_yield(); */
 	}
 
-	/* Before return, we release the packet. */
-	if (pkt)
+	/* Before return, we release the packets. */
+	if (npkts > 0)
 	{
 		pthread_mutex_lock(&ic_control_info.lock);
-		freeRxBuffer(&rx_buffer_pool, pkt);
-		pkt = NULL;
+		for (int i = 0; i < npkts; i++)
+			freeRxBuffer(&rx_buffer_pool, pkts[i]);
+		npkts = 0;
 		pthread_mutex_unlock(&ic_control_info.lock);
 	}
 
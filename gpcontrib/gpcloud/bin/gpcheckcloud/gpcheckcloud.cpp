@@ -142,6 +142,7 @@ static void printTemplate() {
         "secret = \"aws secret\"\n"
         "threadnum = 4\n"
         "chunksize = 67108864\n"
+        "splitsize = 0\n"
         "low_speed_limit = 10240\n"
         "low_speed_time = 60\n"
         "encryption = true\n"
@@ -6,6 +6,14 @@
 #include "s3exception.h"
 #include "s3interface.h"
 
+// A byte range of a key read by a segment. A key that is not split is read
+// as a single piece covering the whole key.
+struct KeyPiece {
+    uint64_t keyIndex;  // index of the key in the bucket listing
+    uint64_t offset;
+    uint64_t length;
+};
+
 // S3BucketReader read multiple files in a bucket.
 class S3BucketReader : public Reader {
    public:
@@ -28,6 +36,10 @@ class S3BucketReader : public Reader {
         return keyList;
     }
 
+    const vector<KeyPiece> &getKeyPieces() {
+        return keyPieces;
+    }
+
    private:
     S3Params params;
 
@@ -45,11 +57,38 @@ class S3BucketReader : public Reader {
     // copy valid data into buf and return its size.
     uint64_t readWithoutHeaderLine(char *buf, uint64_t count);
 
+    // Skip the first line (terminated with eol) of upstream reader, copy the
+    // remaining data into buf and return its size. eolFound is set to false
+    // if upstream reader reaches its end before an eol.
+    uint64_t skipFirstLine(char *buf, uint64_t count, bool &eolFound);
+
+    // Read the rest of the line that crosses the end of the current piece,
+    // return 0 if there is none.
+    uint64_t readLineTail(char *buf, uint64_t count);
+
     ListBucketResult keyList;  // List of matched keys/files.
-    uint64_t keyIndex;         // BucketContent index of keylist->contents.
 
-    BucketContent &getNextKey();
-    S3Params constructReaderParams(BucketContent &key);
+    vector<KeyPiece> keyPieces;  // Pieces of keys assigned to this segment.
+    uint64_t pieceIndex;         // Index of the next piece in keyPieces.
+
+    // The piece being read, the params it is opened with, whether it reaches
+    // the end of its key, and whether the last line read from it has not
+    // ended yet.
+    KeyPiece curPiece;
+    S3Params curPieceParams;
+    bool isPieceAtKeyEnd;
+    bool isLineOpen;
+
+    // Data after the end of the piece, fetched to complete its last line
+    // once upstreamReader has reached the end of the piece.
+    bool isReadingTail;
+    S3VectorUInt8 tailData;
+    uint64_t tailDataPos;
+    uint64_t tailOffset;
+
+    bool isSplittable(const BucketContent &key);
+    void assignKeyPieces();
+    S3Params constructReaderParams(const KeyPiece &piece);
 };
 
 #endif
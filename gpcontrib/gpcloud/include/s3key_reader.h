@@ -73,6 +73,8 @@ class S3KeyReader : public Reader {
           numOfChunks(0),
           curReadingChunk(0),
           transferredKeyLen(0),
+          rangeOffset(0),
+          isRangeAtKeyEnd(true),
           s3Interface(NULL),
           hasEol(false),
           eolAppended(false) {
@@ -152,6 +154,12 @@ class S3KeyReader : public Reader {
     uint64_t numOfChunks;
     uint64_t curReadingChunk;
     uint64_t transferredKeyLen;
+
+    // offset of the byte range being read, and whether the range reaches the
+    // end of the key. The offsetMgr treats the end of the range as its key size.
+    uint64_t rangeOffset;
+    bool isRangeAtKeyEnd;
+
     string region;
     OffsetMgr offsetMgr;
 
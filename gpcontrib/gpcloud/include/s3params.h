@@ -13,8 +13,11 @@ class S3Params {
              const string& region = "")
         : s3Url(sourceUrl, useHttps, version, region),
           keySize(0),
+          rangeOffset(0),
+          rangeLength(0),
           chunkSize(0),
           numOfChunks(0),
+          splitSize(0),
           lowSpeedLimit(0),
           lowSpeedTime(0),
           proxy(""),
@@ -72,6 +75,34 @@ class S3Params {
         this->keySize = size;
     }
 
+    uint64_t getRangeOffset() const {
+        return rangeOffset;
+    }
+
+    void setRangeOffset(uint64_t rangeOffset) {
+        this->rangeOffset = rangeOffset;
+    }
+
+    uint64_t getRangeLength() const {
+        return rangeLength;
+    }
+
+    void setRangeLength(uint64_t rangeLength) {
+        this->rangeLength = rangeLength;
+    }
+
+    bool hasRange() const {
+        return rangeLength != 0;
+    }
+
+    uint64_t getSplitSize() const {
+        return splitSize;
+    }
+
+    void setSplitSize(uint64_t splitSize) {
+        this->splitSize = splitSize;
+    }
+
     uint64_t getLowSpeedLimit() const {
         return lowSpeedLimit;
     }
@@ -152,10 +183,14 @@ class S3Params {
 
     uint64_t keySize;  // key/file size.
 
+    uint64_t rangeOffset;  // offset of the byte range of the key to read.
+    uint64_t rangeLength;  // length of the byte range, 0 to read the whole key.
+
     S3Credential cred;  // S3 credential.
 
     uint64_t chunkSize;    // chunk size
     uint64_t numOfChunks;  // number of chunks(threads).
+    uint64_t splitSize;    // split plain keys larger than this among segments, 0 to disable.
 
     uint64_t lowSpeedLimit;  // low speed limit
     uint64_t lowSpeedTime;   // low speed timeout
@@ -1,13 +1,27 @@
 #include "s3bucket_reader.h"
 
+// Reading a piece costs a request besides its data, count it as this many
+// bytes when balancing pieces among segments.
+#define KEY_PIECE_OPEN_COST (1024 * 1024)
+
+// Size of each request to fetch the line crossing the end of a piece.
+#define LINE_TAIL_FETCH_SIZE (64 * 1024)
+
 S3BucketReader::S3BucketReader() : Reader() {
-    this->keyIndex = 0;  // doesn't matter, be set in open()
+    this->pieceIndex = 0;
 
     this->s3Interface = NULL;
     this->upstreamReader = NULL;
 
     this->needNewReader = true;
     this->isFirstFile = true;
+
+    this->curPiece = KeyPiece();
+    this->isPieceAtKeyEnd = true;
+    this->isLineOpen = false;
+    this->isReadingTail = false;
+    this->tailDataPos = 0;
+    this->tailOffset = 0;
 }
 
 S3BucketReader::~S3BucketReader() {
@@ -17,8 +31,6 @@ S3BucketReader::~S3BucketReader() {
 void S3BucketReader::open(const S3Params& params) {
     this->params = params;
 
-    this->keyIndex = s3ext_segid;  // we may change it in unit tests
-
     S3_CHECK_OR_DIE(this->s3Interface != NULL, S3RuntimeError, "s3Interface is NULL");
 
     S3Url& s3Url = this->params.getS3Url();
@@ -27,15 +39,90 @@ void S3BucketReader::open(const S3Params& params) {
                     s3Url.getFullUrlForCurl());
 
     this->keyList = this->s3Interface->listBucket(s3Url);
+
+    this->assignKeyPieces();
+    this->pieceIndex = 0;
+}
+
+// Only plain keys can be read from the middle, and when every file has a header
+// line, it can't be told apart from the data in the middle of a key.
+bool S3BucketReader::isSplittable(const BucketContent& key) {
+    uint64_t splitSize = this->params.getSplitSize();
+    if (splitSize == 0 || s3ext_segnum <= 1 || hasHeader || key.getSize() <= splitSize) {
+        return false;
+    }
+
+    string keyEncoded = UriEncode(key.getName());
+    FindAndReplace(keyEncoded, "%2F", "/");
+
+    S3Params keyParams = this->params.setPrefix(keyEncoded);
+    return this->s3Interface->checkCompressionType(keyParams.getS3Url()) == S3_COMPRESSION_PLAIN;
 }
 
-BucketContent& S3BucketReader::getNextKey() {
-    BucketContent& key = this->keyList.contents[this->keyIndex];
-    this->keyIndex += s3ext_segnum;
-    return key;
+// Every segment lists the same keys and computes the same assignment from them,
+// so they need no coordination to share the bucket. Keys larger than splitsize
+// are cut into at most segnum byte ranges, then the pieces are handed out from
+// the largest one, each to the segment with the least data so far (the lowest
+// segment id on ties). This segment reads its pieces in the listing order.
+void S3BucketReader::assignKeyPieces() {
+    vector<KeyPiece> allPieces;
+    uint64_t segNum = s3ext_segnum > 0 ? s3ext_segnum : 1;
+
+    for (uint64_t i = 0; i < this->keyList.contents.size(); i++) {
+        const BucketContent& key = this->keyList.contents[i];
+        uint64_t keySize = key.getSize();
+        uint64_t numOfPieces = 1;
+
+        if (this->isSplittable(key)) {
+            uint64_t splitSize = this->params.getSplitSize();
+            numOfPieces = std::min((keySize + splitSize - 1) / splitSize, segNum);
+        }
+
+        for (uint64_t j = 0; j < numOfPieces; j++) {
+            KeyPiece piece;
+            piece.keyIndex = i;
+            piece.offset = keySize / numOfPieces * j;
+            piece.length = (j == numOfPieces - 1) ? keySize - piece.offset : keySize / numOfPieces;
+            allPieces.push_back(piece);
+        }
+    }
+
+    std::stable_sort(allPieces.begin(), allPieces.end(),
+                     [](const KeyPiece& a, const KeyPiece& b) { return a.length > b.length; });
+
+    // (bytes assigned, segment id) of every segment, the least loaded on top
+    typedef std::pair<uint64_t, int> SegmentLoad;
+    std::priority_queue<SegmentLoad, vector<SegmentLoad>, std::greater<SegmentLoad>> loads;
+    for (int i = 0; i < (int)segNum; i++) {
+        loads.push(SegmentLoad(0, i));
+    }
+
+    this->keyPieces.clear();
+    for (uint64_t i = 0; i < allPieces.size(); i++) {
+        SegmentLoad load = loads.top();
+        loads.pop();
+
+        if (load.second == s3ext_segid) {
+            this->keyPieces.push_back(allPieces[i]);
+        }
+
+        load.first += allPieces[i].length + KEY_PIECE_OPEN_COST;
+        loads.push(load);
+    }
+
+    std::sort(this->keyPieces.begin(), this->keyPieces.end(),
+              [](const KeyPiece& a, const KeyPiece& b) {
+                  return a.keyIndex < b.keyIndex ||
+                         (a.keyIndex == b.keyIndex && a.offset < b.offset);
+              });
+
+    S3DEBUG("Segment %d reads %zu of %zu key pieces", s3ext_segid, this->keyPieces.size(),
+            allPieces.size());
 }
 
-S3Params S3BucketReader::constructReaderParams(BucketContent& key) {
+S3Params S3BucketReader::constructReaderParams(const KeyPiece& piece) {
+    BucketContent& key = this->keyList.contents[piece.keyIndex];
+
     // encode the key name but leave the "/"
     // "/encoded_path/encoded_name"
     string keyEncoded = UriEncode(key.getName());
@@ -45,23 +132,45 @@ S3Params S3BucketReader::constructReaderParams(BucketContent& key) {
 
     readerParams.setKeySize(key.getSize());
 
-    S3DEBUG("key: %s, size: %" PRIu64, readerParams.getS3Url().getFullUrlForCurl().c_str(),
-            readerParams.getKeySize());
+    // A piece owns the lines starting in it. Read it from one eol earlier, so
+    // that the partial line at its start can be skipped up to the first eol,
+    // and a line starting right at the piece is kept.
+    if (piece.length < key.getSize()) {
+        uint64_t rangeOffset = piece.offset - std::min(piece.offset, (uint64_t)strlen(eolString));
+        readerParams.setRangeOffset(rangeOffset);
+        readerParams.setRangeLength(piece.offset + piece.length - rangeOffset);
+    }
+
+    S3DEBUG("key: %s, size: %" PRIu64 ", offset: %" PRIu64 ", length: %" PRIu64,
+            readerParams.getS3Url().getFullUrlForCurl().c_str(), readerParams.getKeySize(),
+            piece.offset, piece.length);
     return readerParams;
 }
 
 uint64_t S3BucketReader::readWithoutHeaderLine(char* buf, uint64_t count) {
+    bool eolFound = false;
+    uint64_t remain = this->skipFirstLine(buf, count, eolFound);
+
+    // we have reach the end of file but found no matching EOL.
+    if (!eolFound) {
+        S3WARN("%s", "Reach end of file before matching line terminator");
+    }
+
+    return remain;
+}
+
+uint64_t S3BucketReader::skipFirstLine(char* buf, uint64_t count, bool& eolFound) {
     char* current = NULL;
     char* end = NULL;
     char* currentEOL = eolString;
 
+    eolFound = false;
+
     // check one char at a time
     while (*currentEOL != '\0') {
         if (current == end) {
             uint64_t readCount = this->upstreamReader->read(buf, count);
-            // we have reach the end of file but found no matching EOL.
             if (readCount == 0) {
-                S3WARN("%s", "Reach end of file before matching line terminator");
                 return 0;
             }
 
@@ -81,6 +190,8 @@ uint64_t S3BucketReader::readWithoutHeaderLine(char* buf, uint64_t count) {
         }
     }
 
+    eolFound = true;
+
     // move remained data to front.
     uint64_t remain = end - current;
     char* p = buf;
@@ -93,22 +204,82 @@ uint64_t S3BucketReader::readWithoutHeaderLine(char* buf, uint64_t count) {
     return remain;
 }
 
+uint64_t S3BucketReader::readLineTail(char* buf, uint64_t count) {
+    if (!this->isLineOpen) {
+        return 0;
+    }
+
+    uint64_t keySize = this->keyList.contents[this->curPiece.keyIndex].getSize();
+
+    char eolLastChar = eolString[strlen(eolString) - 1];
+
+    if (this->tailDataPos == this->tailData.size()) {
+        if (this->tailOffset >= keySize) {
+            // the last line of the key has no eol, end it as S3KeyReader does.
+            uint64_t eolLen = strlen(eolString);
+            memcpy(buf, eolString, eolLen);
+            this->isLineOpen = false;
+            return eolLen;
+        }
+
+        uint64_t len = std::min((uint64_t)LINE_TAIL_FETCH_SIZE, keySize - this->tailOffset);
+        uint64_t readLen = this->s3Interface->fetchData(this->tailOffset, this->tailData, len,
+                                                        this->curPieceParams.getS3Url());
+        S3_CHECK_OR_DIE(readLen == len && this->tailData.size() == len, S3PartialResponseError,
+                        len, readLen);
+
+        this->tailOffset += len;
+        this->tailDataPos = 0;
+    }
+
+    uint64_t readCount = 0;
+    while (readCount < count && this->tailDataPos < this->tailData.size()) {
+        char c = this->tailData[this->tailDataPos++];
+        buf[readCount++] = c;
+        if (c == eolLastChar) {
+            this->isLineOpen = false;
+            break;
+        }
+    }
+
+    return readCount;
+}
+
 uint64_t S3BucketReader::read(char* buf, uint64_t count) {
     S3_CHECK_OR_DIE(this->upstreamReader != NULL, S3RuntimeError, "upstreamReader is NULL");
     uint64_t readCount = 0;
+    char eolLastChar = eolString[strlen(eolString) - 1];
+
     while (true) {
         if (this->needNewReader) {
-            if (this->keyIndex >= this->keyList.contents.size()) {
+            if (this->pieceIndex >= this->keyPieces.size()) {
                 S3DEBUG("Read finished for segment: %d", s3ext_segid);
                 return 0;
             }
-            BucketContent& key = this->getNextKey();
+            this->curPiece = this->keyPieces[this->pieceIndex++];
+            this->curPieceParams = constructReaderParams(this->curPiece);
+            this->isPieceAtKeyEnd = (this->curPiece.offset + this->curPiece.length >=
+                                     this->curPieceParams.getKeySize());
+            this->isLineOpen = false;
+            this->isReadingTail = false;
+            this->tailData.release();
+            this->tailDataPos = 0;
+            this->tailOffset = this->curPiece.offset + this->curPiece.length;
 
-            this->upstreamReader->open(constructReaderParams(key));
+            this->upstreamReader->open(this->curPieceParams);
             this->needNewReader = false;
 
-            // ignore header line if it is not the first file
-            if (hasHeader && !this->isFirstFile) {
+            if (this->curPiece.offset > 0) {
+                // the line crossing the start of the piece is read by the previous one
+                bool eolFound = false;
+                readCount = skipFirstLine(buf, count, eolFound);
+                if (readCount != 0) {
+                    this->isLineOpen =
+                        !this->isPieceAtKeyEnd && (buf[readCount - 1] != eolLastChar);
+                    return readCount;
+                }
+            } else if (hasHeader && !this->isFirstFile) {
+                // ignore header line if it is not the first file
                 readCount = readWithoutHeaderLine(buf, count);
                 if (readCount != 0) {
                     return readCount;
@@ -116,7 +287,18 @@ uint64_t S3BucketReader::read(char* buf, uint64_t count) {
             }
         }
 
-        readCount = this->upstreamReader->read(buf, count);
+        if (!this->isReadingTail) {
+            readCount = this->upstreamReader->read(buf, count);
+            if (readCount != 0) {
+                this->isLineOpen = !this->isPieceAtKeyEnd && (buf[readCount - 1] != eolLastChar);
+                return readCount;
+            }
+
+            // the line crossing the end of the piece is read by this one
+            this->isReadingTail = true;
+        }
+
+        readCount = readLineTail(buf, count);
         if (readCount != 0) {
             return readCount;
         }
@@ -137,4 +319,7 @@ void S3BucketReader::close() {
     if (!this->keyList.contents.empty()) {
         this->keyList.contents.clear();
     }
-}
\ No newline at end of file
+
+    this->keyPieces.clear();
+    this->tailData.release();
+}
@@ -3,7 +3,10 @@
 void S3CommonReader::open(const S3Params &params) {
     this->keyReader.setS3InterfaceService(s3InterfaceService);
 
-    S3CompressionType compressionType = s3InterfaceService->checkCompressionType(params.getS3Url());
+    // byte ranges are only read from keys already known to be plain
+    S3CompressionType compressionType =
+        params.hasRange() ? S3_COMPRESSION_PLAIN
+                          : s3InterfaceService->checkCompressionType(params.getS3Url());
 
     switch (compressionType) {
         case S3_COMPRESSION_DEFLATE:
@@ -107,6 +107,10 @@ S3Params InitConfig(const string& urlWithOptions) {
                                        8 * 1024 * 1024, 128 * 1024 * 1024);
     params.setChunkSize(chunkSize);
 
+    // 0 keeps every key on a single segment
+    int64_t splitSize = s3Cfg.SafeScan("splitsize", configSection, 0, 0, INT64_MAX);
+    params.setSplitSize(splitSize);
+
     int64_t lowSpeedLimit = s3Cfg.SafeScan("low_speed_limit", configSection, 10240, 0, INT_MAX);
     params.setLowSpeedLimit(lowSpeedLimit);
 
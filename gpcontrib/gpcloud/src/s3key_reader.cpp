@@ -189,7 +189,17 @@ void S3KeyReader::open(const S3Params& params) {
     this->numOfChunks = params.getNumOfChunks();
     S3_CHECK_OR_DIE(this->numOfChunks > 0, S3RuntimeError, "numOfChunks must not be zero");
 
-    this->offsetMgr.setKeySize(params.getKeySize());
+    // read only the given byte range of the key if there is one
+    uint64_t rangeEnd = params.getKeySize();
+    this->rangeOffset = 0;
+    if (params.hasRange()) {
+        this->rangeOffset = std::min(params.getRangeOffset(), params.getKeySize());
+        rangeEnd = std::min(this->rangeOffset + params.getRangeLength(), params.getKeySize());
+    }
+    this->isRangeAtKeyEnd = (rangeEnd == params.getKeySize());
+
+    this->offsetMgr.setKeySize(rangeEnd);
+    this->offsetMgr.setCurPos(this->rangeOffset);
     this->offsetMgr.setChunkSize(params.getChunkSize());
 
     S3_CHECK_OR_DIE(params.getChunkSize() > 0, S3RuntimeError,
@@ -211,13 +221,14 @@ void S3KeyReader::open(const S3Params& params) {
 }
 
 uint64_t S3KeyReader::read(char* buf, uint64_t count) {
-    uint64_t fileLen = this->offsetMgr.getKeySize();
+    uint64_t fileLen = this->offsetMgr.getKeySize() - this->rangeOffset;
     uint64_t readLen = 0;
 
     do {
         // confirm there is no more available data, done with this file
         if (this->transferredKeyLen >= fileLen) {
-            if (!this->hasEol && !this->eolAppended) {
+            // a range in the middle of the key is not the end of its last line
+            if (!this->hasEol && !this->eolAppended && this->isRangeAtKeyEnd) {
                 uint64_t eolLen = strlen(eolString);
                 memcpy(buf, eolString, eolLen);
 
@@ -264,6 +275,8 @@ void S3KeyReader::reset() {
     this->sharedError = false;
     this->curReadingChunk = 0;
     this->transferredKeyLen = 0;
+    this->rangeOffset = 0;
+    this->isRangeAtKeyEnd = true;
 
     this->offsetMgr.reset();
 
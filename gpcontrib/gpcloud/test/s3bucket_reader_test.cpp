@@ -8,6 +8,7 @@ using ::testing::AtLeast;
 using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::Throw;
+using ::testing::Truly;
 
 class MockS3Reader : public Reader {
    public:
@@ -285,3 +286,178 @@ TEST_F(S3BucketReaderTest, ReadBucketFileWithHeaderAndFuzyMatch) {
     eolString[0] = '\n';
     eolString[1] = '\0';
 }
+
+TEST_F(S3BucketReaderTest, AssignKeysBySize) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 1024 * 1024);
+    result.contents.emplace_back("bar", 64 * 1024 * 1024);
+    result.contents.emplace_back("baz", 1024 * 1024);
+    result.contents.emplace_back("qux", 1024 * 1024);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(2).WillRepeatedly(Return(result));
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    s3ext_segnum = 2;
+
+    // the large key takes a segment, the small ones go to the other
+    s3ext_segid = 0;
+    bucketReader->open(params);
+    ASSERT_EQ((uint64_t)1, bucketReader->getKeyPieces().size());
+    EXPECT_EQ((uint64_t)1, bucketReader->getKeyPieces()[0].keyIndex);
+    bucketReader->close();
+
+    s3ext_segid = 1;
+    bucketReader->open(params);
+    const vector<KeyPiece>& pieces = bucketReader->getKeyPieces();
+    ASSERT_EQ((uint64_t)3, pieces.size());
+    EXPECT_EQ((uint64_t)0, pieces[0].keyIndex);
+    EXPECT_EQ((uint64_t)2, pieces[1].keyIndex);
+    EXPECT_EQ((uint64_t)3, pieces[2].keyIndex);
+}
+
+TEST_F(S3BucketReaderTest, SplitLargePlainKey) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 400);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).WillRepeatedly(Return(result));
+    EXPECT_CALL(s3Interface, checkCompressionType(_))
+        .WillRepeatedly(Return(S3_COMPRESSION_PLAIN));
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setSplitSize(100);
+    s3ext_segnum = 8;
+
+    // the key is cut into 400 / splitsize pieces, one for each of the first segments
+    for (s3ext_segid = 0; s3ext_segid < 8; s3ext_segid++) {
+        bucketReader->open(params);
+        const vector<KeyPiece>& pieces = bucketReader->getKeyPieces();
+        if (s3ext_segid < 4) {
+            ASSERT_EQ((uint64_t)1, pieces.size());
+            EXPECT_EQ((uint64_t)s3ext_segid * 100, pieces[0].offset);
+            EXPECT_EQ((uint64_t)100, pieces[0].length);
+        } else {
+            EXPECT_EQ((uint64_t)0, pieces.size());
+        }
+        bucketReader->close();
+    }
+}
+
+TEST_F(S3BucketReaderTest, DoNotSplitCompressedKey) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo.gz", 400);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+    EXPECT_CALL(s3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_GZIP));
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setSplitSize(100);
+    s3ext_segnum = 4;
+    s3ext_segid = 0;
+
+    bucketReader->open(params);
+    ASSERT_EQ((uint64_t)1, bucketReader->getKeyPieces().size());
+    EXPECT_EQ((uint64_t)0, bucketReader->getKeyPieces()[0].offset);
+    EXPECT_EQ((uint64_t)400, bucketReader->getKeyPieces()[0].length);
+}
+
+class MockFetchTail {
+   public:
+    MockFetchTail(const char* ptr) : p(ptr) {
+    }
+    uint64_t operator()(uint64_t offset, S3VectorUInt8& data, uint64_t len, const S3Url& s3Url) {
+        data.assign(p, p + len);
+        return len;
+    }
+
+   private:
+    const char* p;
+};
+
+// "abcde\nfg|hij\nklm\n" is split at the "|" between two segments
+TEST_F(S3BucketReaderTest, ReadFirstPieceWithLineTail) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 16);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+    EXPECT_CALL(s3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_PLAIN));
+    EXPECT_CALL(s3Interface, fetchData(8, _, 8, _)).WillOnce(Invoke(MockFetchTail("hij\nklm\n")));
+
+    EXPECT_CALL(s3Reader, read(_, _))
+        .WillOnce(Invoke(MockRead("abcde\nfg")))
+        .WillOnce(Return(0));
+    EXPECT_CALL(s3Reader, open(_)).Times(1);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setSplitSize(8);
+    s3ext_segnum = 2;
+    s3ext_segid = 0;
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_EQ((uint64_t)8, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ((uint64_t)4, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ(0, strncmp(buf, "hij\n", 4));
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
+
+TEST_F(S3BucketReaderTest, ReadSecondPieceWithoutFirstLine) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 16);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+    EXPECT_CALL(s3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_PLAIN));
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _)).Times(0);
+
+    // the piece is read from one byte before its start
+    EXPECT_CALL(s3Reader, read(_, _))
+        .WillOnce(Invoke(MockRead("ghij\nklm\n")))
+        .WillOnce(Return(0));
+    EXPECT_CALL(s3Reader, open(_)).Times(1);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setSplitSize(8);
+    s3ext_segnum = 2;
+    s3ext_segid = 1;
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_EQ((uint64_t)4, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ(0, strncmp(buf, "klm\n", 4));
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
+
+// "ab\r\n|cd\r\n" is split at the "|" between two segments, right at a line start
+TEST_F(S3BucketReaderTest, ReadSecondPieceStartingAtCRLFLine) {
+    eolString[0] = '\r';
+    eolString[1] = '\n';
+    eolString[2] = '\0';
+
+    ListBucketResult result;
+    result.contents.emplace_back("foo", 8);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+    EXPECT_CALL(s3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_PLAIN));
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _)).Times(0);
+
+    // the piece is read from the whole eol before its start
+    EXPECT_CALL(s3Reader, read(_, _))
+        .WillOnce(Invoke(MockRead("\r\ncd\r\n")))
+        .WillOnce(Return(0));
+    EXPECT_CALL(s3Reader, open(Truly([](const S3Params& p) {
+                    return p.getRangeOffset() == 2 && p.getRangeLength() == 6;
+                }))).Times(1);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setSplitSize(4);
+    s3ext_segnum = 2;
+    s3ext_segid = 1;
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_EQ((uint64_t)4, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ(0, strncmp(buf, "cd\r\n", 4));
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
@@ -61,6 +61,20 @@ TEST_F(S3CommonReaderTest, OpenPlain) {
     ASSERT_TRUE(NULL != dynamic_cast<S3KeyReader *>(this->upstreamReader));
 }
 
+TEST_F(S3CommonReaderTest, OpenRangeAsPlain) {
+    // test case for: a byte range is read without checking the compression type
+    EXPECT_CALL(mockS3Interface, checkCompressionType(_)).Times(0);
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(1);
+    params.setChunkSize(1024 * 1024 * 2);
+    params.setKeySize(1024);
+    params.setRangeOffset(511);
+    params.setRangeLength(513);
+    this->open(params);
+
+    ASSERT_EQ(this->upstreamReader, &this->keyReader);
+}
+
 TEST_F(S3CommonReaderTest, ReadGZip) {
     Byte compressionBuff[0x100];
     uLong compressedLen = sizeof(compressionBuff);
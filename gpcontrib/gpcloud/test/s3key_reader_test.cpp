@@ -263,6 +263,42 @@ TEST_F(S3KeyReaderTest, ReadWithSingleChunk) {
     EXPECT_EQ((uint64_t)0, this->read(buffer, 64 * 1024));
 }
 
+TEST_F(S3KeyReaderTest, ReadRangeInMiddleOfKey) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(1);
+    params.setKeySize(1024);
+    params.setChunkSize(8192);
+    params.setRangeOffset(255);
+    params.setRangeLength(256);
+
+    EXPECT_CALL(s3Interface, fetchData(255, _, 256, _))
+        .WillOnce(Invoke(MockFetchData(256, 8192)));
+
+    this->open(params);
+
+    // no eol is appended to a range that doesn't reach the end of the key
+    EXPECT_EQ((uint64_t)256, this->read(buffer, 64 * 1024));
+    EXPECT_EQ((uint64_t)0, this->read(buffer, 64 * 1024));
+}
+
+TEST_F(S3KeyReaderTest, ReadRangeAtEndOfKey) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(1);
+    params.setKeySize(1024);
+    params.setChunkSize(8192);
+    params.setRangeOffset(767);
+    params.setRangeLength(257);
+
+    EXPECT_CALL(s3Interface, fetchData(767, _, 257, _))
+        .WillOnce(Invoke(MockFetchData(257, 8192)));
+
+    this->open(params);
+
+    EXPECT_EQ((uint64_t)257, this->read(buffer, 64 * 1024));
+    EXPECT_EQ((uint64_t)1, this->read(buffer, 64 * 1024));
+    EXPECT_EQ((uint64_t)0, this->read(buffer, 64 * 1024));
+}
+
 TEST_F(S3KeyReaderTest, ReadWithSingleChunkNormalCase) {
     // Read buffer < chunk size < key size
     S3Params params("s3://abc/def");
@@ -24,6 +24,7 @@
 #include "access/appendonlywriter.h"
 #include "access/heapam.h"
 #include "access/hio.h"
+#include "access/nbtree.h"
 #include "catalog/catalog.h"
 #include "catalog/gp_fastsequence.h"
 #include "catalog/namespace.h"
@@ -36,6 +37,7 @@
 #include "cdb/cdbappendonlystorageread.h"
 #include "cdb/cdbappendonlystoragewrite.h"
 #include "cdb/cdbvars.h"
+#include "commands/defrem.h"
 #include "executor/executor.h"
 #include "fmgr.h"
 #include "miscadmin.h"
@@ -61,7 +63,42 @@ static AOCSScanDesc aocs_beginscan_internal(Relation relation,
 						bool *proj,
 						uint32 flags);
 
+/*
+ * A "Var op Const" condition of a pushed-down qual, used to tell whether any
+ * value in a block of the column can satisfy the qual.
+ */
+typedef struct AOCSBlockSkipKey
+{
+	StrategyNumber strategy;	/* btree strategy of the operator */
+	FmgrInfo	cmpfn;			/* btree comparison function */
+	Oid			collation;
+	Datum		arg;			/* the constant */
+} AOCSBlockSkipKey;
+
+typedef struct AOCSBlockSkipInfo
+{
+	int			nkeys;
+	AOCSBlockSkipKey keys[FLEXIBLE_ARRAY_MEMBER];
+} AOCSBlockSkipInfo;
+
+/*
+ * Values of a column decoded ahead of the scan position, a batch at a time,
+ * by datumstreamread_get_batch(). A batch never spans blocks, so the values
+ * stay valid until the batch is used up.
+ */
+typedef struct AOCSColumnBatch
+{
+	Datum	   *values;
+	bool	   *isnull;
+	int			nvalues;
+	int			pos;			/* index of the current value */
+	int			firstnth;		/* position of values[0] in its block */
+} AOCSColumnBatch;
+
 static void reorder_qual_col(AOCSScanDesc scan);
+static void aocs_blockskip_prepare(AOCSScanDesc scan, AttrNumber attno, List *quals);
+static bool aocs_skip_blocks(AOCSScanDesc scan, AOCSFileSegInfo *curseginfo);
+static int aocs_column_advance(AOCSScanDesc scan, AttrNumber attno);
 static bool aocs_col_predicate_test(AOCSScanDesc scan, TupleTableSlot *slot, int i, bool sample_phase);
 static bool aocs_getnext_sample(AOCSScanDesc scan, ScanDirection direction, TupleTableSlot *slot);
 static void aocs_insert_finish_guts(AOCSInsertDesc aoInsertDesc);
@@ -334,6 +371,22 @@ initscan_with_colinfo(AOCSScanDesc scan)
 				 scan->columnScanInfo.proj_atts, scan->columnScanInfo.num_proj_atts,
 				 scan->checksum);
 
+	if (scan->aos_batches == NULL && gp_aocs_scan_batch_size > 0)
+	{
+		scan->aos_batch_size = gp_aocs_scan_batch_size;
+		scan->aos_batches = (AOCSColumnBatch *)
+							palloc0(natts * sizeof(AOCSColumnBatch));
+
+		for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+		{
+			AOCSColumnBatch *batch;
+
+			batch = &scan->aos_batches[scan->columnScanInfo.proj_atts[i]];
+			batch->values = palloc(scan->aos_batch_size * sizeof(Datum));
+			batch->isnull = palloc(scan->aos_batch_size * sizeof(bool));
+		}
+	}
+
 	MemoryContextSwitchTo(oldCtx);
 
 	scan->cur_seg = -1;
@@ -453,6 +506,8 @@ close_cur_scan_seg(AOCSScanDesc scan)
 	{
 		if (scan->columnScanInfo.ds[attno])
 			datumstreamread_close_file(scan->columnScanInfo.ds[attno]);
+		if (scan->aos_batches)
+			scan->aos_batches[attno].nvalues = scan->aos_batches[attno].pos = 0;
 	}
 
 	if (scan->blockDirectory)
@@ -632,6 +687,19 @@ aocs_endscan(AOCSScanDesc scan)
 		pfree(scan->columnScanInfo.ds);
 	}
 
+	if (scan->aos_batches)
+	{
+		for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+		{
+			AOCSColumnBatch *batch;
+
+			batch = &scan->aos_batches[scan->columnScanInfo.proj_atts[i]];
+			pfree(batch->values);
+			pfree(batch->isnull);
+		}
+		pfree(scan->aos_batches);
+	}
+
 	if (scan->columnScanInfo.relationTupleDesc)
 	{
 		Assert(scan->columnScanInfo.proj_atts);
@@ -807,30 +875,32 @@ ReadNext:
 		Assert(scan->cur_seg >= 0);
 		curseginfo = scan->seginfo[scan->cur_seg];
 
+		/*
+		 * Pass over the blocks in which no row can satisfy the pushed-down
+		 * quals, before positioning the columns on the next row.
+		 */
+		if (scan->aos_blockskip && !aocs_skip_blocks(scan, curseginfo))
+		{
+			err = -1;
+			close_cur_scan_seg(scan);
+			goto ReadNext;
+		}
+
 		/* Read from cur_seg */
 		visible_pass = predicate_pass = true;
 		for (AttrNumber i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
 		{
 			AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+			AOCSColumnBatch *batch = NULL;
 
-			err = datumstreamread_advance(scan->columnScanInfo.ds[attno]);
-			Assert(err >= 0);
-			if (err == 0)
+			err = aocs_column_advance(scan, attno);
+			if (err < 0)
 			{
-				err = datumstreamread_block(scan->columnScanInfo.ds[attno], scan->blockDirectory, attno);
-				if (err < 0)
-				{
-					/*
-					 * Ha, cannot read next block, we need to go to next seg
-					 */
-					close_cur_scan_seg(scan);
-					goto ReadNext;
-				}
-
-				AOCSScanDesc_UpdateTotalBytesRead(scan, attno);
-
-				err = datumstreamread_advance(scan->columnScanInfo.ds[attno]);
-				Assert(err > 0);
+				/*
+				 * Ha, cannot read next block, we need to go to next seg
+				 */
+				close_cur_scan_seg(scan);
+				goto ReadNext;
 			}
 			if (!visible_pass || !predicate_pass)
 				continue; /* not break, need advance for other cols */
@@ -839,7 +909,14 @@ ReadNext:
 			 * Get the column's datum right here since the data structures
 			 * should still be hot in CPU data cache memory.
 			 */
-			datumstreamread_get(scan->columnScanInfo.ds[attno], &d[attno], &null[attno]);
+			if (scan->aos_batches)
+			{
+				batch = &scan->aos_batches[attno];
+				d[attno] = batch->values[batch->pos];
+				null[attno] = batch->isnull[batch->pos];
+			}
+			else
+				datumstreamread_get(scan->columnScanInfo.ds[attno], &d[attno], &null[attno]);
 
 			/*
 			 * Perform any required upgrades on the Datum we just fetched.
@@ -857,7 +934,8 @@ ReadNext:
 				{
 					Assert(scan->columnScanInfo.ds[attno]->blockFirstRowNum > 0);
 					rowNum = scan->columnScanInfo.ds[attno]->blockFirstRowNum +
-						datumstreamread_nth(scan->columnScanInfo.ds[attno]);
+						(batch ? batch->firstnth + batch->pos :
+						 datumstreamread_nth(scan->columnScanInfo.ds[attno]));
 				}
 				scan->cur_seg_row++;
 				if (rowNum == INT64CONST(-1))
@@ -902,6 +980,67 @@ ReadNext:
 	return false;
 }
 
+/*
+ * Position column 'attno' of the scan on its next value, reading the next
+ * block of the column if needed.
+ *
+ * When the scan decodes columns in batches, the value is taken from the
+ * column's batch, which is refilled from the datum stream once used up.
+ * The datum stream is then ahead of the scan position by the values left
+ * in the batch.
+ *
+ * Returns -1 at the end of the segment file.
+ */
+static int
+aocs_column_advance(AOCSScanDesc scan, AttrNumber attno)
+{
+	DatumStreamRead *ds = scan->columnScanInfo.ds[attno];
+	AOCSColumnBatch *batch;
+	int			err;
+
+	if (scan->aos_batches == NULL)
+	{
+		err = datumstreamread_advance(ds);
+		Assert(err >= 0);
+		if (err == 0)
+		{
+			err = datumstreamread_block(ds, scan->blockDirectory, attno);
+			if (err < 0)
+				return err;
+
+			AOCSScanDesc_UpdateTotalBytesRead(scan, attno);
+
+			err = datumstreamread_advance(ds);
+			Assert(err > 0);
+		}
+		return 1;
+	}
+
+	batch = &scan->aos_batches[attno];
+	if (++batch->pos < batch->nvalues)
+		return 1;
+
+	batch->nvalues = datumstreamread_get_batch(ds, batch->values, batch->isnull,
+											   scan->aos_batch_size);
+	if (batch->nvalues == 0)
+	{
+		err = datumstreamread_block(ds, scan->blockDirectory, attno);
+		if (err < 0)
+			return err;
+
+		AOCSScanDesc_UpdateTotalBytesRead(scan, attno);
+
+		batch->nvalues = datumstreamread_get_batch(ds, batch->values,
+												   batch->isnull,
+												   scan->aos_batch_size);
+		Assert(batch->nvalues > 0);
+	}
+	batch->pos = 0;
+	batch->firstnth = datumstreamread_nth(ds) - batch->nvalues + 1;
+
+	return 1;
+}
+
 
 /* Open next file segment for write.  See SetCurrentFileSegForWrite */
 /* XXX Right now, we put each column to different files */
@@ -2347,6 +2486,8 @@ aocs_predicate_pushdown_prepare(AOCSScanDesc scan,
 	scan->aos_sample_rows       = gp_predicate_pushdown_sample_rows;
 	scan->aos_scaned_rows       = 0;
 	scan->aos_qual_rows         = (int *)palloc0(sizeof(int) * ncol);
+	scan->aos_blockskip         = NULL;
+	scan->aos_blocks_skipped    = 0;
 
 	if (!qual)
 		return state;
@@ -2370,6 +2511,7 @@ aocs_predicate_pushdown_prepare(AOCSScanDesc scan,
 		Assert(scan->aos_pushdown_qual[0] == NULL);
 		scan->aos_pushdown_qual[0] = state;
 		scan->aos_qual_col_num = 1;
+		aocs_blockskip_prepare(scan, qual_atts[0], qual);
 
 		/* The whole qual can be pushed down, so no left qual with seqscan node. */
 		return NULL;
@@ -2442,11 +2584,265 @@ aocs_predicate_pushdown_prepare(AOCSScanDesc scan,
 	{
 		Assert(qual_list[i]);
 		scan->aos_pushdown_qual[i] = ExecInitQual(qual_list[i], ps);
+		aocs_blockskip_prepare(scan, scan->columnScanInfo.proj_atts[i], qual_list[i]);
 	}
 	scan->aos_qual_col_num = qual_attr_num;
 	return ExecInitQual(quals_in_scan, ps);
 }
 
+/*
+ * Collect the "Var op Const" conditions in the quals pushed down to column
+ * 'attno' (zero based), where op is a btree comparison operator of the
+ * column's type, so that aocs_skip_blocks() can tell when a whole block of
+ * the column cannot satisfy them. Other conditions are ignored; that only
+ * makes the test more conservative.
+ */
+static void
+aocs_blockskip_prepare(AOCSScanDesc scan, AttrNumber attno, List *quals)
+{
+	Relation	rel = scan->rs_base.rs_rd;
+	Form_pg_attribute attr = TupleDescAttr(RelationGetDescr(rel), attno);
+	AOCSBlockSkipInfo *info;
+	Oid			opclass;
+	Oid			opfamily;
+	ListCell   *lc;
+
+	if (!gp_enable_aocs_block_skipping)
+		return;
+
+	opclass = GetDefaultOpClass(attr->atttypid, BTREE_AM_OID);
+	if (!OidIsValid(opclass))
+		return;
+	opfamily = get_opclass_family(opclass);
+
+	info = palloc0(offsetof(AOCSBlockSkipInfo, keys) +
+				   list_length(quals) * sizeof(AOCSBlockSkipKey));
+
+	foreach(lc, quals)
+	{
+		OpExpr	   *opexpr = (OpExpr *) lfirst(lc);
+		Expr	   *leftop;
+		Expr	   *rightop;
+		Oid			opno;
+		int			strategy;
+		Oid			lefttype;
+		Oid			righttype;
+		Oid			cmpproc;
+		AOCSBlockSkipKey *key;
+
+		if (!IsA(opexpr, OpExpr) || list_length(opexpr->args) != 2)
+			continue;
+
+		leftop = (Expr *) linitial(opexpr->args);
+		rightop = (Expr *) lsecond(opexpr->args);
+		if (leftop && IsA(leftop, RelabelType))
+			leftop = ((RelabelType *) leftop)->arg;
+		if (rightop && IsA(rightop, RelabelType))
+			rightop = ((RelabelType *) rightop)->arg;
+
+		opno = opexpr->opno;
+		if (IsA(rightop, Var) && IsA(leftop, Const))
+		{
+			Expr	   *tmp = leftop;
+
+			leftop = rightop;
+			rightop = tmp;
+			opno = get_commutator(opno);
+			if (!OidIsValid(opno))
+				continue;
+		}
+		if (!IsA(leftop, Var) || ((Var *) leftop)->varattno != attno + 1 ||
+			!IsA(rightop, Const) || ((Const *) rightop)->constisnull)
+			continue;
+
+		if (!op_in_opfamily(opno, opfamily))
+			continue;
+		get_op_opfamily_properties(opno, opfamily, false,
+								   &strategy, &lefttype, &righttype);
+		cmpproc = get_opfamily_proc(opfamily, lefttype, righttype, BTORDER_PROC);
+		if (!OidIsValid(cmpproc))
+			continue;
+
+		key = &info->keys[info->nkeys++];
+		key->strategy = strategy;
+		fmgr_info(cmpproc, &key->cmpfn);
+		key->collation = opexpr->inputcollid;
+		key->arg = ((Const *) rightop)->constvalue;
+	}
+
+	if (info->nkeys == 0)
+	{
+		pfree(info);
+		return;
+	}
+
+	if (scan->aos_blockskip == NULL)
+		scan->aos_blockskip = palloc0(sizeof(AOCSBlockSkipInfo *) *
+									  RelationGetNumberOfAttributes(rel));
+	scan->aos_blockskip[attno] = info;
+}
+
+/*
+ * Can 'value' satisfy all the conditions collected by aocs_blockskip_prepare()?
+ */
+static bool
+aocs_blockskip_test(AOCSBlockSkipInfo *info, Datum value)
+{
+	for (int i = 0; i < info->nkeys; i++)
+	{
+		AOCSBlockSkipKey *key = &info->keys[i];
+		int32		cmp;
+
+		cmp = DatumGetInt32(FunctionCall2Coll(&key->cmpfn, key->collation,
+											  value, key->arg));
+		switch (key->strategy)
+		{
+			case BTLessStrategyNumber:
+				if (cmp >= 0)
+					return false;
+				break;
+			case BTLessEqualStrategyNumber:
+				if (cmp > 0)
+					return false;
+				break;
+			case BTEqualStrategyNumber:
+				if (cmp != 0)
+					return false;
+				break;
+			case BTGreaterEqualStrategyNumber:
+				if (cmp < 0)
+					return false;
+				break;
+			case BTGreaterStrategyNumber:
+				if (cmp <= 0)
+					return false;
+				break;
+		}
+	}
+	return true;
+}
+
+/*
+ * Can any row in the block just read into 'ds' satisfy the conditions?
+ * The block is left positioned at its beginning.
+ *
+ * The btree comparison operators are strict, so NULLs never match.
+ */
+static bool
+aocs_block_may_match(AOCSScanDesc scan, DatumStreamRead *ds,
+					 AOCSBlockSkipInfo *info)
+{
+	MemoryContext oldcxt;
+	bool		match = false;
+
+	oldcxt = MemoryContextSwitchTo(scan->aos_pushdown_econtext->ecxt_per_tuple_memory);
+	while (!match && datumstreamread_advance(ds) > 0)
+	{
+		Datum		value;
+		bool		isnull;
+
+		datumstreamread_get(ds, &value, &isnull);
+		if (!isnull)
+			match = aocs_blockskip_test(info, value);
+	}
+	MemoryContextSwitchTo(oldcxt);
+	ResetExprContext(scan->aos_pushdown_econtext);
+
+	datumstreamread_rewind_block(ds);
+
+	return match;
+}
+
+/*
+ * Called by aocs_getnext() between rows. If the current block of the most
+ * selective pushed-down column that has block skip conditions is exhausted,
+ * read its next block, and if no value in it can satisfy the conditions,
+ * move all the projected columns past the rows of that block. For the other
+ * columns, blocks that are entirely covered by the skipped rows are never
+ * read or decompressed. Repeat until a block that may contain a matching row
+ * is found.
+ *
+ * Returns false if the end of the segment file was reached.
+ */
+static bool
+aocs_skip_blocks(AOCSScanDesc scan, AOCSFileSegInfo *curseginfo)
+{
+	AOCSBlockSkipInfo *info = NULL;
+	AttrNumber	leadattno = InvalidAttrNumber;
+	DatumStreamRead *ds;
+
+	/* Building the block directory needs to see every block */
+	if (scan->blockDirectory)
+		return true;
+
+	/* Values in old-format segments may need upgrading before comparison */
+	if (curseginfo->formatversion < AOSegfileFormatVersion_GetLatest())
+		return true;
+
+	for (int i = 0; i < scan->aos_qual_col_num; i++)
+	{
+		AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+
+		if (scan->aos_blockskip[attno])
+		{
+			info = scan->aos_blockskip[attno];
+			leadattno = attno;
+			break;
+		}
+	}
+	if (info == NULL)
+		return true;
+
+	/* Values already decoded into the batch belong to the current block */
+	if (scan->aos_batches &&
+		scan->aos_batches[leadattno].pos + 1 < scan->aos_batches[leadattno].nvalues)
+		return true;
+
+	ds = scan->columnScanInfo.ds[leadattno];
+	while (datumstreamread_remaining(ds) == 0)
+	{
+		int64		nrows;
+
+		if (datumstreamread_block(ds, NULL, leadattno) < 0)
+			return false;
+		AOCSScanDesc_UpdateTotalBytesRead(scan, leadattno);
+
+		/* Don't bother with blocks holding a single large value */
+		if (ds->largeObjectState != DatumStreamLargeObjectState_None ||
+			aocs_block_may_match(scan, ds, info))
+			break;
+
+		nrows = ds->blockRowCount;
+		for (int i = 0; i < scan->columnScanInfo.num_proj_atts; i++)
+		{
+			AttrNumber	attno = scan->columnScanInfo.proj_atts[i];
+			int64		skip = nrows;
+
+			/* Use up what is left of the column's batch first */
+			if (scan->aos_batches)
+			{
+				AOCSColumnBatch *batch = &scan->aos_batches[attno];
+				int			left = Max(batch->nvalues - batch->pos - 1, 0);
+
+				Assert(attno != leadattno || left == 0);
+				left = Min(left, skip);
+				batch->pos += left;
+				skip -= left;
+			}
+
+			if (skip == 0)
+				continue;
+			if (datumstreamread_skip(scan->columnScanInfo.ds[attno], skip) > 0)
+				return false;
+			AOCSScanDesc_UpdateTotalBytesRead(scan, attno);
+		}
+		scan->cur_seg_row += nrows;
+		scan->aos_blocks_skipped++;
+	}
+
+	return true;
+}
+
 struct qual_sort_item {
 	int aos_qual_rows;
 	int proj_atts;
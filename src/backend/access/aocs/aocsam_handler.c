@@ -32,6 +32,7 @@
 #include "catalog/storage_xlog.h"
 #include "cdb/cdbaocsam.h"
 #include "cdb/cdbvars.h"
+#include "commands/analyzesketch.h"
 #include "commands/defrem.h"
 #include "commands/progress.h"
 #include "commands/vacuum.h"
@@ -279,6 +280,9 @@ aoco_dml_init(Relation relation, CmdType operation)
 {
 	init_dml_local_state();
 	(void) enter_dml_state(RelationGetRelid(relation));
+
+	/* Set up the sketches of the rows to append, for auto-stats */
+	appended_rows_begin(relation, operation);
 }
 
 /*
@@ -290,6 +294,8 @@ aoco_dml_finish(Relation relation, CmdType operation)
 	AOCODMLState *state;
 	bool		 had_delete_desc = false;
 
+	appended_rows_end(relation);
+
 	state = remove_dml_state(RelationGetRelid(relation));
 
 	if (!state)
@@ -620,6 +626,20 @@ extractcolumns_from_node(Node *expr, bool *cols, AttrNumber natts)
 	return  ecCtx.found;
 }
 
+/*
+ * Report the number of blocks passed over by block skipping, for EXPLAIN
+ * ANALYZE.
+ */
+static void
+aoco_scan_explain_end(PlanState *planstate, struct StringInfoData *buf)
+{
+	AOCSScanDesc aoscan = (AOCSScanDesc) ((ScanState *) planstate)->ss_currentScanDesc;
+
+	if (aoscan)
+		appendStringInfo(buf, "AOCS blocks skipped: " INT64_FORMAT,
+						 aoscan->aos_blocks_skipped);
+}
+
 static TableScanDesc
 aoco_beginscan_extractcolumns(Relation rel, Snapshot snapshot, int nkeys, struct ScanKeyData *key,
 							  ParallelTableScanDesc parallel_scan,
@@ -656,6 +676,9 @@ aoco_beginscan_extractcolumns(Relation rel, Snapshot snapshot, int nkeys, struct
 	if (gp_enable_predicate_pushdown)
 		ps->qual = aocs_predicate_pushdown_prepare(aoscan, qual, ps->qual, ps->ps_ExprContext, ps);
 
+	if (aoscan->aos_blockskip && ps->instrument && ps->instrument->need_cdb)
+		ps->cdbexplainfun = aoco_scan_explain_end;
+
 	return (TableScanDesc)aoscan;
 }
 
@@ -1056,6 +1079,10 @@ aoco_tuple_insert(Relation relation, TupleTableSlot *slot, CommandId cid,
 	aocs_insert(insertDesc, slot);
 
 	pgstat_count_heap_insert(relation, 1);
+
+	/* Sketch the new row for auto-stats, see sketch_appended_rows() */
+	if (appended_rows_sketched())
+		sketch_appended_rows(relation, &slot, 1);
 }
 
 static void
@@ -1107,6 +1134,9 @@ aoco_multi_insert(Relation relation, TupleTableSlot **slots, int ntuples,
 	}
 
 	pgstat_count_heap_insert(relation, ntuples);
+
+	if (appended_rows_sketched())
+		sketch_appended_rows(relation, slots, ntuples);
 }
 
 static TM_Result
@@ -36,6 +36,7 @@
 #include "catalog/storage_xlog.h"
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbvars.h"
+#include "commands/analyzesketch.h"
 #include "commands/vacuum.h"
 #include "commands/progress.h"
 #include "executor/executor.h"
@@ -249,6 +250,9 @@ appendonly_dml_init(Relation relation, CmdType operation)
 {
 	init_dml_local_state();
 	(void) enter_dml_state(RelationGetRelid(relation));
+
+	/* Set up the sketches of the rows to append, for auto-stats */
+	appended_rows_begin(relation, operation);
 }
 
 /*
@@ -260,6 +264,8 @@ appendonly_dml_finish(Relation relation, CmdType operation)
 	AppendOnlyDMLState *state;
 	bool				had_delete_desc = false;
 
+	appended_rows_end(relation);
+
 	state = remove_dml_state(RelationGetRelid(relation));
 
 	if (!state)
@@ -916,6 +922,10 @@ appendonly_tuple_insert(Relation relation, TupleTableSlot *slot, CommandId cid,
 
 	pgstat_count_heap_insert(relation, 1);
 
+	/* Sketch the new row for auto-stats, see sketch_appended_rows() */
+	if (appended_rows_sketched())
+		sketch_appended_rows(relation, &slot, 1);
+
 	appendonly_free_memtuple(mtuple);
 }
 
@@ -1044,6 +1054,9 @@ appendonly_multi_insert(Relation relation, TupleTableSlot **slots, int ntuples,
 	}
 	pgstat_count_heap_insert(relation, ntuples);
 
+	if (appended_rows_sketched())
+		sketch_appended_rows(relation, slots, ntuples);
+
 	for (int i = 0; i < ntuples; i++)
 		appendonly_free_memtuple(mtuple[i]);
 
@@ -19,6 +19,7 @@
 #include "cdb/cdbvars.h"
 #include "cdb/cdbtm.h"
 #include "commands/dbcommands.h"
+#include "fstream/gcompress.h"
 #include "libpq/libpq-be.h"
 #include "miscadmin.h"
 #include "postmaster/postmaster.h"		/* postmaster port */
@@ -30,6 +31,7 @@
 /* GUC */
 int readable_external_table_timeout = 0;
 int gpfdist_retry_timeout = 300;
+int gpfdist_compression = GCOMPRESS_NONE;
 
 static void base16_encode(char *raw, int len, char *encoded);
 static char *get_eol_delimiter(List *params);
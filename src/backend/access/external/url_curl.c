@@ -27,6 +27,7 @@
 #include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"
 #include "commands/copyfrom_internal.h"
+#include "fstream/gcompress.h"
 #include "miscadmin.h"
 #include "utils/guc.h"
 #include "utils/resowner.h"
@@ -96,6 +97,17 @@ typedef struct
 		int			datalen;	/* remaining datablock length */
 	} block;
 
+	gcompress_method compression;	/* compression acknowledged by gpfdist */
+
+	struct
+	{
+		char	   *ptr;		/* palloc-ed buffer */
+		int			max;
+		int			bot,
+					top;
+	} zbuf;						/* uncompressed data of the current 'Z'
+								 * block, or the compressed data to POST */
+
 } URL_CURL_FILE;
 
 #if BYTE_ORDER == BIG_ENDIAN
@@ -269,6 +281,52 @@ url_curl_abort_callback(ResourceReleasePhase phase,
 	}
 }
 
+/*
+ * get_header_value
+ *
+ * If the header line ptr of len bytes is the given header, copy its value,
+ * without the surrounding blanks, into buf and return true.
+ */
+static bool
+get_header_value(char *ptr, int len, const char *name, char *buf, int bufsz)
+{
+	int			namelen = strlen(name);
+	int			i;
+
+	if (len <= namelen || *ptr != 'X' || 0 != strncmp(name, ptr, namelen))
+		return false;
+
+	ptr += namelen;
+	len -= namelen;
+
+	while (len > 0 && (*ptr == ' ' || *ptr == '\t'))
+	{
+		ptr++;
+		len--;
+	}
+
+	if (len <= 0 || *ptr != ':')
+		return false;
+
+	ptr++;
+	len--;
+
+	while (len > 0 && (*ptr == ' ' || *ptr == '\t'))
+	{
+		ptr++;
+		len--;
+	}
+
+	for (i = 0; i < bufsz - 1 && i < len; i++)
+		buf[i] = ptr[i];
+
+	while (i > 0 && isspace((unsigned char) buf[i - 1]))
+		i--;
+
+	buf[i] = 0;
+	return true;
+}
+
 /*
  * header_callback
  *
@@ -283,7 +341,6 @@ header_callback(void *ptr_, size_t size, size_t nmemb, void *userp)
     URL_CURL_FILE *url = (URL_CURL_FILE *) userp;
 	char*		ptr = ptr_;
 	int 		len = size * nmemb;
-	int 		i;
 	char 		buf[20];
 
 	Assert(size == 1);
@@ -319,34 +376,19 @@ header_callback(void *ptr_, size_t size, size_t nmemb, void *userp)
 	/*
 	 * extract the GP-PROTO value from the HTTP header.
 	 */
-	if (len > 10 && *ptr == 'X' && 0 == strncmp("X-GP-PROTO", ptr, 10))
-	{
-		ptr += 10;
-		len -= 10;
+	if (get_header_value(ptr, len, "X-GP-PROTO", buf, sizeof(buf)))
+		url->gp_proto = strtol(buf, 0, 0);
 
-		while (len > 0 && (*ptr == ' ' || *ptr == '\t'))
-		{
-			ptr++;
-			len--;
-		}
-
-		if (len > 0 && *ptr == ':')
-		{
-			ptr++;
-			len--;
-
-			while (len > 0 && (*ptr == ' ' || *ptr == '\t'))
-			{
-				ptr++;
-				len--;
-			}
-
-			for (i = 0; i < sizeof(buf) - 1 && i < len; i++)
-				buf[i] = ptr[i];
+	/*
+	 * gpfdist repeats the X-GP-COMPRESSION header of the request if it
+	 * compresses the data.
+	 */
+	if (get_header_value(ptr, len, "X-GP-COMPRESSION", buf, sizeof(buf)))
+	{
+		gcompress_method method = gcompress_lookup(buf);
 
-			buf[i] = 0;
-			url->gp_proto = strtol(buf, 0, 0);
-		}
+		if (method == gpfdist_compression)
+			url->compression = method;
 	}
 
 	return size * nmemb;
@@ -1199,6 +1241,10 @@ url_curl_fopen(char *url, bool forwrite, extvar_t *ev, CopyFormatOptions *opts)
 	set_httpheader(file, "X-GP-LINE-DELIM-STR", ev->GP_LINE_DELIM_STR);
 	set_httpheader(file, "X-GP-LINE-DELIM-LENGTH", ev->GP_LINE_DELIM_LENGTH);
 
+	/* ask gpfdist to compress the data, it acknowledges in its response */
+	if (gpfdist_compression != GCOMPRESS_NONE && !IS_HTTP_URI(url))
+		set_httpheader(file, "X-GP-COMPRESSION", gcompress_name(gpfdist_compression));
+
 	if (forwrite)
 	{
 		// TIMEOUT for POST only, GET is single HTTP request,
@@ -1369,6 +1415,14 @@ url_curl_fopen(char *url, bool forwrite, extvar_t *ev, CopyFormatOptions *opts)
 		/* post away and check response, retry if failed (timeout or * connect error) */
 		gp_perform_backoff_and_check_response(file, easy_perform_work);
 		file->seq_number++;
+
+		/*
+		 * If gpfdist did not acknowledge the compression, tell it that the
+		 * data we post is not compressed.
+		 */
+		if (gpfdist_compression != GCOMPRESS_NONE &&
+			file->compression == GCOMPRESS_NONE && !IS_HTTP_URI(url))
+			replace_httpheader(file, "X-GP-COMPRESSION", "none");
 	}
 
 	return (URL_FILE *) file;
@@ -1422,6 +1476,12 @@ url_curl_fclose(URL_FILE *fileg, bool failOnError, const char *relname)
 		file->out.ptr = NULL;
 	}
 
+	if (file->zbuf.ptr)
+	{
+		pfree(file->zbuf.ptr);
+		file->zbuf.ptr = NULL;
+	}
+
 	file->gp_proto = 0;
 	file->error = file->eof = 0;
 	memset(&file->in, 0, sizeof(file->in));
@@ -1479,12 +1539,31 @@ gp_proto0_read(char *buf, int bufsz, URL_CURL_FILE *file)
 	return n;
 }
 
+/*
+ * Make room for 'size' bytes in the buffer of compressed blocks.
+ *
+ * The buffer outlives the per-row memory context the caller may be in, so
+ * allocate it in the context of the file itself, like the in and out buffers.
+ */
+static void
+zbuf_reserve(URL_CURL_FILE *file, int size)
+{
+	if (file->zbuf.max >= size)
+		return;
+
+	if (file->zbuf.ptr)
+		pfree(file->zbuf.ptr);
+	file->zbuf.ptr = MemoryContextAlloc(GetMemoryChunkContext(file), size);
+	file->zbuf.max = size;
+}
+
 /*
  * gp_proto1_read
  *
  * get data from the server and handle it according to PROTO 1. In this protocol
  * each data block is tagged by meta info like this:
- * byte 0: type (can be 'F'ilename, 'O'ffset, 'D'ata, 'E'rror, 'L'inenumber)
+ * byte 0: type (can be 'F'ilename, 'O'ffset, 'D'ata, 'E'rror, 'L'inenumber,
+ *         or 'Z' for compressed data)
  * byte 1-4: length. # bytes of following data block. in network-order.
  * byte 5-X: the block itself.
  */
@@ -1636,6 +1715,35 @@ gp_proto1_read(char *buf, int bufsz, URL_CURL_FILE *file, CopyFromState pstate,
 			break;
 		}
 
+		/* Compressed data, uncompress the whole block */
+		if (type == 'Z')
+		{
+			int rawlen;
+
+			if (file->compression == GCOMPRESS_NONE)
+				elog(ERROR, "gpfdist error: unexpected compressed data block");
+
+			fill_buffer(file, len);
+			if (file->in.top - file->in.bot < len)
+				elog(ERROR, "gpfdist error: stream ends suddenly");
+
+			rawlen = gcompress_raw_length(file->in.ptr + file->in.bot, len);
+			if (rawlen <= 0 || !AllocSizeIsValid(rawlen))
+				elog(ERROR, "gpfdist error: bad compressed data block (%d)", rawlen);
+
+			zbuf_reserve(file, rawlen);
+
+			if (gdecompress_block(file->compression, file->in.ptr + file->in.bot, len,
+								  file->zbuf.ptr, rawlen) != rawlen)
+				elog(ERROR, "gpfdist error: could not uncompress data block");
+
+			file->in.bot += len;
+			file->zbuf.bot = 0;
+			file->zbuf.top = rawlen;
+			file->block.datalen = rawlen;
+			break;
+		}
+
 		elog(ERROR, "gpfdist error: unknown meta type %d", type);
 	}
 
@@ -1643,6 +1751,15 @@ gp_proto1_read(char *buf, int bufsz, URL_CURL_FILE *file, CopyFromState pstate,
 	if (bufsz > file->block.datalen)
 		bufsz = file->block.datalen;
 
+	/* the data of a compressed block is already here */
+	if (file->zbuf.bot < file->zbuf.top)
+	{
+		memcpy(buf, file->zbuf.ptr + file->zbuf.bot, bufsz);
+		file->zbuf.bot += bufsz;
+		file->block.datalen -= bufsz;
+		return bufsz;
+	}
+
 	fill_buffer(file, bufsz);
 	n = file->in.top - file->in.bot;
 
@@ -1685,6 +1802,20 @@ gp_proto0_write(URL_CURL_FILE *file, CopyToState pstate)
 	if (nbytes == 0)
 		return;
 
+	/* post the data as one compressed block, if gpfdist agreed to it */
+	if (file->compression != GCOMPRESS_NONE)
+	{
+		int		bound = gcompress_bound(file->compression, nbytes);
+
+		zbuf_reserve(file, bound);
+
+		nbytes = gcompress_block(file->compression, buf, nbytes,
+								 file->zbuf.ptr, file->zbuf.max);
+		if (nbytes < 0)
+			elog(ERROR, "could not compress data for gpfdist");
+		buf = file->zbuf.ptr;
+	}
+
 	/* post binary data */
 	CURL_EASY_SETOPT(file->curl->handle, CURLOPT_POSTFIELDS, buf);
 
@@ -106,6 +106,7 @@
 #include "storage/smgr.h"
 #include "utils/builtins.h"
 #include "utils/memutils.h"
+#include "utils/sharedmdcache.h"
 #include "utils/timestamp.h"
 
 #include "access/twophase_storage_tablespace.h"
@@ -1720,6 +1721,7 @@ FinishPreparedTransaction(const char *gid, bool isCommit, bool raiseErrorIfNotFo
 	if (hdr->initfileinval)
 		RelationCacheInitFilePreInvalidate();
 	SendSharedInvalidMessages(invalmsgs, hdr->ninvalmsgs);
+	SharedMDCacheInvalidate(invalmsgs, hdr->ninvalmsgs);
 	if (hdr->initfileinval)
 		RelationCacheInitFilePostInvalidate();
 
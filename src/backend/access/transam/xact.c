@@ -3072,6 +3072,7 @@ CommitTransaction(void)
 	if (gp_local_distributed_cache_stats)
 	{
 		LocalDistribXactCache_ShowStats("CommitTransaction");
+		DistributedSnapshotWithLocalMapping_ShowStats("CommitTransaction");
 	}
 
 	s->fullTransactionId = InvalidFullTransactionId;
@@ -3408,6 +3409,7 @@ PrepareTransaction(void)
 	if (gp_local_distributed_cache_stats)
 	{
 		LocalDistribXactCache_ShowStats("PrepareTransaction");
+		DistributedSnapshotWithLocalMapping_ShowStats("PrepareTransaction");
 	}
 
 	s->fullTransactionId = InvalidFullTransactionId;
@@ -1776,6 +1776,14 @@ CREATE VIEW gp_suboverflowed_backend(segid, pids) AS
 UNION ALL
   SELECT gp_segment_id, gp_get_suboverflowed_backends() FROM gp_dist_random('gp_id') order by 1;
 
+-- Usage of the optimizer metadata cache of the current session
+CREATE VIEW gp_opt_mdcache_stats AS
+    SELECT * FROM gp_opt_get_mdcache_stats();
+
+-- Usage of the optimizer plan cache of the current session
+CREATE VIEW gp_opt_plan_cache_stats AS
+    SELECT * FROM gp_opt_get_plan_cache_stats();
+
 CREATE VIEW database_tag_descriptions AS
     SELECT
         tddatabaseid,
@@ -16,15 +16,22 @@
  */
 #include "postgres.h"
 
+#include "access/xact.h"
 #include "access/xlog.h"
 #include "cdb/cdbbufferedread.h"
 #include "crypto/bufenc.h"
+#include "executor/instrument.h"
 #include "miscadmin.h"
 #include "pgstat.h"
+#include "storage/bufmgr.h"
+#include "utils/faultinjector.h"
 #include "utils/guc.h"
+#include "utils/spccache.h"
 
 static void BufferedReadIo(
 			   BufferedRead *bufferedRead);
+static void BufferedReadPrefetch(
+			   BufferedRead *bufferedRead);
 static uint8 *BufferedReadUseBeforeBuffer(
 							BufferedRead *bufferedRead,
 							int32 maxReadAheadLen,
@@ -147,6 +154,27 @@ BufferedReadSetFile(
 	bufferedRead->temporaryLimitFileLen = 0;
 	bufferedRead->fileOff =0;
 
+	/*
+	 * Pick the read-ahead depth for the file's tablespace.  Outside a
+	 * transaction we can't look at the tablespace options, so fall back to
+	 * the effective_io_concurrency setting.
+	 */
+#ifdef USE_PREFETCH
+	if (IsTransactionState())
+		bufferedRead->prefetchDepth =
+			get_tablespace_io_concurrency(bufferedRead->relFileNode.spcNode);
+	else
+		bufferedRead->prefetchDepth = effective_io_concurrency;
+#else
+	bufferedRead->prefetchDepth = 0;
+#endif
+	bufferedRead->prefetchPosition = 0;
+	bufferedRead->prefetchRequests = 0;
+	bufferedRead->prefetchBytes = 0;
+	bufferedRead->largeReads = 0;
+	bufferedRead->prefetchHits = 0;
+	INSTR_TIME_SET_ZERO(bufferedRead->readTime);
+
 	if (fileLen > 0)
 	{
 		/*
@@ -170,11 +198,24 @@ BufferedReadIo(
 	int32		largeReadLen;
 	uint8	   *largeReadMemory;
 	int32		offset;
+	instr_time	io_start,
+				io_time;
 
 	largeReadLen = bufferedRead->largeReadLen;
 	Assert(bufferedRead->largeReadLen > 0);
 	largeReadMemory = bufferedRead->largeReadMemory;
 
+	/* Was all of it requested ahead of time? */
+	bufferedRead->largeReads++;
+	if (bufferedRead->fileOff + largeReadLen <= bufferedRead->prefetchPosition)
+	{
+		bufferedRead->prefetchHits++;
+		SIMPLE_FAULT_INJECTOR("ao_read_prefetch_hit");
+	}
+
+	if (track_io_timing)
+		INSTR_TIME_SET_CURRENT(io_start);
+
 	offset = 0;
 	while (largeReadLen > 0)
 	{
@@ -224,8 +265,61 @@ BufferedReadIo(
 		offset += actualLen;
 	}
 
+	if (track_io_timing)
+	{
+		INSTR_TIME_SET_CURRENT(io_time);
+		INSTR_TIME_SUBTRACT(io_time, io_start);
+		INSTR_TIME_ADD(bufferedRead->readTime, io_time);
+		INSTR_TIME_ADD(pgBufferUsage.blk_read_time, io_time);
+	}
+
 	if (VacuumCostActive)
 		VacuumCostBalance += VacuumCostPageMiss;
+
+	BufferedReadPrefetch(bufferedRead);
+}
+
+/*
+ * Ask the kernel to read ahead the part of the file that the next
+ * prefetchDepth large reads will need, so that it is already in the page
+ * cache when we get there.  Anything already requested is not requested
+ * again.
+ */
+static void
+BufferedReadPrefetch(
+					 BufferedRead *bufferedRead)
+{
+#ifdef USE_PREFETCH
+	int64		inEffectFileLen;
+	int64		position;
+	int64		afterPosition;
+
+	if (bufferedRead->prefetchDepth <= 0)
+		return;
+
+	if (bufferedRead->haveTemporaryLimitInEffect)
+		inEffectFileLen = bufferedRead->temporaryLimitFileLen;
+	else
+		inEffectFileLen = bufferedRead->fileLen;
+
+	position = Max(bufferedRead->prefetchPosition, bufferedRead->fileOff);
+	afterPosition = Min(bufferedRead->fileOff +
+						(int64) bufferedRead->prefetchDepth * bufferedRead->maxLargeReadLen,
+						inEffectFileLen);
+
+	while (position < afterPosition)
+	{
+		int32		len = (int32) Min(afterPosition - position,
+									  bufferedRead->maxLargeReadLen);
+
+		(void) FilePrefetch(bufferedRead->file, position, len,
+							WAIT_EVENT_DATA_FILE_PREFETCH);
+		bufferedRead->prefetchRequests++;
+		bufferedRead->prefetchBytes += len;
+		position += len;
+	}
+	bufferedRead->prefetchPosition = Max(bufferedRead->prefetchPosition, position);
+#endif
 }
 
 static uint8 *
@@ -397,6 +491,10 @@ BufferedReadSetTemporaryRange(
 		}
 	}
 
+	/* Set before reading, so that read-ahead stays within the range */
+	bufferedRead->haveTemporaryLimitInEffect = true;
+	bufferedRead->temporaryLimitFileLen = afterFileOffset;
+
 	if (newReadNeeded)
 	{
 		int64		remainingFileLen;
@@ -410,6 +508,7 @@ BufferedReadSetTemporaryRange(
 		 */
 		bufferedRead->fileOff = beginFileOffset;
 		bufferedRead->bufferOffset = 0;
+		bufferedRead->prefetchPosition = beginFileOffset;
 
 		remainingFileLen = afterFileOffset - beginFileOffset;
 		if (remainingFileLen > bufferedRead->maxLargeReadLen)
@@ -422,10 +521,6 @@ BufferedReadSetTemporaryRange(
 		if (bufferedRead->largeReadLen > 0)
 			BufferedReadIo(bufferedRead);
 	}
-
-	bufferedRead->haveTemporaryLimitInEffect = true;
-	bufferedRead->temporaryLimitFileLen = afterFileOffset;
-
 }
 
 /*
@@ -645,6 +740,20 @@ BufferedReadCompleteFile(
 	Assert(bufferedRead != NULL);
 	Assert(bufferedRead->file >= 0);
 
+	elog(Debug_appendonly_print_read_block ? LOG : DEBUG1,
+		 "Append-Only storage read: table \"%s\", segment file \"%s\" complete, "
+		 INT64_FORMAT " large reads, " INT64_FORMAT " of them read ahead, "
+		 INT64_FORMAT " read-ahead requests for " INT64_FORMAT " bytes (depth %d), "
+		 "read time %.3f ms",
+		 bufferedRead->relationName,
+		 bufferedRead->filePathName,
+		 bufferedRead->largeReads,
+		 bufferedRead->prefetchHits,
+		 bufferedRead->prefetchRequests,
+		 bufferedRead->prefetchBytes,
+		 bufferedRead->prefetchDepth,
+		 INSTR_TIME_GET_MILLISEC(bufferedRead->readTime));
+
 	bufferedRead->file = -1;
 	bufferedRead->filePathName = NULL;
 	bufferedRead->fileLen = 0;
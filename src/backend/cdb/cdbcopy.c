@@ -82,6 +82,9 @@
 static void cdbCopyEndInternal(CdbCopy *c, char *abort_msg,
 				   int64 *total_rows_completed_p,
 				   int64 *total_rows_rejected_p);
+static void cdbCopyPutData(CdbCopy *c, int target_seg, const char *buffer,
+			   int nbytes);
+static void cdbCopyFlushData(CdbCopy *c);
 
 static Gang *
 getCdbCopyPrimaryGang(CdbCopy *c)
@@ -110,6 +113,7 @@ makeCdbCopy(GpPolicy *policy, bool on_segment, bool is_copy_in)
 	c->copy_in = is_copy_in;
 	c->seglist = NIL;
 	c->dispatcherState = NULL;
+	c->copy_in_bufs = NULL;
 	initStringInfo(&(c->copy_out_buf));
 
 	/*
@@ -129,8 +133,14 @@ makeCdbCopy(GpPolicy *policy, bool on_segment, bool is_copy_in)
 
 		for (i = 0; i < c->total_segs; i++)
 			c->seglist = lappend_int(c->seglist, i);
-	}
 
+		if (is_copy_in)
+		{
+			c->copy_in_bufs = palloc(c->total_segs * sizeof(StringInfoData));
+			for (i = 0; i < c->total_segs; i++)
+				initStringInfo(&c->copy_in_bufs[i]);
+		}
+	}
 
 	return c;
 }
@@ -238,10 +248,64 @@ cdbCopySendDataToAll(CdbCopy *c, const char *buffer, int nbytes)
 /*
  * sends data to a copy command on a specific segment (usually
  * the hash result of the data value).
+ *
+ * The data is only appended to the segment's buffer here. It is passed to
+ * libpq once COPYIN_CHUNK_SIZE bytes have been collected, or at cdbCopyEnd().
+ * A row costs a few dozen bytes on the wire, so a CopyData message and a
+ * PQputCopyData() call for each of them would make up a good share of the
+ * QD's work in a bulk load. The QE reads the COPY data as a byte stream, so
+ * it doesn't care where the message boundaries are.
  */
 void
 cdbCopySendData(CdbCopy *c, int target_seg, const char *buffer,
 				int nbytes)
+{
+	StringInfo	buf;
+
+	Assert(c->copy_in_bufs);
+	Assert(target_seg >= 0 && target_seg < c->total_segs);
+
+	buf = &c->copy_in_bufs[target_seg];
+
+	/* Don't bother copying a big chunk that fills the buffer by itself. */
+	if (buf->len == 0 && nbytes >= COPYIN_CHUNK_SIZE)
+	{
+		cdbCopyPutData(c, target_seg, buffer, nbytes);
+		return;
+	}
+
+	appendBinaryStringInfo(buf, buffer, nbytes);
+	if (buf->len >= COPYIN_CHUNK_SIZE)
+	{
+		cdbCopyPutData(c, target_seg, buf->data, buf->len);
+		resetStringInfo(buf);
+	}
+}
+
+/*
+ * Send all the buffered data to the segments.
+ */
+static void
+cdbCopyFlushData(CdbCopy *c)
+{
+	if (!c->copy_in_bufs)
+		return;
+
+	for (int seg = 0; seg < c->total_segs; seg++)
+	{
+		StringInfo	buf = &c->copy_in_bufs[seg];
+
+		if (buf->len > 0)
+		{
+			cdbCopyPutData(c, seg, buf->data, buf->len);
+			resetStringInfo(buf);
+		}
+	}
+}
+
+static void
+cdbCopyPutData(CdbCopy *c, int target_seg, const char *buffer,
+			   int nbytes)
 {
 	SegmentDatabaseDescriptor *q;
 	Gang	   *gp;
@@ -415,6 +479,13 @@ cdbCopyGetData(CdbCopy *c, bool copy_cancel, uint64 *rows_processed)
 void
 cdbCopyAbort(CdbCopy *c)
 {
+	/* The QEs are going to throw away whatever we have not sent yet. */
+	if (c->copy_in_bufs)
+	{
+		for (int seg = 0; seg < c->total_segs; seg++)
+			resetStringInfo(&c->copy_in_bufs[seg]);
+	}
+
 	cdbCopyEndInternal(c, "aborting COPY in QE due to error in QD",
 					   NULL, NULL);
 }
@@ -430,6 +501,9 @@ cdbCopyEnd(CdbCopy *c,
 {
 	CHECK_FOR_INTERRUPTS();
 
+	if (getCdbCopyPrimaryGang(c))
+		cdbCopyFlushData(c);
+
 	cdbCopyEndInternal(c, NULL,
 					   total_rows_completed_p,
 					   total_rows_rejected_p);
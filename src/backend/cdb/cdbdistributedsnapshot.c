@@ -23,6 +23,84 @@
 #include "utils/snapmgr.h"
 #include "storage/procarray.h"
 
+/*
+ * Counters of how DistributedSnapshotWithLocalMapping_CommittedTest() got
+ * its answer, logged with gp_local_distributed_cache_stats.
+ */
+static struct
+{
+	int64		mappedHitCount;		/* found in inProgressMappedLocalXids */
+	int64		cacheHitCount;		/* found in the local-distributed cache */
+	int64		distribLogHitCount; /* found in the distributed log */
+	int64		distribLogMissCount;	/* not in the distributed log */
+} CommittedTestStats;
+
+/*
+ * Binary search for localXid in the in-progress local xids we have mapped so
+ * far. They are kept in TransactionIdPrecedes() order. Returns true if found;
+ * otherwise *pos is set to where localXid would have to be inserted.
+ */
+static bool
+MappedLocalXidsSearch(DistributedSnapshotWithLocalMapping *dslm,
+					  TransactionId localXid, int32 *pos)
+{
+	int32		lo = 0;
+	int32		hi = dslm->currentLocalXidsCount;
+
+	while (lo < hi)
+	{
+		int32		mid = lo + (hi - lo) / 2;
+		TransactionId midXid = dslm->inProgressMappedLocalXids[mid];
+
+		Assert(TransactionIdIsValid(midXid));
+
+		if (TransactionIdEquals(localXid, midXid))
+		{
+			*pos = mid;
+			return true;
+		}
+
+		if (TransactionIdPrecedes(midXid, localXid))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	*pos = lo;
+	return false;
+}
+
+/*
+ * Is distribXid in the in-progress array of the distributed snapshot? The
+ * array is sorted in ascending order when the snapshot is created in
+ * CreateDistributedSnapshot(), so we can binary search it.
+ */
+static bool
+InProgressXidArrayContains(DistributedSnapshot *ds,
+						   DistributedTransactionId distribXid)
+{
+	uint32		lo = 0;
+	uint32		hi = ds->count;
+
+	while (lo < hi)
+	{
+		uint32		mid = lo + (hi - lo) / 2;
+
+		Assert(mid == 0 ||
+			   ds->inProgressXidArray[mid - 1] < ds->inProgressXidArray[mid]);
+
+		if (distribXid == ds->inProgressXidArray[mid])
+			return true;
+
+		if (ds->inProgressXidArray[mid] < distribXid)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return false;
+}
+
 /*
  * DistributedSnapshotWithLocalMapping_CommittedTest
  *		Is the given XID still-in-progress according to the
@@ -36,7 +114,7 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 												  bool isVacuumCheck)
 {
 	DistributedSnapshot *ds = &dslm->ds;
-	uint32		i;
+	int32		pos;
 	DistributedTransactionId distribXid = InvalidDistributedTransactionId;
 
 	Assert(!IS_QUERY_DISPATCHER());
@@ -58,22 +136,15 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 		Assert(TransactionIdIsNormal(dslm->minCachedLocalXid));
 		Assert(TransactionIdIsNormal(dslm->maxCachedLocalXid));
 
-		if (TransactionIdEquals(localXid, dslm->minCachedLocalXid) ||
-			TransactionIdEquals(localXid, dslm->maxCachedLocalXid))
+		if (!TransactionIdPrecedes(localXid, dslm->minCachedLocalXid) &&
+			!TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
 		{
-			return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
-		}
+			Assert(dslm->inProgressMappedLocalXids != NULL);
 
-		if (TransactionIdFollows(localXid, dslm->minCachedLocalXid) &&
-			TransactionIdPrecedes(localXid, dslm->maxCachedLocalXid))
-		{
-			for (i = 0; i < dslm->currentLocalXidsCount; i++)
+			if (MappedLocalXidsSearch(dslm, localXid, &pos))
 			{
-				Assert(dslm->inProgressMappedLocalXids != NULL);
-				Assert(TransactionIdIsValid(dslm->inProgressMappedLocalXids[i]));
-
-				if (TransactionIdEquals(localXid, dslm->inProgressMappedLocalXids[i]))
-					return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
+				CommittedTestStats.mappedHitCount++;
+				return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 			}
 		}
 	}
@@ -82,8 +153,10 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 	 * Is this local xid in a process-local cache we maintain?
 	 * If we found it in cache, the distribXid must be a valid gxid.
 	 */
-	if (!LocalDistribXactCache_CommittedFind(localXid,
+	if (LocalDistribXactCache_CommittedFind(localXid,
 											&distribXid))
+		CommittedTestStats.cacheHitCount++;
+	else
 	{
 		/*
 		 * Ok, now we must consult the distributed log.
@@ -94,6 +167,7 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 			 * We found it in the distributed log.
 			 */
 			Assert(distribXid != InvalidDistributedTransactionId);
+			CommittedTestStats.distribLogHitCount++;
 
 			/*
 			 * Since we did not find it in our process local cache, add it.
@@ -108,6 +182,7 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 			 * local-only, or still in-progress. The caller will proceed to do
 			 * a local visibility check, which will determine which it is.
 			 */
+			CommittedTestStats.distribLogMissCount++;
 			return DISTRIBUTEDSNAPSHOT_COMMITTED_UNKNOWN;
 		}
 	}
@@ -148,45 +223,30 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
-	for (i = 0; i < ds->count; i++)
+	if (InProgressXidArrayContains(ds, distribXid))
 	{
-		if (distribXid == ds->inProgressXidArray[i])
+		/*
+		 * Save the relationship to the local xid so we may avoid checking
+		 * the distributed committed log in a subsequent check. We can
+		 * only record local xids till cache size permits. The mapped xids
+		 * are kept sorted, so that the lookup above can binary search them.
+		 */
+		if (dslm->currentLocalXidsCount < ds->count &&
+			!MappedLocalXidsSearch(dslm, localXid, &pos))
 		{
-			/*
-			 * Save the relationship to the local xid so we may avoid checking
-			 * the distributed committed log in a subsequent check. We can
-			 * only record local xids till cache size permits.
-			 */
-			if (dslm->currentLocalXidsCount < ds->count)
-			{
-				Assert(dslm->inProgressMappedLocalXids != NULL);
-				dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount++] =
-					localXid;
-
-				if (!TransactionIdIsValid(dslm->minCachedLocalXid) ||
-					TransactionIdPrecedes(localXid, dslm->minCachedLocalXid))
-				{
-					dslm->minCachedLocalXid = localXid;
-				}
-
-				if (!TransactionIdIsValid(dslm->maxCachedLocalXid) ||
-					TransactionIdFollows(localXid, dslm->maxCachedLocalXid))
-				{
-					dslm->maxCachedLocalXid = localXid;
-				}
-			}
-
-			return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
+			Assert(dslm->inProgressMappedLocalXids != NULL);
+			memmove(&dslm->inProgressMappedLocalXids[pos + 1],
+					&dslm->inProgressMappedLocalXids[pos],
+					(dslm->currentLocalXidsCount - pos) * sizeof(TransactionId));
+			dslm->inProgressMappedLocalXids[pos] = localXid;
+			dslm->currentLocalXidsCount++;
+
+			dslm->minCachedLocalXid = dslm->inProgressMappedLocalXids[0];
+			dslm->maxCachedLocalXid =
+				dslm->inProgressMappedLocalXids[dslm->currentLocalXidsCount - 1];
 		}
 
-		/*
-		 * Leverage the fact that ds->inProgressXidArray is sorted in
-		 * ascending order based on distribXid while creating the snapshot in
-		 * CreateDistributedSnapshot(). So, can fail fast once known are
-		 * lower than rest of them.
-		 */
-		if (distribXid < ds->inProgressXidArray[i])
-			break;
+		return DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS;
 	}
 
 	/*
@@ -195,6 +255,19 @@ DistributedSnapshotWithLocalMapping_CommittedTest(
 	return DISTRIBUTEDSNAPSHOT_COMMITTED_VISIBLE;
 }
 
+void
+DistributedSnapshotWithLocalMapping_ShowStats(char *nameStr)
+{
+	elog(LOG, "%s: Distributed snapshot committed test counts "
+		 "(mapped in-progress hits " INT64_FORMAT ", local-distributed cache hits " INT64_FORMAT
+		 ", distributed log hits " INT64_FORMAT ", distributed log misses " INT64_FORMAT ")",
+		 nameStr,
+		 CommittedTestStats.mappedHitCount,
+		 CommittedTestStats.cacheHitCount,
+		 CommittedTestStats.distribLogHitCount,
+		 CommittedTestStats.distribLogMissCount);
+}
+
 /*
  * Reset all fields except maxCount and the malloc'd pointer for
  * inProgressXidArray.
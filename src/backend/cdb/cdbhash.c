@@ -197,21 +197,45 @@ cdbhash(CdbHash *h, int attno, Datum datum, bool isnull)
 
 		if (!isnull)
 		{
-			LOCAL_FCINFO(fcinfo, 1);
+			Oid			hashfn = h->hashfuncs[attno - 1].fn_oid;
 			uint32		hkey;
 
-			InitFunctionCallInfoData(*fcinfo, &h->hashfuncs[attno - 1], 1,
-									 DEFAULT_COLLATION_OID, /* have to specify collation for attribute of text or bpchar */
-									 NULL, NULL);
-
-			fcinfo->args[0].value = datum;
-			fcinfo->args[0].isnull = false;
-
-			hkey = DatumGetUInt32(FunctionCallInvoke(fcinfo));
-
-			/* Check for null result, since caller is clearly not expecting one */
-			if (fcinfo->isnull)
-				elog(ERROR, "function %u returned NULL", fcinfo->flinfo->fn_oid);
+			/*
+			 * The integer hash functions are cheap compared to the function
+			 * call overhead, and by far the most common distribution key
+			 * types, so compute them inline.  These must match hashint2(),
+			 * hashint4() and hashint8() exactly.
+			 */
+			if (hashfn == F_HASHINT4)
+				hkey = DatumGetUInt32(hash_uint32(DatumGetInt32(datum)));
+			else if (hashfn == F_HASHINT8)
+			{
+				int64		val = DatumGetInt64(datum);
+				uint32		lohalf = (uint32) val;
+				uint32		hihalf = (uint32) (val >> 32);
+
+				lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+				hkey = DatumGetUInt32(hash_uint32(lohalf));
+			}
+			else if (hashfn == F_HASHINT2)
+				hkey = DatumGetUInt32(hash_uint32((int32) DatumGetInt16(datum)));
+			else
+			{
+				LOCAL_FCINFO(fcinfo, 1);
+
+				InitFunctionCallInfoData(*fcinfo, &h->hashfuncs[attno - 1], 1,
+										 DEFAULT_COLLATION_OID, /* have to specify collation for attribute of text or bpchar */
+										 NULL, NULL);
+
+				fcinfo->args[0].value = datum;
+				fcinfo->args[0].isnull = false;
+
+				hkey = DatumGetUInt32(FunctionCallInvoke(fcinfo));
+
+				/* Check for null result, since caller is clearly not expecting one */
+				if (fcinfo->isnull)
+					elog(ERROR, "function %u returned NULL", fcinfo->flinfo->fn_oid);
+			}
 
 			hashkey ^= hkey;
 		}
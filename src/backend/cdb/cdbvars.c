@@ -200,6 +200,7 @@ int			Gp_interconnect_queue_depth = 4;	/* max number of messages
 												 * waiting in rx-queue before
 												 * we drop. */
 int			Gp_interconnect_snd_queue_depth = 2;
+int			Gp_interconnect_recv_batch_size = 16;
 int			Gp_interconnect_timer_period = 5;
 int			Gp_interconnect_timer_checking_period = 20;
 int			Gp_interconnect_default_rtt = 20;
@@ -224,6 +225,7 @@ bool		gp_interconnect_aggressive_retry = true;	/* fast-track app-level
 														 * retry */
 
 bool		gp_interconnect_full_crc = false;	/* sanity check UDP data. */
+bool		gp_interconnect_compress_tuples = false;	/* compress large tuples */
 
 bool		gp_interconnect_log_stats = false;	/* emit stats at log-level */
 
@@ -268,6 +270,7 @@ double		gp_motion_cost_per_row = 0;
 int			gp_segments_for_planner = 0;
 
 int			gp_hashagg_default_nbatches = 32;
+bool		gp_hashagg_streambottom = true;
 
 bool		gp_adjust_selectivity_for_outerjoins = true;
 bool		gp_selectivity_damping_for_scans = false;
@@ -282,6 +285,8 @@ int			gp_hashagg_groups_per_bucket = 5;
 /* Analyzing aid */
 int			gp_motion_slice_noop = 0;
 
+int			gp_motion_send_batch_size = 64;
+
 /* Cloudberry Database Experimental Feature GUCs */
 bool		gp_enable_explain_allstat = false;
 bool		gp_enable_motion_deadlock_sanity = false;	/* planning time sanity
@@ -333,6 +338,7 @@ int			gp_autostats_mode_in_functions;
 char	   *gp_autostats_mode_in_functions_string;
 int			gp_autostats_on_change_threshold = 100000;
 bool		gp_autostats_allow_nonowner = false;
+bool		gp_autostats_incremental = false;
 bool		log_autostats = true;
 
 /* --------------------------------------------------------------------------------------------------
@@ -354,6 +354,16 @@ cdbdisp_makeDispatchParams(CdbDispatcherState *ds,
 	MemoryContextSwitchTo(oldContext);
 }
 
+void
+cdbdisp_setDispatchQueryText(CdbDispatcherState *ds,
+							 char *queryText,
+							 int queryTextLen)
+{
+	Assert(ds->dispatchParams != NULL);
+
+	(pDispatchFuncs->setQueryText) (ds, queryText, queryTextLen);
+}
+
 /*
  * Free memory in CdbDispatcherState
  *
@@ -102,6 +102,8 @@ typedef struct CdbDispatchCmdAsync
 
 static void *cdbdisp_makeDispatchParams_async(int maxSlices, int largestGangSize, char *queryText, int len);
 
+static void cdbdisp_setQueryText_async(struct CdbDispatcherState *ds, char *queryText, int len);
+
 static bool cdbdisp_checkAckMessage_async(struct CdbDispatcherState *ds, const char *message,
 									int timeout_sec);
 
@@ -121,6 +123,7 @@ DispatcherInternalFuncs DispatcherAsyncFuncs =
 	cdbdisp_checkForCancel_async,
 	cdbdisp_getWaitSocketFds_async,
 	cdbdisp_makeDispatchParams_async,
+	cdbdisp_setQueryText_async,
 	cdbdisp_checkAckMessage_async,
 	cdbdisp_checkDispatchResult_async,
 	cdbdisp_dispatchToGang_async,
@@ -437,6 +440,20 @@ cdbdisp_makeDispatchParams_async(int maxSlices, int largestGangSize, char *query
 	return (void *) pParms;
 }
 
+/*
+ * Change the text sent to the gangs dispatched from now on. The gangs
+ * already dispatched may still be sending the old one, so the caller must
+ * not free it.
+ */
+static void
+cdbdisp_setQueryText_async(struct CdbDispatcherState *ds, char *queryText, int len)
+{
+	CdbDispatchCmdAsync *pParms = (CdbDispatchCmdAsync *) ds->dispatchParams;
+
+	pParms->query_text = queryText;
+	pParms->query_text_len = len;
+}
+
 /*
  * Receive and process results from all running QEs.
  * timeout_sec: the second that the dispatcher waits for the ack messages at most.
@@ -60,6 +60,19 @@ typedef struct ParamWalkerContext
 	List	   *params;
 } ParamWalkerContext;
 
+/*
+ * Context for slice_prune_walker(). The Motions whose subtree was detached
+ * are remembered with their children, to put them back after serialization.
+ */
+typedef struct SlicePruneContext
+{
+	plan_tree_base_prefix base; /* Required prefix for
+								 * plan_tree_walker/mutator */
+	Bitmapset  *keepSlices;		/* the slice and all its ancestors */
+	List	   *prunedMotions;
+	List	   *prunedChildren;
+} SlicePruneContext;
+
 /*
  * We need an array describing the relationship between a slice and
  * the number of "child" slices which depend on it.
@@ -107,7 +120,12 @@ static int fillSliceVector(SliceTable *sliceTable,
 static char *buildGpQueryString(DispatchCommandQueryParms *pQueryParms,
 				   int *finalLen);
 
-static DispatchCommandQueryParms *cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc, bool planRequiresTxn);
+static DispatchCommandQueryParms *cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc, bool planRequiresTxn,
+															  bool prunePlan);
+static char *serializePlanForDispatch(PlannedStmt *stmt, int *len);
+static char *serializeSlicePlan(PlannedStmt *stmt, SliceTable *sliceTbl,
+								int sliceIndex, int *len);
+static bool slice_prune_walker(Node *node, SlicePruneContext *context);
 static DispatchCommandQueryParms *cdbdisp_buildUtilityQueryParms(struct Node *stmt, int flags, List *oid_assignments);
 static DispatchCommandQueryParms *cdbdisp_buildCommandQueryParms(const char *strCommand, int flags);
 
@@ -621,26 +639,17 @@ cdbdisp_buildUtilityQueryParms(struct Node *stmt,
 	return pQueryParms;
 }
 
-static DispatchCommandQueryParms *
-cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
-							bool planRequiresTxn)
+/*
+ * Serialize a plan to be dispatched, and check it against gp_max_plan_size.
+ */
+static char *
+serializePlanForDispatch(PlannedStmt *stmt, int *len)
 {
-	char	   *splan,
-			   *sddesc;
-
+	char	   *splan;
 	int			splan_len,
-				splan_len_uncompressed,
-				sddesc_len;
-	Oid			save_userid;
+				splan_len_uncompressed;
 
-	DispatchCommandQueryParms *pQueryParms = (DispatchCommandQueryParms *) palloc0(sizeof(*pQueryParms));
-
-	/*
-	 * serialized plan tree. Note that we're called for a single slice tree
-	 * (corresponding to an initPlan or the main plan), so the parameters are
-	 * fixed and we can include them in the prefix.
-	 */
-	splan = serializeNode((Node *) queryDesc->plannedstmt, &splan_len, &splan_len_uncompressed);
+	splan = serializeNode((Node *) stmt, &splan_len, &splan_len_uncompressed);
 
 	uint64		plan_size_in_kb = ((uint64) splan_len_uncompressed) / (uint64) 1024;
 
@@ -659,6 +668,119 @@ cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
 
 	Assert(splan != NULL && splan_len > 0 && splan_len_uncompressed > 0);
 
+	*len = splan_len;
+	return splan;
+}
+
+/*
+ * Walker for serializeSlicePlan(): detach the children of every Motion that
+ * is neither the sending Motion of the slice nor one of its ancestors. Such
+ * a Motion either receives into the slice, or sits in a part of the plan
+ * the slice never reaches; either way the QE will not initialize anything
+ * below it.
+ */
+static bool
+slice_prune_walker(Node *node, SlicePruneContext *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, Motion))
+	{
+		Motion	   *motion = (Motion *) node;
+
+		if (!bms_is_member(motion->motionID, context->keepSlices))
+		{
+			context->prunedMotions = lappend(context->prunedMotions, motion);
+			context->prunedChildren = lappend(context->prunedChildren,
+											  motion->plan.lefttree);
+			motion->plan.lefttree = NULL;
+			return false;
+		}
+	}
+
+	return plan_tree_walker(node, slice_prune_walker, context, false);
+}
+
+/*
+ * Serialize the part of a plan needed by the QEs of one slice.
+ *
+ * With execute_pruned_plan, a QE only initializes the plan below the
+ * sending Motion of its slice, down to the Motions it receives from, plus
+ * the SubPlans reachable from there (see findSenderMotion() and
+ * getLocallyExecutableSubplans()). Everything below the other slices'
+ * Motions is left out, except the path from the top of the plan to our own
+ * Motion, which the QE follows to find it. The plan is pruned in place and
+ * restored before returning, since it may belong to a cached plan.
+ */
+static char *
+serializeSlicePlan(PlannedStmt *stmt, SliceTable *sliceTbl, int sliceIndex,
+				   int *len)
+{
+	SlicePruneContext context;
+	char	   *splan;
+	ListCell   *lc;
+	int			i;
+
+	exec_init_plan_tree_base(&context.base, stmt);
+	context.keepSlices = NULL;
+	context.prunedMotions = NIL;
+	context.prunedChildren = NIL;
+
+	for (i = sliceIndex; i >= 0; i = sliceTbl->slices[i].parentIndex)
+		context.keepSlices = bms_add_member(context.keepSlices, i);
+
+	PG_TRY();
+	{
+		slice_prune_walker((Node *) stmt->planTree, &context);
+		foreach(lc, stmt->subplans)
+			slice_prune_walker((Node *) lfirst(lc), &context);
+
+		splan = serializePlanForDispatch(stmt, len);
+	}
+	PG_FINALLY();
+	{
+		ListCell   *lcc;
+
+		forboth(lc, context.prunedMotions, lcc, context.prunedChildren)
+			((Motion *) lfirst(lc))->plan.lefttree = (Plan *) lfirst(lcc);
+	}
+	PG_END_TRY();
+
+	list_free(context.prunedMotions);
+	list_free(context.prunedChildren);
+	bms_free(context.keepSlices);
+
+	return splan;
+}
+
+/*
+ * Build the parameters to dispatch a plan. If prunePlan is true, the plan
+ * itself is left out, and the caller serializes a pruned copy for each
+ * slice with serializeSlicePlan().
+ */
+static DispatchCommandQueryParms *
+cdbdisp_buildPlanQueryParms(struct QueryDesc *queryDesc,
+							bool planRequiresTxn,
+							bool prunePlan)
+{
+	char	   *splan = NULL,
+			   *sddesc;
+
+	int			splan_len = 0,
+				sddesc_len;
+	Oid			save_userid;
+
+	DispatchCommandQueryParms *pQueryParms = (DispatchCommandQueryParms *) palloc0(sizeof(*pQueryParms));
+
+	/*
+	 * serialized plan tree. Note that we're called for a single slice tree
+	 * (corresponding to an initPlan or the main plan), so the parameters are
+	 * fixed and we can include them in the prefix.
+	 */
+	if (!prunePlan)
+		splan = serializePlanForDispatch(queryDesc->plannedstmt, &splan_len);
+
 	GetUserIdAndSecContext(&save_userid, &queryDesc->ddesc->secContext);
 	sddesc = serializeNode((Node *) queryDesc->ddesc, &sddesc_len, NULL /* uncompressed_size */ );
 
@@ -1054,6 +1176,9 @@ cdbdisp_dispatchX(QueryDesc* queryDesc,
 	CdbDispatcherState *ds;
 	ErrorData *qeError = NULL;
 	DispatchCommandQueryParms *pQueryParms;
+	bool		prunePlan;
+	char	   *fullQueryText = NULL;
+	int			fullQueryTextLength = 0;
 
 	if (log_dispatch_stats)
 		ResetUsage();
@@ -1087,8 +1212,19 @@ cdbdisp_dispatchX(QueryDesc* queryDesc,
 	/* Each slice table has a unique-id. */
 	sliceTbl->ic_instance_id = ++gp_interconnect_id;
 
-	pQueryParms = cdbdisp_buildPlanQueryParms(queryDesc, planRequiresTxn);
-	queryText = buildGpQueryString(pQueryParms, &queryTextLength);
+	/*
+	 * Unless the QEs would initialize the whole plan anyway, send each gang
+	 * only the part of the plan its slice executes. The plan of a slice is
+	 * serialized just before it is dispatched, so that the earlier gangs
+	 * already receive and start on theirs meanwhile.
+	 */
+	prunePlan = gp_dispatch_pruned_plan && execute_pruned_plan &&
+		sliceTbl->hasMotions;
+
+	pQueryParms = cdbdisp_buildPlanQueryParms(queryDesc, planRequiresTxn,
+											  prunePlan);
+	if (!prunePlan)
+		queryText = buildGpQueryString(pQueryParms, &queryTextLength);
 
 	/*
 	 * Allocate result array with enough slots for QEs of primary gangs.
@@ -1169,6 +1305,40 @@ cdbdisp_dispatchX(QueryDesc* queryDesc,
 		}
 		SIMPLE_FAULT_INJECTOR("before_one_slice_dispatched");
 
+		if (prunePlan)
+		{
+			/*
+			 * An entry DB reader runs on the coordinator, where the executor
+			 * does not eliminate the other slices, so it needs the whole
+			 * plan.
+			 */
+			if (primaryGang->type == GANGTYPE_ENTRYDB_READER)
+			{
+				if (fullQueryText == NULL)
+				{
+					pQueryParms->serializedPlantree =
+						serializePlanForDispatch(queryDesc->plannedstmt,
+												 &pQueryParms->serializedPlantreelen);
+					fullQueryText = buildGpQueryString(pQueryParms,
+													   &fullQueryTextLength);
+					pfree(pQueryParms->serializedPlantree);
+				}
+				queryText = fullQueryText;
+				queryTextLength = fullQueryTextLength;
+			}
+			else
+			{
+				pQueryParms->serializedPlantree =
+					serializeSlicePlan(queryDesc->plannedstmt, sliceTbl, si,
+									   &pQueryParms->serializedPlantreelen);
+				queryText = buildGpQueryString(pQueryParms, &queryTextLength);
+				pfree(pQueryParms->serializedPlantree);
+			}
+			pQueryParms->serializedPlantree = NULL;
+
+			cdbdisp_setDispatchQueryText(ds, queryText, queryTextLength);
+		}
+
 		cdbdisp_dispatchToGang(ds, primaryGang, si);
 		if (planRequiresTxn || isDtxExplicitBegin())
 			addToGxactDtxSegments(primaryGang);
@@ -830,6 +830,13 @@ EndMotionLayerNode(MotionLayerState *mlStates, int16 motNodeID, bool flushCommLa
 				 pMNEntry->stat_tuple_bytes_sent,
 				 pMNEntry->stat_total_chunks_sent
 				);
+			if (pMNEntry->ser_tup_info.compress_raw_bytes > 0)
+				elog(LOG, "Interconnect seg%d slice%d compressed " UINT64_FORMAT
+					 " tuple bytes into " UINT64_FORMAT " bytes.",
+					 GpIdentity.segindex,
+					 currentSliceId,
+					 pMNEntry->ser_tup_info.compress_raw_bytes,
+					 pMNEntry->ser_tup_info.compress_sent_bytes);
 		}
 		if (pMNEntry->stat_total_bytes_recvd > 0)
 		{
@@ -855,6 +862,30 @@ EndMotionLayerNode(MotionLayerState *mlStates, int16 motNodeID, bool flushCommLa
 	pMNEntry->valid = false;
 }
 
+/*
+ * Report how many tuple bytes a sending motion node compressed, and what
+ * they compressed into.  Returns false if the node never compressed
+ * anything, see gp_interconnect_compress_tuples.
+ */
+bool
+GetMotionCompressionStats(MotionLayerState *mlStates, int16 motNodeID,
+						  uint64 *raw_bytes, uint64 *sent_bytes)
+{
+	MotionNodeEntry *pMNEntry;
+
+	if (mlStates == NULL || motNodeID > mlStates->mneCount ||
+		!mlStates->mnEntries[motNodeID - 1].valid)
+		return false;
+
+	pMNEntry = &mlStates->mnEntries[motNodeID - 1];
+	if (pMNEntry->ser_tup_info.compress_raw_bytes == 0)
+		return false;
+
+	*raw_bytes = pMNEntry->ser_tup_info.compress_raw_bytes;
+	*sent_bytes = pMNEntry->ser_tup_info.compress_sent_bytes;
+	return true;
+}
+
 /*
  * Helper function to get the motion node entry for a given ID.  NULL
  * is returned if the ID is unrecognized.
@@ -15,6 +15,10 @@
  */
 #include "postgres.h"
 
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+
 #include "access/detoast.h"
 #include "access/htup.h"
 #include "access/memtup.h"
@@ -24,6 +28,7 @@
 #include "cdb/cdbsrlz.h"
 #include "cdb/tupser.h"
 #include "cdb/cdbvars.h"
+#include "common/pg_lzcompress.h"
 #include "libpq/pqformat.h"
 #include "storage/smgr.h"
 #include "utils/acl.h"
@@ -40,6 +45,22 @@
  */
 #define RECORD_CACHE_MAGIC_TUPLEN	-1
 
+/*
+ * A compressed tuple is sent with this "tuple length", followed by the
+ * length of the uncompressed tuple body and the compressed bytes.
+ */
+#define COMPRESSED_MAGIC_TUPLEN		-2
+
+/*
+ * Tuple bodies shorter than this are never compressed, the saving would not
+ * pay for the CPU spent.  When a tuple fails to shrink below
+ * COMPRESS_MAX_RATIO of its size, the next COMPRESS_BACKOFF_TUPLES tuples are
+ * sent uncompressed before we try again.
+ */
+#define COMPRESS_MIN_TUPBODYLEN		256
+#define COMPRESS_MAX_RATIO			0.9
+#define COMPRESS_BACKOFF_TUPLES		1024
+
 /* A MemoryContext used within the tuple serialize code, so that freeing of
  * space is SUPAFAST.  It is initialized in the first call to InitSerTupInfo()
  * since that must be called before any tuple serialization or deserialization
@@ -48,6 +69,8 @@
 static MemoryContext s_tupSerMemCtxt = NULL;
 
 static void addByteStringToChunkList(TupleChunkList tcList, char *data, int datalen, TupleChunkListCache *cache);
+static int	compressTupleBody(SerTupInfo *pSerInfo, const char *tupbody, int tupbodylen);
+static void decompressTupleBody(const char *source, int slen, char *dest, int rawlen);
 
 #define addCharToChunkList(tcList, x, c)							\
 	do															\
@@ -100,6 +123,8 @@ InitSerTupInfo(TupleDesc tupdesc, SerTupInfo *pSerInfo)
 	/* Store the tuple-descriptor so we can use it later. */
 	pSerInfo->tupdesc = tupdesc;
 
+	pSerInfo->compress_cxt = CurrentMemoryContext;
+
 	pSerInfo->chunkCache.len = 0;
 	pSerInfo->chunkCache.items = NULL;
 
@@ -188,6 +213,11 @@ CleanupSerTupInfo(SerTupInfo *pSerInfo)
 		pfree(pSerInfo->nulls);
 	pSerInfo->nulls = NULL;
 
+	if (pSerInfo->compress_buf != NULL)
+		pfree(pSerInfo->compress_buf);
+	pSerInfo->compress_buf = NULL;
+	pSerInfo->compress_buflen = 0;
+
 	pSerInfo->tupdesc = NULL;
 
 	while (pSerInfo->chunkCache.items != NULL)
@@ -350,6 +380,83 @@ SerializeRecordCacheIntoChunks(SerTupInfo *pSerInfo,
 	return;
 }
 
+/*
+ * Compress a tuple body into pSerInfo->compress_buf.
+ *
+ * Returns the compressed length, or -1 if the tuple should be sent as is,
+ * either because it is too small, compression is backing off, or it didn't
+ * compress well enough.
+ */
+static int
+compressTupleBody(SerTupInfo *pSerInfo, const char *tupbody, int tupbodylen)
+{
+	int			maxlen;
+	int			complen;
+
+	if (tupbodylen < COMPRESS_MIN_TUPBODYLEN)
+		return -1;
+
+	if (pSerInfo->compress_skip > 0)
+	{
+		pSerInfo->compress_skip--;
+		return -1;
+	}
+
+#ifdef USE_LZ4
+	maxlen = LZ4_compressBound(tupbodylen);
+#else
+	maxlen = PGLZ_MAX_OUTPUT(tupbodylen);
+#endif
+
+	if (pSerInfo->compress_buflen < maxlen)
+	{
+		if (pSerInfo->compress_buf != NULL)
+			pfree(pSerInfo->compress_buf);
+		pSerInfo->compress_buf = MemoryContextAlloc(pSerInfo->compress_cxt, maxlen);
+		pSerInfo->compress_buflen = maxlen;
+	}
+
+#ifdef USE_LZ4
+	complen = LZ4_compress_default(tupbody, pSerInfo->compress_buf,
+								   tupbodylen, maxlen);
+	if (complen <= 0)
+		complen = -1;
+#else
+	complen = pglz_compress(tupbody, tupbodylen, pSerInfo->compress_buf,
+							PGLZ_strategy_default);
+#endif
+
+	/* The extra length word must be paid for, too. */
+	if (complen < 0 ||
+		complen + sizeof(int32) > tupbodylen * COMPRESS_MAX_RATIO)
+	{
+		pSerInfo->compress_skip = COMPRESS_BACKOFF_TUPLES;
+		return -1;
+	}
+
+	return complen;
+}
+
+/*
+ * Decompress a tuple body compressed by compressTupleBody().
+ */
+static void
+decompressTupleBody(const char *source, int slen, char *dest, int rawlen)
+{
+	int			len;
+
+#ifdef USE_LZ4
+	len = LZ4_decompress_safe(source, dest, slen, rawlen);
+#else
+	len = pglz_decompress(source, slen, dest, rawlen, true);
+#endif
+
+	if (len != rawlen)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROTOCOL_VIOLATION),
+				 errmsg("compressed tuple data is corrupt")));
+}
+
 static bool
 CandidateForSerializeDirect(int16 targetRoute, struct directTransportBuffer *b)
 {
@@ -379,6 +486,8 @@ SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTranspor
 	char               *tupbody;
 	unsigned int       tupbodylen;
 	unsigned int       tuplen;
+	int32              hdr[2];
+	int                hdrlen;
 	bool               hasExternalAttr = false;
 
 	AssertArg(pSerInfo != NULL);
@@ -471,8 +580,34 @@ SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTranspor
 	tupbody = (char *) mintuple + MINIMAL_TUPLE_DATA_OFFSET;
 	tupbodylen = mintuple->t_len - MINIMAL_TUPLE_DATA_OFFSET;
 
+	/*
+	 * The body is preceded by its length, or for a compressed tuple, by
+	 * COMPRESSED_MAGIC_TUPLEN and the uncompressed length.
+	 */
+	hdr[0] = tupbodylen;
+	hdrlen = sizeof(int32);
+
+	if (gp_interconnect_compress_tuples)
+	{
+		int			complen;
+
+		pSerInfo->compress_raw_bytes += tupbodylen;
+
+		complen = compressTupleBody(pSerInfo, tupbody, tupbodylen);
+		if (complen >= 0)
+		{
+			hdr[0] = COMPRESSED_MAGIC_TUPLEN;
+			hdr[1] = tupbodylen;
+			hdrlen = 2 * sizeof(int32);
+			tupbody = pSerInfo->compress_buf;
+			tupbodylen = complen;
+		}
+
+		pSerInfo->compress_sent_bytes += hdrlen - sizeof(int32) + tupbodylen;
+	}
+
 	/* total on-wire footprint: */
-	tuplen = tupbodylen + sizeof(int);
+	tuplen = tupbodylen + hdrlen;
 
 	if (CandidateForSerializeDirect(targetRoute, b) &&
 		tuplen + TUPLE_CHUNK_HEADER_SIZE <= b->prilen)
@@ -480,8 +615,8 @@ SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTranspor
 		/*
 		 * The tuple fits in the direct transport buffer.
 		 */
-		memcpy(b->pri + TUPLE_CHUNK_HEADER_SIZE, &tupbodylen, sizeof(tupbodylen));
-		memcpy(b->pri + TUPLE_CHUNK_HEADER_SIZE + sizeof(int), tupbody, tupbodylen);
+		memcpy(b->pri + TUPLE_CHUNK_HEADER_SIZE, hdr, hdrlen);
+		memcpy(b->pri + TUPLE_CHUNK_HEADER_SIZE + hdrlen, tupbody, tupbodylen);
 
 		dataSize += tuplen;
 
@@ -504,7 +639,7 @@ SerializeTuple(TupleTableSlot *slot, SerTupInfo *pSerInfo, struct directTranspor
 
 	AssertState(s_tupSerMemCtxt != NULL);
 
-	addByteStringToChunkList(tcList, (char *) &tupbodylen, sizeof(tupbodylen), &pSerInfo->chunkCache);
+	addByteStringToChunkList(tcList, (char *) hdr, hdrlen, &pSerInfo->chunkCache);
 	addByteStringToChunkList(tcList, tupbody, tupbodylen, &pSerInfo->chunkCache);
 
 	/*
@@ -704,6 +839,22 @@ CvtChunksToTup(TupleChunkList tcList, SerTupInfo *pSerInfo, TupleRemapper *remap
 
 			return NULL;
 		}
+		else if (tupbodylen == COMPRESSED_MAGIC_TUPLEN)
+		{
+			/* A compressed MinimalTuple */
+			int			rawlen;
+			int			complen;
+
+			memcpy(&rawlen, pos, sizeof(rawlen));
+			pos += sizeof(rawlen);
+			complen = serData.len - (pos - serData.data);
+
+			tup = palloc(rawlen + MINIMAL_TUPLE_DATA_OFFSET);
+			tup->t_len = rawlen + MINIMAL_TUPLE_DATA_OFFSET;
+
+			decompressTupleBody(pos, complen,
+								(char *) tup + MINIMAL_TUPLE_DATA_OFFSET, rawlen);
+		}
 		else
 		{
 			/* A normal MinimalTuple */
@@ -112,15 +112,18 @@ test__DistributedSnapshotWithLocalMapping_CommittedTest(void **state)
 	assert_true(dslm.inProgressMappedLocalXids[0] == 10);
 	assert_true(dslm.inProgressMappedLocalXids[1] == 20);
 
-	/* Now lets simulate we got tuple with xid=5 */
+	/*
+	 * Now lets simulate we got tuple with xid=5, it should be inserted in
+	 * front to keep the local xid cache sorted.
+	 */
 	retval = DistributedSnapshotWithLocalMapping_CommittedTest(&dslm, 5, false);
 	assert_true(retval == DISTRIBUTEDSNAPSHOT_COMMITTED_INPROGRESS);
 	assert_true(dslm.currentLocalXidsCount == 3);
 	assert_true(dslm.minCachedLocalXid == 5);
 	assert_true(dslm.maxCachedLocalXid == 20);
-	assert_true(dslm.inProgressMappedLocalXids[0] == 10);
-	assert_true(dslm.inProgressMappedLocalXids[1] == 20);
-	assert_true(dslm.inProgressMappedLocalXids[2] == 5);
+	assert_true(dslm.inProgressMappedLocalXids[0] == 5);
+	assert_true(dslm.inProgressMappedLocalXids[1] == 10);
+	assert_true(dslm.inProgressMappedLocalXids[2] == 20);
 
 	/*
 	 * Lets revalidate that local cache is working and
@@ -132,9 +135,9 @@ test__DistributedSnapshotWithLocalMapping_CommittedTest(void **state)
 	assert_true(dslm.currentLocalXidsCount == 3);
 	assert_true(dslm.minCachedLocalXid == 5);
 	assert_true(dslm.maxCachedLocalXid == 20);
-	assert_true(dslm.inProgressMappedLocalXids[0] == 10);
-	assert_true(dslm.inProgressMappedLocalXids[1] == 20);
-	assert_true(dslm.inProgressMappedLocalXids[2] == 5);
+	assert_true(dslm.inProgressMappedLocalXids[0] == 5);
+	assert_true(dslm.inProgressMappedLocalXids[1] == 10);
+	assert_true(dslm.inProgressMappedLocalXids[2] == 20);
 
 	/*
 	 * Test where local cache should not be touched, if distributedXid is not
@@ -145,9 +148,9 @@ test__DistributedSnapshotWithLocalMapping_CommittedTest(void **state)
 	assert_true(dslm.currentLocalXidsCount == 3);
 	assert_true(dslm.minCachedLocalXid == 5);
 	assert_true(dslm.maxCachedLocalXid == 20);
-	assert_true(dslm.inProgressMappedLocalXids[0] == 10);
-	assert_true(dslm.inProgressMappedLocalXids[1] == 20);
-	assert_true(dslm.inProgressMappedLocalXids[2] == 5);
+	assert_true(dslm.inProgressMappedLocalXids[0] == 5);
+	assert_true(dslm.inProgressMappedLocalXids[1] == 10);
+	assert_true(dslm.inProgressMappedLocalXids[2] == 20);
 
 	free(ds->inProgressXidArray);
 	free(dslm.inProgressMappedLocalXids);
@@ -130,6 +130,7 @@
 #include "cdb/cdbtm.h"
 #include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"
+#include "commands/analyzesketch.h"
 #include "commands/analyzeutils.h"
 #include "executor/spi.h"
 #include "funcapi.h"
@@ -190,6 +191,12 @@ static int acquire_sample_rows_dispatcher(Relation onerel, bool inh, int elevel,
 static BlockNumber acquire_index_number_of_blocks(Relation indexrel, Relation tablerel);
 
 static void gp_acquire_correlations_dispatcher(Oid relOid, bool inh, float4 *correlations, bool *correlationsIsNull);
+static double acquire_column_sketches_dispatcher(Relation onerel, int attr_cnt,
+												 VacAttrStats **vacattrstats,
+												 int elevel);
+static double collect_column_sketches(const char *sql, int nsketched,
+									  int attr_cnt, VacAttrStats **vacattrstats);
+static void compute_sketch_stats(VacAttrStatsP stats, double totalrows);
 static int	compare_rows(const void *a, const void *b);
 static void update_attstats(Oid relid, bool inh,
 							int natts, VacAttrStats **vacattrstats);
@@ -498,6 +505,7 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 	Bitmapset **colLargeRowIndexes;
 	double     *colLargeRowLength;
 	bool		sample_needed;
+	double		sketchrows = -1;
 
 	int64		AnalyzePageHit = VacuumPageHit;
 	int64		AnalyzePageMiss = VacuumPageMiss;
@@ -735,7 +743,39 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 		}
 	}
 
+	/*
+	 * With gp_statistics_use_sketches, the statistics of the columns of a
+	 * distributed table are built from sketches of all its rows, computed on
+	 * the segments. A sample is then only needed for the columns that cannot
+	 * be sketched, the expression indexes and the extended statistics.
+	 *
+	 * Leaf partitions keep using the sample, as their HLL counters must be
+	 * built the same way for the root to merge them.
+	 */
+	if (gp_statistics_use_sketches && !inh &&
+		Gp_role == GP_ROLE_DISPATCH &&
+		onerel->rd_rel->relkind == RELKIND_RELATION &&
+		!onerel->rd_rel->relispartition &&
+		GpPolicyIsPartitioned(onerel->rd_cdbpolicy))
+		sketchrows = acquire_column_sketches_dispatcher(onerel, attr_cnt,
+														vacattrstats, elevel);
+
 	sample_needed = needs_sample(vacattrstats, attr_cnt);
+	if (sample_needed && sketchrows >= 0)
+	{
+		sample_needed = (minrows > 0);
+		for (i = 0; i < attr_cnt; i++)
+		{
+			if (vacattrstats[i]->sketches == NIL)
+				sample_needed = true;
+		}
+		for (ind = 0; ind < nindexes; ind++)
+		{
+			if (indexdata[ind].attr_cnt > 0)
+				sample_needed = true;
+		}
+	}
+
 	if (sample_needed)
 	{
 		if (ctx)
@@ -799,6 +839,10 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 		rows = NULL;
 	}
 
+	/* The sketches counted the rows exactly, trust them over the sample */
+	if (sketchrows >= 0)
+		totalrows = sketchrows;
+
 	if (ctx)
 	{
 		ctx->sample_rows = rows;
@@ -819,8 +863,11 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 	 * any tuples. In addition, we continue for statistics calculation if
 	 * optimizer_analyze_root_partition or ROOTPARTITION is specified in the
 	 * ANALYZE statement.
+	 *
+	 * Likewise, when every column has been sketched, there is no sample, and
+	 * the statistics are computed if the table has any rows.
 	 */
-	if (numrows > 0 || !sample_needed)
+	if (numrows > 0 || (!sample_needed && sketchrows != 0))
 	{
 		HeapTuple *validRows = (HeapTuple *) palloc(numrows * sizeof(HeapTuple));
 		MemoryContext col_context,
@@ -838,7 +885,8 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 		/*
 		 * Get correlations from segments.
 		 */
-		if (Gp_role == GP_ROLE_DISPATCH && GpPolicyIsPartitioned(onerel->rd_cdbpolicy))
+		if (Gp_role == GP_ROLE_DISPATCH && GpPolicyIsPartitioned(onerel->rd_cdbpolicy) &&
+			(sample_needed || sketchrows < 0))
 		{
 			/*
 			 * in gp_acquire_correlations_dispatcher we get correlations and correlationsIsNull
@@ -873,6 +921,21 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 				MemoryContextResetAndDeleteChildren(col_context);
 				continue;
 			}
+
+			/* Columns with sketches from the segments don't use the sample */
+			if (stats->sketches != NIL)
+			{
+				AttributeOpts *aopt;
+
+				compute_sketch_stats(stats, totalrows);
+
+				aopt = get_attribute_options(onerel->rd_id, stats->attr->attnum);
+				if (aopt != NULL && aopt->n_distinct != 0.0)
+					stats->stadistinct = aopt->n_distinct;
+
+				MemoryContextResetAndDeleteChildren(col_context);
+				continue;
+			}
 			Assert(sample_needed);
 
 			Bitmapset  *rowIndexes = colLargeRowIndexes[stats->attr->attnum - 1];
@@ -989,7 +1052,7 @@ do_analyze_rel(Relation onerel, VacuumParams *params,
 		 * are used as is to evaluate index statistics. It is less likely to have
 		 * indexes on very wide columns, so the effect will be minimal.
 		 */
-		if (nindexes > 0)
+		if (nindexes > 0 && numrows > 0)
 			compute_index_stats(onerel, totalrows,
 								indexdata, nindexes,
 								rows, numrows,
@@ -5381,3 +5444,871 @@ gp_acquire_correlations_dispatcher(Oid relOid, bool inh, float4 *correlations, b
 	cdbdisp_clearCdbPgResults(&cdb_pgresults);
 	table_close(onerel, AccessShareLock);
 }
+
+/*
+ * Can the statistics of the column be built from sketches? The sketches
+ * describe scalar columns, whose values can be sent to the dispatcher as
+ * text.
+ */
+static bool
+column_sketch_supported(VacAttrStats *stats)
+{
+	return stats->compute_stats == compute_scalar_stats &&
+		gp_acquire_sample_rows_col_type(stats->attrtypid) == stats->attrtypid;
+}
+
+/*
+ * Parse a text[] of values of a column sent by a segment.
+ */
+static Datum *
+parse_sketch_values(char *str, VacAttrStats *stats, int *nvalues)
+{
+	Oid			typinput;
+	Oid			typioparam;
+	FmgrInfo	infunc;
+	ArrayType  *arr;
+	Datum	   *texts;
+	Datum	   *values;
+	int			n;
+
+	getTypeInputInfo(stats->attrtypid, &typinput, &typioparam);
+	fmgr_info(typinput, &infunc);
+
+	arr = DatumGetArrayTypeP(OidInputFunctionCall(F_ARRAY_IN, str,
+												  TEXTOID, -1));
+	deconstruct_array(arr, TEXTOID, -1, false, TYPALIGN_INT,
+					  &texts, NULL, &n);
+
+	values = (Datum *) palloc(Max(n, 1) * sizeof(Datum));
+	for (int i = 0; i < n; i++)
+		values[i] = InputFunctionCall(&infunc, TextDatumGetCString(texts[i]),
+									  typioparam, stats->attrtypmod);
+
+	*nvalues = n;
+	return values;
+}
+
+/*
+ * Parse a float8[] sent by a segment.
+ */
+static double *
+parse_sketch_numbers(char *str, int *nnumbers)
+{
+	ArrayType  *arr;
+	Datum	   *datums;
+	double	   *numbers;
+	int			n;
+
+	arr = DatumGetArrayTypeP(OidInputFunctionCall(F_ARRAY_IN, str,
+												  FLOAT8OID, -1));
+	deconstruct_array(arr, FLOAT8OID, sizeof(float8), FLOAT8PASSBYVAL,
+					  TYPALIGN_DOUBLE, &datums, NULL, &n);
+
+	numbers = (double *) palloc(Max(n, 1) * sizeof(double));
+	for (int i = 0; i < n; i++)
+		numbers[i] = DatumGetFloat8(datums[i]);
+
+	*nnumbers = n;
+	return numbers;
+}
+
+/*
+ * The columns returned by gp_acquire_column_sketches() and
+ * gp_acquire_appended_sketches().
+ */
+#define COLUMN_SKETCH_COLS \
+	"attnum int2, totalrows float8, nullrows float8, toowiderows float8, " \
+	"totalwidth float8, correlation float4, hll bytea, mcverror float8, " \
+	"mcvs text[], mcvcounts float8[], points text[], pointweights float8[]"
+
+/*
+ * Collect the sketches of the columns of a distributed table, computed on
+ * the segments by gp_acquire_column_sketches() over all the rows of the
+ * table. The sketches of each segment are added to the sketches list of the
+ * VacAttrStats of the column, to be merged by compute_sketch_stats().
+ *
+ * Returns the number of rows of the table, or -1 if none of the columns can
+ * be sketched.
+ */
+static double
+acquire_column_sketches_dispatcher(Relation onerel, int attr_cnt,
+								   VacAttrStats **vacattrstats, int elevel)
+{
+	StringInfoData attnums;
+	char	   *sql;
+	int			nsketched = 0;
+	int			stattarget = 0;
+	double		totalrows = 0;
+
+	Assert(Gp_role == GP_ROLE_DISPATCH);
+
+	initStringInfo(&attnums);
+	for (int i = 0; i < attr_cnt; i++)
+	{
+		VacAttrStats *stats = vacattrstats[i];
+
+		if (!column_sketch_supported(stats))
+			continue;
+		appendStringInfo(&attnums, "%s%d", nsketched > 0 ? "," : "",
+						 stats->attr->attnum);
+		stattarget = Max(stattarget, stats->attr->attstattarget);
+		nsketched++;
+	}
+	if (nsketched == 0)
+		return -1;
+
+	sql = psprintf("select * from pg_catalog.gp_acquire_column_sketches(%u, '{%s}', %d) "
+				   "as (" COLUMN_SKETCH_COLS ");",
+				   RelationGetRelid(onerel), attnums.data, stattarget);
+
+	totalrows = collect_column_sketches(sql, nsketched, attr_cnt, vacattrstats);
+
+	ereport(elevel,
+			(errmsg("\"%s\": sketched %d columns over %.0f rows",
+					RelationGetRelationName(onerel), nsketched, totalrows)));
+
+	return totalrows;
+}
+
+/*
+ * Dispatch a query returning column sketches, and add the sketches of each
+ * segment to the VacAttrStats of their columns. nsketched is the number of
+ * columns each segment returns.
+ *
+ * Returns the total number of rows sketched on the segments, or -1 if some
+ * segment could not sketch some column.
+ */
+static double
+collect_column_sketches(const char *sql, int nsketched, int attr_cnt,
+						VacAttrStats **vacattrstats)
+{
+	CdbPgResults cdb_pgresults = {NULL, 0};
+	double		totalrows = 0;
+	bool		missing = false;
+
+	CdbDispatchCommand(sql, DF_WITH_SNAPSHOT, &cdb_pgresults);
+
+	for (int segno = 0; segno < cdb_pgresults.numResults; segno++)
+	{
+		struct pg_result *pgresult = cdb_pgresults.pg_results[segno];
+		int			rows;
+
+		if (PQresultStatus(pgresult) != PGRES_TUPLES_OK)
+		{
+			cdbdisp_clearCdbPgResults(&cdb_pgresults);
+			ereport(ERROR,
+					(errmsg("unexpected result from segment: %d",
+							PQresultStatus(pgresult))));
+		}
+		rows = PQntuples(pgresult);
+		if (rows != nsketched || PQnfields(pgresult) != NUM_COLUMN_SKETCH_COLS)
+		{
+			cdbdisp_clearCdbPgResults(&cdb_pgresults);
+			ereport(ERROR,
+					(errmsg("unexpected shape of result from segment (%d rows, %d cols)",
+							rows, PQnfields(pgresult))));
+		}
+
+		for (int j = 0; j < rows; j++)
+		{
+			ColumnSketch *sketch = palloc0(sizeof(ColumnSketch));
+			VacAttrStats *stats = NULL;
+			int			n;
+
+			sketch->attnum = DatumGetInt16(DirectFunctionCall1(int2in,
+															   CStringGetDatum(PQgetvalue(pgresult, j, 0))));
+			for (int i = 0; i < attr_cnt; i++)
+			{
+				if (vacattrstats[i]->attr->attnum == sketch->attnum)
+					stats = vacattrstats[i];
+			}
+			if (stats == NULL)
+				elog(ERROR, "unexpected column %d in sketches from segment",
+					 sketch->attnum);
+
+			if (PQgetisnull(pgresult, j, 1))
+			{
+				/* The segment did not sketch this column */
+				missing = true;
+				continue;
+			}
+			sketch->totalrows = DatumGetFloat8(DirectFunctionCall1(float8in,
+																   CStringGetDatum(PQgetvalue(pgresult, j, 1))));
+			sketch->nullrows = DatumGetFloat8(DirectFunctionCall1(float8in,
+																  CStringGetDatum(PQgetvalue(pgresult, j, 2))));
+			sketch->toowiderows = DatumGetFloat8(DirectFunctionCall1(float8in,
+																	 CStringGetDatum(PQgetvalue(pgresult, j, 3))));
+			sketch->totalwidth = DatumGetFloat8(DirectFunctionCall1(float8in,
+																	CStringGetDatum(PQgetvalue(pgresult, j, 4))));
+			sketch->corrnull = PQgetisnull(pgresult, j, 5);
+			if (!sketch->corrnull)
+				sketch->correlation = DatumGetFloat4(DirectFunctionCall1(float4in,
+																		 CStringGetDatum(PQgetvalue(pgresult, j, 5))));
+			if (!PQgetisnull(pgresult, j, 6))
+				sketch->hll = DatumGetByteaP(DirectFunctionCall1(byteain,
+																 CStringGetDatum(PQgetvalue(pgresult, j, 6))));
+			sketch->mcverror = DatumGetFloat8(DirectFunctionCall1(float8in,
+																  CStringGetDatum(PQgetvalue(pgresult, j, 7))));
+			sketch->mcvs = parse_sketch_values(PQgetvalue(pgresult, j, 8),
+											   stats, &sketch->nmcvs);
+			sketch->mcvcounts = parse_sketch_numbers(PQgetvalue(pgresult, j, 9), &n);
+			if (n != sketch->nmcvs)
+				elog(ERROR, "mismatched heavy hitters in sketches from segment");
+			sketch->points = parse_sketch_values(PQgetvalue(pgresult, j, 10),
+												 stats, &sketch->npoints);
+			sketch->pointweights = parse_sketch_numbers(PQgetvalue(pgresult, j, 11), &n);
+			if (n != sketch->npoints)
+				elog(ERROR, "mismatched quantiles in sketches from segment");
+
+			/* Every column of a segment was sketched over the same rows */
+			if (j == 0)
+				totalrows += sketch->totalrows;
+
+			stats->sketches = lappend(stats->sketches, sketch);
+		}
+	}
+
+	cdbdisp_clearCdbPgResults(&cdb_pgresults);
+
+	if (missing)
+	{
+		for (int i = 0; i < attr_cnt; i++)
+			vacattrstats[i]->sketches = NIL;
+		return -1;
+	}
+
+	return totalrows;
+}
+
+/*
+ * A value of a column with its count, or its weight, gathered from the
+ * sketches of the segments.
+ */
+typedef struct
+{
+	Datum		value;
+	double		count;
+} SketchItem;
+
+static int
+compare_sketch_items(const void *a, const void *b, void *arg)
+{
+	return ApplySortComparator(((const SketchItem *) a)->value, false,
+							   ((const SketchItem *) b)->value, false,
+							   (SortSupport) arg);
+}
+
+static int
+compare_sketch_counts(const void *a, const void *b, void *arg)
+{
+	const SketchItem *ia = (const SketchItem *) a;
+	const SketchItem *ib = (const SketchItem *) b;
+
+	if (ia->count != ib->count)
+		return ia->count > ib->count ? -1 : 1;
+	return compare_sketch_items(a, b, arg);
+}
+
+/*
+ *	compute_sketch_stats() -- compute column statistics from the sketches of
+ *	the segments
+ *
+ *	This is the counterpart of compute_scalar_stats() for the columns whose
+ *	sketches were collected by acquire_column_sketches_dispatcher(). The null
+ *	fraction, the width and the number of distinct values describe all the
+ *	rows of the table. The most common values come from the merged heavy
+ *	hitters, and the histogram from the merged quantiles, without the most
+ *	common values.
+ */
+static void
+compute_sketch_stats(VacAttrStatsP stats, double totalrows)
+{
+	StdAnalyzeData *mystats = (StdAnalyzeData *) stats->extra_data;
+	bool		is_varwidth = (!stats->attrtype->typbyval &&
+							   stats->attrtype->typlen < 0);
+	int			num_mcv = stats->attr->attstattarget;
+	int			num_bins = stats->attr->attstattarget;
+	double		nullrows = 0;
+	double		toowiderows = 0;
+	double		totalwidth = 0;
+	double		mcverror = 0;
+	double		corrsum = 0;
+	double		corrweight = 0;
+	double		nonnull;
+	double		sketched;
+	double		ndistinct;
+	GpHLLCounter hll = NULL;
+	SketchItem *mcvs;
+	SketchItem *points;
+	int			nmcvs = 0;
+	int			npoints = 0;
+	int			nmerged;
+	int			slot_idx = 0;
+	bool		complete;
+	SortSupportData ssup;
+	ListCell   *lc;
+
+	foreach(lc, stats->sketches)
+	{
+		ColumnSketch *sketch = (ColumnSketch *) lfirst(lc);
+
+		nmcvs += sketch->nmcvs;
+		npoints += sketch->npoints;
+	}
+	mcvs = (SketchItem *) palloc(Max(nmcvs, 1) * sizeof(SketchItem));
+	points = (SketchItem *) palloc(Max(npoints, 1) * sizeof(SketchItem));
+
+	/* Add up the counters, and gather the sketches of all the segments */
+	nmcvs = npoints = 0;
+	foreach(lc, stats->sketches)
+	{
+		ColumnSketch *sketch = (ColumnSketch *) lfirst(lc);
+
+		nullrows += sketch->nullrows;
+		toowiderows += sketch->toowiderows;
+		totalwidth += sketch->totalwidth;
+		mcverror += sketch->mcverror;
+
+		if (sketch->hll != NULL)
+		{
+			GpHLLCounter merged;
+
+			merged = gp_hyperloglog_merge_counters(hll, (GpHLLCounter) sketch->hll);
+			if (hll != NULL)
+				pfree(hll);
+			hll = merged;
+		}
+
+		/* Weigh the correlation of each segment by its number of values */
+		if (!sketch->corrnull)
+		{
+			double		weight = sketch->totalrows - sketch->nullrows -
+				sketch->toowiderows;
+
+			corrsum += sketch->correlation * weight;
+			corrweight += weight;
+		}
+
+		for (int i = 0; i < sketch->nmcvs; i++)
+		{
+			mcvs[nmcvs].value = sketch->mcvs[i];
+			mcvs[nmcvs].count = sketch->mcvcounts[i];
+			nmcvs++;
+		}
+		for (int i = 0; i < sketch->npoints; i++)
+		{
+			points[npoints].value = sketch->points[i];
+			points[npoints].count = sketch->pointweights[i];
+			npoints++;
+		}
+	}
+
+	nonnull = totalrows - nullrows;
+	sketched = nonnull - toowiderows;
+
+	/*
+	 * Keep the merged HLL counter in the last slot, like for leaf partitions,
+	 * so that the rows appended later can be merged into the statistics, see
+	 * analyze_appended_rows().
+	 */
+	if (hll != NULL)
+	{
+		MemoryContext old_context;
+		Datum	   *hll_values;
+
+		old_context = MemoryContextSwitchTo(stats->anl_context);
+		hll_values = (Datum *) palloc(sizeof(Datum));
+		hll_values[0] = PointerGetDatum(gp_hll_compress(gp_hll_copy(hll)));
+		MemoryContextSwitchTo(old_context);
+
+		stats->stakind[STATISTIC_NUM_SLOTS - 1] = STATISTIC_KIND_FULLHLL;
+		stats->stavalues[STATISTIC_NUM_SLOTS - 1] = hll_values;
+		stats->numvalues[STATISTIC_NUM_SLOTS - 1] = 1;
+	}
+
+	stats->stats_valid = true;
+	stats->stanullfrac = totalrows > 0 ? nullrows / totalrows : 0.0;
+	if (is_varwidth)
+		stats->stawidth = nonnull > 0 ? totalwidth / nonnull : 0;
+	else
+		stats->stawidth = stats->attrtype->typlen;
+
+	if (nonnull <= 0)
+	{
+		/* We found only nulls; assume the column is entirely null */
+		stats->stanullfrac = 1.0;
+		stats->stadistinct = 0.0;	/* "unknown" */
+		return;
+	}
+	if (sketched <= 0)
+	{
+		/* All the values were too wide, assume they are all distinct */
+		stats->stadistinct = -1.0 * (1.0 - stats->stanullfrac);
+		return;
+	}
+
+	memset(&ssup, 0, sizeof(ssup));
+	ssup.ssup_cxt = CurrentMemoryContext;
+	ssup.ssup_collation = stats->attrcollid;
+	ssup.ssup_nulls_first = false;
+	ssup.abbreviate = false;
+	PrepareSortSupportFromOrderingOp(mystats->ltopr, &ssup);
+
+	/* Merge the heavy hitters of the segments, adding up their counts */
+	qsort_arg(mcvs, nmcvs, sizeof(SketchItem), compare_sketch_items, &ssup);
+	nmerged = 0;
+	for (int i = 0; i < nmcvs; i++)
+	{
+		if (nmerged > 0 &&
+			compare_sketch_items(&mcvs[nmerged - 1], &mcvs[i], &ssup) == 0)
+			mcvs[nmerged - 1].count += mcvs[i].count;
+		else
+			mcvs[nmerged++] = mcvs[i];
+	}
+
+	/*
+	 * If no segment had to evict a heavy hitter, the heavy hitters hold every
+	 * value with its exact count. Otherwise, estimate the number of distinct
+	 * values with the merged HLL counters, counting the values that are too
+	 * wide as distinct.
+	 */
+	complete = (mcverror == 0 && toowiderows == 0);
+	if (complete)
+		ndistinct = nmerged;
+	else
+	{
+		ndistinct = (hll != NULL ? gp_hyperloglog_estimate(hll) : 0) + toowiderows;
+		ndistinct = Max(ndistinct, 1);
+		ndistinct = Min(ndistinct, nonnull);
+	}
+
+	if (fabs(nonnull - ndistinct) / nonnull < GP_HLL_ERROR_MARGIN)
+		stats->stadistinct = -1.0 * (1.0 - stats->stanullfrac);
+	else if (ndistinct > 0.1 * totalrows)
+		stats->stadistinct = -(ndistinct / totalrows);
+	else
+		stats->stadistinct = floor(ndistinct + 0.5);
+
+	/*
+	 * Keep the values that are more common than the average, by the same
+	 * margin as compute_scalar_stats() for a uniform column, or all of them if
+	 * they are every value of the column and fit in the target.
+	 */
+	qsort_arg(mcvs, nmerged, sizeof(SketchItem), compare_sketch_counts, &ssup);
+	if (complete && nmerged <= num_mcv)
+		num_mcv = nmerged;
+	else
+	{
+		double		mincount = Max(1.25 * sketched / ndistinct, 2);
+		int			n = 0;
+
+		while (n < num_mcv && n < nmerged && mcvs[n].count >= mincount)
+			n++;
+		num_mcv = n;
+	}
+
+	/* Generate MCV slot entry */
+	if (num_mcv > 0)
+	{
+		MemoryContext old_context;
+		Datum	   *mcv_values;
+		float4	   *mcv_freqs;
+
+		/* Must copy the target values into anl_context */
+		old_context = MemoryContextSwitchTo(stats->anl_context);
+		mcv_values = (Datum *) palloc(num_mcv * sizeof(Datum));
+		mcv_freqs = (float4 *) palloc(num_mcv * sizeof(float4));
+		for (int i = 0; i < num_mcv; i++)
+		{
+			mcv_values[i] = datumCopy(mcvs[i].value,
+									  stats->attrtype->typbyval,
+									  stats->attrtype->typlen);
+			mcv_freqs[i] = mcvs[i].count / totalrows;
+		}
+		MemoryContextSwitchTo(old_context);
+
+		stats->stakind[slot_idx] = STATISTIC_KIND_MCV;
+		stats->staop[slot_idx] = mystats->eqopr;
+		stats->stacoll[slot_idx] = stats->attrcollid;
+		stats->stanumbers[slot_idx] = mcv_freqs;
+		stats->numnumbers[slot_idx] = num_mcv;
+		stats->stavalues[slot_idx] = mcv_values;
+		stats->numvalues[slot_idx] = num_mcv;
+		slot_idx++;
+	}
+
+	/*
+	 * Collapse out the most common values from the merged quantiles, and
+	 * generate a histogram slot entry if there are at least two distinct
+	 * values left. The bounds are picked at evenly-spaced ranks of the
+	 * weighted values.
+	 */
+	qsort_arg(mcvs, num_mcv, sizeof(SketchItem), compare_sketch_items, &ssup);
+	qsort_arg(points, npoints, sizeof(SketchItem), compare_sketch_items, &ssup);
+	{
+		int			nvals = 0;
+		int			ndistinct_vals = 0;
+		int			num_hist;
+		int			j = 0;
+		double		totalweight = 0;
+
+		for (int i = 0; i < npoints; i++)
+		{
+			int			compare = -1;
+
+			while (j < num_mcv &&
+				   (compare = compare_sketch_items(&mcvs[j], &points[i], &ssup)) < 0)
+				j++;
+			if (j < num_mcv && compare == 0)
+				continue;
+
+			if (nvals == 0 ||
+				compare_sketch_items(&points[nvals - 1], &points[i], &ssup) != 0)
+				ndistinct_vals++;
+			totalweight += points[i].count;
+			points[nvals++] = points[i];
+		}
+
+		num_hist = ndistinct_vals;
+		if (num_hist > num_bins)
+			num_hist = num_bins + 1;
+		if (num_hist >= 2)
+		{
+			MemoryContext old_context;
+			Datum	   *hist_values;
+			double		cumweight = 0;
+			int			pos = 0;
+
+			/* Must copy the target values into anl_context */
+			old_context = MemoryContextSwitchTo(stats->anl_context);
+			hist_values = (Datum *) palloc(num_hist * sizeof(Datum));
+			for (int i = 0; i < num_hist; i++)
+			{
+				double		rank = i * totalweight / (num_hist - 1);
+
+				while (pos < nvals - 1 && cumweight + points[pos].count <= rank)
+					cumweight += points[pos++].count;
+				hist_values[i] = datumCopy(points[pos].value,
+										   stats->attrtype->typbyval,
+										   stats->attrtype->typlen);
+			}
+			MemoryContextSwitchTo(old_context);
+
+			stats->stakind[slot_idx] = STATISTIC_KIND_HISTOGRAM;
+			stats->staop[slot_idx] = mystats->ltopr;
+			stats->stacoll[slot_idx] = stats->attrcollid;
+			stats->stavalues[slot_idx] = hist_values;
+			stats->numvalues[slot_idx] = num_hist;
+			slot_idx++;
+		}
+	}
+
+	/* Generate a correlation entry if there are multiple values */
+	if (corrweight > 0 && sketched > 1)
+	{
+		MemoryContext old_context;
+		float4	   *corrs;
+
+		old_context = MemoryContextSwitchTo(stats->anl_context);
+		corrs = (float4 *) palloc(sizeof(float4));
+		MemoryContextSwitchTo(old_context);
+		corrs[0] = corrsum / corrweight;
+
+		stats->stakind[slot_idx] = STATISTIC_KIND_CORRELATION;
+		stats->staop[slot_idx] = mystats->ltopr;
+		stats->stacoll[slot_idx] = stats->attrcollid;
+		stats->stanumbers[slot_idx] = corrs;
+		stats->numnumbers[slot_idx] = 1;
+		slot_idx++;
+	}
+}
+
+/*
+ * Describe the statistics of a column, built from sketches, like the sketch
+ * of one more segment, for compute_sketch_stats() to merge them with the
+ * sketches of the appended rows. reltuples is the number of rows the
+ * statistics describe.
+ *
+ * The most common values keep their counts, and the histogram bounds share
+ * the other rows evenly. The counts of the values not in the list are only
+ * known to be about the average.
+ *
+ * Returns NULL if the statistics were not built from sketches.
+ */
+static ColumnSketch *
+sketch_from_statistics(VacAttrStats *stats, double reltuples)
+{
+	HeapTuple	statup;
+	Form_pg_statistic stat;
+	AttStatsSlot sslot;
+	ColumnSketch *sketch;
+	double		nonnull;
+	double		ndistinct;
+	double		listed = 0;
+	double		rest;
+	int			nbounds = 0;
+	Datum	   *bounds = NULL;
+
+	statup = SearchSysCache3(STATRELATTINH,
+							 ObjectIdGetDatum(stats->attr->attrelid),
+							 Int16GetDatum(stats->attr->attnum),
+							 BoolGetDatum(false));
+	if (!HeapTupleIsValid(statup))
+		return NULL;
+
+	if (!get_attstatsslot(&sslot, statup, STATISTIC_KIND_FULLHLL,
+						  InvalidOid, ATTSTATSSLOT_VALUES))
+	{
+		ReleaseSysCache(statup);
+		return NULL;
+	}
+	stat = (Form_pg_statistic) GETSTRUCT(statup);
+
+	sketch = (ColumnSketch *) palloc0(sizeof(ColumnSketch));
+	sketch->attnum = stats->attr->attnum;
+	sketch->totalrows = reltuples;
+	sketch->nullrows = stat->stanullfrac * reltuples;
+	nonnull = reltuples - sketch->nullrows;
+	sketch->totalwidth = stat->stawidth * nonnull;
+	sketch->hll = DatumGetByteaPCopy(sslot.values[0]);
+	free_attstatsslot(&sslot);
+
+	if (get_attstatsslot(&sslot, statup, STATISTIC_KIND_MCV, InvalidOid,
+						 ATTSTATSSLOT_VALUES | ATTSTATSSLOT_NUMBERS))
+	{
+		sketch->nmcvs = sslot.nvalues;
+		sketch->mcvs = (Datum *) palloc(sslot.nvalues * sizeof(Datum));
+		sketch->mcvcounts = (double *) palloc(sslot.nvalues * sizeof(double));
+		for (int i = 0; i < sslot.nvalues; i++)
+		{
+			sketch->mcvs[i] = datumCopy(sslot.values[i],
+										stats->attrtype->typbyval,
+										stats->attrtype->typlen);
+			sketch->mcvcounts[i] = sslot.numbers[i] * reltuples;
+			listed += sketch->mcvcounts[i];
+		}
+		free_attstatsslot(&sslot);
+	}
+
+	if (get_attstatsslot(&sslot, statup, STATISTIC_KIND_HISTOGRAM, InvalidOid,
+						 ATTSTATSSLOT_VALUES))
+	{
+		nbounds = sslot.nvalues;
+		bounds = (Datum *) palloc(Max(nbounds, 1) * sizeof(Datum));
+		for (int i = 0; i < nbounds; i++)
+			bounds[i] = datumCopy(sslot.values[i],
+								  stats->attrtype->typbyval,
+								  stats->attrtype->typlen);
+		free_attstatsslot(&sslot);
+	}
+
+	sketch->corrnull = true;
+	if (get_attstatsslot(&sslot, statup, STATISTIC_KIND_CORRELATION, InvalidOid,
+						 ATTSTATSSLOT_NUMBERS))
+	{
+		sketch->corrnull = false;
+		sketch->correlation = sslot.numbers[0];
+		free_attstatsslot(&sslot);
+	}
+
+	if (stat->stadistinct > 0)
+		ndistinct = stat->stadistinct;
+	else if (stat->stadistinct < 0)
+		ndistinct = -stat->stadistinct * reltuples;
+	else
+		ndistinct = nonnull;
+
+	ReleaseSysCache(statup);
+
+	/*
+	 * If the most common values hold all the rows, the list was complete.
+	 * Otherwise, the other values could be missing from the list by about
+	 * their average count.
+	 */
+	rest = nonnull - listed;
+	if (rest < 1)
+		sketch->mcverror = 0;
+	else
+		sketch->mcverror = Max(rest / Max(ndistinct - sketch->nmcvs, 1), 1);
+
+	/* The quantiles are the most common values and the histogram bounds */
+	sketch->npoints = sketch->nmcvs + nbounds;
+	sketch->points = (Datum *) palloc(Max(sketch->npoints, 1) * sizeof(Datum));
+	sketch->pointweights = (double *) palloc(Max(sketch->npoints, 1) * sizeof(double));
+	for (int i = 0; i < sketch->nmcvs; i++)
+	{
+		sketch->points[i] = sketch->mcvs[i];
+		sketch->pointweights[i] = sketch->mcvcounts[i];
+	}
+	for (int i = 0; i < nbounds; i++)
+	{
+		sketch->points[sketch->nmcvs + i] = bounds[i];
+		sketch->pointweights[sketch->nmcvs + i] = Max(rest, 0) / nbounds;
+	}
+
+	return sketch;
+}
+
+/*
+ *	analyze_appended_rows() -- merge the rows appended to an append-optimized
+ *	table by the current transaction into its statistics
+ *
+ *	This is what auto-stats does instead of ANALYZE, with
+ *	gp_autostats_incremental, after rows are inserted into a table whose
+ *	statistics were built from sketches, with gp_statistics_use_sketches. The
+ *	segments sketched the rows as they were appended, see
+ *	sketch_appended_rows(), and the statistics of the table are merged with
+ *	these sketches like with the sketches of another segment. The rest of the
+ *	table is not scanned again.
+ *
+ *	Returns false if the statistics cannot be merged, and the table must be
+ *	analyzed instead.
+ */
+bool
+analyze_appended_rows(Oid relid)
+{
+	Relation	onerel;
+	Relation   *Irel;
+	int			nindexes;
+	VacAttrStats **vacattrstats;
+	int			attr_cnt = 0;
+	StringInfoData attnums;
+	char	   *sql;
+	double		reltuples;
+	double		appendedrows;
+	double		totalrows;
+	MemoryContext caller_context;
+	MemoryContext col_context;
+	Oid			save_userid;
+	int			save_sec_context;
+	bool		mergeable;
+
+	Assert(Gp_role == GP_ROLE_DISPATCH);
+
+	/* Lock the table like ANALYZE, so that concurrent merges wait */
+	onerel = try_relation_open(relid, ShareUpdateExclusiveLock, false);
+	if (onerel == NULL)
+		return false;
+
+	/*
+	 * Leaf partitions are left to ANALYZE, as the root merges their HLL
+	 * counters. So are the tables whose expression indexes or extended
+	 * statistics would go stale.
+	 */
+	reltuples = onerel->rd_rel->reltuples;
+	mergeable = (RelationIsAppendOptimized(onerel) &&
+				 onerel->rd_rel->relkind == RELKIND_RELATION &&
+				 !onerel->rd_rel->relispartition &&
+				 GpPolicyIsPartitioned(onerel->rd_cdbpolicy) &&
+				 reltuples > 0 &&
+				 RelationGetStatExtList(onerel) == NIL);
+	if (mergeable)
+	{
+		vac_open_indexes(onerel, AccessShareLock, &nindexes, &Irel);
+		for (int i = 0; i < nindexes; i++)
+		{
+			if (RelationGetIndexExpressions(Irel[i]) != NIL)
+				mergeable = false;
+		}
+		vac_close_indexes(nindexes, Irel, NoLock);
+	}
+	if (!mergeable)
+	{
+		relation_close(onerel, NoLock);
+		return false;
+	}
+
+	anl_context = AllocSetContextCreate(CurrentMemoryContext,
+										"Analyze",
+										ALLOCSET_DEFAULT_SIZES);
+	caller_context = MemoryContextSwitchTo(anl_context);
+
+	/* Like ANALYZE, query the segments as the table owner */
+	GetUserIdAndSecContext(&save_userid, &save_sec_context);
+	SetUserIdAndSecContext(onerel->rd_rel->relowner,
+						   save_sec_context | SECURITY_RESTRICTED_OPERATION);
+
+	/* Every column must have statistics built from sketches */
+	initStringInfo(&attnums);
+	vacattrstats = (VacAttrStats **)
+		palloc(RelationGetNumberOfAttributes(onerel) * sizeof(VacAttrStats *));
+	for (int i = 1; i <= RelationGetNumberOfAttributes(onerel); i++)
+	{
+		VacAttrStats *stats = examine_attribute(onerel, i, NULL, DEBUG2);
+		ColumnSketch *sketch;
+
+		if (stats == NULL)
+			continue;
+		vacattrstats[attr_cnt++] = stats;
+
+		if (!column_sketch_supported(stats) ||
+			(sketch = sketch_from_statistics(stats, reltuples)) == NULL)
+		{
+			mergeable = false;
+			break;
+		}
+		stats->sketches = list_make1(sketch);
+		appendStringInfo(&attnums, "%s%d", attr_cnt > 1 ? "," : "", i);
+	}
+
+	appendedrows = -1;
+	if (mergeable && attr_cnt > 0)
+	{
+		sql = psprintf("select * from pg_catalog.gp_acquire_appended_sketches(%u, '{%s}') "
+					   "as (" COLUMN_SKETCH_COLS ");",
+					   relid, attnums.data);
+		appendedrows = collect_column_sketches(sql, attr_cnt, attr_cnt,
+											   vacattrstats);
+	}
+
+	if (appendedrows > 0)
+	{
+		totalrows = reltuples + appendedrows;
+
+		col_context = AllocSetContextCreate(anl_context,
+											"Analyze Column",
+											ALLOCSET_DEFAULT_SIZES);
+		MemoryContextSwitchTo(col_context);
+		for (int i = 0; i < attr_cnt; i++)
+		{
+			VacAttrStats *stats = vacattrstats[i];
+			AttributeOpts *aopt;
+
+			compute_sketch_stats(stats, totalrows);
+
+			aopt = get_attribute_options(relid, stats->attr->attnum);
+			if (aopt != NULL && aopt->n_distinct != 0.0)
+				stats->stadistinct = aopt->n_distinct;
+
+			MemoryContextResetAndDeleteChildren(col_context);
+		}
+		MemoryContextSwitchTo(anl_context);
+		MemoryContextDelete(col_context);
+
+		update_attstats(relid, false, attr_cnt, vacattrstats);
+
+		vac_update_relstats(onerel,
+							AcquireNumberOfBlocks(onerel),
+							totalrows,
+							0,
+							RelationGetIndexList(onerel) != NIL,
+							InvalidTransactionId,
+							InvalidMultiXactId,
+							true,
+							false /* isVacuum */);
+
+		if (log_autostats)
+			elog(LOG, "Auto-stats merged %.0f appended rows into the statistics of tableoid %u.",
+				 appendedrows, relid);
+	}
+
+	SetUserIdAndSecContext(save_userid, save_sec_context);
+
+	MemoryContextSwitchTo(caller_context);
+	MemoryContextDelete(anl_context);
+	anl_context = NULL;
+
+	relation_close(onerel, NoLock);
+
+	return appendedrows >= 0;
+}
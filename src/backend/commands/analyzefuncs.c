@@ -18,10 +18,12 @@
 #include "cdb/cdbappendonlyam.h"
 #include "cdb/cdbaocsam.h"
 #include "cdb/cdbvars.h"
+#include "commands/analyzesketch.h"
 #include "commands/vacuum.h"
 #include "nodes/makefuncs.h"
 #include "storage/bufmgr.h"
 #include "utils/acl.h"
+#include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/lsyscache.h"
 #include "utils/rel.h"
@@ -37,6 +39,7 @@
 
 bool			gp_statistics_pullup_from_child_partition = false;
 bool			gp_statistics_use_fkeys = false;
+bool			gp_statistics_use_sketches = false;
 
 
 /*
@@ -526,3 +529,294 @@ gp_acquire_correlations(PG_FUNCTION_ARGS)
 
 	SRF_RETURN_DONE(funcctx);
 }
+
+/*
+ * Companion to gp_acquire_column_sketches(): the values of a sketch, as a
+ * text array of their output representations.
+ */
+static Datum
+sketch_values_to_text_array(Datum *values, int nvalues, FmgrInfo *outfunc)
+{
+	Datum	   *texts = (Datum *) palloc(Max(nvalues, 1) * sizeof(Datum));
+	int			i;
+
+	for (i = 0; i < nvalues; i++)
+		texts[i] = CStringGetTextDatum(OutputFunctionCall(outfunc, values[i]));
+
+	return PointerGetDatum(construct_array(texts, nvalues, TEXTOID,
+										   -1, false, TYPALIGN_INT));
+}
+
+static Datum
+sketch_numbers_to_float8_array(double *numbers, int nnumbers)
+{
+	Datum	   *datums = (Datum *) palloc(Max(nnumbers, 1) * sizeof(Datum));
+	int			i;
+
+	for (i = 0; i < nnumbers; i++)
+		datums[i] = Float8GetDatum(numbers[i]);
+
+	return PointerGetDatum(construct_array(datums, nnumbers, FLOAT8OID,
+										   sizeof(float8), FLOAT8PASSBYVAL,
+										   TYPALIGN_DOUBLE));
+}
+
+/*
+ * The result type of gp_acquire_column_sketches() and
+ * gp_acquire_appended_sketches().
+ */
+static TupleDesc
+column_sketches_tupdesc(void)
+{
+	TupleDesc	outDesc;
+
+	outDesc = CreateTemplateTupleDesc(NUM_COLUMN_SKETCH_COLS);
+	TupleDescInitEntry(outDesc, 1, "attnum", INT2OID, -1, 0);
+	TupleDescInitEntry(outDesc, 2, "totalrows", FLOAT8OID, -1, 0);
+	TupleDescInitEntry(outDesc, 3, "nullrows", FLOAT8OID, -1, 0);
+	TupleDescInitEntry(outDesc, 4, "toowiderows", FLOAT8OID, -1, 0);
+	TupleDescInitEntry(outDesc, 5, "totalwidth", FLOAT8OID, -1, 0);
+	TupleDescInitEntry(outDesc, 6, "correlation", FLOAT4OID, -1, 0);
+	TupleDescInitEntry(outDesc, 7, "hll", BYTEAOID, -1, 0);
+	TupleDescInitEntry(outDesc, 8, "mcverror", FLOAT8OID, -1, 0);
+	TupleDescInitEntry(outDesc, 9, "mcvs", TEXTARRAYOID, -1, 0);
+	TupleDescInitEntry(outDesc, 10, "mcvcounts", FLOAT8ARRAYOID, -1, 0);
+	TupleDescInitEntry(outDesc, 11, "points", TEXTARRAYOID, -1, 0);
+	TupleDescInitEntry(outDesc, 12, "pointweights", FLOAT8ARRAYOID, -1, 0);
+
+	return BlessTupleDesc(outDesc);
+}
+
+/*
+ * Form the result row of a sketch. A sketch with a negative totalrows, of a
+ * column that was not sketched, has a NULL totalrows.
+ */
+static HeapTuple
+column_sketch_form_tuple(gp_acquire_column_sketches_context *ctx,
+						 ColumnSketch *sketch)
+{
+	Datum		outvalues[NUM_COLUMN_SKETCH_COLS];
+	bool		outnulls[NUM_COLUMN_SKETCH_COLS];
+	Form_pg_attribute relatt;
+	Oid			typoutput;
+	bool		typisvarlena;
+	FmgrInfo	outfunc;
+
+	relatt = TupleDescAttr(RelationGetDescr(ctx->onerel), sketch->attnum - 1);
+	getTypeOutputInfo(relatt->atttypid, &typoutput, &typisvarlena);
+	fmgr_info(typoutput, &outfunc);
+
+	MemSet(outnulls, false, sizeof(outnulls));
+	outvalues[0] = Int16GetDatum(sketch->attnum);
+	outvalues[1] = Float8GetDatum(sketch->totalrows);
+	outnulls[1] = sketch->totalrows < 0;
+	outvalues[2] = Float8GetDatum(sketch->nullrows);
+	outvalues[3] = Float8GetDatum(sketch->toowiderows);
+	outvalues[4] = Float8GetDatum(sketch->totalwidth);
+	outvalues[5] = Float4GetDatum(sketch->correlation);
+	outnulls[5] = sketch->corrnull;
+	outvalues[6] = PointerGetDatum(sketch->hll);
+	outnulls[6] = sketch->hll == NULL;
+	outvalues[7] = Float8GetDatum(sketch->mcverror);
+	outvalues[8] = sketch_values_to_text_array(sketch->mcvs, sketch->nmcvs,
+											   &outfunc);
+	outvalues[9] = sketch_numbers_to_float8_array(sketch->mcvcounts,
+												  sketch->nmcvs);
+	outvalues[10] = sketch_values_to_text_array(sketch->points,
+												sketch->npoints, &outfunc);
+	outvalues[11] = sketch_numbers_to_float8_array(sketch->pointweights,
+												   sketch->npoints);
+
+	return heap_form_tuple(ctx->outDesc, outvalues, outnulls);
+}
+
+/*
+ * gp_acquire_column_sketches - Scan all the rows of a table, and return the
+ * sketches of the given columns, see commands/analyzesketch.c.
+ *
+ * This is an internal function called in
+ * acquire_column_sketches_dispatcher(), when gp_statistics_use_sketches is
+ * on. It returns a row for each column, and the values in the sketches as
+ * text arrays, which the dispatcher reads back with the input function of
+ * the column. For example:
+ *
+ * postgres=# select * from pg_catalog.gp_acquire_column_sketches('foo'::regclass, '{1}', 100) as (
+ *     attnum int2, totalrows float8, nullrows float8, toowiderows float8,
+ *     totalwidth float8, correlation float4, hll bytea, mcverror float8,
+ *     mcvs text[], mcvcounts float8[], points text[], pointweights float8[]);
+ *  attnum | totalrows | nullrows | ... | mcvs  | mcvcounts | points  | pointweights
+ * --------+-----------+----------+-----+-------+-----------+---------+--------------
+ *       1 |         3 |        0 | ... | {1,2} | {2,1}     | {1,1,2} | {1,1,1}
+ * (1 row)
+ */
+Datum
+gp_acquire_column_sketches(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx = NULL;
+	gp_acquire_column_sketches_context *ctx;
+	MemoryContext oldcontext;
+	Oid			relOid = PG_GETARG_OID(0);
+	ArrayType  *attnumArray = PG_GETARG_ARRAYTYPE_P(1);
+	int32		stattarget = PG_GETARG_INT32(2);
+	TupleDesc	outDesc;
+	ColumnSketch *sketch;
+
+	if (stattarget < 1)
+		elog(ERROR, "invalid stattarget argument");
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		Relation	onerel;
+		Datum	   *attnumDatums;
+		int			nattnums;
+		AttrNumber *attnums;
+		int			i;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+
+		/*
+		 * switch to memory context appropriate for multiple function
+		 * calls
+		 */
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		/* Construct the context to keep across calls. */
+		ctx = (gp_acquire_column_sketches_context *) palloc0(sizeof(gp_acquire_column_sketches_context));
+
+		if (!pg_class_ownercheck(relOid, GetUserId()))
+			aclcheck_error(ACLCHECK_NOT_OWNER, OBJECT_TABLE,
+						   get_rel_name(relOid));
+
+		onerel = table_open(relOid, AccessShareLock);
+
+		deconstruct_array(attnumArray, INT2OID, sizeof(int16), true,
+						  TYPALIGN_SHORT, &attnumDatums, NULL, &nattnums);
+		attnums = (AttrNumber *) palloc(Max(nattnums, 1) * sizeof(AttrNumber));
+		for (i = 0; i < nattnums; i++)
+			attnums[i] = DatumGetInt16(attnumDatums[i]);
+
+		/* The scan covers the rows appended so far, don't merge them again */
+		discard_appended_sketches(relOid);
+
+		ctx->nsketches = nattnums;
+		ctx->sketches = (ColumnSketch **) palloc(Max(nattnums, 1) * sizeof(ColumnSketch *));
+		build_column_sketches(onerel, nattnums, attnums, stattarget,
+							  ctx->sketches);
+
+		outDesc = column_sketches_tupdesc();
+		funcctx->tuple_desc = outDesc;
+
+		ctx->onerel = onerel;
+		funcctx->user_fctx = ctx;
+		ctx->outDesc = outDesc;
+		ctx->index = 0;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	/* stuff done on every call of the function */
+	funcctx = SRF_PERCALL_SETUP();
+
+	ctx = funcctx->user_fctx;
+	outDesc = ctx->outDesc;
+
+	if (ctx->index < ctx->nsketches)
+	{
+		HeapTuple	res;
+
+		sketch = ctx->sketches[ctx->index];
+		res = column_sketch_form_tuple(ctx, sketch);
+
+		ctx->index++;
+
+		SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(res));
+	}
+
+	table_close(ctx->onerel, AccessShareLock);
+
+	pfree(ctx);
+	funcctx->user_fctx = NULL;
+
+	SRF_RETURN_DONE(funcctx);
+}
+
+/*
+ * gp_acquire_appended_sketches - Return the sketches of the rows appended to
+ * an append-optimized table by the current transaction, see
+ * sketch_appended_rows().
+ *
+ * This is an internal function called in analyze_appended_rows(), by
+ * auto-stats with gp_autostats_incremental. It returns the same rows as
+ * gp_acquire_column_sketches(), and forgets the appended rows. A column that
+ * was not sketched has a NULL totalrows.
+ */
+Datum
+gp_acquire_appended_sketches(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx = NULL;
+	gp_acquire_column_sketches_context *ctx;
+	MemoryContext oldcontext;
+	Oid			relOid = PG_GETARG_OID(0);
+	ArrayType  *attnumArray = PG_GETARG_ARRAYTYPE_P(1);
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		Datum	   *attnumDatums;
+		int			nattnums;
+		AttrNumber *attnums;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+
+		/*
+		 * switch to memory context appropriate for multiple function
+		 * calls
+		 */
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		ctx = (gp_acquire_column_sketches_context *) palloc0(sizeof(gp_acquire_column_sketches_context));
+
+		if (!pg_class_ownercheck(relOid, GetUserId()))
+			aclcheck_error(ACLCHECK_NOT_OWNER, OBJECT_TABLE,
+						   get_rel_name(relOid));
+
+		ctx->onerel = table_open(relOid, AccessShareLock);
+
+		deconstruct_array(attnumArray, INT2OID, sizeof(int16), true,
+						  TYPALIGN_SHORT, &attnumDatums, NULL, &nattnums);
+		attnums = (AttrNumber *) palloc(Max(nattnums, 1) * sizeof(AttrNumber));
+		for (int i = 0; i < nattnums; i++)
+			attnums[i] = DatumGetInt16(attnumDatums[i]);
+
+		ctx->nsketches = nattnums;
+		ctx->sketches = (ColumnSketch **) palloc(Max(nattnums, 1) * sizeof(ColumnSketch *));
+		take_appended_sketches(ctx->onerel, nattnums, attnums, ctx->sketches);
+
+		ctx->outDesc = column_sketches_tupdesc();
+		funcctx->tuple_desc = ctx->outDesc;
+		funcctx->user_fctx = ctx;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	/* stuff done on every call of the function */
+	funcctx = SRF_PERCALL_SETUP();
+
+	ctx = funcctx->user_fctx;
+
+	if (ctx->index < ctx->nsketches)
+	{
+		HeapTuple	res;
+
+		res = column_sketch_form_tuple(ctx, ctx->sketches[ctx->index]);
+		ctx->index++;
+
+		SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(res));
+	}
+
+	table_close(ctx->onerel, AccessShareLock);
+
+	pfree(ctx);
+	funcctx->user_fctx = NULL;
+
+	SRF_RETURN_DONE(funcctx);
+}
@@ -0,0 +1,1099 @@
+/*-------------------------------------------------------------------------
+ *
+ * analyzesketch.c
+ *	  Build column sketches for ANALYZE on a segment.
+ *
+ * Instead of sending a sample of its rows to the dispatcher, each segment
+ * can scan all of its rows, and summarize every column in sketches that
+ * are small, and that the dispatcher can merge:
+ *
+ * - a HyperLogLog counter, for the number of distinct values,
+ * - a Misra-Gries heavy hitters sketch, for the most common values,
+ * - a KLL quantiles sketch, for the histogram,
+ * - a reservoir sample of the rows, for the correlation, which depends on
+ *   the physical order of the rows, and cannot be merged.
+ *
+ * The memory used by the sketches of a column only depends on its
+ * statistics target, not on the number of rows.
+ *
+ * The same sketches can be built as the rows are appended to an
+ * append-optimized table, for auto-stats to merge them into the statistics
+ * of the table without scanning it again, see sketch_appended_rows().
+ *
+ * Portions Copyright (c) 2023, HashData Technology Limited.
+ *
+ * IDENTIFICATION
+ *	  src/backend/commands/analyzesketch.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <math.h>
+
+#include "access/detoast.h"
+#include "access/tableam.h"
+#include "access/xact.h"
+#include "cdb/cdbvars.h"
+#include "commands/analyzesketch.h"
+#include "commands/vacuum.h"
+#include "executor/tuptable.h"
+#include "parser/parse_oper.h"
+#include "utils/datum.h"
+#include "utils/hyperloglog/gp_hyperloglog.h"
+#include "utils/memutils.h"
+#include "utils/rel.h"
+#include "utils/sampling.h"
+#include "utils/snapmgr.h"
+#include "utils/sortsupport.h"
+
+/* An entry of the heavy hitters sketch */
+typedef struct HeavyHitter
+{
+	Datum		value;
+	double		count;
+	uint32		hash;
+	char		status;
+} HeavyHitter;
+
+#define SH_PREFIX heavyhitters
+#define SH_ELEMENT_TYPE HeavyHitter
+#define SH_KEY_TYPE Datum
+#define SH_SCOPE static inline
+#define SH_DECLARE
+#include "lib/simplehash.h"
+
+static uint32 heavy_hitter_hash(struct heavyhitters_hash *tb, Datum value);
+static bool heavy_hitter_equal(struct heavyhitters_hash *tb, Datum a, Datum b);
+
+#define SH_PREFIX heavyhitters
+#define SH_ELEMENT_TYPE HeavyHitter
+#define SH_KEY_TYPE Datum
+#define SH_KEY value
+#define SH_HASH_KEY(tb, key) heavy_hitter_hash(tb, key)
+#define SH_EQUAL(tb, a, b) heavy_hitter_equal(tb, a, b)
+#define SH_SCOPE static inline
+#define SH_STORE_HASH
+#define SH_GET_HASH(tb, a) a->hash
+#define SH_DEFINE
+#include "lib/simplehash.h"
+
+/* A value of the quantiles sketch, and the number of rows it stands for */
+typedef struct WeightedValue
+{
+	Datum		value;
+	double		weight;
+} WeightedValue;
+
+/* A value of the correlation sample, and its position in the scan */
+typedef struct CorrelationItem
+{
+	Datum		value;
+	double		rowno;
+	int			tupno;
+} CorrelationItem;
+
+/* The state of the sketches of a column during the scan */
+typedef struct SketchBuilder
+{
+	AttrNumber	attnum;
+	int16		typlen;
+	bool		typbyval;
+	char		typalign;
+	bool		is_varlena;
+	bool		is_varwidth;
+	SortSupportData ssup;
+	SamplerRandomState randstate;
+
+	double		nullrows;
+	double		toowiderows;
+	double		totalwidth;
+
+	GpHLLCounter hll;
+
+	/* Misra-Gries heavy hitters */
+	heavyhitters_hash *hh;
+	int			hhcapacity;
+	double		hherror;
+
+	/*
+	 * KLL quantiles sketch. The values of level h stand for 2^h rows each.
+	 * The top level holds up to k values, every level below it 2/3 of the
+	 * level above.
+	 */
+	int			k;
+	int			nlevels;
+	Datum	  **levels;
+	int		   *nitems;
+	int		   *nalloc;
+	int			size;
+	int			maxsize;
+	bool		hasminmax;
+	Datum		min;
+	Datum		max;
+
+	/* the correlation sample, shared slots with the other columns */
+	Datum	   *corrvalues;
+	bool	   *corrvalid;
+} SketchBuilder;
+
+static SketchBuilder *sketch_builder_create(Relation onerel, AttrNumber attnum,
+											int stattarget, int corrsize);
+static void sketch_builder_add(SketchBuilder *b, Datum value, bool isnull,
+							   int corrslot, MemoryContext row_context);
+static ColumnSketch *sketch_builder_finish(SketchBuilder *b, double totalrows,
+										   double *corrrownos, int ncorr,
+										   int maxpoints);
+static void heavy_hitters_add(SketchBuilder *b, Datum value);
+static void quantiles_add(SketchBuilder *b, Datum value);
+static void quantiles_grow(SketchBuilder *b);
+static void quantiles_compress(SketchBuilder *b);
+static void quantiles_compact(SketchBuilder *b, int level);
+static int	quantiles_capacity(SketchBuilder *b, int level);
+static void quantiles_append(SketchBuilder *b, int level, Datum value);
+static void quantiles_summarize(SketchBuilder *b, ColumnSketch *sketch,
+								int maxpoints);
+static void compute_sample_correlation(SketchBuilder *b, ColumnSketch *sketch,
+									   double *corrrownos, int ncorr);
+static int	compare_datums(const void *a, const void *b, void *arg);
+static int	compare_weighted_values(const void *a, const void *b, void *arg);
+static int	compare_correlation_rownos(const void *a, const void *b);
+static int	compare_correlation_values(const void *a, const void *b, void *arg);
+
+/* The sketches of a set of columns, fed one row at a time */
+struct ColumnSketchSet
+{
+	MemoryContext context;
+	MemoryContext row_context;
+	int			nattrs;
+	int			stattarget;
+	SketchBuilder **builders;
+	SamplerRandomState randstate;
+	int			corrsize;
+	double	   *corrrownos;
+	double		rowno;
+};
+
+/*
+ * The sketches of the rows appended to append-optimized tables by the
+ * current transaction, see sketch_appended_rows().
+ */
+typedef struct AppendedSketches
+{
+	Oid			relid;
+	bool		active;			/* an INSERT or COPY into it is running */
+	ColumnSketchSet *set;
+} AppendedSketches;
+
+static List *appended_sketches = NIL;
+
+/*
+ * The relations whose rows were changed by the current transaction without
+ * being sketched, so that no sketch describes all their appended rows.
+ */
+static List *appended_unsketched = NIL;
+static bool appended_callbacks_registered = false;
+
+static AppendedSketches *find_appended_sketches(Oid relid);
+static ColumnSketchSet *appended_sketches_begin(Relation rel);
+static void appended_sketches_forget(Oid relid);
+static void appended_sketches_xact_callback(XactEvent event, void *arg);
+static void appended_sketches_subxact_callback(SubXactEvent event,
+											   SubTransactionId mySubid,
+											   SubTransactionId parentSubid,
+											   void *arg);
+
+/*
+ * build_column_sketches() -- scan all the rows of a relation, and sketch the
+ * given columns.
+ *
+ * The sketches are allocated in the caller's memory context.
+ */
+void
+build_column_sketches(Relation onerel, int nattrs, AttrNumber *attnums,
+					  int stattarget, ColumnSketch **sketches)
+{
+	ColumnSketchSet *set;
+	TableScanDesc scan;
+	TupleTableSlot *slot;
+
+	set = column_sketches_begin(onerel, nattrs, attnums, stattarget);
+
+	slot = table_slot_create(onerel, NULL);
+	scan = table_beginscan(onerel, GetActiveSnapshot(), 0, NULL);
+	while (table_scan_getnextslot(scan, ForwardScanDirection, slot))
+	{
+		vacuum_delay_point();
+		column_sketches_add(set, slot);
+	}
+	table_endscan(scan);
+	ExecDropSingleTupleTableSlot(slot);
+
+	column_sketches_end(set, sketches);
+}
+
+/*
+ * column_sketches_begin() -- start sketching the given columns of a relation
+ *
+ * The state lives in a child of the current memory context, until
+ * column_sketches_end().
+ */
+ColumnSketchSet *
+column_sketches_begin(Relation onerel, int nattrs, AttrNumber *attnums,
+					  int stattarget)
+{
+	ColumnSketchSet *set;
+	MemoryContext sketch_context;
+	MemoryContext oldcontext;
+
+	sketch_context = AllocSetContextCreate(CurrentMemoryContext,
+										   "Column sketches",
+										   ALLOCSET_DEFAULT_SIZES);
+	oldcontext = MemoryContextSwitchTo(sketch_context);
+
+	set = (ColumnSketchSet *) palloc0(sizeof(ColumnSketchSet));
+	set->context = sketch_context;
+	set->row_context = AllocSetContextCreate(sketch_context,
+											 "Column sketches row",
+											 ALLOCSET_DEFAULT_SIZES);
+	set->nattrs = nattrs;
+	set->stattarget = stattarget;
+	set->corrsize = SKETCH_CORRELATION_FACTOR * stattarget;
+	set->builders = (SketchBuilder **) palloc(Max(nattrs, 1) * sizeof(SketchBuilder *));
+	for (int i = 0; i < nattrs; i++)
+		set->builders[i] = sketch_builder_create(onerel, attnums[i], stattarget,
+												 set->corrsize);
+	set->corrrownos = (double *) palloc(set->corrsize * sizeof(double));
+	sampler_random_init_state(random(), set->randstate);
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return set;
+}
+
+/*
+ * column_sketches_add() -- add a row to the sketches
+ */
+void
+column_sketches_add(ColumnSketchSet *set, TupleTableSlot *slot)
+{
+	MemoryContext oldcontext;
+	int			corrslot;
+
+	/*
+	 * Pick the rows of the correlation sample with Algorithm R: the first
+	 * corrsize rows fill the sample, and each row after them replaces a
+	 * random one with probability corrsize / (rowno + 1).
+	 */
+	if (set->rowno < set->corrsize)
+		corrslot = (int) set->rowno;
+	else
+	{
+		double		pos = floor(sampler_random_fract(set->randstate) * (set->rowno + 1));
+
+		corrslot = pos < set->corrsize ? (int) pos : -1;
+	}
+	if (corrslot >= 0)
+		set->corrrownos[corrslot] = set->rowno;
+
+	oldcontext = MemoryContextSwitchTo(set->context);
+	slot_getallattrs(slot);
+	for (int i = 0; i < set->nattrs; i++)
+	{
+		AttrNumber	attnum = set->builders[i]->attnum;
+
+		sketch_builder_add(set->builders[i],
+						   slot->tts_values[attnum - 1],
+						   slot->tts_isnull[attnum - 1],
+						   corrslot, set->row_context);
+	}
+	MemoryContextSwitchTo(oldcontext);
+	MemoryContextReset(set->row_context);
+	set->rowno++;
+}
+
+/*
+ * column_sketches_end() -- finish the sketches, and release the state
+ *
+ * The sketches are allocated in the caller's memory context.
+ */
+void
+column_sketches_end(ColumnSketchSet *set, ColumnSketch **sketches)
+{
+	for (int i = 0; i < set->nattrs; i++)
+		sketches[i] = sketch_builder_finish(set->builders[i], set->rowno,
+											set->corrrownos,
+											(int) Min(set->rowno, set->corrsize),
+											SKETCH_POINTS_FACTOR * set->stattarget);
+
+	MemoryContextDelete(set->context);
+}
+
+static AppendedSketches *
+find_appended_sketches(Oid relid)
+{
+	ListCell   *lc;
+
+	foreach(lc, appended_sketches)
+	{
+		AppendedSketches *entry = (AppendedSketches *) lfirst(lc);
+
+		if (entry->relid == relid)
+			return entry;
+	}
+
+	return NULL;
+}
+
+/*
+ * Start sketching the columns of a relation that can be sorted, in the
+ * current memory context.
+ */
+static ColumnSketchSet *
+appended_sketches_begin(Relation rel)
+{
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	AttrNumber *attnums;
+	int			nattrs = 0;
+	int			stattarget = 0;
+
+	attnums = (AttrNumber *) palloc(Max(tupdesc->natts, 1) * sizeof(AttrNumber));
+	for (int i = 0; i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute attr = TupleDescAttr(tupdesc, i);
+		Oid			ltopr;
+		int			target;
+
+		if (attr->attisdropped || attr->attstattarget == 0)
+			continue;
+		get_sort_group_operators(attr->atttypid, false, false, false,
+								 &ltopr, NULL, NULL, NULL);
+		if (!OidIsValid(ltopr))
+			continue;
+
+		target = attr->attstattarget < 0 ? default_statistics_target :
+			attr->attstattarget;
+		stattarget = Max(stattarget, target);
+		attnums[nattrs++] = attr->attnum;
+	}
+
+	return column_sketches_begin(rel, nattrs, attnums, Max(stattarget, 1));
+}
+
+/* Drop the sketches of the rows appended to a relation */
+static void
+appended_sketches_forget(Oid relid)
+{
+	AppendedSketches *entry = find_appended_sketches(relid);
+
+	if (entry != NULL)
+	{
+		MemoryContextDelete(entry->set->context);
+		appended_sketches = list_delete_ptr(appended_sketches, entry);
+		pfree(entry);
+	}
+}
+
+/*
+ * appended_rows_begin() -- called by a QE writer when a DML command on an
+ * append-optimized table starts
+ *
+ * With gp_autostats_incremental, the segments sketch the rows as they are
+ * inserted, so that auto-stats can merge them into the statistics of the
+ * table, see analyze_appended_rows(), rather than analyzing it again. Only
+ * the on_change policy can merge them: on_no_stats fires for tables without
+ * statistics, which are analyzed in full.
+ *
+ * The sketches are created here, so that a segment that gets no rows still
+ * has an empty sketch. Any other change to the rows, and an INSERT or COPY
+ * while the sketches are off, leaves the relation without a sketch of all
+ * its appended rows until the end of the transaction.
+ */
+void
+appended_rows_begin(Relation rel, CmdType operation)
+{
+	Oid			relid = RelationGetRelid(rel);
+	MemoryContext oldcontext;
+
+	if (Gp_role != GP_ROLE_EXECUTE)
+		return;
+
+	if (!appended_callbacks_registered)
+	{
+		RegisterXactCallback(appended_sketches_xact_callback, NULL);
+		RegisterSubXactCallback(appended_sketches_subxact_callback, NULL);
+		appended_callbacks_registered = true;
+	}
+
+	if (list_member_oid(appended_unsketched, relid))
+		return;
+
+	oldcontext = MemoryContextSwitchTo(TopTransactionContext);
+	if (operation == CMD_INSERT && appended_rows_sketched())
+	{
+		AppendedSketches *entry = find_appended_sketches(relid);
+
+		if (entry == NULL)
+		{
+			entry = (AppendedSketches *) palloc(sizeof(AppendedSketches));
+			entry->relid = relid;
+			entry->set = appended_sketches_begin(rel);
+			appended_sketches = lappend(appended_sketches, entry);
+		}
+		entry->active = true;
+	}
+	else
+	{
+		appended_sketches_forget(relid);
+		appended_unsketched = lappend_oid(appended_unsketched, relid);
+	}
+	MemoryContextSwitchTo(oldcontext);
+}
+
+/*
+ * appended_rows_end() -- called when the DML command ends
+ */
+void
+appended_rows_end(Relation rel)
+{
+	AppendedSketches *entry = find_appended_sketches(RelationGetRelid(rel));
+
+	if (entry != NULL)
+		entry->active = false;
+}
+
+/*
+ * sketch_appended_rows() -- add rows appended to an append-optimized table
+ * to the sketches of the current transaction
+ *
+ * Only the rows of the INSERT or COPY that appended_rows_begin() saw start
+ * are sketched, not the ones a table rewrite copies. The sketches last until
+ * they are taken by take_appended_sketches() or the transaction ends.
+ */
+void
+sketch_appended_rows(Relation rel, TupleTableSlot **slots, int nslots)
+{
+	AppendedSketches *entry = find_appended_sketches(RelationGetRelid(rel));
+
+	if (entry == NULL || !entry->active)
+		return;
+
+	for (int i = 0; i < nslots; i++)
+		column_sketches_add(entry->set, slots[i]);
+}
+
+/*
+ * take_appended_sketches() -- finish the sketches of the rows appended to a
+ * relation by the current transaction
+ *
+ * Fills in a sketch for each of the given columns, and forgets the rows. The
+ * sketches are empty if no row was appended here. If the rows were changed
+ * without being sketched, or if the column was not sketched, the sketch has
+ * a negative totalrows.
+ */
+void
+take_appended_sketches(Relation rel, int nattrs, AttrNumber *attnums,
+					   ColumnSketch **sketches)
+{
+	Oid			relid = RelationGetRelid(rel);
+	AppendedSketches *entry = find_appended_sketches(relid);
+	ColumnSketchSet *set = NULL;
+	ColumnSketch **all = NULL;
+	int			nall = 0;
+
+	if (entry != NULL)
+	{
+		set = entry->set;
+		appended_sketches = list_delete_ptr(appended_sketches, entry);
+		pfree(entry);
+	}
+	else if (!list_member_oid(appended_unsketched, relid))
+		set = appended_sketches_begin(rel);
+
+	if (set != NULL)
+	{
+		nall = set->nattrs;
+		all = (ColumnSketch **) palloc(Max(nall, 1) * sizeof(ColumnSketch *));
+		column_sketches_end(set, all);
+	}
+
+	for (int i = 0; i < nattrs; i++)
+	{
+		ColumnSketch *sketch = NULL;
+
+		for (int j = 0; j < nall; j++)
+		{
+			if (all[j]->attnum == attnums[i])
+				sketch = all[j];
+		}
+		if (sketch == NULL)
+		{
+			sketch = (ColumnSketch *) palloc0(sizeof(ColumnSketch));
+			sketch->attnum = attnums[i];
+			sketch->corrnull = true;
+			sketch->totalrows = -1;
+		}
+		sketches[i] = sketch;
+	}
+}
+
+/*
+ * discard_appended_sketches() -- forget the rows appended to a relation by
+ * the current transaction, once ANALYZE has scanned them.
+ */
+void
+discard_appended_sketches(Oid relid)
+{
+	appended_sketches_forget(relid);
+	appended_unsketched = list_delete_oid(appended_unsketched, relid);
+}
+
+/*
+ * The sketches of the appended rows only describe the rows of the current
+ * transaction. Forget them when it ends. When a subtransaction aborts, some
+ * of the rows are gone, and the sketches no longer describe the others.
+ */
+static void
+appended_sketches_xact_callback(XactEvent event, void *arg)
+{
+	switch (event)
+	{
+		case XACT_EVENT_COMMIT:
+		case XACT_EVENT_PARALLEL_COMMIT:
+		case XACT_EVENT_ABORT:
+		case XACT_EVENT_PARALLEL_ABORT:
+		case XACT_EVENT_PREPARE:
+			/* The memory goes away with TopTransactionContext */
+			appended_sketches = NIL;
+			appended_unsketched = NIL;
+			break;
+		default:
+			break;
+	}
+}
+
+static void
+appended_sketches_subxact_callback(SubXactEvent event,
+								   SubTransactionId mySubid,
+								   SubTransactionId parentSubid,
+								   void *arg)
+{
+	MemoryContext oldcontext;
+	ListCell   *lc;
+
+	if (event != SUBXACT_EVENT_ABORT_SUB)
+		return;
+
+	oldcontext = MemoryContextSwitchTo(TopTransactionContext);
+	foreach(lc, appended_sketches)
+	{
+		AppendedSketches *entry = (AppendedSketches *) lfirst(lc);
+
+		MemoryContextDelete(entry->set->context);
+		appended_unsketched = lappend_oid(appended_unsketched, entry->relid);
+	}
+	MemoryContextSwitchTo(oldcontext);
+
+	list_free_deep(appended_sketches);
+	appended_sketches = NIL;
+}
+
+static SketchBuilder *
+sketch_builder_create(Relation onerel, AttrNumber attnum, int stattarget,
+					  int corrsize)
+{
+	SketchBuilder *b;
+	Form_pg_attribute attr;
+	Oid			ltopr;
+
+	if (attnum < 1 || attnum > RelationGetNumberOfAttributes(onerel))
+		elog(ERROR, "invalid attribute number %d", attnum);
+	attr = TupleDescAttr(RelationGetDescr(onerel), attnum - 1);
+	if (attr->attisdropped)
+		elog(ERROR, "cannot sketch dropped column %d", attnum);
+
+	get_sort_group_operators(attr->atttypid,
+							 true, false, false,
+							 &ltopr, NULL, NULL,
+							 NULL);
+
+	b = (SketchBuilder *) palloc0(sizeof(SketchBuilder));
+	b->attnum = attnum;
+	b->typlen = attr->attlen;
+	b->typbyval = attr->attbyval;
+	b->typalign = attr->attalign;
+	b->is_varlena = !attr->attbyval && attr->attlen == -1;
+	b->is_varwidth = !attr->attbyval && attr->attlen < 0;
+
+	b->ssup.ssup_cxt = CurrentMemoryContext;
+	b->ssup.ssup_collation = attr->attcollation;
+	b->ssup.ssup_nulls_first = false;
+	b->ssup.abbreviate = false;
+	PrepareSortSupportFromOrderingOp(ltopr, &b->ssup);
+	sampler_random_init_state(random(), b->randstate);
+
+	b->hll = gp_hyperloglog_init_def();
+
+	b->hhcapacity = SKETCH_HEAVY_HITTERS_FACTOR * stattarget;
+	b->hh = heavyhitters_create(CurrentMemoryContext, b->hhcapacity, b);
+
+	b->k = SKETCH_QUANTILES_FACTOR * stattarget;
+	quantiles_grow(b);
+
+	b->corrvalues = (Datum *) palloc(corrsize * sizeof(Datum));
+	b->corrvalid = (bool *) palloc0(corrsize * sizeof(bool));
+
+	return b;
+}
+
+static void
+sketch_builder_add(SketchBuilder *b, Datum value, bool isnull, int corrslot,
+				   MemoryContext row_context)
+{
+	/* The row replaces another one in the correlation sample */
+	if (corrslot >= 0 && b->corrvalid[corrslot])
+	{
+		if (!b->typbyval)
+			pfree(DatumGetPointer(b->corrvalues[corrslot]));
+		b->corrvalid[corrslot] = false;
+	}
+
+	if (isnull)
+	{
+		b->nullrows++;
+		return;
+	}
+
+	/*
+	 * Like compute_scalar_stats(), count the toasted width, and leave out
+	 * the values that are too wide.
+	 */
+	if (b->is_varlena)
+	{
+		MemoryContext oldcontext;
+
+		b->totalwidth += VARSIZE_ANY(DatumGetPointer(value));
+		if (toast_raw_datum_size(value) > WIDTH_THRESHOLD)
+		{
+			b->toowiderows++;
+			return;
+		}
+		oldcontext = MemoryContextSwitchTo(row_context);
+		value = PointerGetDatum(PG_DETOAST_DATUM(value));
+		MemoryContextSwitchTo(oldcontext);
+	}
+	else if (b->is_varwidth)
+		b->totalwidth += strlen(DatumGetCString(value)) + 1;
+	else
+		b->totalwidth += b->typlen;
+
+	b->hll = gp_hyperloglog_add_item(b->hll, value, b->typlen, b->typbyval,
+									 b->typalign);
+	heavy_hitters_add(b, value);
+	quantiles_add(b, value);
+
+	if (!b->hasminmax)
+	{
+		b->min = datumCopy(value, b->typbyval, b->typlen);
+		b->max = datumCopy(value, b->typbyval, b->typlen);
+		b->hasminmax = true;
+	}
+	else if (ApplySortComparator(value, false, b->min, false, &b->ssup) < 0)
+	{
+		if (!b->typbyval)
+			pfree(DatumGetPointer(b->min));
+		b->min = datumCopy(value, b->typbyval, b->typlen);
+	}
+	else if (ApplySortComparator(value, false, b->max, false, &b->ssup) > 0)
+	{
+		if (!b->typbyval)
+			pfree(DatumGetPointer(b->max));
+		b->max = datumCopy(value, b->typbyval, b->typlen);
+	}
+
+	if (corrslot >= 0)
+	{
+		b->corrvalues[corrslot] = datumCopy(value, b->typbyval, b->typlen);
+		b->corrvalid[corrslot] = true;
+	}
+}
+
+static ColumnSketch *
+sketch_builder_finish(SketchBuilder *b, double totalrows, double *corrrownos,
+					  int ncorr, int maxpoints)
+{
+	ColumnSketch *sketch;
+	heavyhitters_iterator iter;
+	HeavyHitter *entry;
+
+	sketch = (ColumnSketch *) palloc0(sizeof(ColumnSketch));
+	sketch->attnum = b->attnum;
+	sketch->totalrows = totalrows;
+	sketch->nullrows = b->nullrows;
+	sketch->toowiderows = b->toowiderows;
+	sketch->totalwidth = b->totalwidth;
+	sketch->hll = (bytea *) gp_hll_compress(gp_hll_copy(b->hll));
+
+	sketch->mcvs = (Datum *) palloc(Max(b->hh->members, 1) * sizeof(Datum));
+	sketch->mcvcounts = (double *) palloc(Max(b->hh->members, 1) * sizeof(double));
+	heavyhitters_start_iterate(b->hh, &iter);
+	while ((entry = heavyhitters_iterate(b->hh, &iter)) != NULL)
+	{
+		sketch->mcvs[sketch->nmcvs] = datumCopy(entry->value, b->typbyval,
+												b->typlen);
+		sketch->mcvcounts[sketch->nmcvs] = entry->count;
+		sketch->nmcvs++;
+	}
+	sketch->mcverror = b->hherror;
+
+	quantiles_summarize(b, sketch, maxpoints);
+	compute_sample_correlation(b, sketch, corrrownos, ncorr);
+
+	return sketch;
+}
+
+static uint32
+heavy_hitter_hash(struct heavyhitters_hash *tb, Datum value)
+{
+	SketchBuilder *b = (SketchBuilder *) tb->private_data;
+
+	return datum_image_hash(value, b->typbyval, b->typlen);
+}
+
+static bool
+heavy_hitter_equal(struct heavyhitters_hash *tb, Datum a, Datum b)
+{
+	SketchBuilder *builder = (SketchBuilder *) tb->private_data;
+
+	return datum_image_eq(a, b, builder->typbyval, builder->typlen);
+}
+
+/*
+ * Count a value in the Misra-Gries sketch. When there is no counter left for
+ * a new value, all the counters are decremented instead, which discounts
+ * the new value and one occurrence of every tracked one. That can happen at
+ * most n / (capacity + 1) times, so no count is more than that too low, and
+ * the decrements cost O(1) per value on average.
+ *
+ * Values are compared by their binary image, which is fine for a sketch: the
+ * dispatcher merges the values that are equal but differ in their images.
+ */
+static void
+heavy_hitters_add(SketchBuilder *b, Datum value)
+{
+	HeavyHitter *entry;
+	heavyhitters_iterator iter;
+	bool		found;
+
+	entry = heavyhitters_lookup(b->hh, value);
+	if (entry != NULL)
+	{
+		entry->count++;
+		return;
+	}
+
+	if (b->hh->members < b->hhcapacity)
+	{
+		entry = heavyhitters_insert(b->hh,
+									datumCopy(value, b->typbyval, b->typlen),
+									&found);
+		Assert(!found);
+		entry->count = 1;
+		return;
+	}
+
+	heavyhitters_start_iterate(b->hh, &iter);
+	while ((entry = heavyhitters_iterate(b->hh, &iter)) != NULL)
+	{
+		if (--entry->count <= 0)
+		{
+			Datum		old = entry->value;
+
+			heavyhitters_delete_item(b->hh, entry);
+			if (!b->typbyval)
+				pfree(DatumGetPointer(old));
+		}
+	}
+	b->hherror++;
+}
+
+static void
+quantiles_add(SketchBuilder *b, Datum value)
+{
+	quantiles_append(b, 0, datumCopy(value, b->typbyval, b->typlen));
+	b->size++;
+	if (b->size >= b->maxsize)
+		quantiles_compress(b);
+}
+
+static int
+quantiles_capacity(SketchBuilder *b, int level)
+{
+	int			depth = b->nlevels - level - 1;
+
+	return Max(2, (int) ceil(b->k * pow(2.0 / 3.0, depth)));
+}
+
+static void
+quantiles_grow(SketchBuilder *b)
+{
+	int			level;
+
+	if (b->nlevels == 0)
+	{
+		b->levels = (Datum **) palloc(sizeof(Datum *));
+		b->nitems = (int *) palloc(sizeof(int));
+		b->nalloc = (int *) palloc(sizeof(int));
+	}
+	else
+	{
+		b->levels = (Datum **) repalloc(b->levels, (b->nlevels + 1) * sizeof(Datum *));
+		b->nitems = (int *) repalloc(b->nitems, (b->nlevels + 1) * sizeof(int));
+		b->nalloc = (int *) repalloc(b->nalloc, (b->nlevels + 1) * sizeof(int));
+	}
+	b->nalloc[b->nlevels] = 64;
+	b->levels[b->nlevels] = (Datum *) palloc(64 * sizeof(Datum));
+	b->nitems[b->nlevels] = 0;
+	b->nlevels++;
+
+	b->maxsize = 0;
+	for (level = 0; level < b->nlevels; level++)
+		b->maxsize += quantiles_capacity(b, level);
+}
+
+static void
+quantiles_append(SketchBuilder *b, int level, Datum value)
+{
+	if (b->nitems[level] >= b->nalloc[level])
+	{
+		b->nalloc[level] *= 2;
+		b->levels[level] = (Datum *) repalloc(b->levels[level],
+											  b->nalloc[level] * sizeof(Datum));
+	}
+	b->levels[level][b->nitems[level]++] = value;
+}
+
+/*
+ * Compact the lowest full levels, until the sketch is below its maximum
+ * size again.
+ */
+static void
+quantiles_compress(SketchBuilder *b)
+{
+	int			level;
+
+	for (level = 0; level < b->nlevels; level++)
+	{
+		if (b->nitems[level] >= quantiles_capacity(b, level))
+		{
+			if (level + 1 >= b->nlevels)
+				quantiles_grow(b);
+			quantiles_compact(b, level);
+			if (b->size < b->maxsize)
+				break;
+		}
+	}
+}
+
+/*
+ * Sort a level, and promote every other value to the level above, starting
+ * from the first or the second one at random. When the number of values is
+ * odd, the smallest one stays.
+ */
+static void
+quantiles_compact(SketchBuilder *b, int level)
+{
+	Datum	   *items = b->levels[level];
+	int			nitems = b->nitems[level];
+	int			first = nitems % 2;
+	int			npairs = nitems / 2;
+	int			offset;
+	int			i;
+
+	qsort_arg(items, nitems, sizeof(Datum), compare_datums, &b->ssup);
+	offset = sampler_random_fract(b->randstate) < 0.5 ? 0 : 1;
+
+	for (i = 0; i < npairs; i++)
+	{
+		Datum		keep = items[first + 2 * i + offset];
+		Datum		drop = items[first + 2 * i + 1 - offset];
+
+		quantiles_append(b, level + 1, keep);
+		if (!b->typbyval)
+			pfree(DatumGetPointer(drop));
+	}
+	b->nitems[level] = first;
+	b->size -= npairs;
+}
+
+/*
+ * Summarize the quantiles sketch in at most maxpoints values, taken at evenly
+ * spaced ranks. The minimum and the maximum are always kept, the sketch may
+ * have compacted them away.
+ */
+static void
+quantiles_summarize(SketchBuilder *b, ColumnSketch *sketch, int maxpoints)
+{
+	WeightedValue *items;
+	int			nitems = 0;
+	int			level;
+	int			i;
+
+	for (level = 0; level < b->nlevels; level++)
+		nitems += b->nitems[level];
+	if (nitems == 0)
+		return;
+
+	items = (WeightedValue *) palloc(nitems * sizeof(WeightedValue));
+	nitems = 0;
+	for (level = 0; level < b->nlevels; level++)
+	{
+		double		weight = ldexp(1.0, level);
+
+		for (i = 0; i < b->nitems[level]; i++)
+		{
+			items[nitems].value = b->levels[level][i];
+			items[nitems].weight = weight;
+			nitems++;
+		}
+	}
+	qsort_arg(items, nitems, sizeof(WeightedValue), compare_weighted_values,
+			  &b->ssup);
+
+	if (nitems <= maxpoints)
+	{
+		sketch->npoints = nitems;
+		sketch->points = (Datum *) palloc(nitems * sizeof(Datum));
+		sketch->pointweights = (double *) palloc(nitems * sizeof(double));
+		for (i = 0; i < nitems; i++)
+		{
+			sketch->points[i] = items[i].value;
+			sketch->pointweights[i] = items[i].weight;
+		}
+	}
+	else
+	{
+		double		totalweight = 0;
+		double		step;
+		double		cumweight = 0;
+		int			j = 0;
+
+		for (i = 0; i < nitems; i++)
+			totalweight += items[i].weight;
+		step = totalweight / maxpoints;
+
+		sketch->npoints = maxpoints;
+		sketch->points = (Datum *) palloc(maxpoints * sizeof(Datum));
+		sketch->pointweights = (double *) palloc(maxpoints * sizeof(double));
+		for (i = 0; i < maxpoints; i++)
+		{
+			double		rank = (i + 0.5) * step;
+
+			while (j < nitems - 1 && cumweight + items[j].weight <= rank)
+				cumweight += items[j++].weight;
+			sketch->points[i] = items[j].value;
+			sketch->pointweights[i] = step;
+		}
+	}
+
+	sketch->points[0] = b->min;
+	sketch->points[sketch->npoints - 1] = b->max;
+	for (i = 0; i < sketch->npoints; i++)
+		sketch->points[i] = datumCopy(sketch->points[i], b->typbyval, b->typlen);
+
+	pfree(items);
+}
+
+/*
+ * Compute the correlation between the physical order and the logical order
+ * of the values in the correlation sample, the same way as
+ * compute_scalar_stats() does for the sample rows.
+ */
+static void
+compute_sample_correlation(SketchBuilder *b, ColumnSketch *sketch,
+						   double *corrrownos, int ncorr)
+{
+	CorrelationItem *items;
+	int			nitems = 0;
+	double		corr_xysum = 0;
+	double		corr_xsum;
+	double		corr_x2sum;
+	int			i;
+
+	sketch->corrnull = true;
+	if (ncorr < 2)
+		return;
+
+	items = (CorrelationItem *) palloc(ncorr * sizeof(CorrelationItem));
+	for (i = 0; i < ncorr; i++)
+	{
+		if (!b->corrvalid[i])
+			continue;
+		items[nitems].value = b->corrvalues[i];
+		items[nitems].rowno = corrrownos[i];
+		nitems++;
+	}
+	if (nitems < 2)
+	{
+		pfree(items);
+		return;
+	}
+
+	qsort(items, nitems, sizeof(CorrelationItem), compare_correlation_rownos);
+	for (i = 0; i < nitems; i++)
+		items[i].tupno = i;
+	qsort_arg(items, nitems, sizeof(CorrelationItem),
+			  compare_correlation_values, &b->ssup);
+	for (i = 0; i < nitems; i++)
+		corr_xysum += ((double) i) * ((double) items[i].tupno);
+
+	corr_xsum = ((double) (nitems - 1)) * ((double) nitems) / 2.0;
+	corr_x2sum = ((double) (nitems - 1)) * ((double) nitems) *
+		(double) (2 * nitems - 1) / 6.0;
+	sketch->correlation = (nitems * corr_xysum - corr_xsum * corr_xsum) /
+		(nitems * corr_x2sum - corr_xsum * corr_xsum);
+	sketch->corrnull = false;
+
+	pfree(items);
+}
+
+static int
+compare_datums(const void *a, const void *b, void *arg)
+{
+	return ApplySortComparator(*(const Datum *) a, false,
+							   *(const Datum *) b, false,
+							   (SortSupport) arg);
+}
+
+static int
+compare_weighted_values(const void *a, const void *b, void *arg)
+{
+	return ApplySortComparator(((const WeightedValue *) a)->value, false,
+							   ((const WeightedValue *) b)->value, false,
+							   (SortSupport) arg);
+}
+
+static int
+compare_correlation_rownos(const void *a, const void *b)
+{
+	double		ra = ((const CorrelationItem *) a)->rowno;
+	double		rb = ((const CorrelationItem *) b)->rowno;
+
+	return (ra > rb) - (ra < rb);
+}
+
+static int
+compare_correlation_values(const void *a, const void *b, void *arg)
+{
+	const CorrelationItem *ia = (const CorrelationItem *) a;
+	const CorrelationItem *ib = (const CorrelationItem *) b;
+	int			compare;
+
+	compare = ApplySortComparator(ia->value, false, ib->value, false,
+								  (SortSupport) arg);
+	if (compare != 0)
+		return compare;
+
+	/* like compare_scalars(), keep equal values in physical order */
+	return ia->tupno - ib->tupno;
+}
@@ -245,11 +245,8 @@
  */
 
 /*
- * GPDB_12_MERGE_FIXME: we lost the "streaming bottom" feature in the merge.
- *
- * And the detailed cdb executor instruments to print by explain.
- *
- * They were in execHHashagg.c
+ * GPDB_12_MERGE_FIXME: we lost the detailed cdb executor instruments to
+ * print by explain in the merge. They were in execHHashagg.c
  */
 
 #include "postgres.h"
@@ -284,6 +281,7 @@
 #include "utils/tuplesort.h"
 
 #include "cdb/cdbexplain.h"
+#include "cdb/cdbvars.h"
 #include "lib/stringinfo.h"             /* StringInfo */
 #include "optimizer/walkers.h"
 
@@ -325,6 +323,17 @@
  */
 #define HASHAGG_HLL_BIT_WIDTH 5
 
+/*
+ * GPDB: a streaming hash aggregate, see hash_agg_stream_restart(), considers
+ * its input poorly reduced if it has more groups than this fraction of its
+ * input tuples.  It checks that every HASHAGG_STREAM_PROBE_TUPLES input
+ * tuples, and when the input is poorly reduced, emits the table whenever it
+ * reaches HASHAGG_STREAM_SMALL_NGROUPS groups, so that it stays in cache.
+ */
+#define HASHAGG_STREAM_POOR_REDUCTION 0.9
+#define HASHAGG_STREAM_PROBE_TUPLES 65536
+#define HASHAGG_STREAM_SMALL_NGROUPS 4096
+
 /*
  * Estimate chunk overhead as a constant 16 bytes. XXX: should this be
  * improved?
@@ -458,6 +467,8 @@ static bool agg_refill_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table_in_memory(AggState *aggstate);
 static void hash_agg_check_limits(AggState *aggstate);
+static void hash_agg_stream_restart(AggState *aggstate);
+static void ExecAggExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 static void hash_agg_enter_spill_mode(AggState *aggstate);
 static void hash_agg_update_metrics(AggState *aggstate, bool from_tape,
 									int npartitions);
@@ -1926,6 +1937,19 @@ hash_agg_check_limits(AggState *aggstate)
 	Size		hashkey_mem = MemoryContextMemAllocated(aggstate->hashcontext->ecxt_per_tuple_memory,
 														true);
 
+	/*
+	 * A streaming aggregate never spills; when the table is full, it is
+	 * emitted before reading more input.
+	 */
+	if (aggstate->hash_streaming)
+	{
+		if (meta_mem + hashkey_mem > aggstate->hash_mem_limit ||
+			ngroups > aggstate->hash_ngroups_limit ||
+			(aggstate->hash_stream_small && ngroups >= HASHAGG_STREAM_SMALL_NGROUPS))
+			aggstate->hash_stream_pending = true;
+		return;
+	}
+
 	/*
 	 * Don't spill unless there's at least one group in the hash table so we
 	 * can be sure to make progress even in edge cases.
@@ -1938,6 +1962,37 @@ hash_agg_check_limits(AggState *aggstate)
 	}
 }
 
+/*
+ * GPDB: the groups of a streaming aggregate have all been emitted, reset the
+ * hash tables and continue reading the input.
+ *
+ * The rows emitted are only partially aggregated, and the aggregate above
+ * combines them again, so emitting a group more than once is harmless.  If
+ * the table holds almost as many groups as it was fed tuples, we might as
+ * well pass the input through quickly: keep the table small from now on.
+ */
+static void
+hash_agg_stream_restart(AggState *aggstate)
+{
+	Assert(aggstate->hash_streaming && aggstate->hash_stream_pending);
+
+	aggstate->hash_stream_small =
+		aggstate->hash_ngroups_current >
+		aggstate->hash_stream_ntuples * HASHAGG_STREAM_POOR_REDUCTION;
+
+	/* free memory and reset hash tables */
+	ReScanExprContext(aggstate->hashcontext);
+	for (int setno = 0; setno < aggstate->num_hashes; setno++)
+		ResetTupleHashTable(aggstate->perhash[setno].hashtable);
+
+	aggstate->hash_ngroups_current = 0;
+	aggstate->hash_stream_ntuples = 0;
+	aggstate->hash_stream_pending = false;
+	aggstate->hash_stream_passes++;
+
+	agg_fill_hash_table(aggstate);
+}
+
 /*
  * Enter "spill mode", meaning that no new groups are added to any of the hash
  * tables. Tuples that would create a new group are instead spilled, and
@@ -2667,6 +2722,24 @@ agg_fill_hash_table(AggState *aggstate)
 		 * hash lookups do this too
 		 */
 		ResetExprContext(aggstate->tmpcontext);
+
+		/*
+		 * GPDB: a streaming aggregate stops reading when the table is full,
+		 * or when it sees it is not reducing its input, to emit what it has.
+		 */
+		if (aggstate->hash_streaming)
+		{
+			aggstate->hash_stream_ntuples++;
+
+			if (!aggstate->hash_stream_small &&
+				aggstate->hash_stream_ntuples % HASHAGG_STREAM_PROBE_TUPLES == 0 &&
+				aggstate->hash_ngroups_current >
+				aggstate->hash_stream_ntuples * HASHAGG_STREAM_POOR_REDUCTION)
+				aggstate->hash_stream_pending = true;
+
+			if (aggstate->hash_stream_pending)
+				break;
+		}
 	}
 
 	/* finalize spills, if any */
@@ -2853,6 +2926,13 @@ agg_retrieve_hash_table(AggState *aggstate)
 		result = agg_retrieve_hash_table_in_memory(aggstate);
 		if (result == NULL)
 		{
+			/* GPDB: a streaming aggregate may have more input to read */
+			if (aggstate->hash_stream_pending)
+			{
+				hash_agg_stream_restart(aggstate);
+				continue;
+			}
+
 			if (!agg_refill_hash_table(aggstate))
 			{
 				aggstate->agg_done = true;
@@ -3347,6 +3427,21 @@ hashagg_reset_spill_state(AggState *aggstate)
 }
 
 
+/*
+ * CDB: tell EXPLAIN ANALYZE if a streaming aggregate emitted its groups
+ * before the end of its input.
+ */
+static void
+ExecAggExplainEnd(PlanState *planstate, struct StringInfoData *buf)
+{
+	AggState   *aggstate = (AggState *) planstate;
+
+	if (aggstate->hash_stream_passes > 0)
+		appendStringInfo(buf, "Streamed: hash table emitted %d times before end of input%s",
+						 aggstate->hash_stream_passes,
+						 aggstate->hash_stream_small ? ", input not reduced" : "");
+}
+
 /* -----------------
  * ExecInitAgg
  *
@@ -3545,6 +3640,9 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
     {
         /* Allocate string buffer. */
         aggstate->ss.ps.cdbexplainbuf = makeStringInfo();
+
+        /* Request a callback at end of query. */
+        aggstate->ss.ps.cdbexplainfun = ExecAggExplainEnd;
     }
 
 	/*
@@ -3839,6 +3937,16 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 
 		/* Initialize this to 1, meaning nothing spilled, yet */
 		aggstate->hash_batches_used = 1;
+
+		/*
+		 * GPDB: the output of a partial aggregate is combined again above
+		 * it, and the planner marks the deduplicating Aggs of DISTINCT
+		 * aggregates as streaming, so those can emit their groups early
+		 * instead of spilling them.
+		 */
+		aggstate->hash_streaming = gp_hashagg_streambottom &&
+			aggstate->aggstrategy == AGG_HASHED &&
+			(node->streaming || DO_AGGSPLIT_SKIPFINAL(node->aggsplit));
 	}
 
 	/*
@@ -4687,6 +4795,9 @@ ExecReScanAgg(AggState *node)
 		node->hash_ever_spilled = false;
 		node->hash_spill_mode = false;
 		node->hash_ngroups_current = 0;
+		node->hash_stream_pending = false;
+		node->hash_stream_small = false;
+		node->hash_stream_ntuples = 0;
 
 		ReScanExprContext(node->hashcontext);
 		/* Rebuild an empty hash table */
@@ -5081,6 +5192,8 @@ ReuseHashTable(AggState *node)
 {
 	PlanState  *outerPlan = outerPlanState(node);
 	Agg     *aggnode = (Agg *) node->ss.ps.plan;
+	/* a streaming aggregate's table only holds the groups emitted last */
 	return (outerPlan->chgParam == NULL && !node->hash_ever_spilled &&
+			node->hash_stream_passes == 0 && !node->hash_stream_pending &&
 			!bms_overlap(node->ss.ps.chgParam, aggnode->aggParams));
 }
@@ -60,6 +60,9 @@ static uint32 evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash *h);
 
 static void doSendEndOfStream(Motion *motion, MotionState *node);
 static void doSendTuple(Motion *motion, MotionState *node, TupleTableSlot *outerTupleSlot);
+static void doSendTupleBatch(Motion *motion, MotionState *node);
+static int16 evalHashRoute(ExprContext *econtext, MotionState *node);
+static void ExecMotionExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 
 
 /*=========================================================================
@@ -251,7 +254,10 @@ execMotionSender(MotionState *node)
 
 		if (done || TupIsNull(outerTupleSlot))
 		{
-			doSendEndOfStream(motion, node);
+			if (node->numBatchedTuples > 0)
+				doSendTupleBatch(motion, node);
+			if (!node->stopRequested)
+				doSendEndOfStream(motion, node);
 			done = true;
 		}
 		else if (motion->motionType == MOTIONTYPE_GATHER_SINGLE &&
@@ -265,7 +271,21 @@ execMotionSender(MotionState *node)
 		}
 		else
 		{
-			doSendTuple(motion, node, outerTupleSlot);
+			if (node->sendBatchSize > 0)
+			{
+				/*
+				 * Collect the tuple into the batch, and send the batch once
+				 * it is full.
+				 */
+				ExecCopySlot(node->batchSlots[node->numBatchedTuples++],
+							 outerTupleSlot);
+				node->numTuplesFromChild++;
+
+				if (node->numBatchedTuples == node->sendBatchSize)
+					doSendTupleBatch(motion, node);
+			}
+			else
+				doSendTuple(motion, node, outerTupleSlot);
 			/* doSendTuple() may have set node->stopRequested as a side-effect */
 
 			if (node->stopRequested)
@@ -824,6 +844,17 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 					node->numHashSegments <= recvSlice->planNumSegments);
 		nkeys = list_length(node->hashExprs);
 
+		/*
+		 * The hash keys of batched tuples are computed from the MinimalTuple
+		 * slots of the batch, not from the child's result slots, so they
+		 * must not be compiled for the child's slot type.
+		 */
+		if (gp_motion_send_batch_size > 1)
+		{
+			motionstate->ps.outeropsfixed = false;
+			motionstate->ps.outeropsset = true;
+		}
+
 		if (nkeys > 0)
 			motionstate->hashExprs = ExecInitExprList(node->hashExprs,
 													  (PlanState *) motionstate);
@@ -848,6 +879,29 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 					nkeys,
 					node->hashFuncs);
 		}
+
+		/*
+		 * Batch the tuples, so that the hash keys are computed in a tight
+		 * loop and the tuples for each target go out together.  The copies
+		 * are in MinimalTuple slots, which is the form SerializeTuple()
+		 * needs anyway.
+		 */
+		if (gp_motion_send_batch_size > 1)
+		{
+			int			batchSize = gp_motion_send_batch_size;
+
+			motionstate->sendBatchSize = batchSize;
+			motionstate->batchSlots = palloc(batchSize * sizeof(TupleTableSlot *));
+			for (int i = 0; i < batchSize; i++)
+				motionstate->batchSlots[i] = ExecAllocTableSlot(&estate->es_tupleTable,
+																tupDesc,
+																&TTSOpsMinimalTuple);
+			motionstate->batchRoutes = palloc(batchSize * sizeof(int16));
+			motionstate->batchOrder = palloc(batchSize * sizeof(int));
+			motionstate->numRoutes = motionstate->numHashSegments *
+				Max(motionstate->parallel_workers, 1);
+			motionstate->routeCounts = palloc((motionstate->numRoutes + 1) * sizeof(int));
+		}
 	}
 
 	/*
@@ -900,6 +954,10 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 						  node->sendSorted,
 						  tupDesc);
 
+	/* CDB: Offer extra info for EXPLAIN ANALYZE. */
+	if (motionstate->mstype == MOTIONSTATE_SEND &&
+		estate->es_instrument && (estate->es_instrument & INSTRUMENT_CDB))
+		motionstate->ps.cdbexplainfun = ExecMotionExplainEnd;
 
 #ifdef CDB_MOTION_DEBUG
 	motionstate->outputFunArray = (Oid *) palloc(tupDesc->natts * sizeof(Oid));
@@ -918,6 +976,24 @@ ExecInitMotion(Motion *node, EState *estate, int eflags)
 	return motionstate;
 }
 
+/*
+ * Report how well the tuples sent by this node compressed, if they were.
+ */
+static void
+ExecMotionExplainEnd(PlanState *planstate, struct StringInfoData *buf)
+{
+	Motion	   *motion = (Motion *) planstate->plan;
+	uint64		raw_bytes;
+	uint64		sent_bytes;
+
+	if (GetMotionCompressionStats(planstate->state->motionlayer_context,
+								  motion->motionID,
+								  &raw_bytes, &sent_bytes))
+		appendStringInfo(buf, "Interconnect compression: " UINT64_FORMAT
+						 " bytes compressed to " UINT64_FORMAT " bytes",
+						 raw_bytes, sent_bytes);
+}
+
 /* ----------------------------------------------------------------
  *		ExecEndMotion(node)
  * ----------------------------------------------------------------
@@ -1010,6 +1086,15 @@ ExecEndMotion(MotionState *node)
 		pfree(node->cdbhashworkers);
 		node->cdbhashworkers = NULL;
 	}
+	if (node->batchSlots != NULL)
+	{
+		/* the slots themselves are released with the executor's tuple table */
+		pfree(node->batchSlots);
+		pfree(node->batchRoutes);
+		pfree(node->batchOrder);
+		pfree(node->routeCounts);
+		node->batchSlots = NULL;
+	}
 
 	/*
 	 * Free up this motion node's resources in the Motion Layer.
@@ -1138,6 +1223,137 @@ evalHashKey(ExprContext *econtext, List *hashkeys, CdbHash * h)
 	return target_seg;
 }
 
+/*
+ * Compute the target route of the tuple in econtext's outer slot, for a hash
+ * Motion.  Like evalHashKey(), but the key expressions are evaluated only
+ * once when both the segment and the worker are hashed, and the caller is
+ * responsible for resetting the expression context.
+ */
+static int16
+evalHashRoute(ExprContext *econtext, MotionState *node)
+{
+	CdbHash    *h = node->cdbhash;
+	CdbHash    *hw = node->cdbhashworkers;
+	uint32		segIdx;
+	uint32		workerIdx = 0;
+	ListCell   *hk;
+	int			i;
+
+	if (node->hashExprs == NIL)
+	{
+		segIdx = cdbhashrandomseg(h->numsegs);
+		if (hw)
+			workerIdx = cdbhashrandomseg(hw->numsegs) / node->numHashSegments;
+	}
+	else
+	{
+		cdbhashinit(h);
+		if (hw)
+			cdbhashinit(hw);
+
+		i = 0;
+		foreach(hk, node->hashExprs)
+		{
+			ExprState  *keyexpr = (ExprState *) lfirst(hk);
+			Datum		keyval;
+			bool		isNull;
+
+			keyval = ExecEvalExpr(keyexpr, econtext, &isNull);
+
+			cdbhash(h, i + 1, keyval, isNull);
+			if (hw)
+				cdbhash(hw, i + 1, keyval, isNull);
+			i++;
+		}
+
+		segIdx = cdbhashreduce(h);
+		if (hw)
+			workerIdx = cdbhashreduce(hw) / node->numHashSegments;
+	}
+
+	Assert(segIdx < node->numHashSegments &&
+		   "redistribute destination outside segment array");
+
+	if (hw)
+		return segIdx * node->parallel_workers + workerIdx;
+	return segIdx;
+}
+
+/*
+ * Send the tuples collected in node->batchSlots of a hash Motion.
+ *
+ * All the target routes are computed first, and then the tuples are sent
+ * grouped by route, keeping their order within a route, which is all a
+ * receiver can observe.  Sending a run of tuples to the same route keeps
+ * filling the same transport buffer instead of hopping between
+ * connections for every tuple.
+ */
+static void
+doSendTupleBatch(Motion *motion, MotionState *node)
+{
+	ExprContext *econtext = node->ps.ps_ExprContext;
+	MemoryContext oldContext;
+	int			nbatch = node->numBatchedTuples;
+	int		   *counts = node->routeCounts;
+	int			i;
+
+	Assert(motion->motionType == MOTIONTYPE_HASH);
+
+	/* Compute the routes, and count the tuples for each. */
+	ResetExprContext(econtext);
+	oldContext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	memset(counts, 0, (node->numRoutes + 1) * sizeof(int));
+	for (i = 0; i < nbatch; i++)
+	{
+		int16		route;
+
+		econtext->ecxt_outertuple = node->batchSlots[i];
+		route = evalHashRoute(econtext, node);
+		Assert(route >= 0 && route < node->numRoutes);
+
+		node->batchRoutes[i] = route;
+		counts[route + 1]++;
+	}
+
+	MemoryContextSwitchTo(oldContext);
+
+	/* Counting sort, stable, so the order within each route is kept. */
+	for (i = 0; i < node->numRoutes; i++)
+		counts[i + 1] += counts[i];
+	for (i = 0; i < nbatch; i++)
+		node->batchOrder[counts[node->batchRoutes[i]]++] = i;
+
+	for (i = 0; i < nbatch; i++)
+	{
+		int			idx = node->batchOrder[i];
+		int16		targetRoute = node->batchRoutes[idx];
+		SendReturnCode sendRC;
+
+		CheckAndSendRecordCache(node->ps.state->motionlayer_context,
+								node->ps.state->interconnect_context,
+								motion->motionID,
+								targetRoute);
+
+		sendRC = SendTuple(node->ps.state->motionlayer_context,
+						   node->ps.state->interconnect_context,
+						   motion->motionID,
+						   node->batchSlots[idx],
+						   targetRoute);
+
+		Assert(sendRC == SEND_COMPLETE || sendRC == STOP_SENDING);
+		if (sendRC == STOP_SENDING)
+		{
+			node->stopRequested = true;
+			break;
+		}
+		node->numTuplesToAMS++;
+	}
+
+	for (i = 0; i < nbatch; i++)
+		ExecClearTuple(node->batchSlots[i]);
+	node->numBatchedTuples = 0;
+}
 
 void
 doSendEndOfStream(Motion *motion, MotionState *node)
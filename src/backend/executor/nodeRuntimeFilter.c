@@ -3,6 +3,20 @@
  * nodeRuntimeFilter.c
  *	  Routines to handle runtime filter.
  *
+ * A RuntimeFilter node sits on the outer side of a Hash Join and drops the
+ * outer tuples whose join keys are not in a Bloom filter of the inner side,
+ * which the Hash node fills while building the hash table.
+ *
+ * The filter is only seen by the process that built it, so the node must be
+ * in the same slice as the Hash Join. When the outer side is redistributed,
+ * the node ends up above the Motion, and the tuples it drops have already
+ * crossed the interconnect. Filtering them in the sending slice would need
+ * the filters built by the Hash Joins on every segment to be merged and
+ * delivered to the scans of the other slice before they start. The
+ * interconnect only carries tuples along the Motion tree, and the
+ * dispatcher only talks to the QEs at dispatch time, so there is no channel
+ * to do that.
+ *
  * Copyright (c) 2023, HashData Technology Limited.
  *
  *
@@ -35,6 +35,18 @@
  * the whole tuplestore, and advertises that it's ready in shared memory.
  * Consumer slices wait for that before trying to read the store.
  *
+ * If gp_shareinput_stream_chunk_tuples is set, the producer doesn't write
+ * one big tuplestore, but a series of smaller ones ("chunks"), and publishes
+ * each chunk as soon as it's complete. Consumers start reading the first
+ * chunk while the producer is still working on the rest, and move on to
+ * the next one when they reach the end of the current chunk, waiting for
+ * the producer if they've caught up with it. Each chunk holds twice as many
+ * tuples as the previous one, so that the first tuples become available
+ * early, without creating an excessive number of files for large inputs.
+ * Whether a scan was streamed is decided by the producer alone; consumers
+ * find out from the shared state, so a mismatch in the setting between
+ * the processes does no harm.
+ *
  * The producer and the consumers communicate the status of the scan using
  * shared memory. There's a hash table in shared memory, containing a
  * 'shareinput_Xslice_state' struct for each shared scan. The producer uses
@@ -105,13 +117,15 @@ typedef struct shareinput_Xslice_state
 	int			refcount;		/* reference count of this entry */
 	pg_atomic_uint32	ready;	/* is the input fully materialized and ready to be read? */
 	pg_atomic_uint32	ndone;	/* # of consumers that have finished the scan */
+	pg_atomic_uint32	nchunks;	/* # of chunks published so far, if streaming */
 
 	/*
 	 * ready_done_cv is used for signaling when the scan becomes "ready", and
 	 * when it becomes "done". The producer wakes up everyone waiting on this
 	 * condition variable when it sets ready = true. Also, when the last
 	 * consumer finishes the scan (ndone reaches nconsumers), it wakes up the
-	 * producer using this same condition variable.
+	 * producer using this same condition variable. When streaming, the
+	 * producer also wakes up the consumers every time it publishes a chunk.
 	 */
 	ConditionVariable ready_done_cv;
 
@@ -180,6 +194,15 @@ typedef struct shareinput_local_state
 
 	/* Tuplestore that holds the result */
 	Tuplestorestate *ts_state;
+
+	/*
+	 * Is the cross-slice result streamed in chunks? If so, ts_state is not
+	 * used; each ShareInputScanState opens the chunks for itself, and the
+	 * producer keeps the tuplestores it wrote in 'chunks', until all the
+	 * consumers are done.
+	 */
+	bool		streaming;
+	List	   *chunks;
 } shareinput_local_state;
 
 static shareinput_Xslice_reference *get_shareinput_reference(int share_id);
@@ -191,9 +214,16 @@ static void shareinput_release_callback(ResourceReleasePhase phase,
 
 static void shareinput_writer_notifyready(shareinput_Xslice_reference *ref);
 static void shareinput_reader_waitready(shareinput_Xslice_reference *ref);
+static void shareinput_writer_notifychunk(shareinput_Xslice_reference *ref, int nchunks);
+static bool shareinput_reader_waitchunk(shareinput_Xslice_reference *ref, int chunkno);
 static void shareinput_reader_notifydone(shareinput_Xslice_reference *ref, int nconsumers);
 static void shareinput_writer_waitdone(shareinput_Xslice_reference *ref, int nconsumers);
 
+static void shareinput_create_chunkname(char *p, int size, int share_id, int chunkno);
+static void shareinput_produce_chunks(ShareInputScanState *node);
+static void shareinput_open_chunk(ShareInputScanState *node, int chunkno);
+static bool shareinput_next_chunk(ShareInputScanState *node, bool forward);
+
 static void ExecShareInputScanExplainEnd(PlanState *planstate, struct StringInfoData *buf);
 
 
@@ -227,7 +257,13 @@ init_tuplestore_state(ShareInputScanState *node)
 		if (currentSliceId == sisc->producer_slice_id || estate->es_plannedstmt->numSlices == 1)
 		{
 			/* We are the producer */
-			if (sisc->cross_slice)
+			if (sisc->cross_slice && gp_shareinput_stream_chunk_tuples > 0)
+			{
+				shareinput_produce_chunks(node);
+				local_state->streaming = true;
+				ts = NULL;
+			}
+			else if (sisc->cross_slice)
 			{
 				char		rwfile_prefix[100];
 
@@ -286,21 +322,24 @@ init_tuplestore_state(ShareInputScanState *node)
 				}
 			}
 
-			for (;;)
+			if (!local_state->streaming)
 			{
-				outerslot = ExecProcNode(local_state->childState);
-				if (TupIsNull(outerslot))
-					break;
-				tuplestore_puttupleslot(ts, outerslot);
-			}
+				for (;;)
+				{
+					outerslot = ExecProcNode(local_state->childState);
+					if (TupIsNull(outerslot))
+						break;
+					tuplestore_puttupleslot(ts, outerslot);
+				}
 
-			if (sisc->cross_slice)
-			{
-				tuplestore_freeze(ts);
-				shareinput_writer_notifyready(node->ref);
-			}
+				if (sisc->cross_slice)
+				{
+					tuplestore_freeze(ts);
+					shareinput_writer_notifyready(node->ref);
+				}
 
-			tuplestore_rescan(ts);
+				tuplestore_rescan(ts);
+			}
 		}
 		else
 		{
@@ -314,14 +353,24 @@ init_tuplestore_state(ShareInputScanState *node)
 
 			shareinput_reader_waitready(node->ref);
 
-			shareinput_create_bufname_prefix(rwfile_prefix, sizeof(rwfile_prefix), sisc->share_id);
-			ts = tuplestore_open_shared(get_shareinput_fileset(), rwfile_prefix);
+			/* A streaming producer publishes the first chunk before 'ready' */
+			pg_read_barrier();
+			if (pg_atomic_read_u32(&node->ref->xslice_state->nchunks) > 0)
+			{
+				local_state->streaming = true;
+				ts = NULL;
+			}
+			else
+			{
+				shareinput_create_bufname_prefix(rwfile_prefix, sizeof(rwfile_prefix), sisc->share_id);
+				ts = tuplestore_open_shared(get_shareinput_fileset(), rwfile_prefix);
+			}
 		}
 		local_state->ts_state = ts;
 		local_state->ready = true;
 		tsptrno = 0;
 	}
-	else
+	else if (!local_state->streaming)
 	{
 		/* Another local reader */
 		ts = local_state->ts_state;
@@ -331,6 +380,14 @@ init_tuplestore_state(ShareInputScanState *node)
 		tuplestore_rescan(ts);
 	}
 
+	if (local_state->streaming)
+	{
+		/* Every scan reads the chunks through a tuplestore of its own */
+		shareinput_open_chunk(node, 0);
+		node->isready = true;
+		return;
+	}
+
 	node->ts_state = ts;
 	node->ts_pos = tsptrno;
 
@@ -388,7 +445,13 @@ ExecShareInputScan(PlanState *pstate)
 		gotOK = tuplestore_gettupleslot(node->ts_state, forward, false, slot);
 
 		if (!gotOK)
+		{
+			/* At the end of a chunk, continue with the next one, if any */
+			if (node->local_state->streaming &&
+				shareinput_next_chunk(node, forward))
+				continue;
 			return NULL;
+		}
 
 		SIMPLE_FAULT_INJECTOR("execshare_input_next");
 
@@ -420,6 +483,7 @@ ExecInitShareInputScan(ShareInputScan *node, EState *estate, int eflags)
 
 	sisstate->ts_state = NULL;
 	sisstate->ts_pos = -1;
+	sisstate->ts_chunk = 0;
 
 	/*
 	 * init child node.
@@ -570,12 +634,29 @@ ExecEndShareInputScan(ShareInputScanState *node)
 		node->ref = NULL;
 	}
 
+	if (local_state && local_state->streaming && node->ts_state)
+	{
+		tuplestore_end(node->ts_state);
+		node->ts_state = NULL;
+	}
+
 	if (local_state && local_state->ts_state)
 	{
 		tuplestore_end(local_state->ts_state);
 		local_state->ts_state = NULL;
 	}
 
+	/* The producer deletes the chunks, now that all consumers are done */
+	if (local_state && local_state->chunks != NIL)
+	{
+		ListCell   *lc;
+
+		foreach(lc, local_state->chunks)
+			tuplestore_end((Tuplestorestate *) lfirst(lc));
+		list_free(local_state->chunks);
+		local_state->chunks = NIL;
+	}
+
 	/*
 	 * shutdown subplan.  First scanner of underlying share input will
 	 * do the shutdown, all other scanners are no-op because outerPlanState
@@ -598,6 +679,15 @@ ExecReScanShareInputScan(ShareInputScanState *node)
 	ExecClearTuple(node->ss.ps.ps_ResultTupleSlot);
 	Assert(node->ts_pos != -1);
 
+	if (node->local_state->streaming)
+	{
+		if (node->ts_chunk != 0)
+			shareinput_open_chunk(node, 0);
+		else
+			tuplestore_rescan(node->ts_state);
+		return;
+	}
+
 	tuplestore_select_read_pointer(node->ts_state, node->ts_pos);
 	tuplestore_rescan(node->ts_state);
 }
@@ -684,6 +774,128 @@ shareinput_create_bufname_prefix(char* p, int size, int share_id)
 			 gp_session_id, gp_command_count, share_id);
 }
 
+/*
+ * Like shareinput_create_bufname_prefix(), but for one chunk of a streamed
+ * cross-slice scan.
+ */
+static void
+shareinput_create_chunkname(char *p, int size, int share_id, int chunkno)
+{
+	snprintf(p, size, "SIRW_%d_%d_%d_%d",
+			 gp_session_id, gp_command_count, share_id, chunkno);
+}
+
+/*
+ * shareinput_produce_chunks
+ *
+ *  Called by the producer of a streamed cross-slice scan to run the shared
+ *  subplan to completion, publishing the result in chunks as it goes. The
+ *  first chunk holds gp_shareinput_stream_chunk_tuples tuples, and each
+ *  following one twice as many as the one before. There is always at least
+ *  one chunk, even if the subplan returns no rows.
+ */
+static void
+shareinput_produce_chunks(ShareInputScanState *node)
+{
+	ShareInputScan *sisc = (ShareInputScan *) node->ss.ps.plan;
+	shareinput_local_state *local_state = node->local_state;
+	Tuplestorestate *ts = NULL;
+	int64		chunk_tuples = gp_shareinput_stream_chunk_tuples;
+	int			nchunks = 0;
+	TupleTableSlot *outerslot;
+	char		chunkname[100];
+
+	elog(DEBUG1, "SISC writer (shareid=%d, slice=%d): streaming result in chunks of %d tuples and up",
+		 sisc->share_id, currentSliceId, gp_shareinput_stream_chunk_tuples);
+
+	for (;;)
+	{
+		if (ts == NULL)
+		{
+			ts = tuplestore_begin_heap(true, /* randomAccess */
+									   false, /* interXact */
+									   10); /* maxKBytes, everything goes to the file anyway */
+			shareinput_create_chunkname(chunkname, sizeof(chunkname),
+										sisc->share_id, nchunks);
+			tuplestore_make_shared(ts, get_shareinput_fileset(), chunkname);
+		}
+
+		outerslot = ExecProcNode(local_state->childState);
+		if (TupIsNull(outerslot))
+			break;
+		tuplestore_puttupleslot(ts, outerslot);
+
+		if (tuplestore_tuple_count(ts) >= chunk_tuples)
+		{
+			tuplestore_freeze(ts);
+			local_state->chunks = lappend(local_state->chunks, ts);
+			shareinput_writer_notifychunk(node->ref, ++nchunks);
+			ts = NULL;
+
+			if (chunk_tuples < PG_INT64_MAX / 2)
+				chunk_tuples *= 2;
+		}
+	}
+
+	tuplestore_freeze(ts);
+	local_state->chunks = lappend(local_state->chunks, ts);
+	shareinput_writer_notifychunk(node->ref, ++nchunks);
+
+	shareinput_writer_notifyready(node->ref);
+}
+
+/*
+ * shareinput_open_chunk
+ *
+ *  Open a published chunk of a streamed scan for reading, replacing the
+ *  chunk the scan was reading until now, if any.
+ */
+static void
+shareinput_open_chunk(ShareInputScanState *node, int chunkno)
+{
+	ShareInputScan *sisc = (ShareInputScan *) node->ss.ps.plan;
+	char		chunkname[100];
+
+	if (node->ts_state)
+		tuplestore_end(node->ts_state);
+
+	shareinput_create_chunkname(chunkname, sizeof(chunkname),
+								sisc->share_id, chunkno);
+	node->ts_state = tuplestore_open_shared(get_shareinput_fileset(), chunkname);
+	node->ts_pos = 0;
+	node->ts_chunk = chunkno;
+}
+
+/*
+ * shareinput_next_chunk
+ *
+ *  Called when a streamed scan runs off the end of its current chunk.
+ *  Moves to the next chunk in the scan direction, waiting for the producer
+ *  to publish it if necessary. Returns false if there is no such chunk,
+ *  leaving the scan positioned at the end of the current one.
+ */
+static bool
+shareinput_next_chunk(ShareInputScanState *node, bool forward)
+{
+	int			chunkno = forward ? node->ts_chunk + 1 : node->ts_chunk - 1;
+
+	if (chunkno < 0)
+		return false;
+	if (forward && !shareinput_reader_waitchunk(node->ref, chunkno))
+		return false;
+
+	shareinput_open_chunk(node, chunkno);
+
+	/* When scanning backwards, start from the end of the previous chunk */
+	if (!forward)
+	{
+		while (tuplestore_advance(node->ts_state, true))
+			;
+	}
+
+	return true;
+}
+
 /*
  * Initialization of the shared hash table for cross-slice communication.
  *
@@ -827,6 +1039,7 @@ get_shareinput_reference(int share_id)
 		xslice_state->refcount = 0;
 		pg_atomic_init_u32(&xslice_state->ready, 0);
 		pg_atomic_init_u32(&xslice_state->ndone, 0);
+		pg_atomic_init_u32(&xslice_state->nchunks, 0);
 
 		ConditionVariableInit(&xslice_state->ready_done_cv);
 	}
@@ -910,7 +1123,8 @@ shareinput_release_callback(ResourceReleasePhase phase,
  * shareinput_reader_waitready
  *
  *  Called by the reader (consumer) to wait for the writer (producer) to produce
- *  all the tuples and write them to disk.
+ *  all the tuples and write them to disk, or, if the producer is streaming
+ *  the result, to publish the first chunk.
  *
  *  This is a blocking operation.
  */
@@ -935,6 +1149,8 @@ shareinput_reader_waitready(shareinput_Xslice_reference *ref)
 		int ready = pg_atomic_read_u32(&state->ready);
 		if (ready)
 			break;
+		if (pg_atomic_read_u32(&state->nchunks) > 0)
+			break;
 
 		ConditionVariableSleep(&state->ready_done_cv, WAIT_EVENT_SHAREINPUT_SCAN);
 	}
@@ -971,6 +1187,69 @@ shareinput_writer_notifyready(shareinput_Xslice_reference *ref)
 		 ref->share_id, currentSliceId);
 }
 
+/*
+ * shareinput_writer_notifychunk
+ *
+ *  Called by the writer (producer) of a streamed scan after it has frozen
+ *  a chunk, to let the readers (consumers) know that the first 'nchunks'
+ *  chunks can be read.
+ */
+static void
+shareinput_writer_notifychunk(shareinput_Xslice_reference *ref, int nchunks)
+{
+	shareinput_Xslice_state *state = ref->xslice_state;
+
+	/* pg_atomic_exchange_u32() is a full barrier, see the readers */
+	(void) pg_atomic_exchange_u32(&state->nchunks, nchunks);
+
+	ConditionVariableBroadcast(&state->ready_done_cv);
+
+	elog(DEBUG1, "SISC WRITER (shareid=%d, slice=%d): published chunk %d",
+		 ref->share_id, currentSliceId, nchunks - 1);
+}
+
+/*
+ * shareinput_reader_waitchunk
+ *
+ *  Called by the reader (consumer) of a streamed scan to wait until chunk
+ *  'chunkno' has been published. Returns false if the producer finished
+ *  without producing that many chunks, i.e. the reader has seen all of the
+ *  result.
+ *
+ *  This is a blocking operation.
+ */
+static bool
+shareinput_reader_waitchunk(shareinput_Xslice_reference *ref, int chunkno)
+{
+	shareinput_Xslice_state *state = ref->xslice_state;
+	bool		found;
+
+	for (;;)
+	{
+		if (pg_atomic_read_u32(&state->nchunks) > chunkno)
+		{
+			found = true;
+			break;
+		}
+		if (pg_atomic_read_u32(&state->ready))
+		{
+			/*
+			 * The producer published the last chunk before it set 'ready',
+			 * so the count can't change anymore. Re-read it, in case it was
+			 * bumped after we looked above.
+			 */
+			pg_read_barrier();
+			found = pg_atomic_read_u32(&state->nchunks) > chunkno;
+			break;
+		}
+
+		ConditionVariableSleep(&state->ready_done_cv, WAIT_EVENT_SHAREINPUT_SCAN);
+	}
+	ConditionVariableCancelSleep();
+
+	return found;
+}
+
 /*
  * shareinput_reader_notifydone
  *
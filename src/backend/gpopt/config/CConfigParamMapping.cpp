@@ -290,6 +290,18 @@ CConfigParamMapping::SConfigMappingElem CConfigParamMapping::m_elements[] = {
 	 false,	 // m_negate_param
 	 GPOS_WSZ_LIT(
 		 "Explore a nested loop join even if a hash join is possible")},
+	{EopttraceEnableMemoize, &optimizer_enable_memoize,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Enable plan alternatives that cache the inner side of index nested loop joins.")},
+	{EopttraceEnableIncrementalSort, &optimizer_enable_incremental_sort,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Enable sort alternatives that exploit a presorted prefix of the input.")},
+	{EopttraceEnableExtendedStats, &optimizer_enable_extended_stats,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Use extended statistics in cardinality estimation.")},
 
 };
 
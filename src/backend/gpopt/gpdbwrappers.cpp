@@ -40,6 +40,7 @@ extern "C" {
 #include "optimizer/plancat.h"
 #include "parser/parse_agg.h"
 #include "partitioning/partdesc.h"
+#include "statistics/statistics.h"
 #include "storage/lmgr.h"
 #include "utils/fmgroids.h"
 #include "utils/memutils.h"
@@ -746,6 +747,63 @@ gpdb::GetAttStats(Oid relid, AttrNumber attnum)
 	return nullptr;
 }
 
+List *
+gpdb::GetRelationStatExtList(Relation relation)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: from relcache */
+		return RelationGetStatExtList(relation);
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
+bool
+gpdb::IsExtStatsKindBuilt(Oid stat_oid, char kind)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic_ext_data */
+		HeapTuple htup =
+			SearchSysCache1(STATEXTDATASTXOID, ObjectIdGetDatum(stat_oid));
+		if (!HeapTupleIsValid(htup))
+		{
+			return false;
+		}
+
+		bool is_built = statext_is_kind_built(htup, kind);
+		ReleaseSysCache(htup);
+		return is_built;
+	}
+	GP_WRAP_END;
+	return false;
+}
+
+MVDependencies *
+gpdb::GetMVDependencies(Oid stat_oid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic_ext_data */
+		return statext_dependencies_load(stat_oid);
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
+MVNDistinct *
+gpdb::GetMVNDistinct(Oid stat_oid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic_ext_data */
+		return statext_ndistinct_load(stat_oid);
+	}
+	GP_WRAP_END;
+	return nullptr;
+}
+
 Oid
 gpdb::GetCommutatorOp(Oid opno)
 {
@@ -2531,11 +2589,16 @@ gpdb::CountLeafPartTables
  * We register a callback to a cache on all the catalog tables that contain
  * information that's contained in the ORCA metadata cache.
 
- * There is no fine-grained mechanism in the metadata cache for invalidating
- * individual entries ATM, so we just blow the whole cache whenever anything
- * changes. The callback simply increments a counter. Whenever we start
- * planning a query, we check the counter to see if it has changed since the
- * last planned query, and reset the whole cache if it has.
+ * Invalidations that can be attributed to individual cache entries are
+ * recorded in a small array: relcache invalidations carry the OID of the
+ * relation, and syscache invalidations on the caches listed in
+ * mdcache_fine_grained_caches carry the hash value of the changed tuple's
+ * key. Whenever we start planning a query, COptTasks consumes the recorded
+ * invalidations and evicts only the matching entries. Anything that cannot
+ * be attributed (an invalidation of a whole cache, a change to a catalog
+ * whose contents are spread over several kinds of metadata objects, or more
+ * invalidations than fit in the array) sets a flag, and the whole cache is
+ * reset before the next query is planned.
  *
  * To make sure we've covered all catalog tables that contain information
  * that's stored in the metadata cache, there are "catalog tables: xxx"
@@ -2544,21 +2607,81 @@ gpdb::CountLeafPartTables
  * anything fetched via the wrapper functions in this file can end up in the
  * metadata cache and hence need to have an invalidation callback registered.
  */
-static bool mdcache_invalidation_counter_registered = false;
-static int64 mdcache_invalidation_counter = 0;
-static int64 last_mdcache_invalidation_counter = 0;
+#define MDCACHE_MAX_PENDING_INVALIDATIONS 256
+
+static bool mdcache_invalidation_callbacks_registered = false;
+static bool mdcache_needs_reset = false;
+static int mdcache_num_pending_invalidations = 0;
+static gpdb::MDCacheInvalidation
+	mdcache_pending_invalidations[MDCACHE_MAX_PENDING_INVALIDATIONS];
+
+/*
+ * Syscaches whose entries map to metadata cache objects keyed by the same
+ * catalog key.
+ */
+static const int mdcache_fine_grained_caches[] = {
+	AGGFNOID,	   /* pg_aggregate */
+	CONSTROID,	   /* pg_constraint */
+	OPEROID,	   /* pg_operator */
+	PROCOID,	   /* pg_proc */
+	STATRELATTINH, /* pg_statistics */
+	TYPEOID,	   /* pg_type */
+};
 
 static void
-mdsyscache_invalidation_counter_callback(Datum /*arg*/, int /*cacheid*/,
-										 uint32 /*hashvalue*/)
+mdcache_record_invalidation(int cacheid, uint32 hashvalue, Oid relid)
 {
-	mdcache_invalidation_counter++;
+	if (mdcache_needs_reset)
+		return;
+
+	if (mdcache_num_pending_invalidations >= MDCACHE_MAX_PENDING_INVALIDATIONS)
+	{
+		/* too many changes to track one by one, blow the whole cache */
+		mdcache_needs_reset = true;
+		mdcache_num_pending_invalidations = 0;
+		return;
+	}
+
+	gpdb::MDCacheInvalidation *inval =
+		&mdcache_pending_invalidations[mdcache_num_pending_invalidations++];
+	inval->cacheid = cacheid;
+	inval->hashvalue = hashvalue;
+	inval->relid = relid;
 }
 
 static void
-mdrelcache_invalidation_counter_callback(Datum /*arg*/, Oid /*relid*/)
+mdsyscache_invalidation_callback(Datum /*arg*/, int cacheid, uint32 hashvalue)
 {
-	mdcache_invalidation_counter++;
+	bool fine_grained = false;
+
+	/* a zero hash value means the whole syscache was flushed */
+	if (0 != hashvalue)
+	{
+		for (unsigned int i = 0; i < lengthof(mdcache_fine_grained_caches); i++)
+		{
+			if (cacheid == mdcache_fine_grained_caches[i])
+			{
+				fine_grained = true;
+				break;
+			}
+		}
+	}
+
+	if (fine_grained)
+		mdcache_record_invalidation(cacheid, hashvalue, InvalidOid);
+	else
+		mdcache_needs_reset = true;
+}
+
+static void
+mdrelcache_invalidation_callback(Datum /*arg*/, Oid relid)
+{
+	/* an invalid relid means the whole relcache was flushed */
+	if (OidIsValid(relid))
+		mdcache_record_invalidation(gpdb::MDCacheRelcacheInvalidation, 0,
+									relid);
+	else
+		mdcache_needs_reset = true;
 }
 
 static void
@@ -2621,31 +2744,34 @@ register_mdcache_invalidation_callbacks(void)
 	for (i = 0; i < lengthof(metadata_caches); i++)
 	{
 		CacheRegisterSyscacheCallback(metadata_caches[i],
-									  &mdsyscache_invalidation_counter_callback,
+									  &mdsyscache_invalidation_callback,
 									  (Datum) 0);
 	}
 
 	/* also register the relcache callback */
-	CacheRegisterRelcacheCallback(&mdrelcache_invalidation_counter_callback,
+	CacheRegisterRelcacheCallback(&mdrelcache_invalidation_callback,
 								  (Datum) 0);
 }
 
-// Has there been any catalog changes since last call?
+// Has there been any catalog change since last call that cannot be handled
+// by evicting individual entries?
 bool
 gpdb::MDCacheNeedsReset(void)
 {
 	GP_WRAP_START;
 	{
-		if (!mdcache_invalidation_counter_registered)
+		if (!mdcache_invalidation_callbacks_registered)
 		{
 			register_mdcache_invalidation_callbacks();
-			mdcache_invalidation_counter_registered = true;
+			mdcache_invalidation_callbacks_registered = true;
 		}
-		if (last_mdcache_invalidation_counter == mdcache_invalidation_counter)
+		if (!mdcache_needs_reset)
 			return false;
 		else
 		{
-			last_mdcache_invalidation_counter = mdcache_invalidation_counter;
+			/* the reset supersedes any pending fine-grained invalidation */
+			mdcache_needs_reset = false;
+			mdcache_num_pending_invalidations = 0;
 			return true;
 		}
 	}
@@ -2654,6 +2780,93 @@ gpdb::MDCacheNeedsReset(void)
 	return true;
 }
 
+// Copy the fine-grained invalidations recorded since the last call into a
+// palloc'd array and forget about them. Invalidations arriving while the
+// caller processes the copy are kept for the next call.
+gpdb::MDCacheInvalidation *
+gpdb::MDCacheConsumeInvalidations(int *num_invalidations)
+{
+	GP_WRAP_START;
+	{
+		MDCacheInvalidation *invalidations = nullptr;
+
+		*num_invalidations = mdcache_num_pending_invalidations;
+		if (0 < mdcache_num_pending_invalidations)
+		{
+			invalidations = (MDCacheInvalidation *) palloc(
+				mdcache_num_pending_invalidations *
+				sizeof(MDCacheInvalidation));
+			memcpy(invalidations, mdcache_pending_invalidations,
+				   mdcache_num_pending_invalidations *
+					   sizeof(MDCacheInvalidation));
+			mdcache_num_pending_invalidations = 0;
+		}
+		return invalidations;
+	}
+	GP_WRAP_END;
+
+	return nullptr;
+}
+
+// Get the hash value under which a syscache would report changes to the
+// tuple with the given keys
+uint32
+gpdb::GetSysCacheHashValue(int cacheid, Datum key1, Datum key2, Datum key3)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: none, only the hash function of the cache is used */
+		return ::GetSysCacheHashValue(cacheid, key1, key2, key3, 0);
+	}
+	GP_WRAP_END;
+
+	return 0;
+}
+
+bool
+gpdb::SharedMDCacheEnabled(void)
+{
+	// No GP_WRAP_START/END needed here, this only checks a few flags
+	return ::SharedMDCacheEnabled();
+}
+
+uint64
+gpdb::SharedMDCacheGeneration(void)
+{
+	GP_WRAP_START;
+	{
+		return ::SharedMDCacheGeneration();
+	}
+	GP_WRAP_END;
+
+	return 0;
+}
+
+char *
+gpdb::SharedMDCacheLookup(const char *key)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: none, the objects were translated by other backends */
+		return ::SharedMDCacheLookup(key);
+	}
+	GP_WRAP_END;
+
+	return nullptr;
+}
+
+void
+gpdb::SharedMDCacheInsert(const char *key, const char *dxl,
+						  const SharedMDCacheDeps *deps, uint64 generation)
+{
+	GP_WRAP_START;
+	{
+		::SharedMDCacheInsert(key, dxl, deps, generation);
+		return;
+	}
+	GP_WRAP_END;
+}
+
 // returns true if a query cancel is requested in GPDB
 bool
 gpdb::IsAbortRequested(void)
@@ -16,12 +16,21 @@
 
 extern "C" {
 #include "postgres.h"
+
+#include "utils/syscache.h"
 }
+#include "gpos/common/CAutoRg.h"
+
+#include "gpopt/gpdbwrappers.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/relcache/CMDProviderRelcache.h"
 #include "gpopt/translate/CTranslatorRelcacheToDXL.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/exception.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDRelation.h"
 
 using namespace gpos;
 using namespace gpdxl;
@@ -66,15 +75,182 @@ CMDProviderRelcache::GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 	return str;
 }
 
-// return the requested metadata object
+// record that the object depends on the syscache entry with the given keys
+static void
+AddSyscacheDep(SharedMDCacheDeps *deps, INT cacheid, Datum key1, Datum key2,
+			   Datum key3)
+{
+	GPOS_ASSERT(SHARED_MDCACHE_MAX_SYSCACHE_DEPS > deps->nsyscache);
+
+	deps->cacheids[deps->nsyscache] = cacheid;
+	deps->hashvalues[deps->nsyscache] =
+		gpdb::GetSysCacheHashValue(cacheid, key1, key2, key3);
+	deps->nsyscache++;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		FSharedMDCacheDeps
+//
+//	@doc:
+//		Collect the catalog changes that make the given object stale, using
+//		the same rules as the eviction from the backend-private cache.
+//		Returns false for objects that are not shared: triggers, casts and
+//		comparisons depend on too many catalog entries, and the statistics
+//		of partitioned tables are derived from all their leaf partitions
+//
+//---------------------------------------------------------------------------
+static BOOL
+FSharedMDCacheDeps(CMDAccessor *md_accessor, const IMDCacheObject *md_obj,
+				   SharedMDCacheDeps *deps)
+{
+	const IMDId *mdid = md_obj->MDId();
+
+	deps->relid = InvalidOid;
+	deps->nsyscache = 0;
+
+	switch (md_obj->MDType())
+	{
+		case IMDCacheObject::EmdtRelStats:
+		case IMDCacheObject::EmdtColStats:
+		{
+			IMDId *rel_mdid =
+				IMDCacheObject::EmdtRelStats == md_obj->MDType()
+					? CMDIdRelStats::CastMdid(mdid)->GetRelMdId()
+					: CMDIdColStats::CastMdid(mdid)->GetRelMdId();
+			const IMDRelation *md_rel = md_accessor->RetrieveRel(rel_mdid);
+			if (md_rel->IsPartitioned())
+			{
+				return false;
+			}
+
+			OID rel_oid = CMDIdGPDB::CastMdid(rel_mdid)->Oid();
+			deps->relid = rel_oid;
+
+			if (IMDCacheObject::EmdtColStats == md_obj->MDType())
+			{
+				INT attno =
+					md_rel->GetMdCol(CMDIdColStats::CastMdid(mdid)->Position())
+						->AttrNum();
+				if (0 < attno)
+				{
+					AddSyscacheDep(deps, STATRELATTINH,
+								   ObjectIdGetDatum(rel_oid),
+								   Int16GetDatum(attno), BoolGetDatum(false));
+					AddSyscacheDep(deps, STATRELATTINH,
+								   ObjectIdGetDatum(rel_oid),
+								   Int16GetDatum(attno), BoolGetDatum(true));
+				}
+			}
+			return true;
+		}
+
+		default:
+			break;
+	}
+
+	if (IMDId::EmdidGPDB != mdid->MdidType())
+	{
+		return false;
+	}
+
+	OID oid = CMDIdGPDB::CastMdid(mdid)->Oid();
+
+	switch (md_obj->MDType())
+	{
+		case IMDCacheObject::EmdtRel:
+		case IMDCacheObject::EmdtInd:
+			deps->relid = oid;
+			return true;
+
+		case IMDCacheObject::EmdtType:
+			AddSyscacheDep(deps, TYPEOID, ObjectIdGetDatum(oid), 0, 0);
+			return true;
+
+		case IMDCacheObject::EmdtOp:
+			AddSyscacheDep(deps, OPEROID, ObjectIdGetDatum(oid), 0, 0);
+			return true;
+
+		case IMDCacheObject::EmdtFunc:
+			AddSyscacheDep(deps, PROCOID, ObjectIdGetDatum(oid), 0, 0);
+			return true;
+
+		case IMDCacheObject::EmdtAgg:
+			AddSyscacheDep(deps, AGGFNOID, ObjectIdGetDatum(oid), 0, 0);
+			AddSyscacheDep(deps, PROCOID, ObjectIdGetDatum(oid), 0, 0);
+			return true;
+
+		case IMDCacheObject::EmdtCheckConstraint:
+			AddSyscacheDep(deps, CONSTROID, ObjectIdGetDatum(oid), 0, 0);
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderRelcache::GetMDObj
+//
+//	@doc:
+//		Return the requested metadata object. If the metadata cache shared
+//		by all backends is enabled, the object is parsed from the DXL that
+//		another backend published there, and objects that have to be
+//		translated from the relcache are published for the others
+//
+//---------------------------------------------------------------------------
 IMDCacheObject *
 CMDProviderRelcache::GetMDObj(CMemoryPool *mp, CMDAccessor *md_accessor,
 							  IMDId *mdid) const
 {
+	if (!gpdb::SharedMDCacheEnabled())
+	{
+		IMDCacheObject *md_obj =
+			CTranslatorRelcacheToDXL::RetrieveObject(mp, md_accessor, mdid);
+		GPOS_ASSERT(nullptr != md_obj);
+
+		return md_obj;
+	}
+
+	CAutoRg<CHAR> key(
+		CDXLUtils::CreateMultiByteCharStringFromWCString(mp, mdid->GetBuffer()));
+
+	CHAR *dxl = gpdb::SharedMDCacheLookup(key.Rgt());
+	if (nullptr != dxl)
+	{
+		IMDCacheObjectArray *md_obj_array = CDXLUtils::ParseDXLToIMDObjectArray(
+			mp, dxl, nullptr /*xsd_file_path*/);
+		gpdb::GPDBFree(dxl);
+
+		GPOS_ASSERT(1 == md_obj_array->Size());
+		IMDCacheObject *md_obj = (*md_obj_array)[0];
+		md_obj->AddRef();
+		md_obj_array->Release();
+
+		return md_obj;
+	}
+
+	// anything invalidated from now on may already be stale in the
+	// translated object
+	ULLONG generation = gpdb::SharedMDCacheGeneration();
+
 	IMDCacheObject *md_obj =
 		CTranslatorRelcacheToDXL::RetrieveObject(mp, md_accessor, mdid);
 	GPOS_ASSERT(nullptr != md_obj);
 
+	SharedMDCacheDeps deps;
+	if (FSharedMDCacheDeps(md_accessor, md_obj, &deps))
+	{
+		CWStringDynamic *str = CDXLUtils::SerializeMDObj(
+			mp, md_obj, true /*fSerializeHeaders*/, false /*findent*/);
+		CAutoRg<CHAR> sz(
+			CDXLUtils::CreateMultiByteCharStringFromWCString(mp, str->GetBuffer()));
+		GPOS_DELETE(str);
+
+		gpdb::SharedMDCacheInsert(key.Rgt(), sz.Rgt(), &deps, generation);
+	}
+
 	return md_obj;
 }
 
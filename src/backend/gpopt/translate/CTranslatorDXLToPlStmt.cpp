@@ -1850,6 +1850,13 @@ CTranslatorDXLToPlStmt::TranslateDXLNLJoin(
 		right_plan = TranslateDXLOperatorToPlan(
 			right_tree_dxlnode, &right_dxl_translate_ctxt,
 			translation_context_arr_with_siblings);
+
+		if (dxl_nlj->IsMemoize())
+		{
+			right_plan = TranslateMemoize(right_plan,
+										  dxl_nlj->GetNestLoopParamsColRefs(),
+										  &right_dxl_translate_ctxt);
+		}
 	}
 	else
 	{
@@ -2994,15 +3001,26 @@ CTranslatorDXLToPlStmt::TranslateDXLSort(
 	const CDXLNode *sort_dxlnode, CDXLTranslateContext *output_context,
 	CDXLTranslationContextArray *ctxt_translation_prev_siblings)
 {
-	// create sort plan node
-	Sort *sort = MakeNode(Sort);
+	CDXLPhysicalSort *sort_dxlop =
+		CDXLPhysicalSort::Cast(sort_dxlnode->GetOperator());
+
+	// create sort plan node, an incremental sort if the input is already
+	// sorted on a prefix of the sort columns
+	Sort *sort = nullptr;
+	if (0 < sort_dxlop->GetPresortedCols())
+	{
+		IncrementalSort *incremental_sort = MakeNode(IncrementalSort);
+		incremental_sort->nPresortedCols = sort_dxlop->GetPresortedCols();
+		sort = &(incremental_sort->sort);
+	}
+	else
+	{
+		sort = MakeNode(Sort);
+	}
 
 	Plan *plan = &(sort->plan);
 	plan->plan_node_id = m_dxl_to_plstmt_context->GetNextPlanId();
 
-	CDXLPhysicalSort *sort_dxlop =
-		CDXLPhysicalSort::Cast(sort_dxlnode->GetOperator());
-
 	// translate operator costs
 	TranslatePlanCosts(sort_dxlnode, plan);
 
@@ -5716,6 +5734,85 @@ CTranslatorDXLToPlStmt::TranslateNestLoopParamList(
 	return nest_params_list;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToPlStmt::TranslateMemoize
+//
+//	@doc:
+//		Put a Memoize node on top of the inner plan of an index nested loop
+//		join, keyed on the params that pass the outer values to it. Keys
+//		are compared bit by bit, since the hash equality operator of a type
+//		may consider values equal that the join condition tells apart. If
+//		one of the key types cannot be hashed, the inner plan is returned
+//		unchanged.
+//
+//---------------------------------------------------------------------------
+Plan *
+CTranslatorDXLToPlStmt::TranslateMemoize(Plan *inner_plan,
+										 CDXLColRefArray *pdrgdxlcrOuterRefs,
+										 CDXLTranslateContext *dxltrctxRight)
+{
+	const ULONG num_keys = pdrgdxlcrOuterRefs->Size();
+	GPOS_ASSERT(0 < num_keys);
+
+	Oid *hash_operators = (Oid *) gpdb::GPDBAlloc(num_keys * sizeof(Oid));
+	Oid *collations = (Oid *) gpdb::GPDBAlloc(num_keys * sizeof(Oid));
+	List *param_exprs = NIL;
+	Bitmapset *keyparamids = nullptr;
+	for (ULONG ul = 0; ul < num_keys; ul++)
+	{
+		const CMappingElementColIdParamId *colid_param_mapping =
+			dxltrctxRight->GetParamIdMappingElement(
+				(*pdrgdxlcrOuterRefs)[ul]->Id());
+		GPOS_ASSERT(nullptr != colid_param_mapping);
+
+		Oid type_oid =
+			CMDIdGPDB::CastMdid(colid_param_mapping->MdidType())->Oid();
+		TypeCacheEntry *typentry =
+			gpdb::LookupTypeCache(type_oid, TYPECACHE_EQ_OPR);
+		if (!OidIsValid(typentry->eq_opr) ||
+			!gpdb::IsOpHashJoinable(typentry->eq_opr, type_oid))
+		{
+			return inner_plan;
+		}
+
+		Param *param = MakeNode(Param);
+		param->paramkind = PARAM_EXEC;
+		param->paramid = colid_param_mapping->ParamId();
+		param->paramtype = type_oid;
+		param->paramtypmod = colid_param_mapping->TypeModifier();
+		param->paramcollid = gpdb::TypeCollation(type_oid);
+		param->location = -1;
+
+		hash_operators[ul] = typentry->eq_opr;
+		collations[ul] = param->paramcollid;
+		param_exprs = gpdb::LAppend(param_exprs, param);
+		keyparamids = gpdb::BmsAddMember(keyparamids, param->paramid);
+	}
+
+	Memoize *memoize = MakeNode(Memoize);
+	memoize->numKeys = num_keys;
+	memoize->hashOperators = hash_operators;
+	memoize->collations = collations;
+	memoize->param_exprs = param_exprs;
+	memoize->singlerow = false;
+	memoize->binary_mode = true;
+	memoize->est_entries = 0;
+	memoize->keyparamids = keyparamids;
+
+	Plan *plan = &(memoize->plan);
+	plan->plan_node_id = m_dxl_to_plstmt_context->GetNextPlanId();
+	plan->startup_cost = inner_plan->startup_cost;
+	plan->total_cost = inner_plan->total_cost;
+	plan->plan_rows = inner_plan->plan_rows;
+	plan->plan_width = inner_plan->plan_width;
+	plan->targetlist = CreateDirectCopyTargetList(inner_plan->targetlist);
+	plan->lefttree = inner_plan;
+	SetParamIds(plan);
+
+	return plan;
+}
+
 List *
 CTranslatorDXLToPlStmt::CreateDirectCopyTargetList(List *target_list)
 {
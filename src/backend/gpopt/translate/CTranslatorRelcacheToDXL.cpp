@@ -23,8 +23,10 @@ extern "C" {
 #include "catalog/pg_am.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_statistic.h"
+#include "catalog/pg_statistic_ext.h"
 #include "cdb/cdbhash.h"
 #include "partitioning/partdesc.h"
+#include "statistics/statistics.h"
 #include "utils/array.h"
 #include "utils/datum.h"
 #include "utils/elog.h"
@@ -1676,13 +1678,98 @@ CTranslatorRelcacheToDXL::RetrieveRelStats(CMemoryPool *mp, IMDId *mdid)
 	ULONG relpages = rel->rd_rel->relpages;
 	ULONG relallvisible = rel->rd_rel->relallvisible;
 
-	CDXLRelStats *dxl_rel_stats = GPOS_NEW(mp)
-		CDXLRelStats(mp, m_rel_stats_mdid, mdname, CDouble(num_rows),
-					 relation_empty, relpages, relallvisible);
+	CMDDependencyArray *dependencies = GPOS_NEW(mp) CMDDependencyArray(mp);
+	CMDNDistinctArray *ndistincts = GPOS_NEW(mp) CMDNDistinctArray(mp);
+	RetrieveRelExtStats(mp, rel.get(), dependencies, ndistincts);
+
+	CDXLRelStats *dxl_rel_stats = GPOS_NEW(mp) CDXLRelStats(
+		mp, m_rel_stats_mdid, mdname, CDouble(num_rows), relation_empty,
+		relpages, relallvisible, dependencies, ndistincts);
 
 	return dxl_rel_stats;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::RetrieveRelExtStats
+//
+//	@doc:
+//		Retrieve the functional dependencies and multi-column ndistinct
+//		coefficients built by ANALYZE for the extended statistics objects
+//		of the given relation. Items that involve expressions are skipped,
+//		since the optimizer can only match them to plain columns.
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorRelcacheToDXL::RetrieveRelExtStats(CMemoryPool *mp, Relation rel,
+											  CMDDependencyArray *dependencies,
+											  CMDNDistinctArray *ndistincts)
+{
+	List *stat_oids = gpdb::GetRelationStatExtList(rel);
+
+	ListCell *lc = nullptr;
+	ForEach(lc, stat_oids)
+	{
+		OID stat_oid = lfirst_oid(lc);
+
+		if (gpdb::IsExtStatsKindBuilt(stat_oid, STATS_EXT_DEPENDENCIES))
+		{
+			MVDependencies *mv_deps = gpdb::GetMVDependencies(stat_oid);
+			for (ULONG ul = 0; ul < mv_deps->ndeps; ul++)
+			{
+				MVDependency *dep = mv_deps->deps[ul];
+				BOOL has_expr = false;
+				for (INT i = 0; i < dep->nattributes; i++)
+				{
+					has_expr = has_expr || (0 >= dep->attributes[i]);
+				}
+				if (has_expr)
+				{
+					continue;
+				}
+
+				// the last attribute is implied by all the others
+				ULongPtrArray *from_attnos = GPOS_NEW(mp) ULongPtrArray(mp);
+				for (INT i = 0; i < dep->nattributes - 1; i++)
+				{
+					from_attnos->Append(GPOS_NEW(mp) ULONG(dep->attributes[i]));
+				}
+				ULONG to_attno = dep->attributes[dep->nattributes - 1];
+				dependencies->Append(GPOS_NEW(mp) CMDDependency(
+					from_attnos, to_attno, CDouble(dep->degree)));
+			}
+		}
+
+		if (gpdb::IsExtStatsKindBuilt(stat_oid, STATS_EXT_NDISTINCT))
+		{
+			MVNDistinct *mv_ndistinct = gpdb::GetMVNDistinct(stat_oid);
+			for (ULONG ul = 0; ul < mv_ndistinct->nitems; ul++)
+			{
+				MVNDistinctItem *item = &mv_ndistinct->items[ul];
+				BOOL has_expr = false;
+				for (INT i = 0; i < item->nattributes; i++)
+				{
+					has_expr = has_expr || (0 >= item->attributes[i]);
+				}
+				if (has_expr)
+				{
+					continue;
+				}
+
+				ULongPtrArray *attnos = GPOS_NEW(mp) ULongPtrArray(mp);
+				for (INT i = 0; i < item->nattributes; i++)
+				{
+					attnos->Append(GPOS_NEW(mp) ULONG(item->attributes[i]));
+				}
+				ndistincts->Append(GPOS_NEW(mp) CMDNDistinct(
+					attnos, CDouble(item->ndistinct)));
+			}
+		}
+	}
+
+	gpdb::ListFree(stat_oids);
+}
+
 // Retrieve column statistics from relcache
 // If all statistics are missing, create dummy statistics
 // Also, if the statistics are broken, create dummy statistics
@@ -63,11 +63,13 @@ extern "C" {
 #include "naucrates/exception.h"
 #include "naucrates/init.h"
 #include "naucrates/md/CMDIdCast.h"
+#include "naucrates/md/CMDIdColStats.h"
 #include "naucrates/md/CMDIdRelStats.h"
 #include "naucrates/md/CMDIdScCmp.h"
 #include "naucrates/md/CSystemId.h"
 #include "naucrates/md/IMDId.h"
 #include "naucrates/md/IMDRelStats.h"
+#include "naucrates/md/IMDRelation.h"
 #include "naucrates/traceflags/traceflags.h"
 
 using namespace gpos;
@@ -85,6 +87,251 @@ using namespace gpdbcost;
 const CSystemId default_sysid(IMDId::EmdidGPDB, GPOS_WSZ_STR_LENGTH("GPDB"));
 
 
+//---------------------------------------------------------------------------
+//	@struct:
+//		SMDCacheInvalidationCtxt
+//
+//	@doc:
+//		Catalog changes to apply to the metadata cache, along with the
+//		relations whose statistics they make stale
+//
+//---------------------------------------------------------------------------
+struct SMDCacheInvalidationCtxt
+{
+	// memory pool for the relation sets
+	CMemoryPool *m_mp;
+
+	// invalidations recorded since the last optimized query
+	gpdb::MDCacheInvalidation *m_invalidations;
+	INT m_num_invalidations;
+
+	// was any relation invalidated?
+	BOOL m_has_relcache_inval;
+
+	// was any type, operator or function invalidated?
+	BOOL m_has_syscache_inval;
+
+	// was any pg_statistic row changed?
+	BOOL m_has_stats_inval;
+
+	// relations currently in the cache
+	UlongToUlongMap *m_cached_rels;
+
+	// relations whose statistics must be evicted
+	UlongToUlongMap *m_stale_stats_rels;
+};
+
+// add an oid to a set of relations
+static void
+AddRelOid(CMemoryPool *mp, UlongToUlongMap *rels, OID oid)
+{
+	if (nullptr == rels->Find(&oid))
+	{
+		rels->Insert(GPOS_NEW(mp) ULONG(oid), GPOS_NEW(mp) ULONG(oid));
+	}
+}
+
+// oid of a metadata object identified by a GPDB mdid
+static OID
+MDObjectOid(const IMDId *mdid)
+{
+	return CMDIdGPDB::CastMdid(mdid)->Oid();
+}
+
+// was the given relation invalidated in the relcache?
+static BOOL
+FRelcacheInvalidated(const SMDCacheInvalidationCtxt *ctxt, OID oid)
+{
+	for (INT i = 0; i < ctxt->m_num_invalidations; i++)
+	{
+		if (gpdb::MDCacheRelcacheInvalidation ==
+				ctxt->m_invalidations[i].cacheid &&
+			oid == ctxt->m_invalidations[i].relid)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// was the syscache entry with the given keys invalidated?
+static BOOL
+FSyscacheInvalidated(const SMDCacheInvalidationCtxt *ctxt, INT cacheid,
+					 Datum key1, Datum key2, Datum key3)
+{
+	BOOL fHashed = false;
+	uint32 hashvalue = 0;
+
+	for (INT i = 0; i < ctxt->m_num_invalidations; i++)
+	{
+		if (cacheid != ctxt->m_invalidations[i].cacheid)
+		{
+			continue;
+		}
+
+		// only hash the keys if there is anything to compare against
+		if (!fHashed)
+		{
+			hashvalue = gpdb::GetSysCacheHashValue(cacheid, key1, key2, key3);
+			fHashed = true;
+		}
+
+		if (hashvalue == ctxt->m_invalidations[i].hashvalue)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// was the catalog entry of the given oid invalidated?
+static BOOL
+FOidInvalidated(const SMDCacheInvalidationCtxt *ctxt, INT cacheid, OID oid)
+{
+	return FSyscacheInvalidated(ctxt, cacheid, ObjectIdGetDatum(oid), 0, 0);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		FCollectStaleStatsRels
+//
+//	@doc:
+//		Cache scan callback that evicts nothing, but records the cached
+//		relations and the ones whose statistics are no longer valid:
+//		relations with changed pg_statistic rows, and partitioned tables
+//		when any relation changed, as their statistics are derived from
+//		the leaf partitions
+//
+//---------------------------------------------------------------------------
+static BOOL
+FCollectStaleStatsRels(IMDCacheObject *pmdobj, void *ptr)
+{
+	SMDCacheInvalidationCtxt *ctxt = (SMDCacheInvalidationCtxt *) ptr;
+
+	if (IMDCacheObject::EmdtRel != pmdobj->MDType() ||
+		IMDId::EmdidGPDB != pmdobj->MDId()->MdidType())
+	{
+		return false;
+	}
+
+	CMemoryPool *mp = ctxt->m_mp;
+	const IMDRelation *pmdrel = dynamic_cast<IMDRelation *>(pmdobj);
+	OID oid = MDObjectOid(pmdrel->MDId());
+
+	AddRelOid(mp, ctxt->m_cached_rels, oid);
+
+	if (ctxt->m_has_relcache_inval && pmdrel->IsPartitioned())
+	{
+		AddRelOid(mp, ctxt->m_stale_stats_rels, oid);
+		return false;
+	}
+
+	if (ctxt->m_has_stats_inval)
+	{
+		const ULONG ulCols = pmdrel->ColumnCount();
+		for (ULONG ul = 0; ul < ulCols; ul++)
+		{
+			INT attno = pmdrel->GetMdCol(ul)->AttrNum();
+			if (0 >= attno)
+			{
+				continue;
+			}
+
+			if (FSyscacheInvalidated(ctxt, STATRELATTINH,
+									 ObjectIdGetDatum(oid),
+									 Int16GetDatum(attno), BoolGetDatum(false)) ||
+				FSyscacheInvalidated(ctxt, STATRELATTINH,
+									 ObjectIdGetDatum(oid),
+									 Int16GetDatum(attno), BoolGetDatum(true)))
+			{
+				AddRelOid(mp, ctxt->m_stale_stats_rels, oid);
+				break;
+			}
+		}
+	}
+
+	return false;
+}
+
+// are the statistics of the given relation stale?
+static BOOL
+FStatsInvalidated(const SMDCacheInvalidationCtxt *ctxt, const IMDId *rel_mdid)
+{
+	OID oid = MDObjectOid(rel_mdid);
+
+	if (nullptr != ctxt->m_stale_stats_rels->Find(&oid) ||
+		FRelcacheInvalidated(ctxt, oid))
+	{
+		return true;
+	}
+
+	// without the relation we cannot map pg_statistic changes to columns
+	return ctxt->m_has_stats_inval && nullptr == ctxt->m_cached_rels->Find(&oid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		FMDCacheObjectInvalidated
+//
+//	@doc:
+//		Cache scan callback that decides whether a cached metadata object
+//		is affected by the recorded catalog changes
+//
+//---------------------------------------------------------------------------
+static BOOL
+FMDCacheObjectInvalidated(IMDCacheObject *pmdobj, void *ptr)
+{
+	const SMDCacheInvalidationCtxt *ctxt = (SMDCacheInvalidationCtxt *) ptr;
+	const IMDId *mdid = pmdobj->MDId();
+
+	switch (pmdobj->MDType())
+	{
+		case IMDCacheObject::EmdtRel:
+		case IMDCacheObject::EmdtInd:
+			return ctxt->m_has_relcache_inval &&
+				   FRelcacheInvalidated(ctxt, MDObjectOid(mdid));
+
+		case IMDCacheObject::EmdtTrigger:
+			// trigger changes are announced through their relation only
+			return ctxt->m_has_relcache_inval;
+
+		case IMDCacheObject::EmdtType:
+			return FOidInvalidated(ctxt, TYPEOID, MDObjectOid(mdid));
+
+		case IMDCacheObject::EmdtOp:
+			return FOidInvalidated(ctxt, OPEROID, MDObjectOid(mdid));
+
+		case IMDCacheObject::EmdtFunc:
+			return FOidInvalidated(ctxt, PROCOID, MDObjectOid(mdid));
+
+		case IMDCacheObject::EmdtAgg:
+			return FOidInvalidated(ctxt, AGGFNOID, MDObjectOid(mdid)) ||
+				   FOidInvalidated(ctxt, PROCOID, MDObjectOid(mdid));
+
+		case IMDCacheObject::EmdtCheckConstraint:
+			return FOidInvalidated(ctxt, CONSTROID, MDObjectOid(mdid));
+
+		case IMDCacheObject::EmdtCastFunc:
+		case IMDCacheObject::EmdtScCmp:
+			// derived from several types, operators and functions
+			return ctxt->m_has_syscache_inval;
+
+		case IMDCacheObject::EmdtRelStats:
+			return FStatsInvalidated(
+				ctxt, CMDIdRelStats::CastMdid(mdid)->GetRelMdId());
+
+		case IMDCacheObject::EmdtColStats:
+			return FStatsInvalidated(
+				ctxt, CMDIdColStats::CastMdid(mdid)->GetRelMdId());
+
+		default:
+			return true;
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		SOptContext::SOptContext
@@ -463,6 +710,66 @@ COptTasks::GetCostModel(CMemoryPool *mp, ULONG num_segments)
 	return cost_model;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::EvictInvalidatedMDCacheEntries
+//
+//	@doc:
+//		Evict the metadata cache entries affected by the catalog changes
+//		recorded since the last optimized query
+//
+//---------------------------------------------------------------------------
+void
+COptTasks::EvictInvalidatedMDCacheEntries(CMemoryPool *mp)
+{
+	SMDCacheInvalidationCtxt ctxt;
+	ctxt.m_invalidations =
+		gpdb::MDCacheConsumeInvalidations(&ctxt.m_num_invalidations);
+
+	if (0 == ctxt.m_num_invalidations)
+	{
+		return;
+	}
+
+	ctxt.m_has_relcache_inval = false;
+	ctxt.m_has_syscache_inval = false;
+	ctxt.m_has_stats_inval = false;
+	for (INT i = 0; i < ctxt.m_num_invalidations; i++)
+	{
+		switch (ctxt.m_invalidations[i].cacheid)
+		{
+			case gpdb::MDCacheRelcacheInvalidation:
+				ctxt.m_has_relcache_inval = true;
+				break;
+			case STATRELATTINH:
+				ctxt.m_has_stats_inval = true;
+				break;
+			case TYPEOID:
+			case OPEROID:
+			case PROCOID:
+			case AGGFNOID:
+				ctxt.m_has_syscache_inval = true;
+				break;
+			default:
+				break;
+		}
+	}
+
+	ctxt.m_mp = mp;
+	ctxt.m_cached_rels = GPOS_NEW(mp) UlongToUlongMap(mp);
+	ctxt.m_stale_stats_rels = GPOS_NEW(mp) UlongToUlongMap(mp);
+
+	if (ctxt.m_has_relcache_inval || ctxt.m_has_stats_inval)
+	{
+		(void) CMDCache::EvictEntries(FCollectStaleStatsRels, &ctxt);
+	}
+	(void) CMDCache::EvictEntries(FMDCacheObjectInvalidated, &ctxt);
+
+	ctxt.m_cached_rels->Release();
+	ctxt.m_stale_stats_rels->Release();
+	gpdb::GPDBFree(ctxt.m_invalidations);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::OptimizeTask
@@ -503,10 +810,16 @@ COptTasks::OptimizeTask(void *ptr)
 		CMDCache::Reset();
 		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
 	}
-	else if (CMDCache::ULLGetCacheQuota() !=
-			 (ULLONG) optimizer_mdcache_size * 1024L)
+	else
 	{
-		CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		// only drop the entries affected by catalog changes
+		EvictInvalidatedMDCacheEntries(mp);
+
+		if (CMDCache::ULLGetCacheQuota() !=
+			(ULLONG) optimizer_mdcache_size * 1024L)
+		{
+			CMDCache::SetCacheQuota(optimizer_mdcache_size * 1024L);
+		}
 	}
 
 
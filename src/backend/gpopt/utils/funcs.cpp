@@ -18,7 +18,9 @@
 extern "C" {
 #include "postgres.h"
 
+#include "access/htup_details.h"
 #include "fmgr.h"
+#include "funcapi.h"
 #include "lib/stringinfo.h"
 #include "utils/builtins.h"
 }
@@ -26,6 +28,7 @@ extern "C" {
 #include "gpos/_api.h"
 
 #include "gpopt/gpdbwrappers.h"
+#include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/utils/COptTasks.h"
 #include "gpopt/utils/funcs.h"
 
@@ -117,3 +120,41 @@ LibraryVersion()
 	PG_RETURN_TEXT_P(result);
 }
 }
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		MDCacheStats
+//
+//	@doc:
+//		Returns the usage statistics of the metadata cache of this backend
+//
+//---------------------------------------------------------------------------
+extern "C" {
+Datum
+MDCacheStats(PG_FUNCTION_ARGS)
+{
+	TupleDesc tupdesc;
+	if (get_call_result_type(fcinfo, nullptr, &tupdesc) != TYPEFUNC_COMPOSITE)
+	{
+		elog(ERROR, "return type must be a row type");
+	}
+
+	Datum values[6];
+	bool nulls[6] = {false, false, false, false, false, false};
+
+	values[0] = Int64GetDatum((int64) CMDCache::ULLGetCacheEntries());
+	values[1] = Int64GetDatum((int64) CMDCache::ULLGetCacheHits());
+	values[2] = Int64GetDatum((int64) CMDCache::ULLGetCacheMisses());
+	values[3] = Int64GetDatum((int64) CMDCache::ULLGetCacheInvalidations());
+	values[4] = Int64GetDatum(
+		CMDCache::FInitialized()
+			? (int64) CMDCache::ULLGetCacheEvictionCounter()
+			: 0);
+	values[5] = Int64GetDatum((int64) CMDCache::ULLGetCacheResets());
+
+	HeapTuple tuple = heap_form_tuple(tupdesc, values, nulls);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
+}
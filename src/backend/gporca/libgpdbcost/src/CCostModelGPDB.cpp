@@ -27,9 +27,11 @@
 #include "gpopt/operators/CPhysicalHashAgg.h"
 #include "gpopt/operators/CPhysicalIndexOnlyScan.h"
 #include "gpopt/operators/CPhysicalIndexScan.h"
+#include "gpopt/operators/CPhysicalInnerIndexNLJoin.h"
 #include "gpopt/operators/CPhysicalMotion.h"
 #include "gpopt/operators/CPhysicalPartitionSelector.h"
 #include "gpopt/operators/CPhysicalSequenceProject.h"
+#include "gpopt/operators/CPhysicalSort.h"
 #include "gpopt/operators/CPhysicalUnionAll.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/operators/CScalarBitmapIndexProbe.h"
@@ -641,9 +643,32 @@ CCostModelGPDB::CostSort(CMemoryPool *mp, CExpressionHandle &exprhdl,
 			->Get();
 	GPOS_ASSERT(0 < dSortTupWidthCost);
 
+	// an incremental sort only sorts the groups of rows with equal values
+	// of the presorted columns, each of them with n*log(n) complexity
+	CDouble rows_per_group = rows;
+	CPhysicalSort *popSort = CPhysicalSort::PopConvert(exprhdl.Pop());
+	if (popSort->FIncremental() && 0 < pci->ChildCount())
+	{
+		CDouble groups(1.0);
+		for (ULONG ul = 0; ul < popSort->UlPresortedCols(); ul++)
+		{
+			// NDV < 1 implies there are no stats for the column, in which
+			// case no benefit is assumed
+			CDouble ndv = pci->Pcstats(0)->GetNDVs(popSort->Pos()->Pcr(ul));
+			if (ndv < 1.0)
+			{
+				groups = 1.0;
+				break;
+			}
+			groups = groups * ndv;
+		}
+		groups = std::min(groups.Get(), rows.Get());
+		rows_per_group = CDouble(std::max(2.0, (rows / groups).Get()));
+	}
+
 	// sort cost is correlated with the number of rows and width of input tuples. We use n*log(n) for sorting complexity.
-	CCost costLocal =
-		CCost(num_rebinds * (rows * rows.Log2() * width * dSortTupWidthCost));
+	CCost costLocal = CCost(num_rebinds * (rows * rows_per_group.Log2() *
+										   width * dSortTupWidthCost));
 	CCost costChild =
 		CostChildren(mp, exprhdl, pci, pcmgpdb->GetCostModelParams());
 
@@ -1129,14 +1154,65 @@ CCostModelGPDB::CostIndexNLJoin(CMemoryPool *mp, CExpressionHandle &exprhdl,
 	CCost costChild =
 		CostChildren(mp, exprhdl, pci, pcmgpdb->GetCostModelParams());
 
+	BOOL fInnerJoin =
+		COperator::EopPhysicalInnerIndexNLJoin == exprhdl.Pop()->Eopid();
+	if (fInnerJoin &&
+		CPhysicalInnerIndexNLJoin::PopConvert(exprhdl.Pop())->FMemoize())
+	{
+		// the inner child is cached by the values of the outer references,
+		// so it is only executed once per distinct value; on top of that,
+		// every outer tuple probes the cache and every miss stores the
+		// inner tuples in it
+		CColRefArray *pdrgpcrOuterRefs =
+			CPhysicalInnerIndexNLJoin::PopConvert(exprhdl.Pop())
+				->PdrgPcrOuterRefs();
+		const CDouble dNumRowsOuter = std::max(1.0, num_rows_outer);
+		CDouble dDistinct = 1.0;
+		for (ULONG ul = 0; ul < pdrgpcrOuterRefs->Size(); ul++)
+		{
+			// NDV < 1 implies there are no stats for the column, in which
+			// case every outer tuple is assumed to miss the cache
+			CDouble ndv = pci->Pcstats(0)->GetNDVs((*pdrgpcrOuterRefs)[ul]);
+			if (ndv < 1.0)
+			{
+				dDistinct = dNumRowsOuter;
+				break;
+			}
+			dDistinct = dDistinct * ndv;
+		}
+		dDistinct = std::min(dDistinct.Get(), dNumRowsOuter.Get());
+		const CDouble dMissRatio = dDistinct / dNumRowsOuter;
+
+		const CDouble dProbeCostUnit =
+			pcmgpdb->GetCostModelParams()
+				->PcpLookup(
+					CCostModelParamsGPDB::EcpHashAggInputTupColumnCostUnit)
+				->Get();
+		const CDouble dMaterializeCostUnit =
+			pcmgpdb->GetCostModelParams()
+				->PcpLookup(CCostModelParamsGPDB::EcpMaterializeCostUnit)
+				->Get();
+		GPOS_ASSERT(0 < dProbeCostUnit);
+		GPOS_ASSERT(0 < dMaterializeCostUnit);
+
+		const DOUBLE dCostInner = pci->PdCost()[1];
+		costChild = CCost(costChild.Get() -
+						  (1.0 - dMissRatio.Get()) * dCostInner);
+		costLocal = costLocal +
+					CCost(pci->NumRebinds() *
+						  (dNumRowsOuter * pdrgpcrOuterRefs->Size() *
+							   dProbeCostUnit +
+						   dDistinct * pci->PdRows()[1] * pci->GetWidth()[1] *
+							   dMaterializeCostUnit)
+							  .Get());
+	}
+
 	ULONG risk = pci->Pcstats()->StatsEstimationRisk();
 	ULONG ulPenalizationFactor = 1;
 	const CDouble dIndexJoinAllowedRiskThreshold =
 		pcmgpdb->GetCostModelParams()
 			->PcpLookup(CCostModelParamsGPDB::EcpIndexJoinAllowedRiskThreshold)
 			->Get();
-	BOOL fInnerJoin =
-		COperator::EopPhysicalInnerIndexNLJoin == exprhdl.Pop()->Eopid();
 
 	// Only apply penalize factor for inner index nestloop join, because we are more confident
 	// on the cardinality estimation of outer join than inner join. So don't penalize outer join
@@ -195,6 +195,12 @@ public:
 	// check if order specs satisfies req'd spec
 	BOOL FSatisfies(const COrderSpec *pos) const;
 
+	// number of leading components that match the ones of the given spec
+	ULONG UlCommonPrefix(const COrderSpec *pos) const;
+
+	// return an order spec made of the first given number of components
+	COrderSpec *PosPrefix(CMemoryPool *mp, ULONG ulLength) const;
+
 	// append enforcers to dynamic array for the given plan properties
 	void AppendEnforcers(CMemoryPool *mp, CExpressionHandle &exprhdl,
 						 CReqdPropPlan *prpp, CExpressionArray *pdrgpexpr,
@@ -45,6 +45,18 @@ private:
 	// the maximum size of the cache
 	static ULLONG m_ullCacheQuota;
 
+	// number of lookups served from the cache
+	static ULLONG m_ullCacheHits;
+
+	// number of lookups that had to go to the metadata provider
+	static ULLONG m_ullCacheMisses;
+
+	// number of entries evicted because of catalog invalidations
+	static ULLONG m_ullCacheInvalidations;
+
+	// number of times the whole cache was reset
+	static ULLONG m_ullCacheResets;
+
 	// private ctor
 	CMDCache() = default;
 
@@ -79,6 +91,56 @@ public:
 	// reset global instance
 	static void Reset();
 
+	// evict the entries satisfying the given predicate, returns the number
+	// of evicted entries
+	static ULONG EvictEntries(CMDAccessor::MDCache::EvictPredicatePtr pfEvict,
+							  void *ctx);
+
+	// record the outcome of a cache lookup
+	static void
+	RecordLookup(BOOL fHit)
+	{
+		if (fHit)
+		{
+			m_ullCacheHits++;
+		}
+		else
+		{
+			m_ullCacheMisses++;
+		}
+	}
+
+	// get the number of lookups served from the cache
+	static ULLONG
+	ULLGetCacheHits()
+	{
+		return m_ullCacheHits;
+	}
+
+	// get the number of lookups not served from the cache
+	static ULLONG
+	ULLGetCacheMisses()
+	{
+		return m_ullCacheMisses;
+	}
+
+	// get the number of entries evicted because of catalog invalidations
+	static ULLONG
+	ULLGetCacheInvalidations()
+	{
+		return m_ullCacheInvalidations;
+	}
+
+	// get the number of times the whole cache was reset
+	static ULLONG
+	ULLGetCacheResets()
+	{
+		return m_ullCacheResets;
+	}
+
+	// get the number of entries currently in the cache
+	static ULLONG ULLGetCacheEntries();
+
 	// global accessor
 	static CMDAccessor::MDCache *
 	Pcache()
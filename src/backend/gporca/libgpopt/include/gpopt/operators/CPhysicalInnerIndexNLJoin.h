@@ -34,12 +34,17 @@ private:
 	// a copy of the original join predicate that has been pushed down to the inner side
 	CExpression *m_origJoinPred;
 
+	// cache the rows of the inner child by the values of the outer
+	// references, so that the index is only probed once per distinct value
+	BOOL m_fMemoize;
+
 public:
 	CPhysicalInnerIndexNLJoin(const CPhysicalInnerIndexNLJoin &) = delete;
 
 	// ctor
 	CPhysicalInnerIndexNLJoin(CMemoryPool *mp, CColRefArray *colref_array,
-							  CExpression *origJoinPred);
+							  CExpression *origJoinPred,
+							  BOOL fMemoize = false);
 
 	// dtor
 	~CPhysicalInnerIndexNLJoin() override;
@@ -103,6 +108,16 @@ public:
 		return m_origJoinPred;
 	}
 
+	// is the inner child cached by the values of the outer references
+	BOOL
+	FMemoize() const
+	{
+		return m_fMemoize;
+	}
+
+	// print
+	IOstream &OsPrint(IOstream &os) const override;
+
 };	// class CPhysicalInnerIndexNLJoin
 
 }  // namespace gpopt
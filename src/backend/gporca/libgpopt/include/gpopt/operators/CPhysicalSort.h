@@ -36,11 +36,16 @@ private:
 	// columns used by order spec
 	CColRefSet *m_pcrsSort;
 
+	// number of leading sort columns the input is already sorted on;
+	// if non-zero, only the groups of equal values of those columns are
+	// sorted (incremental sort)
+	ULONG m_ulPresortedCols;
+
 public:
 	CPhysicalSort(const CPhysicalSort &) = delete;
 
 	// ctor
-	CPhysicalSort(CMemoryPool *mp, COrderSpec *pos);
+	CPhysicalSort(CMemoryPool *mp, COrderSpec *pos, ULONG ulPresortedCols = 0);
 
 	// dtor
 	~CPhysicalSort() override;
@@ -59,6 +64,20 @@ public:
 		return m_pos;
 	}
 
+	// number of presorted leading sort columns
+	ULONG
+	UlPresortedCols() const
+	{
+		return m_ulPresortedCols;
+	}
+
+	// is this an incremental sort
+	BOOL
+	FIncremental() const
+	{
+		return 0 < m_ulPresortedCols;
+	}
+
 	// return a string for operator name
 	const CHAR *
 	SzId() const override
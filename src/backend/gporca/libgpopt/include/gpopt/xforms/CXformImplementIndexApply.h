@@ -15,6 +15,8 @@
 #include "gpopt/operators/CPhysicalLeftOuterIndexNLJoin.h"
 #include "gpopt/operators/CPhysicalNLJoin.h"
 #include "gpopt/xforms/CXformImplementation.h"
+#include "naucrates/md/IMDType.h"
+#include "naucrates/traceflags/traceflags.h"
 
 namespace gpopt
 {
@@ -23,6 +25,29 @@ using namespace gpos;
 class CXformImplementIndexApply : public CXformImplementation
 {
 private:
+	// can the inner child be cached by the values of the given outer
+	// references; the executor needs them as parameters and hashable
+	static BOOL
+	FMemoizable(CColRefArray *colref_array)
+	{
+		if (!GPOS_FTRACE(EopttraceEnableMemoize) ||
+			!GPOS_FTRACE(EopttraceIndexedNLJOuterRefAsParams) ||
+			0 == colref_array->Size())
+		{
+			return false;
+		}
+
+		for (ULONG ul = 0; ul < colref_array->Size(); ul++)
+		{
+			if (!(*colref_array)[ul]->RetrieveType()->IsHashable())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 public:
 	CXformImplementIndexApply(const CXformImplementIndexApply &) = delete;
 
@@ -107,6 +132,24 @@ public:
 
 		// add alternative to results
 		pxfres->Add(pexprResult);
+
+		// for inner joins, also add an alternative that caches the inner
+		// child by the values of the outer references and leave the choice
+		// to the cost model
+		if (!indexApply->FouterJoin() && FMemoizable(colref_array))
+		{
+			colref_array->AddRef();
+			pexprOuter->AddRef();
+			pexprInner->AddRef();
+			pexprScalar->AddRef();
+			CExpression *pexprMemoize = GPOS_NEW(mp) CExpression(
+				mp,
+				GPOS_NEW(mp) CPhysicalInnerIndexNLJoin(
+					mp, colref_array, indexApply->OrigJoinPred(),
+					true /*fMemoize*/),
+				pexprOuter, pexprInner, pexprScalar);
+			pxfres->Add(pexprMemoize);
+		}
 	}
 
 };	// class CXformImplementIndexApply
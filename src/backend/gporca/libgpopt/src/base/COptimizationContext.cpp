@@ -277,6 +277,16 @@ COptimizationContext::FOptimizeSort(CMemoryPool *,		 // mp
 
 	CPhysicalSort *pop = CPhysicalSort::PopConvert(pgexprSort->Pop());
 
+	// an incremental sort requires its presorted prefix from its own group;
+	// optimizing it for a context asking for no more than that prefix would
+	// make it optimize the same group with the same context
+	if (pop->FIncremental() &&
+		pop->UlPresortedCols() >=
+			poc->Prpp()->Peo()->PosRequired()->UlSortColumns())
+	{
+		return false;
+	}
+
 	return poc->Prpp()->Peo()->FCompatible(
 		const_cast<COrderSpec *>(pop->Pos()));
 }
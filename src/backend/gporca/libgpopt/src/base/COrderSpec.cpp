@@ -12,8 +12,11 @@
 #include "gpopt/base/COrderSpec.h"
 
 #include "gpopt/base/CColRefSet.h"
+#include "gpopt/base/CDrvdPropPlan.h"
 #include "gpopt/base/COptCtxt.h"
+#include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CPhysicalSort.h"
+#include "naucrates/traceflags/traceflags.h"
 
 #ifdef GPOS_DEBUG
 #include "gpos/error/CAutoTrace.h"
@@ -185,17 +188,72 @@ COrderSpec::FSatisfies(const COrderSpec *pos) const
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COrderSpec::UlCommonPrefix
+//
+//	@doc:
+//		Number of leading components that match the ones of the given
+//		order spec
+//
+//---------------------------------------------------------------------------
+ULONG
+COrderSpec::UlCommonPrefix(const COrderSpec *pos) const
+{
+	GPOS_ASSERT(nullptr != pos);
+
+	const ULONG ulMax =
+		std::min(m_pdrgpoe->Size(), pos->m_pdrgpoe->Size());
+
+	ULONG ul = 0;
+	while (ul < ulMax && (*m_pdrgpoe)[ul]->Matches((*(pos->m_pdrgpoe))[ul]))
+	{
+		ul++;
+	}
+
+	return ul;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COrderSpec::PosPrefix
+//
+//	@doc:
+//		Return an order spec made of the first given number of components
+//
+//---------------------------------------------------------------------------
+COrderSpec *
+COrderSpec::PosPrefix(CMemoryPool *mp, ULONG ulLength) const
+{
+	GPOS_ASSERT(ulLength <= m_pdrgpoe->Size());
+
+	COrderSpec *pos = GPOS_NEW(mp) COrderSpec(mp);
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		COrderExpression *poe = (*m_pdrgpoe)[ul];
+		IMDId *mdid = poe->GetMdIdSortOp();
+		mdid->AddRef();
+		pos->Append(mdid, poe->Pcr(), poe->Ent());
+	}
+
+	return pos;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COrderSpec::AppendEnforcers
 //
 //	@doc:
-//		Add required enforcers enforcers to dynamic array
+//		Add required enforcers enforcers to dynamic array; if the
+//		expression already delivers a prefix of the required order, an
+//		incremental sort that only sorts the groups of equal prefix values
+//		is added as an alternative to the full sort
 //
 //---------------------------------------------------------------------------
 void
-COrderSpec::AppendEnforcers(CMemoryPool *mp,
-							CExpressionHandle &,  // exprhdl
+COrderSpec::AppendEnforcers(CMemoryPool *mp, CExpressionHandle &exprhdl,
 							CReqdPropPlan *
 #ifdef GPOS_DEBUG
 								prpp
@@ -215,6 +273,22 @@ COrderSpec::AppendEnforcers(CMemoryPool *mp,
 	CExpression *pexprSort = GPOS_NEW(mp)
 		CExpression(mp, GPOS_NEW(mp) CPhysicalSort(mp, this), pexpr);
 	pdrgpexpr->Append(pexprSort);
+
+	if (GPOS_FTRACE(EopttraceEnableIncrementalSort))
+	{
+		COrderSpec *posDelivered =
+			CDrvdPropPlan::Pdpplan(exprhdl.Pdp())->Pos();
+		const ULONG ulPresortedCols = UlCommonPrefix(posDelivered);
+		if (0 < ulPresortedCols && ulPresortedCols < UlSortColumns())
+		{
+			AddRef();
+			pexpr->AddRef();
+			CExpression *pexprIncrementalSort = GPOS_NEW(mp) CExpression(
+				mp, GPOS_NEW(mp) CPhysicalSort(mp, this, ulPresortedCols),
+				pexpr);
+			pdrgpexpr->Append(pexprIncrementalSort);
+		}
+	}
 }
 
 
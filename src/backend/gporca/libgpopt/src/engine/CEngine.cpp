@@ -548,9 +548,11 @@ CEngine::FOptimizeChild(
 
 	if (nullptr != pgexprParent &&
 		COperator::EopPhysicalSort == pgexprParent->Pop()->Eopid() &&
+		!CPhysicalSort::PopConvert(pgexprParent->Pop())->FIncremental() &&
 		COperator::EopPhysicalMotionGather == popChild->Eopid())
 	{
-		// prevent (Sort --> GatherMerge), since Sort destroys order maintained by GatherMerge
+		// prevent (Sort --> GatherMerge), since Sort destroys order maintained by GatherMerge;
+		// an incremental sort builds on that order instead
 		return !CPhysicalMotionGather::PopConvert(popChild)->FOrderPreserving();
 	}
 
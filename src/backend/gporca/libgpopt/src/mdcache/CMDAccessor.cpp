@@ -23,6 +23,7 @@
 #include "gpopt/base/CColRefTable.h"
 #include "gpopt/exception.h"
 #include "gpopt/mdcache/CMDAccessorUtils.h"
+#include "gpopt/mdcache/CMDCache.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CMDIdCast.h"
@@ -509,6 +510,10 @@ CMDAccessor::GetImdObj(IMDId *mdid)
 		a_pmdcacc = GPOS_NEW(m_mp) CacheAccessorMD(m_pcache);
 		a_pmdcacc->Lookup(&mdkey);
 		IMDCacheObject *pmdobjNew = a_pmdcacc->Val();
+		if (CMDCache::Pcache() == m_pcache)
+		{
+			CMDCache::RecordLookup(nullptr != pmdobjNew);
+		}
 		if (nullptr == pmdobjNew)
 		{
 			// object not found in MD cache: retrieve it from MD provider
@@ -1076,6 +1081,10 @@ CMDAccessor::Pstats(CMemoryPool *mp, IMDId *rel_mdid, CColRefSet *pcrsHist,
 		GPOS_NEW(mp) UlongToHistogramMap(mp);
 	UlongToDoubleMap *colid_width_mapping = GPOS_NEW(mp) UlongToDoubleMap(mp);
 
+	// attribute number -> column id of the user columns, used to map the
+	// extended statistics of the relation to the columns of the query
+	UlongToUlongMap *attno_to_colid = GPOS_NEW(mp) UlongToUlongMap(mp);
+
 	CColRefSetIter crsiHist(*pcrsHist);
 	while (crsiHist.Advance())
 	{
@@ -1092,6 +1101,12 @@ CMDAccessor::Pstats(CMemoryPool *mp, IMDId *rel_mdid, CColRefSet *pcrsHist,
 		RecordColumnStats(mp, rel_mdid, colid, ulPos, pcrtable->IsSystemCol(),
 						  fEmptyTable, col_histogram_mapping,
 						  colid_width_mapping, stats_config);
+
+		if (!pcrtable->IsSystemCol())
+		{
+			attno_to_colid->Insert(GPOS_NEW(mp) ULONG(attno),
+								   GPOS_NEW(mp) ULONG(colid));
+		}
 	}
 
 	// extract column widths
@@ -1115,9 +1130,18 @@ CMDAccessor::Pstats(CMemoryPool *mp, IMDId *rel_mdid, CColRefSet *pcrsHist,
 
 	CDouble rows = std::max(DOUBLE(1.0), pmdRelStats->Rows().Get());
 
-	return GPOS_NEW(mp) CStatistics(
+	CStatistics *stats = GPOS_NEW(mp) CStatistics(
 		mp, col_histogram_mapping, colid_width_mapping, rows, fEmptyTable,
 		pmdRelStats->RelPages(), pmdRelStats->RelAllVisible());
+
+	if (GPOS_FTRACE(EopttraceEnableExtendedStats) && !fEmptyTable)
+	{
+		stats->SetExtendedStats(CExtendedStats::CreateExtendedStats(
+			mp, pmdRelStats, attno_to_colid, rows));
+	}
+	attno_to_colid->Release();
+
+	return stats;
 }
 
 
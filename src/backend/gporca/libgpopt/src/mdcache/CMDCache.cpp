@@ -25,6 +25,12 @@ CMDAccessor::MDCache *CMDCache::m_pcache = nullptr;
 // maximum size of the cache
 ULLONG CMDCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
 
+// cache usage statistics, kept across resets
+ULLONG CMDCache::m_ullCacheHits = 0;
+ULLONG CMDCache::m_ullCacheMisses = 0;
+ULLONG CMDCache::m_ullCacheInvalidations = 0;
+ULLONG CMDCache::m_ullCacheResets = 0;
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Init
@@ -123,6 +129,47 @@ CMDCache::Reset()
 {
 	Shutdown();
 	Init();
+	m_ullCacheResets++;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::EvictEntries
+//
+//	@doc:
+//		Evict the entries satisfying the given predicate, leaving the rest
+//		of the cache intact
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDCache::EvictEntries(CMDAccessor::MDCache::EvictPredicatePtr pfEvict,
+					   void *ctx)
+{
+	GPOS_ASSERT(nullptr != m_pcache);
+
+	ULONG ulEvicted = m_pcache->EvictMatchingEntries(pfEvict, ctx);
+	m_ullCacheInvalidations += ulEvicted;
+
+	return ulEvicted;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheEntries
+//
+//	@doc:
+//		Get the number of entries currently in the cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheEntries()
+{
+	if (nullptr == m_pcache)
+	{
+		return 0;
+	}
+
+	return m_pcache->Size();
 }
 
 ULLONG
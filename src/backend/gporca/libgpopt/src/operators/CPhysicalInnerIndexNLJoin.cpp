@@ -36,10 +36,12 @@ using namespace gpopt;
 //---------------------------------------------------------------------------
 CPhysicalInnerIndexNLJoin::CPhysicalInnerIndexNLJoin(CMemoryPool *mp,
 													 CColRefArray *colref_array,
-													 CExpression *origJoinPred)
+													 CExpression *origJoinPred,
+													 BOOL fMemoize)
 	: CPhysicalInnerNLJoin(mp),
 	  m_pdrgpcrOuterRefs(colref_array),
-	  m_origJoinPred(origJoinPred)
+	  m_origJoinPred(origJoinPred),
+	  m_fMemoize(fMemoize)
 {
 	GPOS_ASSERT(nullptr != colref_array);
 	if (nullptr != origJoinPred)
@@ -77,8 +79,10 @@ CPhysicalInnerIndexNLJoin::Matches(COperator *pop) const
 {
 	if (pop->Eopid() == Eopid())
 	{
-		return m_pdrgpcrOuterRefs->Equals(
-			CPhysicalInnerIndexNLJoin::PopConvert(pop)->PdrgPcrOuterRefs());
+		CPhysicalInnerIndexNLJoin *popIndexNLJ =
+			CPhysicalInnerIndexNLJoin::PopConvert(pop);
+		return m_fMemoize == popIndexNLJ->FMemoize() &&
+			   m_pdrgpcrOuterRefs->Equals(popIndexNLJ->PdrgPcrOuterRefs());
 	}
 
 	return false;
@@ -186,4 +190,24 @@ CPhysicalInnerIndexNLJoin::Ped(CMemoryPool *mp, CExpressionHandle &exprhdl,
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysicalInnerIndexNLJoin::OsPrint
+//
+//	@doc:
+//		Debug print
+//
+//---------------------------------------------------------------------------
+IOstream &
+CPhysicalInnerIndexNLJoin::OsPrint(IOstream &os) const
+{
+	os << SzId();
+	if (m_fMemoize)
+	{
+		os << " (Memoize)";
+	}
+
+	return os;
+}
+
 // EOF
@@ -28,12 +28,15 @@ using namespace gpopt;
 //		Ctor
 //
 //---------------------------------------------------------------------------
-CPhysicalSort::CPhysicalSort(CMemoryPool *mp, COrderSpec *pos)
+CPhysicalSort::CPhysicalSort(CMemoryPool *mp, COrderSpec *pos,
+							 ULONG ulPresortedCols)
 	: CPhysical(mp),
 	  m_pos(pos),  // caller must add-ref pos
-	  m_pcrsSort(nullptr)
+	  m_pcrsSort(nullptr),
+	  m_ulPresortedCols(ulPresortedCols)
 {
 	GPOS_ASSERT(nullptr != pos);
+	GPOS_ASSERT(ulPresortedCols < pos->UlSortColumns());
 
 	m_pcrsSort = Pos()->PcrsUsed(mp);
 }
@@ -71,7 +74,8 @@ CPhysicalSort::Matches(COperator *pop) const
 	}
 
 	CPhysicalSort *popSort = CPhysicalSort::PopConvert(pop);
-	return m_pos->Matches(popSort->Pos());
+	return m_ulPresortedCols == popSort->UlPresortedCols() &&
+		   m_pos->Matches(popSort->Pos());
 }
 
 
@@ -125,6 +129,13 @@ CPhysicalSort::PosRequired(CMemoryPool *mp,
 {
 	GPOS_ASSERT(0 == child_index);
 
+	// an incremental sort relies on its child to deliver the presorted
+	// prefix of the order it establishes
+	if (FIncremental())
+	{
+		return m_pos->PosPrefix(mp, m_ulPresortedCols);
+	}
+
 	// sort operator is order-establishing and does not require child to deliver
 	// any sort order; we return an empty sort order as child requirement
 	return GPOS_NEW(mp) COrderSpec(mp);
@@ -369,6 +380,10 @@ IOstream &
 CPhysicalSort::OsPrint(IOstream &os) const
 {
 	os << SzId() << "  ";
+	if (FIncremental())
+	{
+		os << "Presorted: " << m_ulPresortedCols << " ";
+	}
 	return Pos()->OsPrint(os);
 }
 
@@ -3063,8 +3063,8 @@ CTranslatorExprToDXL::PdxlnSort(CExpression *pexprSort,
 	CDXLNode *filter_dxlnode = PdxlnFilter(nullptr);
 
 	// construct a sort node
-	CDXLPhysicalSort *pdxlopSort =
-		GPOS_NEW(m_mp) CDXLPhysicalSort(m_mp, false /*discard_duplicates*/);
+	CDXLPhysicalSort *pdxlopSort = GPOS_NEW(m_mp) CDXLPhysicalSort(
+		m_mp, false /*discard_duplicates*/, popSort->UlPresortedCols());
 
 	// construct sort node from its components
 	CDXLNode *pdxlnSort = GPOS_NEW(m_mp) CDXLNode(m_mp, pdxlopSort);
@@ -4238,6 +4238,7 @@ CTranslatorExprToDXL::PdxlnNLJoin(CExpression *pexprInnerNLJ,
 
 	EdxlJoinType join_type = EdxljtSentinel;
 	BOOL is_index_nlj = false;
+	BOOL memoize = false;
 	CColRefArray *outer_refs = nullptr;
 	switch (pop->Eopid())
 	{
@@ -4251,6 +4252,7 @@ CTranslatorExprToDXL::PdxlnNLJoin(CExpression *pexprInnerNLJ,
 			StoreIndexNLJOuterRefs(pop);
 			outer_refs =
 				CPhysicalInnerIndexNLJoin::PopConvert(pop)->PdrgPcrOuterRefs();
+			memoize = CPhysicalInnerIndexNLJoin::PopConvert(pop)->FMemoize();
 			break;
 
 		case COperator::EopPhysicalLeftOuterIndexNLJoin:
@@ -4318,7 +4320,8 @@ CTranslatorExprToDXL::PdxlnNLJoin(CExpression *pexprInnerNLJ,
 
 	// construct a join node
 	CDXLPhysicalNLJoin *pdxlopNLJ = GPOS_NEW(m_mp)
-		CDXLPhysicalNLJoin(m_mp, join_type, is_index_nlj, nest_params_exists);
+		CDXLPhysicalNLJoin(m_mp, join_type, is_index_nlj, nest_params_exists,
+						   memoize && nest_params_exists);
 	pdxlopNLJ->SetNestLoopParamsColRefs(col_refs);
 
 	// construct projection list
@@ -424,6 +424,9 @@ private:
 	}
 
 public:
+	// type definition of the predicate used for selective eviction
+	using EvictPredicatePtr = BOOL (*)(T, void *);
+
 	// ctor
 	CCache(CMemoryPool *mp, BOOL unique, ULLONG cache_quota,
 		   ULONG g_clock_init_counter, HashFuncPtr hash_func,
@@ -514,6 +517,58 @@ public:
 		return m_eviction_factor;
 	}
 
+	// evict all entries whose value satisfies the given predicate, regardless
+	// of their gclock counter; entries that are still pinned are marked for
+	// deletion and are destroyed once their last accessor releases them;
+	// returns the number of entries evicted
+	ULONG
+	EvictMatchingEntries(EvictPredicatePtr pred, void *ctx)
+	{
+		GPOS_ASSERT(nullptr != pred);
+
+		ULONG num_evicted = 0;
+		CCacheHashtableIter iter(m_hash_table);
+
+		// removing an entry automatically advances the iterator
+		BOOL advanced = false;
+		while (advanced || iter.Advance())
+		{
+			advanced = false;
+			CCacheHashTableEntry *entry = nullptr;
+			BOOL deleted = false;
+
+			// scope for CCacheHashtableIterAccessor
+			{
+				CCacheHashtableIterAccessor acc(iter);
+
+				entry = acc.Value();
+				if (nullptr != entry && !entry->IsMarkedForDeletion() &&
+					pred(entry->Val(), ctx))
+				{
+					num_evicted++;
+					if (EXPECTED_REF_COUNT_FOR_DELETE == entry->RefCount())
+					{
+						acc.Remove(entry);
+						deleted = true;
+						advanced = true;
+						m_cache_size -= entry->Pmp()->TotalAllocatedSize();
+					}
+					else
+					{
+						entry->MarkForDeletion();
+					}
+				}
+			}
+
+			if (deleted)
+			{
+				DestroyCacheEntry(entry);
+			}
+		}
+
+		return num_evicted;
+	}
+
 };	//  CCache
 
 // invalid key
@@ -62,7 +62,12 @@ private:
 	// active flag
 	BOOL m_active;
 
-	// we only support a single worker now
+	// we only support a single worker now; the optimizer runs inside a
+	// backend process where memory pools are backed by palloc and metadata
+	// lookups call into the relcache/syscache, neither of which is
+	// thread-safe, and the sync containers used by the memo and the job
+	// scheduler (CSyncList, CSyncPool, CSyncHashtable) no longer take locks,
+	// so jobs must not be executed by more than one worker concurrently
 	CWorker *m_single_worker;
 
 	// task storage
@@ -50,6 +50,9 @@ private:
 		//key equality function
 		static BOOL FMyEqual(ULONG *const &pvKey, ULONG *const &pvKeySecond);
 
+		// eviction predicate selecting objects with odd keys
+		static BOOL FOddKey(SSimpleObject *pso, void *pv);
+
 		// equality for object-based comparison
 		BOOL
 		operator==(const SSimpleObject &obj) const
@@ -157,6 +160,7 @@ public:
 	static GPOS_RESULT EresUnittest_DeepObject();
 	static GPOS_RESULT EresUnittest_Iteration();
 	static GPOS_RESULT EresUnittest_IterativeDeletion();
+	static GPOS_RESULT EresUnittest_SelectiveEviction();
 
 
 };	// class CCacheTest
@@ -47,7 +47,8 @@ CCacheTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Eviction),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Iteration),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_DeepObject),
-		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion)};
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion),
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_SelectiveEviction)};
 
 	fUnique = true;
 	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -93,6 +94,22 @@ CCacheTest::SSimpleObject::FMyEqual(ULONG *const &pvKey,
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::SSimpleObject::FOddKey
+//
+//	@doc:
+//		Eviction predicate selecting objects with odd keys
+//
+//---------------------------------------------------------------------------
+BOOL
+CCacheTest::SSimpleObject::FOddKey(SSimpleObject *pso, void *	 // pv
+)
+{
+	return 1 == pso->m_ulKey % 2;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCacheTest::CDeepObject::UlMyHash
@@ -985,4 +1002,72 @@ CCacheTest::EresUnittest_IterativeDeletion()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::EresUnittest_SelectiveEviction
+//
+//	@doc:
+//		Evicting the entries matching a predicate leaves the other entries
+//		in the cache, and hides pinned matching entries from lookups
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCacheTest::EresUnittest_SelectiveEviction()
+{
+	CAutoP<CCache<SSimpleObject *, ULONG *> > apcache;
+	apcache = CCacheFactory::CreateCache<SSimpleObject *, ULONG *>(
+		true /*fUnique*/, UNLIMITED_CACHE_QUOTA, SSimpleObject::UlMyHash,
+		SSimpleObject::FMyEqual);
+
+	CCache<SSimpleObject *, ULONG *> *pcache = apcache.Value();
+
+	for (ULONG i = 0; i < GPOS_CACHE_ELEMENTS; i++)
+	{
+		(void) InsertOneElement(pcache, i);
+	}
+	GPOS_ASSERT(GPOS_CACHE_ELEMENTS == pcache->Size());
+
+	// scope for the accessor pinning an entry that is about to be evicted
+	{
+		ULONG ulPinned = 1;
+		CSimpleObjectCacheAccessor caPinned(pcache);
+		caPinned.Lookup(&ulPinned);
+		SSimpleObject *psoPinned = caPinned.Val();
+		GPOS_ASSERT(nullptr != psoPinned);
+
+		// release object since there is no customer to release it after lookup and before CCache's cleanup
+		psoPinned->Release();
+
+		ULONG ulEvicted GPOS_ASSERTS_ONLY =
+			pcache->EvictMatchingEntries(SSimpleObject::FOddKey, nullptr);
+		GPOS_ASSERT(GPOS_CACHE_ELEMENTS / 2 == ulEvicted);
+
+		// pinned entry is kept alive for its accessor, but cannot be found
+		GPOS_ASSERT(ulPinned == psoPinned->m_ulKey);
+		CSimpleObjectCacheAccessor ca(pcache);
+		ca.Lookup(&ulPinned);
+		GPOS_ASSERT(nullptr == ca.Val());
+	}
+	GPOS_ASSERT(GPOS_CACHE_ELEMENTS / 2 == pcache->Size());
+
+	for (ULONG i = 0; i < GPOS_CACHE_ELEMENTS; i++)
+	{
+		GPOS_CHECK_ABORT;
+
+		CSimpleObjectCacheAccessor ca(pcache);
+		ca.Lookup(&i);
+		SSimpleObject *pso = ca.Val();
+		GPOS_ASSERT((0 == i % 2) == (nullptr != pso));
+
+		if (nullptr != pso)
+		{
+			// release object since there is no customer to release it after lookup and before CCache's cleanup
+			pso->Release();
+		}
+	}
+
+	return GPOS_OK;
+}
+
 // EOF
@@ -54,6 +54,9 @@ private:
 	// if nest params are required to be parsed
 	BOOL m_nest_params_exists;
 
+	// whether the inner side is cached by the values of the nest params
+	BOOL m_memoize;
+
 	void SerializeNestLoopParamsToDXL(CXMLSerializer *pxmlser) const;
 
 public:
@@ -61,7 +64,8 @@ public:
 
 	// ctor/dtor
 	CDXLPhysicalNLJoin(CMemoryPool *mp, EdxlJoinType join_type,
-					   BOOL is_index_nlj, BOOL nest_params_exists);
+					   BOOL is_index_nlj, BOOL nest_params_exists,
+					   BOOL memoize = false);
 
 	~CDXLPhysicalNLJoin() override;
 
@@ -79,6 +83,13 @@ public:
 	// nest params exists for parsing
 	BOOL NestParamsExists() const;
 
+	// is the inner side cached by the values of the nest params?
+	BOOL
+	IsMemoize() const
+	{
+		return m_memoize;
+	}
+
 	// serialize operator in DXL format
 	void SerializeToDXL(CXMLSerializer *xml_serializer,
 						const CDXLNode *dxlnode) const override;
@@ -46,18 +46,29 @@ private:
 	// whether sort discards duplicates
 	BOOL m_discard_duplicates;
 
+	// number of leading sort columns the input is already sorted on,
+	// non-zero for an incremental sort
+	ULONG m_presorted_cols;
 
 public:
 	CDXLPhysicalSort(const CDXLPhysicalSort &) = delete;
 
 	// ctor/dtor
-	CDXLPhysicalSort(CMemoryPool *mp, BOOL discard_duplicates);
+	CDXLPhysicalSort(CMemoryPool *mp, BOOL discard_duplicates,
+					 ULONG presorted_cols = 0);
 
 	// accessors
 	Edxlopid GetDXLOperator() const override;
 	const CWStringConst *GetOpNameStr() const override;
 	BOOL FDiscardDuplicates() const;
 
+	// number of presorted leading sort columns
+	ULONG
+	GetPresortedCols() const
+	{
+		return m_presorted_cols;
+	}
+
 	// serialize operator in DXL format
 	void SerializeToDXL(CXMLSerializer *xml_serializer,
 						const CDXLNode *dxlnode) const override;
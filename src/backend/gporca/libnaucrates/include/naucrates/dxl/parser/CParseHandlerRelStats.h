@@ -15,6 +15,8 @@
 #include "gpos/base.h"
 
 #include "naucrates/dxl/parser/CParseHandlerMetadataObject.h"
+#include "naucrates/md/CMDDependency.h"
+#include "naucrates/md/CMDNDistinct.h"
 
 namespace gpdxl
 {
@@ -35,6 +37,26 @@ XERCES_CPP_NAMESPACE_USE
 class CParseHandlerRelStats : public CParseHandlerMetadataObject
 {
 private:
+	// attributes of the relation stats element, kept until its end tag
+	// since the object is built only after parsing its children
+	IMDId *m_mdid;
+
+	CMDName *m_mdname;
+
+	CDouble m_rows;
+
+	BOOL m_is_empty;
+
+	ULONG m_relpages;
+
+	ULONG m_relallvisible;
+
+	// functional dependencies from extended statistics
+	CMDDependencyArray *m_dependencies;
+
+	// multi-column ndistinct from extended statistics
+	CMDNDistinctArray *m_ndistincts;
+
 	// process the start of an element
 	void StartElement(
 		const XMLCh *const element_uri,			// URI of element's namespace
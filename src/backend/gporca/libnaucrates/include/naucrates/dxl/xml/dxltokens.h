@@ -398,6 +398,7 @@ enum Edxltoken
 	EdxltokenSortOpName,
 	EdxltokenSortDiscardDuplicates,
 	EdxltokenSortNullsFirst,
+	EdxltokenSortPresortedCols,
 
 	EdxltokenMaterializeEager,
 	EdxltokenSpoolId,
@@ -436,6 +437,7 @@ enum Edxltoken
 	EdxltokenNLJIndexParamList,
 	EdxltokenNLJIndexParam,
 	EdxltokenNLJIndexOuterRefAsParam,
+	EdxltokenNLJMemoize,
 
 	// metadata-related constants
 	EdxltokenRelation,
@@ -455,6 +457,10 @@ enum Edxltoken
 	EdxltokenRelationStats,
 	EdxltokenColumnStats,
 	EdxltokenColumnStatsBucket,
+	EdxltokenRelationStatsDependency,
+	EdxltokenRelationStatsNDistinct,
+	EdxltokenDependencyDegree,
+	EdxltokenAttnos,
 	EdxltokenEmptyRelation,
 	EdxltokenIsNull,
 	EdxltokenLintValue,
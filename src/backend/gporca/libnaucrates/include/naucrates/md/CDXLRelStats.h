@@ -66,12 +66,20 @@ private:
 	// number of all-visible blocks (not always up-to-date)
 	ULONG m_relallvisible;
 
+	// functional dependencies from extended statistics
+	CMDDependencyArray *m_dependencies;
+
+	// multi-column ndistinct from extended statistics
+	CMDNDistinctArray *m_ndistincts;
+
 public:
 	CDXLRelStats(const CDXLRelStats &) = delete;
 
 	CDXLRelStats(CMemoryPool *mp, CMDIdRelStats *rel_stats_mdid,
 				 CMDName *mdname, CDouble rows, BOOL is_empty, ULONG relpages,
-				 ULONG relallvisible);
+				 ULONG relallvisible,
+				 CMDDependencyArray *dependencies = nullptr,
+				 CMDNDistinctArray *ndistincts = nullptr);
 
 	~CDXLRelStats() override;
 
@@ -108,6 +116,20 @@ public:
 		return m_empty;
 	}
 
+	// functional dependencies from extended statistics
+	const CMDDependencyArray *
+	GetDependencies() const override
+	{
+		return m_dependencies;
+	}
+
+	// multi-column ndistinct from extended statistics
+	const CMDNDistinctArray *
+	GetNDistincts() const override
+	{
+		return m_ndistincts;
+	}
+
 	// serialize relation stats in DXL format given a serializer object
 	void Serialize(gpdxl::CXMLSerializer *) const override;
 
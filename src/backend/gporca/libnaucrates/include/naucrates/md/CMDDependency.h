@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (c) 2023, HashData Technology Limited.
+//
+//	@filename:
+//		CMDDependency.h
+//
+//	@doc:
+//		Functional dependency between columns of a relation, taken from an
+//		extended statistics object
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_CMDDependency_H
+#define GPMD_CMDDependency_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/common/CRefCount.h"
+
+namespace gpdxl
+{
+class CXMLSerializer;
+}
+
+namespace gpmd
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CMDDependency
+//
+//	@doc:
+//		Dependency (from_attnos) => to_attno: the values of the columns in
+//		from_attnos determine the value of to_attno in a fraction 'degree'
+//		of the rows
+//
+//---------------------------------------------------------------------------
+class CMDDependency : public CRefCount
+{
+private:
+	// attribute numbers of the determining columns
+	ULongPtrArray *m_from_attnos;
+
+	// attribute number of the implied column
+	ULONG m_to_attno;
+
+	// degree of validity, between 0 and 1
+	CDouble m_degree;
+
+public:
+	CMDDependency(const CMDDependency &) = delete;
+
+	// ctor
+	CMDDependency(ULongPtrArray *from_attnos, ULONG to_attno, CDouble degree);
+
+	// dtor
+	~CMDDependency() override;
+
+	// attribute numbers of the determining columns
+	const ULongPtrArray *
+	FromAttnos() const
+	{
+		return m_from_attnos;
+	}
+
+	// attribute number of the implied column
+	ULONG
+	ToAttno() const
+	{
+		return m_to_attno;
+	}
+
+	// degree of validity
+	CDouble
+	Degree() const
+	{
+		return m_degree;
+	}
+
+	// serialize the dependency in DXL format
+	void Serialize(gpdxl::CXMLSerializer *xml_serializer) const;
+
+#ifdef GPOS_DEBUG
+	// debug print of the dependency
+	void DebugPrint(IOstream &os) const;
+#endif
+};
+
+// array of functional dependencies
+using CMDDependencyArray = CDynamicPtrArray<CMDDependency, CleanupRelease>;
+
+}  // namespace gpmd
+
+#endif	// !GPMD_CMDDependency_H
+
+// EOF
@@ -0,0 +1,86 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (c) 2023, HashData Technology Limited.
+//
+//	@filename:
+//		CMDNDistinct.h
+//
+//	@doc:
+//		Number of distinct values of a combination of columns of a relation,
+//		taken from an extended statistics object
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_CMDNDistinct_H
+#define GPMD_CMDNDistinct_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/common/CRefCount.h"
+
+namespace gpdxl
+{
+class CXMLSerializer;
+}
+
+namespace gpmd
+{
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CMDNDistinct
+//
+//	@doc:
+//		Number of distinct combinations of values of a set of columns
+//
+//---------------------------------------------------------------------------
+class CMDNDistinct : public CRefCount
+{
+private:
+	// attribute numbers of the columns, in ascending order
+	ULongPtrArray *m_attnos;
+
+	// number of distinct combinations
+	CDouble m_ndistinct;
+
+public:
+	CMDNDistinct(const CMDNDistinct &) = delete;
+
+	// ctor
+	CMDNDistinct(ULongPtrArray *attnos, CDouble ndistinct);
+
+	// dtor
+	~CMDNDistinct() override;
+
+	// attribute numbers of the columns
+	const ULongPtrArray *
+	Attnos() const
+	{
+		return m_attnos;
+	}
+
+	// number of distinct combinations
+	CDouble
+	NDistinct() const
+	{
+		return m_ndistinct;
+	}
+
+	// serialize the ndistinct item in DXL format
+	void Serialize(gpdxl::CXMLSerializer *xml_serializer) const;
+
+#ifdef GPOS_DEBUG
+	// debug print of the ndistinct item
+	void DebugPrint(IOstream &os) const;
+#endif
+};
+
+// array of ndistinct items
+using CMDNDistinctArray = CDynamicPtrArray<CMDNDistinct, CleanupRelease>;
+
+}  // namespace gpmd
+
+#endif	// !GPMD_CMDNDistinct_H
+
+// EOF
@@ -17,6 +17,8 @@
 #include "gpos/base.h"
 #include "gpos/common/CDouble.h"
 
+#include "naucrates/md/CMDDependency.h"
+#include "naucrates/md/CMDNDistinct.h"
 #include "naucrates/md/IMDCacheObject.h"
 
 namespace gpmd
@@ -51,6 +53,12 @@ public:
 
 	// is statistics on an empty input
 	virtual BOOL IsEmpty() const = 0;
+
+	// functional dependencies from extended statistics
+	virtual const CMDDependencyArray *GetDependencies() const = 0;
+
+	// multi-column ndistinct from extended statistics
+	virtual const CMDNDistinctArray *GetNDistincts() const = 0;
 };
 }  // namespace gpmd
 
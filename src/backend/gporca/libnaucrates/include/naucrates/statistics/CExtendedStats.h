@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (c) 2023, HashData Technology Limited.
+//
+//	@filename:
+//		CExtendedStats.h
+//
+//	@doc:
+//		Extended statistics of a base relation, expressed in terms of the
+//		column ids of the query
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CExtendedStats_H
+#define GPNAUCRATES_CExtendedStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CRefCount.h"
+#include "gpos/common/DbgPrintMixin.h"
+
+#include "naucrates/md/IMDRelStats.h"
+#include "naucrates/statistics/IStatistics.h"
+
+namespace gpnaucrates
+{
+using namespace gpos;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CExtendedStats
+//
+//	@doc:
+//		Functional dependencies and multi-column ndistinct coefficients of
+//		a base relation, with the attribute numbers of the metadata object
+//		replaced by the column ids of the query. Only the items whose
+//		columns all have a column id are kept.
+//
+//---------------------------------------------------------------------------
+class CExtendedStats : public CRefCount, public DbgPrintMixin<CExtendedStats>
+{
+private:
+	// functional dependency (from_colids) => to_colid
+	struct SDependency : public CRefCount
+	{
+		// determining columns
+		CBitSet *m_from_colids;
+
+		// determined column
+		ULONG m_to_colid;
+
+		// fraction of the rows for which the dependency holds
+		CDouble m_degree;
+
+		SDependency(CBitSet *from_colids, ULONG to_colid, CDouble degree)
+			: m_from_colids(from_colids),
+			  m_to_colid(to_colid),
+			  m_degree(degree)
+		{
+		}
+
+		~SDependency() override
+		{
+			m_from_colids->Release();
+		}
+	};
+
+	// number of distinct combinations of values of a set of columns
+	struct SNDistinct : public CRefCount
+	{
+		// columns of the combination
+		CBitSet *m_colids;
+
+		// number of distinct combinations
+		CDouble m_ndistinct;
+
+		SNDistinct(CBitSet *colids, CDouble ndistinct)
+			: m_colids(colids), m_ndistinct(ndistinct)
+		{
+		}
+
+		~SNDistinct() override
+		{
+			m_colids->Release();
+		}
+	};
+
+	using SDependencyArray = CDynamicPtrArray<SDependency, CleanupRelease>;
+	using SNDistinctArray = CDynamicPtrArray<SNDistinct, CleanupRelease>;
+
+	// functional dependencies
+	SDependencyArray *m_dependencies;
+
+	// multi-column ndistinct coefficients
+	SNDistinctArray *m_ndistincts;
+
+	// number of rows of the relation the statistics were built on
+	CDouble m_rel_rows;
+
+	// map the given attribute numbers to column ids, return null if any
+	// of them has no column id
+	static CBitSet *MapAttnos(CMemoryPool *mp, const ULongPtrArray *attnos,
+							  UlongToUlongMap *attno_to_colid);
+
+	// private ctor
+	CExtendedStats(CMemoryPool *mp, CDouble rel_rows);
+
+public:
+	CExtendedStats(const CExtendedStats &) = delete;
+
+	// dtor
+	~CExtendedStats() override;
+
+	// build the extended statistics of a relation for the given columns;
+	// return null if none of the items can be used
+	static CExtendedStats *CreateExtendedStats(CMemoryPool *mp,
+											   const IMDRelStats *md_rel_stats,
+											   UlongToUlongMap *attno_to_colid,
+											   CDouble rel_rows);
+
+	// adjust the scale factors of equality predicates on the columns of
+	// the relation for the functional dependencies between them
+	void ApplyDependencies(CMemoryPool *mp, ULongPtrArray *eq_colids,
+						   CDoubleArray *scale_factors) const;
+
+	// number of distinct combinations of values of exactly the given set
+	// of columns in an input of the given number of rows; return false
+	// if there are no statistics on that set
+	BOOL LookupNDistinct(const CBitSet *colids, CDouble rows,
+						 CDouble *ndistinct) const;
+
+	// print function
+	IOstream &OsPrint(IOstream &os) const;
+};	// class CExtendedStats
+
+}  // namespace gpnaucrates
+
+#endif	// !GPNAUCRATES_CExtendedStats_H
+
+// EOF
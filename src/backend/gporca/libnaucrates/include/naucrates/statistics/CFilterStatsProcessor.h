@@ -64,13 +64,15 @@ private:
 	static UlongToHistogramMap *MakeHistHashMapConjOrDisjFilter(
 		CMemoryPool *mp, const CStatisticsConfig *stats_config,
 		UlongToHistogramMap *input_histograms, CDouble input_rows,
-		CStatsPred *pred_stats, CDouble *scale_factor);
+		CStatsPred *pred_stats, CDouble *scale_factor,
+		const CExtendedStats *ext_stats = nullptr);
 
 	// create new hash map of histograms after applying the conjunction predicate
 	static UlongToHistogramMap *MakeHistHashMapConjFilter(
 		CMemoryPool *mp, const CStatisticsConfig *stats_config,
 		UlongToHistogramMap *intermediate_histograms, CDouble input_rows,
-		CStatsPredConj *conjunctive_pred_stats, CDouble *scale_factor);
+		CStatsPredConj *conjunctive_pred_stats, CDouble *scale_factor,
+		const CExtendedStats *ext_stats = nullptr);
 
 	// create new hash map of histograms after applying the disjunctive predicate
 	static UlongToHistogramMap *MakeHistHashMapDisjFilter(
@@ -30,7 +30,15 @@ protected:
 		CMemoryPool *mp, CStatisticsConfig *stats_config, CDouble left_num_rows,
 		CDouble right_num_rows,
 		CScaleFactorUtils::SJoinConditionArray *join_conds_scale_factors,
-		IStatistics::EStatsJoinType join_type);
+		IStatistics::EStatsJoinType join_type,
+		CDouble limit_for_result_scale_factor);
+
+	// upper bound of the number of distinct combinations of values of the
+	// equi-join columns of one side of the join
+	static CDouble JoinColsNDVUpperBound(CMemoryPool *mp,
+										 const CStatistics *stats,
+										 CStatsPredJoinArray *join_preds_stats,
+										 BOOL is_outer, BOOL *has_ext_stats);
 
 
 	// check if the join statistics object is empty output based on the input
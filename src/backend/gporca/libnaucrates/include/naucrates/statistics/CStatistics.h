@@ -15,6 +15,7 @@
 #include "gpos/common/CBitSet.h"
 #include "gpos/string/CWStringDynamic.h"
 
+#include "naucrates/statistics/CExtendedStats.h"
 #include "naucrates/statistics/CHistogram.h"
 #include "naucrates/statistics/CStatsPredArrayCmp.h"
 #include "naucrates/statistics/CStatsPredConj.h"
@@ -113,6 +114,10 @@ private:
 	// source can be one of the following operators: like Get, Group By, and Project
 	CUpperBoundNDVPtrArray *m_src_upper_bound_NDVs;
 
+	// extended statistics of the base relation the columns come from, only
+	// kept on base table scans and on filters on top of them
+	CExtendedStats *m_ext_stats;
+
 	// the default value for operators that have no cardinality estimation risk
 	static const ULONG no_card_est_risk_default_val;
 
@@ -313,6 +318,22 @@ public:
 	{
 		return m_src_upper_bound_NDVs;
 	}
+
+	// extended statistics, may be null
+	CExtendedStats *
+	GetExtendedStats() const
+	{
+		return m_ext_stats;
+	}
+
+	// set the extended statistics, takes ownership of the given object
+	void
+	SetExtendedStats(CExtendedStats *ext_stats)
+	{
+		CRefCount::SafeRelease(m_ext_stats);
+		m_ext_stats = ext_stats;
+	}
+
 	// create an empty statistics object
 	static CStatistics *
 	MakeEmptyStats(CMemoryPool *mp)
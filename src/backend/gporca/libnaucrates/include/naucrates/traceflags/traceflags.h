@@ -215,6 +215,14 @@ enum EOptTraceFlag
 
 	EopttraceForceComprehensiveJoinImplementation = 103041,
 
+	// enable plan alternatives that cache the inner side of index NLJs
+	// (Memoize)
+	EopttraceEnableMemoize = 103042,
+
+	// enable sort alternatives that only sort the groups of a presorted
+	// prefix of the required order (IncrementalSort)
+	EopttraceEnableIncrementalSort = 103043,
+
 	///////////////////////////////////////////////////////
 	///////////////////// statistics flags ////////////////
 	//////////////////////////////////////////////////////
@@ -245,6 +253,11 @@ enum EOptTraceFlag
 
 	// Use experimental cost model
 	EopttraceExperimentalCostModel = 104009,
+
+	// Use extended statistics (functional dependencies and multi-column
+	// ndistinct) in cardinality estimation
+	EopttraceEnableExtendedStats = 104010,
+
 	///////////////////////////////////////////////////////
 	/////////// constant expression evaluator flags ///////
 	///////////////////////////////////////////////////////
@@ -32,16 +32,28 @@ using namespace gpmd;
 //---------------------------------------------------------------------------
 CDXLRelStats::CDXLRelStats(CMemoryPool *mp, CMDIdRelStats *rel_stats_mdid,
 						   CMDName *mdname, CDouble rows, BOOL is_empty,
-						   ULONG relpages, ULONG relallvisible)
+						   ULONG relpages, ULONG relallvisible,
+						   CMDDependencyArray *dependencies,
+						   CMDNDistinctArray *ndistincts)
 	: m_mp(mp),
 	  m_rel_stats_mdid(rel_stats_mdid),
 	  m_mdname(mdname),
 	  m_rows(rows),
 	  m_empty(is_empty),
 	  m_relpages(relpages),
-	  m_relallvisible(relallvisible)
+	  m_relallvisible(relallvisible),
+	  m_dependencies(dependencies),
+	  m_ndistincts(ndistincts)
 {
 	GPOS_ASSERT(rel_stats_mdid->IsValid());
+	if (nullptr == m_dependencies)
+	{
+		m_dependencies = GPOS_NEW(mp) CMDDependencyArray(mp);
+	}
+	if (nullptr == m_ndistincts)
+	{
+		m_ndistincts = GPOS_NEW(mp) CMDNDistinctArray(mp);
+	}
 	m_dxl_str = CDXLUtils::SerializeMDObj(
 		m_mp, this, false /*fSerializeHeader*/, false /*indentation*/);
 }
@@ -59,6 +71,8 @@ CDXLRelStats::~CDXLRelStats()
 	GPOS_DELETE(m_mdname);
 	GPOS_DELETE(m_dxl_str);
 	m_rel_stats_mdid->Release();
+	m_dependencies->Release();
+	m_ndistincts->Release();
 }
 
 //---------------------------------------------------------------------------
@@ -145,6 +159,16 @@ CDXLRelStats::Serialize(CXMLSerializer *xml_serializer) const
 	xml_serializer->AddAttribute(
 		CDXLTokens::GetDXLTokenStr(EdxltokenEmptyRelation), m_empty);
 
+	for (ULONG ul = 0; ul < m_dependencies->Size(); ul++)
+	{
+		(*m_dependencies)[ul]->Serialize(xml_serializer);
+	}
+
+	for (ULONG ul = 0; ul < m_ndistincts->Size(); ul++)
+	{
+		(*m_ndistincts)[ul]->Serialize(xml_serializer);
+	}
+
 	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenRelationStats));
@@ -179,6 +203,16 @@ CDXLRelStats::DebugPrint(IOstream &os) const
 	os << "RelAllVisible: " << RelAllVisible() << std::endl;
 
 	os << "Empty: " << IsEmpty() << std::endl;
+
+	for (ULONG ul = 0; ul < m_dependencies->Size(); ul++)
+	{
+		(*m_dependencies)[ul]->DebugPrint(os);
+	}
+
+	for (ULONG ul = 0; ul < m_ndistincts->Size(); ul++)
+	{
+		(*m_ndistincts)[ul]->DebugPrint(os);
+	}
 }
 
 #endif	// GPOS_DEBUG
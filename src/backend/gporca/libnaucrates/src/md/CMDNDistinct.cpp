@@ -0,0 +1,73 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (c) 2023, HashData Technology Limited.
+//
+//	@filename:
+//		CMDNDistinct.cpp
+//
+//	@doc:
+//		Implementation of the class for representing multi-column ndistinct
+//---------------------------------------------------------------------------
+
+#include "naucrates/md/CMDNDistinct.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+
+// ctor
+CMDNDistinct::CMDNDistinct(ULongPtrArray *attnos, CDouble ndistinct)
+	: m_attnos(attnos), m_ndistinct(ndistinct)
+{
+	GPOS_ASSERT(nullptr != attnos);
+	GPOS_ASSERT(1 < attnos->Size());
+}
+
+// dtor
+CMDNDistinct::~CMDNDistinct()
+{
+	m_attnos->Release();
+}
+
+// serialize the ndistinct item in DXL format
+void
+CMDNDistinct::Serialize(CXMLSerializer *xml_serializer) const
+{
+	xml_serializer->OpenElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenRelationStatsNDistinct));
+
+	CWStringDynamic *attnos_str =
+		CDXLUtils::Serialize(xml_serializer->Pmp(), m_attnos);
+	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenAttnos),
+								 attnos_str);
+	GPOS_DELETE(attnos_str);
+	xml_serializer->AddAttribute(
+		CDXLTokens::GetDXLTokenStr(EdxltokenStatsDistinct), m_ndistinct);
+
+	xml_serializer->CloseElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenRelationStatsNDistinct));
+}
+
+#ifdef GPOS_DEBUG
+// prints an ndistinct item to the provided output
+void
+CMDNDistinct::DebugPrint(IOstream &os) const
+{
+	os << "NDistinct: (";
+	for (ULONG ul = 0; ul < m_attnos->Size(); ul++)
+	{
+		if (0 < ul)
+		{
+			os << ", ";
+		}
+		os << *(*m_attnos)[ul];
+	}
+	os << ") " << m_ndistinct << std::endl;
+}
+#endif	// GPOS_DEBUG
+
+// EOF
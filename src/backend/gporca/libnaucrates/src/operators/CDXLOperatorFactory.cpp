@@ -204,11 +204,16 @@ CDXLOperatorFactory::MakeDXLNLJoin(CDXLMemoryManager *dxl_memory_manager,
 			EdxltokenNLJIndexOuterRefAsParam, EdxltokenPhysicalNLJoin);
 	}
 
+	// identify if the inner side is cached by the values of the nest params
+	BOOL memoize = ExtractConvertAttrValueToBool(
+		dxl_memory_manager, attrs, EdxltokenNLJMemoize, EdxltokenPhysicalNLJoin,
+		true /*is_optional*/, false /*default_value*/);
+
 	EdxlJoinType join_type = ParseJoinType(
 		join_type_xml, CDXLTokens::GetDXLTokenStr(EdxltokenPhysicalNLJoin));
 
-	return GPOS_NEW(mp)
-		CDXLPhysicalNLJoin(mp, join_type, is_index_nlj, nest_params_exists);
+	return GPOS_NEW(mp) CDXLPhysicalNLJoin(mp, join_type, is_index_nlj,
+										   nest_params_exists, memoize);
 }
 
 //---------------------------------------------------------------------------
@@ -551,7 +556,13 @@ CDXLOperatorFactory::MakeDXLSort(CDXLMemoryManager *dxl_memory_manager,
 		dxl_memory_manager, attrs, EdxltokenSortDiscardDuplicates,
 		EdxltokenPhysicalSort);
 
-	return GPOS_NEW(mp) CDXLPhysicalSort(mp, discard_duplicates);
+	// number of presorted columns is only present for incremental sorts
+	ULONG presorted_cols = ExtractConvertAttrValueToUlong(
+		dxl_memory_manager, attrs, EdxltokenSortPresortedCols,
+		EdxltokenPhysicalSort, true /*is_optional*/, 0 /*default_value*/);
+
+	return GPOS_NEW(mp)
+		CDXLPhysicalSort(mp, discard_duplicates, presorted_cols);
 }
 
 //---------------------------------------------------------------------------
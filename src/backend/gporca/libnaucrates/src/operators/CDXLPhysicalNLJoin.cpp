@@ -28,11 +28,13 @@ using namespace gpdxl;
 //---------------------------------------------------------------------------
 CDXLPhysicalNLJoin::CDXLPhysicalNLJoin(CMemoryPool *mp, EdxlJoinType join_type,
 									   BOOL is_index_nlj,
-									   BOOL nest_params_exists)
+									   BOOL nest_params_exists, BOOL memoize)
 	: CDXLPhysicalJoin(mp, join_type),
 	  m_is_index_nlj(is_index_nlj),
-	  m_nest_params_exists(nest_params_exists)
+	  m_nest_params_exists(nest_params_exists),
+	  m_memoize(memoize)
 {
+	GPOS_ASSERT_IMP(memoize, is_index_nlj && nest_params_exists);
 	m_nest_params_col_refs = nullptr;
 }
 
@@ -95,6 +97,11 @@ CDXLPhysicalNLJoin::SerializeToDXL(CXMLSerializer *xml_serializer,
 	xml_serializer->AddAttribute(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNLJIndexOuterRefAsParam),
 		m_nest_params_exists);
+	if (m_memoize)
+	{
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNLJMemoize), m_memoize);
+	}
 
 
 	// serialize properties
@@ -26,8 +26,11 @@ using namespace gpdxl;
 //		Constructor
 //
 //---------------------------------------------------------------------------
-CDXLPhysicalSort::CDXLPhysicalSort(CMemoryPool *mp, BOOL discard_duplicates)
-	: CDXLPhysical(mp), m_discard_duplicates(discard_duplicates)
+CDXLPhysicalSort::CDXLPhysicalSort(CMemoryPool *mp, BOOL discard_duplicates,
+								   ULONG presorted_cols)
+	: CDXLPhysical(mp),
+	  m_discard_duplicates(discard_duplicates),
+	  m_presorted_cols(presorted_cols)
 {
 }
 
@@ -96,6 +99,14 @@ CDXLPhysicalSort::SerializeToDXL(CXMLSerializer *xml_serializer,
 		CDXLTokens::GetDXLTokenStr(EdxltokenSortDiscardDuplicates),
 		m_discard_duplicates);
 
+	// only incremental sorts carry the number of presorted columns
+	if (0 < m_presorted_cols)
+	{
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenSortPresortedCols),
+			m_presorted_cols);
+	}
+
 	// serialize properties
 	dxlnode->SerializePropertiesToDXL(xml_serializer);
 
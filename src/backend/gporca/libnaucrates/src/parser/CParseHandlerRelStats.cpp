@@ -34,7 +34,15 @@ XERCES_CPP_NAMESPACE_USE
 CParseHandlerRelStats::CParseHandlerRelStats(
 	CMemoryPool *mp, CParseHandlerManager *parse_handler_mgr,
 	CParseHandlerBase *parse_handler_root)
-	: CParseHandlerMetadataObject(mp, parse_handler_mgr, parse_handler_root)
+	: CParseHandlerMetadataObject(mp, parse_handler_mgr, parse_handler_root),
+	  m_mdid(nullptr),
+	  m_mdname(nullptr),
+	  m_rows(0.0),
+	  m_is_empty(false),
+	  m_relpages(0),
+	  m_relallvisible(0),
+	  m_dependencies(nullptr),
+	  m_ndistincts(nullptr)
 {
 }
 
@@ -52,6 +60,45 @@ CParseHandlerRelStats::StartElement(const XMLCh *const,	 // element_uri,
 									const XMLCh *const,	 // element_qname,
 									const Attributes &attrs)
 {
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenRelationStatsDependency),
+				 element_local_name))
+	{
+		GPOS_ASSERT(nullptr != m_dependencies);
+
+		ULongPtrArray *from_attnos =
+			CDXLOperatorFactory::ExtractConvertValuesToArray(
+				m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+				EdxltokenAttnos, EdxltokenRelationStatsDependency);
+		ULONG to_attno = CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs, EdxltokenAttno,
+			EdxltokenRelationStatsDependency);
+		CDouble degree = CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+			EdxltokenDependencyDegree, EdxltokenRelationStatsDependency);
+
+		m_dependencies->Append(GPOS_NEW(m_mp)
+								   CMDDependency(from_attnos, to_attno, degree));
+		return;
+	}
+
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenRelationStatsNDistinct),
+				 element_local_name))
+	{
+		GPOS_ASSERT(nullptr != m_ndistincts);
+
+		ULongPtrArray *attnos = CDXLOperatorFactory::ExtractConvertValuesToArray(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs, EdxltokenAttnos,
+			EdxltokenRelationStatsNDistinct);
+		CDouble ndistinct = CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+			EdxltokenStatsDistinct, EdxltokenRelationStatsNDistinct);
+
+		m_ndistincts->Append(GPOS_NEW(m_mp) CMDNDistinct(attnos, ndistinct));
+		return;
+	}
+
 	if (0 != XMLString::compareString(
 				 CDXLTokens::XmlstrToken(EdxltokenRelationStats),
 				 element_local_name))
@@ -71,55 +118,51 @@ CParseHandlerRelStats::StartElement(const XMLCh *const,	 // element_uri,
 			m_parse_handler_mgr->GetDXLMemoryManager(), xml_str_table_name);
 
 	// create a copy of the string in the CMDName constructor
-	CMDName *mdname = GPOS_NEW(m_mp) CMDName(m_mp, str_table_name);
+	m_mdname = GPOS_NEW(m_mp) CMDName(m_mp, str_table_name);
 
 	GPOS_DELETE(str_table_name);
 
 
 	// parse metadata id info
-	IMDId *mdid = CDXLOperatorFactory::ExtractConvertAttrValueToMdId(
+	m_mdid = CDXLOperatorFactory::ExtractConvertAttrValueToMdId(
 		m_parse_handler_mgr->GetDXLMemoryManager(), attrs, EdxltokenMdid,
 		EdxltokenRelationStats);
 
 	// parse rows
 
-	CDouble rows = CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
+	m_rows = CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
 		m_parse_handler_mgr->GetDXLMemoryManager(), attrs, EdxltokenRows,
 		EdxltokenRelationStats);
 
-	BOOL is_empty = false;
 	const XMLCh *xml_str_is_empty =
 		attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenEmptyRelation));
 	if (nullptr != xml_str_is_empty)
 	{
-		is_empty = CDXLOperatorFactory::ConvertAttrValueToBool(
+		m_is_empty = CDXLOperatorFactory::ConvertAttrValueToBool(
 			m_parse_handler_mgr->GetDXLMemoryManager(), xml_str_is_empty,
 			EdxltokenEmptyRelation, EdxltokenStatsDerivedRelation);
 	}
 
-	ULONG relpages = 0;
 	const XMLCh *xml_relpages =
 		attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenRelPages));
 	if (nullptr != xml_relpages)
 	{
-		relpages = CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
+		m_relpages = CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
 			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
 			EdxltokenRelPages, EdxltokenRelationStats);
 	}
 
-	ULONG relallvisible = 0;
 	const XMLCh *xml_relallvisible =
 		attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenRelAllVisible));
 	if (nullptr != xml_relallvisible)
 	{
-		relallvisible = CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
+		m_relallvisible = CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
 			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
 			EdxltokenRelAllVisible, EdxltokenRelationStats);
 	}
 
-	m_imd_obj =
-		GPOS_NEW(m_mp) CDXLRelStats(m_mp, CMDIdRelStats::CastMdid(mdid), mdname,
-									rows, is_empty, relpages, relallvisible);
+	m_dependencies = GPOS_NEW(m_mp) CMDDependencyArray(m_mp);
+	m_ndistincts = GPOS_NEW(m_mp) CMDNDistinctArray(m_mp);
 }
 
 //---------------------------------------------------------------------------
@@ -136,6 +179,16 @@ CParseHandlerRelStats::EndElement(const XMLCh *const,  // element_uri,
 								  const XMLCh *const  // element_qname
 )
 {
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenRelationStatsDependency),
+				 element_local_name) ||
+		0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenRelationStatsNDistinct),
+				 element_local_name))
+	{
+		return;
+	}
+
 	if (0 != XMLString::compareString(
 				 CDXLTokens::XmlstrToken(EdxltokenRelationStats),
 				 element_local_name))
@@ -146,6 +199,10 @@ CParseHandlerRelStats::EndElement(const XMLCh *const,  // element_uri,
 				   str->GetBuffer());
 	}
 
+	m_imd_obj = GPOS_NEW(m_mp) CDXLRelStats(
+		m_mp, CMDIdRelStats::CastMdid(m_mdid), m_mdname, m_rows, m_is_empty,
+		m_relpages, m_relallvisible, m_dependencies, m_ndistincts);
+
 	// deactivate handler
 	m_parse_handler_mgr->DeactivateHandler();
 }
@@ -0,0 +1,266 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (c) 2023, HashData Technology Limited.
+//
+//	@filename:
+//		CExtendedStats.cpp
+//
+//	@doc:
+//		Implementation of the extended statistics of a base relation
+//---------------------------------------------------------------------------
+
+#include "naucrates/statistics/CExtendedStats.h"
+
+#include "naucrates/statistics/CStatistics.h"
+
+using namespace gpnaucrates;
+
+FORCE_GENERATE_DBGSTR(gpnaucrates::CExtendedStats);
+
+// ctor
+CExtendedStats::CExtendedStats(CMemoryPool *mp, CDouble rel_rows)
+	: m_dependencies(GPOS_NEW(mp) SDependencyArray(mp)),
+	  m_ndistincts(GPOS_NEW(mp) SNDistinctArray(mp)),
+	  m_rel_rows(rel_rows)
+{
+}
+
+// dtor
+CExtendedStats::~CExtendedStats()
+{
+	m_dependencies->Release();
+	m_ndistincts->Release();
+}
+
+// map the given attribute numbers to column ids, return null if any
+// of them has no column id
+CBitSet *
+CExtendedStats::MapAttnos(CMemoryPool *mp, const ULongPtrArray *attnos,
+						  UlongToUlongMap *attno_to_colid)
+{
+	CBitSet *colids = GPOS_NEW(mp) CBitSet(mp);
+	for (ULONG ul = 0; ul < attnos->Size(); ul++)
+	{
+		const ULONG *colid = attno_to_colid->Find((*attnos)[ul]);
+		if (nullptr == colid)
+		{
+			colids->Release();
+			return nullptr;
+		}
+		(void) colids->ExchangeSet(*colid);
+	}
+
+	return colids;
+}
+
+// build the extended statistics of a relation for the given columns;
+// return null if none of the items can be used
+CExtendedStats *
+CExtendedStats::CreateExtendedStats(CMemoryPool *mp,
+									const IMDRelStats *md_rel_stats,
+									UlongToUlongMap *attno_to_colid,
+									CDouble rel_rows)
+{
+	GPOS_ASSERT(nullptr != md_rel_stats);
+	GPOS_ASSERT(nullptr != attno_to_colid);
+
+	CExtendedStats *ext_stats = GPOS_NEW(mp) CExtendedStats(mp, rel_rows);
+
+	const CMDDependencyArray *dependencies = md_rel_stats->GetDependencies();
+	for (ULONG ul = 0; ul < dependencies->Size(); ul++)
+	{
+		CMDDependency *dependency = (*dependencies)[ul];
+		ULONG to_attno = dependency->ToAttno();
+		const ULONG *to_colid = attno_to_colid->Find(&to_attno);
+		if (nullptr == to_colid)
+		{
+			continue;
+		}
+
+		CBitSet *from_colids =
+			MapAttnos(mp, dependency->FromAttnos(), attno_to_colid);
+		if (nullptr != from_colids)
+		{
+			ext_stats->m_dependencies->Append(GPOS_NEW(mp) SDependency(
+				from_colids, *to_colid, dependency->Degree()));
+		}
+	}
+
+	const CMDNDistinctArray *ndistincts = md_rel_stats->GetNDistincts();
+	for (ULONG ul = 0; ul < ndistincts->Size(); ul++)
+	{
+		CMDNDistinct *ndistinct = (*ndistincts)[ul];
+		CBitSet *colids = MapAttnos(mp, ndistinct->Attnos(), attno_to_colid);
+		if (nullptr != colids)
+		{
+			ext_stats->m_ndistincts->Append(
+				GPOS_NEW(mp) SNDistinct(colids, ndistinct->NDistinct()));
+		}
+	}
+
+	if (0 == ext_stats->m_dependencies->Size() &&
+		0 == ext_stats->m_ndistincts->Size())
+	{
+		ext_stats->Release();
+		return nullptr;
+	}
+
+	return ext_stats;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExtendedStats::ApplyDependencies
+//
+//	@doc:
+//		Adjust the scale factors of equality predicates for the functional
+//		dependencies between their columns. The i-th entry of eq_colids is
+//		the column of the i-th scale factor if its predicates are all
+//		equalities, and gpos::ulong_max otherwise.
+//
+//		As in the planner, the strongest dependency (a_1..a_n) => b whose
+//		columns are all restricted is applied first, and replaces the
+//		selectivity of b with P(b | a_1..a_n) = f + (1 - f) * P(b), where f
+//		is the degree of the dependency. Column b is then left out of the
+//		remaining dependencies, so that no selectivity is discounted twice.
+//
+//---------------------------------------------------------------------------
+void
+CExtendedStats::ApplyDependencies(CMemoryPool *mp, ULongPtrArray *eq_colids,
+								  CDoubleArray *scale_factors) const
+{
+	GPOS_ASSERT(nullptr != eq_colids);
+	GPOS_ASSERT(nullptr != scale_factors);
+	GPOS_ASSERT(eq_colids->Size() == scale_factors->Size());
+
+	if (0 == m_dependencies->Size())
+	{
+		return;
+	}
+
+	CBitSet *restricted_colids = GPOS_NEW(mp) CBitSet(mp);
+	for (ULONG ul = 0; ul < eq_colids->Size(); ul++)
+	{
+		if (gpos::ulong_max != *(*eq_colids)[ul])
+		{
+			(void) restricted_colids->ExchangeSet(*(*eq_colids)[ul]);
+		}
+	}
+
+	while (1 < restricted_colids->Size())
+	{
+		// find the strongest applicable dependency, preferring the ones
+		// with more determining columns
+		SDependency *strongest = nullptr;
+		for (ULONG ul = 0; ul < m_dependencies->Size(); ul++)
+		{
+			SDependency *dependency = (*m_dependencies)[ul];
+			if (!restricted_colids->Get(dependency->m_to_colid) ||
+				!restricted_colids->ContainsAll(dependency->m_from_colids))
+			{
+				continue;
+			}
+
+			if (nullptr == strongest ||
+				dependency->m_degree > strongest->m_degree ||
+				(dependency->m_degree == strongest->m_degree &&
+				 dependency->m_from_colids->Size() >
+					 strongest->m_from_colids->Size()))
+			{
+				strongest = dependency;
+			}
+		}
+
+		if (nullptr == strongest)
+		{
+			break;
+		}
+
+		for (ULONG ul = 0; ul < eq_colids->Size(); ul++)
+		{
+			if (strongest->m_to_colid == *(*eq_colids)[ul])
+			{
+				CDouble *scale_factor = (*scale_factors)[ul];
+				CDouble selectivity =
+					CDouble(1.0) / std::max(DOUBLE(1.0), scale_factor->Get());
+				CDouble degree = strongest->m_degree;
+				*scale_factor =
+					CDouble(1.0) /
+					(degree + (CDouble(1.0) - degree) * selectivity);
+			}
+		}
+
+		(void) restricted_colids->ExchangeClear(strongest->m_to_colid);
+	}
+
+	restricted_colids->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExtendedStats::LookupNDistinct
+//
+//	@doc:
+//		Number of distinct combinations of values of exactly the given set
+//		of columns. The coefficient was computed on the whole relation, so
+//		when fewer rows are left it is scaled down with the same formula
+//		the planner uses in estimate_num_groups().
+//
+//---------------------------------------------------------------------------
+BOOL
+CExtendedStats::LookupNDistinct(const CBitSet *colids, CDouble rows,
+								CDouble *ndistinct) const
+{
+	GPOS_ASSERT(nullptr != colids);
+	GPOS_ASSERT(nullptr != ndistinct);
+
+	for (ULONG ul = 0; ul < m_ndistincts->Size(); ul++)
+	{
+		SNDistinct *item = (*m_ndistincts)[ul];
+		if (!item->m_colids->Equals(colids))
+		{
+			continue;
+		}
+
+		CDouble result = item->m_ndistinct;
+		if (rows < m_rel_rows && CDouble(0.0) < result)
+		{
+			result = result *
+					 (CDouble(1.0) - ((m_rel_rows - rows) / m_rel_rows)
+										 .Pow(m_rel_rows / result));
+		}
+
+		*ndistinct = std::max(CStatistics::MinRows.Get(),
+							  std::min(result.Get(), rows.Get()));
+		return true;
+	}
+
+	return false;
+}
+
+// print function
+IOstream &
+CExtendedStats::OsPrint(IOstream &os) const
+{
+	os << "{" << std::endl;
+	for (ULONG ul = 0; ul < m_dependencies->Size(); ul++)
+	{
+		SDependency *dependency = (*m_dependencies)[ul];
+		os << "Dependency ";
+		dependency->m_from_colids->OsPrint(os);
+		os << " => " << dependency->m_to_colid
+		   << " Degree: " << dependency->m_degree << std::endl;
+	}
+	for (ULONG ul = 0; ul < m_ndistincts->Size(); ul++)
+	{
+		SNDistinct *item = (*m_ndistincts)[ul];
+		os << "NDistinct ";
+		item->m_colids->OsPrint(os);
+		os << " " << item->m_ndistinct << std::endl;
+	}
+	os << "}" << std::endl;
+
+	return os;
+}
+
+// EOF
@@ -231,7 +231,7 @@ CFilterStatsProcessor::MakeStatsFilter(CMemoryPool *mp,
 	{
 		histograms_new = MakeHistHashMapConjOrDisjFilter(
 			mp, stats_config, histograms_copy, input_rows, base_pred_stats,
-			&scale_factor);
+			&scale_factor, input_stats->GetExtendedStats());
 
 		GPOS_ASSERT(CStatistics::MinRows.Get() <= scale_factor.Get());
 		rows_filter = input_rows / scale_factor;
@@ -252,6 +252,15 @@ CFilterStatsProcessor::MakeStatsFilter(CMemoryPool *mp,
 					rows_filter, input_stats->IsEmpty(),
 					input_stats->GetNumberOfPredicates() + num_predicates);
 
+	// the filter keeps the column ids, so the extended statistics of the
+	// input can still be used on top of it
+	CExtendedStats *ext_stats = input_stats->GetExtendedStats();
+	if (nullptr != ext_stats)
+	{
+		ext_stats->AddRef();
+		filter_stats->SetExtendedStats(ext_stats);
+	}
+
 	// since the filter operation is reductive, we choose the bounding method that takes
 	// the minimum of the cardinality upper bound of the source column (in the input hash map)
 	// and estimated output cardinality
@@ -268,7 +277,8 @@ UlongToHistogramMap *
 CFilterStatsProcessor::MakeHistHashMapConjOrDisjFilter(
 	CMemoryPool *mp, const CStatisticsConfig *stats_config,
 	UlongToHistogramMap *input_histograms, CDouble input_rows,
-	CStatsPred *pred_stats, CDouble *scale_factor)
+	CStatsPred *pred_stats, CDouble *scale_factor,
+	const CExtendedStats *ext_stats)
 {
 	GPOS_ASSERT(nullptr != pred_stats);
 	GPOS_ASSERT(nullptr != stats_config);
@@ -282,7 +292,7 @@ CFilterStatsProcessor::MakeHistHashMapConjOrDisjFilter(
 			CStatsPredConj::ConvertPredStats(pred_stats);
 		return MakeHistHashMapConjFilter(mp, stats_config, input_histograms,
 										 input_rows, conjunctive_pred_stats,
-										 scale_factor);
+										 scale_factor, ext_stats);
 	}
 
 	CStatsPredDisj *disjunctive_pred_stats =
@@ -301,7 +311,8 @@ UlongToHistogramMap *
 CFilterStatsProcessor::MakeHistHashMapConjFilter(
 	CMemoryPool *mp, const CStatisticsConfig *stats_config,
 	UlongToHistogramMap *input_histograms, CDouble input_rows,
-	CStatsPredConj *conjunctive_pred_stats, CDouble *scale_factor)
+	CStatsPredConj *conjunctive_pred_stats, CDouble *scale_factor,
+	const CExtendedStats *ext_stats)
 {
 	GPOS_ASSERT(nullptr != stats_config);
 	GPOS_ASSERT(nullptr != input_histograms);
@@ -312,6 +323,10 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 	CBitSet *filter_colids = GPOS_NEW(mp) CBitSet(mp);
 	CDoubleArray *scale_factors = GPOS_NEW(mp) CDoubleArray(mp);
 
+	// for each entry of scale_factors, the column whose predicates are all
+	// equalities, or gpos::ulong_max
+	ULongPtrArray *eq_colids = GPOS_NEW(mp) ULongPtrArray(mp);
+
 	// create copy of the original hash map of colid -> histogram
 	UlongToHistogramMap *result_histograms =
 		CStatisticsUtils::CopyHistHashMap(mp, input_histograms);
@@ -319,6 +334,7 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 	// properties of last seen column
 	CDouble last_scale_factor(1.0);
 	ULONG last_colid = gpos::ulong_max;
+	BOOL last_is_eq = false;
 
 	// iterate over filters and update corresponding histograms
 	const ULONG filters = conjunctive_pred_stats->GetNumPreds();
@@ -339,6 +355,7 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 				CStatsPredUnsupported::ConvertPredStats(child_pred_stats);
 			scale_factors->Append(
 				GPOS_NEW(mp) CDouble(unsupported_pred_stats->ScaleFactor()));
+			eq_colids->Append(GPOS_NEW(mp) ULONG(gpos::ulong_max));
 
 			continue;
 		}
@@ -348,11 +365,21 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 		if (IsNewStatsColumn(colid, last_colid))
 		{
 			scale_factors->Append(GPOS_NEW(mp) CDouble(last_scale_factor));
+			eq_colids->Append(GPOS_NEW(mp) ULONG(
+				last_is_eq ? last_colid : gpos::ulong_max));
 			last_scale_factor = CDouble(1.0);
+			last_is_eq = true;
 		}
 
 		if (CStatsPred::EsptDisj != child_pred_stats->GetPredStatsType())
 		{
+			last_is_eq =
+				last_is_eq &&
+				CStatsPred::EsptPoint == child_pred_stats->GetPredStatsType() &&
+				CStatsPred::EstatscmptEq ==
+					CStatsPredPoint::ConvertPredStats(child_pred_stats)
+						->GetCmpType();
+
 			GPOS_ASSERT(gpos::ulong_max != colid);
 			hist_before = result_histograms->Find(&colid)->CopyHistogram();
 			GPOS_ASSERT(nullptr != hist_before);
@@ -432,14 +459,22 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 			}
 
 			last_colid = colid;
+			last_is_eq = false;
 			disjunctive_input_histograms->Release();
 		}
 	}
 
 	// scaling factor of the last predicate
 	scale_factors->Append(GPOS_NEW(mp) CDouble(last_scale_factor));
+	eq_colids->Append(
+		GPOS_NEW(mp) ULONG(last_is_eq ? last_colid : gpos::ulong_max));
 
 	GPOS_ASSERT(nullptr != scale_factors);
+	if (nullptr != ext_stats)
+	{
+		// account for correlated columns before assuming independence
+		ext_stats->ApplyDependencies(mp, eq_colids, scale_factors);
+	}
 	CScaleFactorUtils::SortScalingFactor(scale_factors, true /* fDescending */);
 
 	*scale_factor = CScaleFactorUtils::CalcScaleFactorCumulativeConj(
@@ -447,6 +482,7 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 
 	// clean up
 	scale_factors->Release();
+	eq_colids->Release();
 	filter_colids->Release();
 
 	return result_histograms;
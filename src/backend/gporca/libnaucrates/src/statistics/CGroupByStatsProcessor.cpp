@@ -78,6 +78,28 @@ CGroupByStatsProcessor::CalcGroupByStats(CMemoryPool *mp,
 		CDouble groups =
 			CStatisticsUtils::GetCumulativeNDVs(stats_config, NDVs);
 
+		// when the grouping columns are plain columns with a multi-column
+		// ndistinct coefficient, use it instead of combining the per-column
+		// NDVs as if the columns were independent
+		CExtendedStats *ext_stats = input_stats->GetExtendedStats();
+		if (nullptr != ext_stats && 1 < GCs->Size() &&
+			0 == computed_groupby_cols->Size())
+		{
+			CBitSet *grouping_colids = GPOS_NEW(mp) CBitSet(mp);
+			for (ULONG ul = 0; ul < GCs->Size(); ul++)
+			{
+				(void) grouping_colids->ExchangeSet(*(*GCs)[ul]);
+			}
+
+			CDouble ndistinct(0.0);
+			if (ext_stats->LookupNDistinct(grouping_colids, input_stats->Rows(),
+										   &ndistinct))
+			{
+				groups = ndistinct;
+			}
+			grouping_colids->Release();
+		}
+
 		// clean up
 		groupby_cols_for_stats->Release();
 		computed_groupby_cols->Release();
@@ -421,12 +421,37 @@ CJoinStatsProcessor::SetResultingJoinStats(
 	}
 
 
+	// the cumulative scale factor stands for the NDV of the combined
+	// equi-join columns, which cannot exceed the cardinality of the larger
+	// of the inputs; when the join columns of a side have a multi-column
+	// ndistinct coefficient, it gives a tighter bound for correlated columns
+	CDouble limit_for_result_scale_factor(
+		std::max(outer_stats->Rows().Get(), inner_side_stats->Rows().Get()));
+	if (IStatistics::EsjtInnerJoin == join_type && 1 < num_join_conds)
+	{
+		BOOL outer_has_ext_stats = false;
+		BOOL inner_has_ext_stats = false;
+		CDouble outer_ndv =
+			JoinColsNDVUpperBound(mp, outer_stats, join_pred_stats_info,
+								  true /* is_outer */, &outer_has_ext_stats);
+		CDouble inner_ndv =
+			JoinColsNDVUpperBound(mp, inner_side_stats, join_pred_stats_info,
+								  false /* is_outer */, &inner_has_ext_stats);
+		if (outer_has_ext_stats || inner_has_ext_stats)
+		{
+			limit_for_result_scale_factor =
+				std::min(limit_for_result_scale_factor.Get(),
+						 std::max(outer_ndv.Get(), inner_ndv.Get()));
+		}
+	}
+
 	num_join_rows = CStatistics::MinRows;
 	if (!output_is_empty)
 	{
 		num_join_rows = CalcJoinCardinality(
 			mp, stats_config, outer_stats->Rows(), inner_side_stats->Rows(),
-			join_conds_scale_factors, join_type);
+			join_conds_scale_factors, join_type,
+			limit_for_result_scale_factor);
 	}
 
 	// clean up
@@ -470,12 +495,11 @@ CJoinStatsProcessor::CalcJoinCardinality(
 	CMemoryPool *mp, CStatisticsConfig *stats_config, CDouble left_num_rows,
 	CDouble right_num_rows,
 	CScaleFactorUtils::SJoinConditionArray *join_conds_scale_factors,
-	IStatistics::EStatsJoinType join_type)
+	IStatistics::EStatsJoinType join_type,
+	CDouble limit_for_result_scale_factor)
 {
 	GPOS_ASSERT(nullptr != stats_config);
 	GPOS_ASSERT(nullptr != join_conds_scale_factors);
-	CDouble limit_for_result_scale_factor(
-		std::max(left_num_rows.Get(), right_num_rows.Get()));
 
 	CDouble scale_factor = CScaleFactorUtils::CumulativeJoinScaleFactor(
 		mp, stats_config, join_conds_scale_factors,
@@ -509,6 +533,53 @@ CJoinStatsProcessor::CalcJoinCardinality(
 
 
 
+// upper bound of the number of distinct combinations of values of the
+// equi-join columns of one side of the join: the multi-column ndistinct
+// coefficient of the extended statistics if there is one, otherwise the
+// product of the NDVs of the columns, capped by the number of rows
+CDouble
+CJoinStatsProcessor::JoinColsNDVUpperBound(CMemoryPool *mp,
+										   const CStatistics *stats,
+										   CStatsPredJoinArray *join_preds_stats,
+										   BOOL is_outer, BOOL *has_ext_stats)
+{
+	GPOS_ASSERT(nullptr != has_ext_stats);
+
+	*has_ext_stats = false;
+	CDouble rows = stats->Rows();
+	CDouble ndv_product(1.0);
+	CBitSet *join_colids = GPOS_NEW(mp) CBitSet(mp);
+	for (ULONG ul = 0; ul < join_preds_stats->Size(); ul++)
+	{
+		CStatsPredJoin *join_pred_stats = (*join_preds_stats)[ul];
+		if (CStatsPred::EstatscmptEq != join_pred_stats->GetCmpType() ||
+			!join_pred_stats->HasValidColIdOuter() ||
+			!join_pred_stats->HasValidColIdInner())
+		{
+			join_colids->Release();
+			return rows;
+		}
+
+		ULONG colid = is_outer ? join_pred_stats->ColIdOuter()
+							   : join_pred_stats->ColIdInner();
+		const CHistogram *histogram = stats->GetHistogram(colid);
+		GPOS_ASSERT(nullptr != histogram);
+		ndv_product = ndv_product * std::max(CStatistics::MinRows.Get(),
+											 histogram->GetNumDistinct().Get());
+		(void) join_colids->ExchangeSet(colid);
+	}
+
+	CDouble ndv = std::min(ndv_product.Get(), rows.Get());
+	CExtendedStats *ext_stats = stats->GetExtendedStats();
+	if (nullptr != ext_stats)
+	{
+		*has_ext_stats = ext_stats->LookupNDistinct(join_colids, rows, &ndv);
+	}
+	join_colids->Release();
+
+	return ndv;
+}
+
 // check if the join statistics object is empty output based on the input
 // histograms and the join histograms
 BOOL
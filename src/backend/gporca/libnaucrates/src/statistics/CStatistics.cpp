@@ -71,7 +71,8 @@ CStatistics::CStatistics(CMemoryPool *mp,
 	  m_num_rebinds(
 		  1.0),	 // by default, a stats object is rebound to parameters only once
 	  m_num_predicates(num_predicates),
-	  m_src_upper_bound_NDVs(nullptr)
+	  m_src_upper_bound_NDVs(nullptr),
+	  m_ext_stats(nullptr)
 {
 	GPOS_ASSERT(nullptr != m_colid_histogram_mapping);
 	GPOS_ASSERT(nullptr != m_colid_width_mapping);
@@ -98,7 +99,8 @@ CStatistics::CStatistics(CMemoryPool *mp,
 	  m_num_rebinds(
 		  1.0),	 // by default, a stats object is rebound to parameters only once
 	  m_num_predicates(0),
-	  m_src_upper_bound_NDVs(nullptr)
+	  m_src_upper_bound_NDVs(nullptr),
+	  m_ext_stats(nullptr)
 {
 	GPOS_ASSERT(nullptr != m_colid_histogram_mapping);
 	GPOS_ASSERT(nullptr != m_colid_width_mapping);
@@ -117,6 +119,7 @@ CStatistics::~CStatistics()
 	m_colid_histogram_mapping->Release();
 	m_colid_width_mapping->Release();
 	m_src_upper_bound_NDVs->Release();
+	CRefCount::SafeRelease(m_ext_stats);
 }
 
 // look up the width of a particular column
@@ -574,6 +577,13 @@ CStatistics::ScaleStats(CMemoryPool *mp, CDouble factor) const
 		GPOS_NEW(mp) CStatistics(mp, histograms_new, widths_new,
 								 scaled_num_rows, IsEmpty(), m_num_predicates);
 
+	// the column ids are unchanged, so the extended statistics still apply
+	if (nullptr != m_ext_stats)
+	{
+		m_ext_stats->AddRef();
+		scaled_stats->SetExtendedStats(m_ext_stats);
+	}
+
 	// In the output statistics object, the upper bound source cardinality of the scaled column
 	// cannot be greater than the the upper bound source cardinality information maintained in the input
 	// statistics object. Therefore we choose CStatistics::EcbmMin the bounding method which takes
@@ -447,6 +447,7 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenSortOpName, GPOS_WSZ_LIT("SortOperatorName")},
 		{EdxltokenSortDiscardDuplicates, GPOS_WSZ_LIT("SortDiscardDuplicates")},
 		{EdxltokenSortNullsFirst, GPOS_WSZ_LIT("SortNullsFirst")},
+		{EdxltokenSortPresortedCols, GPOS_WSZ_LIT("SortPresortedCols")},
 
 		{EdxltokenMaterializeEager, GPOS_WSZ_LIT("Eager")},
 
@@ -501,6 +502,10 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenRelationStats, GPOS_WSZ_LIT("RelationStatistics")},
 		{EdxltokenColumnStats, GPOS_WSZ_LIT("ColumnStatistics")},
 		{EdxltokenColumnStatsBucket, GPOS_WSZ_LIT("StatsBucket")},
+		{EdxltokenRelationStatsDependency, GPOS_WSZ_LIT("FunctionalDependency")},
+		{EdxltokenRelationStatsNDistinct, GPOS_WSZ_LIT("MultiColumnNDistinct")},
+		{EdxltokenDependencyDegree, GPOS_WSZ_LIT("Degree")},
+		{EdxltokenAttnos, GPOS_WSZ_LIT("Attnos")},
 		{EdxltokenEmptyRelation, GPOS_WSZ_LIT("EmptyRelation")},
 
 		{EdxltokenIsNull, GPOS_WSZ_LIT("IsNull")},
@@ -769,6 +774,7 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenNLJIndexParamList, GPOS_WSZ_LIT("NLJIndexParamList")},
 		{EdxltokenNLJIndexParam, GPOS_WSZ_LIT("NLJIndexParam")},
 		{EdxltokenNLJIndexOuterRefAsParam, GPOS_WSZ_LIT("OuterRefAsParam")},
+		{EdxltokenNLJMemoize, GPOS_WSZ_LIT("Memoize")},
 	};
 
 	m_pstrmap = GPOS_NEW_ARRAY(m_mp, SStrMapElem, EdxltokenSentinel);
@@ -53,6 +53,7 @@ const CHAR *CParseHandlerTest::m_rgszPlanDXLFileNames[] = {
 	"../data/dxl/parse_tests/q16-FuncExpr-WithNestedFuncExpr.xml",
 	"../data/dxl/parse_tests/q17-AggRef.xml",
 	"../data/dxl/parse_tests/q18-Sort-TS.xml",
+	"../data/dxl/parse_tests/q77-IncrementalSort.xml",
 	"../data/dxl/parse_tests/q19-DistinctFrom.xml",
 	"../data/dxl/parse_tests/q20-DistinctFrom-HJ.xml",
 	"../data/dxl/parse_tests/q21-SubqueryScan.xml",
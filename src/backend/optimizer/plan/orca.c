@@ -21,11 +21,17 @@
 
 #include "postgres.h"
 
+#include "access/htup_details.h"
+#include "catalog/pg_class.h"
+#include "catalog/pg_proc.h"
 #include "cdb/cdbmutate.h"		/* apply_shareinput */
 #include "cdb/cdbplan.h"
+#include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"
 #include "nodes/makefuncs.h"
+#include "nodes/nodeFuncs.h"
 #include "optimizer/clauses.h"
+#include "optimizer/cost.h"
 #include "optimizer/optimizer.h"
 #include "optimizer/orca.h"
 #include "optimizer/paths.h"
@@ -39,6 +45,7 @@
 #include "portability/instr_time.h"
 #include "utils/guc.h"
 #include "utils/lsyscache.h"
+#include "utils/syscache.h"
 
 /* GPORCA entry point */
 extern PlannedStmt * GPOPTOptimizedPlan(Query *parse, bool *had_unexpected_failure);
@@ -49,6 +56,8 @@ static Plan *remove_redundant_results(PlannerInfo *root, Plan *plan);
 static Node *remove_redundant_results_mutator(Node *node, void *);
 static bool can_replace_tlist(Plan *plan);
 static Node *push_down_expr_mutator(Node *node, List *child_tlist);
+static bool want_parallel_plan(Query *parse);
+static bool parallel_scan_candidate_walker(Node *node, void *context);
 
 /*
  * Logging of optimization outcome
@@ -111,6 +120,26 @@ optimize_query(Query *parse, int cursorOptions, ParamListInfo boundParams)
 	if ((cursorOptions & CURSOR_OPT_UPDATABLE) != 0)
 		return NULL;
 
+	/*
+	 * GPORCA only produces plans with one process per segment in each slice.
+	 * If the user asked for intra-segment parallelism, and the query could
+	 * use it, let the Postgres planner build a parallel plan instead.
+	 */
+	if (optimizer_parallel_fallback && want_parallel_plan(parse))
+	{
+		if (optimizer_trace_fallback)
+			ereport(INFO,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("GPORCA failed to produce a plan, falling back to planner"),
+					 errdetail("Feature not supported: Intra-segment parallel plans")));
+		return NULL;
+	}
+
+	/* Reuse the plan of an identical query, if we have one */
+	result = orca_plan_cache_lookup(parse, cursorOptions, boundParams);
+	if (result)
+		return result;
+
 	/*
 	 * Initialize a dummy PlannerGlobal struct. ORCA doesn't use it, but the
 	 * pre- and post-processing steps do.
@@ -282,6 +311,8 @@ optimize_query(Query *parse, int cursorOptions, ParamListInfo boundParams)
 	result->oneoffPlan = glob->oneoffPlan;
 	result->transientPlan = glob->transientPlan;
 
+	orca_plan_cache_insert(parse, cursorOptions, boundParams, result);
+
 	return result;
 }
 
@@ -1178,3 +1209,67 @@ generate_alternate_vars(Var *invar, grouped_window_ctx * ctx)
 	}
 	return alternates;
 }
+
+/*
+ * Would the Postgres planner consider a parallel plan for this query?
+ *
+ * That takes parallel query to be enabled, the query to be parallel safe,
+ * and at least one table big enough for a parallel scan on each segment.
+ * This mirrors the cheap checks at the top of standard_planner() and
+ * create_plain_partial_paths(); the planner still makes the final call on
+ * cost.
+ */
+static bool
+want_parallel_plan(Query *parse)
+{
+	if (!enable_parallel || max_parallel_workers_per_gather <= 0 ||
+		IS_SINGLENODE())
+		return false;
+
+	if (max_parallel_hazard(parse) == PROPARALLEL_UNSAFE)
+		return false;
+
+	return query_tree_walker(parse, parallel_scan_candidate_walker, NULL,
+							 QTW_EXAMINE_RTES_BEFORE);
+}
+
+static bool
+parallel_scan_candidate_walker(Node *node, void *context)
+{
+	if (node == NULL)
+		return false;
+
+	if (IsA(node, RangeTblEntry))
+	{
+		RangeTblEntry *rte = (RangeTblEntry *) node;
+		HeapTuple	tp;
+		bool		result = false;
+
+		if (rte->rtekind != RTE_RELATION)
+			return false;
+
+		tp = SearchSysCache1(RELOID, ObjectIdGetDatum(rte->relid));
+		if (HeapTupleIsValid(tp))
+		{
+			Form_pg_class reltup = (Form_pg_class) GETSTRUCT(tp);
+
+			/*
+			 * relpages on the QD is the total over all segments, as gathered
+			 * by ANALYZE.
+			 */
+			if ((reltup->relkind == RELKIND_RELATION ||
+				 reltup->relkind == RELKIND_MATVIEW) &&
+				reltup->relpages / Max(getgpsegmentCount(), 1) >=
+				min_parallel_table_scan_size)
+				result = true;
+			ReleaseSysCache(tp);
+		}
+		return result;
+	}
+
+	if (IsA(node, Query))
+		return query_tree_walker((Query *) node, parallel_scan_candidate_walker,
+								 context, QTW_EXAMINE_RTES_BEFORE);
+
+	return expression_tree_walker(node, parallel_scan_candidate_walker, context);
+}
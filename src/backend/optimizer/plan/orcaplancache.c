@@ -0,0 +1,363 @@
+/*-------------------------------------------------------------------------
+ *
+ * orcaplancache.c
+ *	  Per-session cache of the plans GPORCA produced for repeated queries
+ *
+ * Dashboards and BI tools send the same queries over and over, and every one
+ * of them goes through the full Query -> DXL -> memo -> DXL -> PlannedStmt
+ * pipeline of ORCA. With optimizer_plan_cache_size set, optimize_query()
+ * keeps the plans of that many distinct SELECT queries, keyed on the query
+ * identifier computed by queryjumble.c, and hands out a copy of a cached
+ * plan when a later query tree is equal() to the cached one.
+ *
+ * The query identifier ignores constants, so queries of the same shape end
+ * up in the same hash bucket, but a plan is only reused for exactly the same
+ * constants: ORCA folds constants into derived predicates, partition
+ * selection and cardinality estimates, and there is no way to tell from the
+ * produced plan where they went, let alone to rebind them.
+ *
+ * A cached plan is dropped when anything it was derived from changes. Catalog
+ * changes are tracked like plancache.c does for generic plans, plus the
+ * catalogs that the ORCA metadata cache depends on. Plans that evaluated
+ * stable functions at planning time (oneoffPlan) or that depend on
+ * transaction-local state (transientPlan) are not cached, and any change of
+ * a configuration parameter or of the number of segments makes the cached
+ * plans stale.
+ *
+ * Portions Copyright (c) 2024-Present HashData, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/optimizer/plan/orcaplancache.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "cdb/cdbutil.h"
+#include "funcapi.h"
+#include "lib/ilist.h"
+#include "optimizer/orca.h"
+#include "utils/builtins.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+#include "utils/queryjumble.h"
+#include "utils/syscache.h"
+
+typedef struct OrcaPlanCacheEntry
+{
+	dlist_node	bucket_node;	/* in the list of its hash bucket */
+	dlist_node	lru_node;		/* in orca_plan_cache_lru */
+	MemoryContext context;		/* holds the entry and everything below */
+	uint64		queryId;
+	Query	   *query;
+	int			cursorOptions;
+	PlannedStmt *plan;
+	uint64		guc_assignment_count;	/* settings the plan was built under */
+	int			numsegments;
+} OrcaPlanCacheEntry;
+
+typedef struct OrcaPlanCacheBucket
+{
+	uint64		queryId;		/* hash key, must be first */
+	dlist_head	entries;
+} OrcaPlanCacheBucket;
+
+static MemoryContext orca_plan_cache_context = NULL;
+static HTAB *orca_plan_cache_hash = NULL;
+
+/* all entries, most recently used first */
+static dlist_head orca_plan_cache_lru = DLIST_STATIC_INIT(orca_plan_cache_lru);
+static int	orca_plan_cache_entries = 0;
+
+static uint64 orca_plan_cache_hits = 0;
+static uint64 orca_plan_cache_misses = 0;
+static uint64 orca_plan_cache_invalidations = 0;
+static uint64 orca_plan_cache_evictions = 0;
+
+static void
+orca_plan_cache_remove(OrcaPlanCacheEntry *entry)
+{
+	OrcaPlanCacheBucket *bucket;
+
+	bucket = hash_search(orca_plan_cache_hash, &entry->queryId, HASH_FIND,
+						 NULL);
+	Assert(bucket != NULL);
+
+	dlist_delete(&entry->bucket_node);
+	if (dlist_is_empty(&bucket->entries))
+		hash_search(orca_plan_cache_hash, &entry->queryId, HASH_REMOVE, NULL);
+
+	dlist_delete(&entry->lru_node);
+	orca_plan_cache_entries--;
+
+	MemoryContextDelete(entry->context);
+}
+
+/*
+ * Relcache invalidation callback: drop the plans that use the relation.
+ */
+static void
+orca_plan_cache_rel_callback(Datum arg, Oid relid)
+{
+	dlist_mutable_iter iter;
+
+	dlist_foreach_modify(iter, &orca_plan_cache_lru)
+	{
+		OrcaPlanCacheEntry *entry =
+			dlist_container(OrcaPlanCacheEntry, lru_node, iter.cur);
+
+		/* an invalid relid means the whole relcache was flushed */
+		if (!OidIsValid(relid) ||
+			list_member_oid(entry->plan->relationOids, relid))
+		{
+			orca_plan_cache_remove(entry);
+			orca_plan_cache_invalidations++;
+		}
+	}
+}
+
+/*
+ * Syscache invalidation callback for pg_proc and pg_type: drop the plans
+ * that depend on the changed object, see PlanCacheObjectCallback().
+ */
+static void
+orca_plan_cache_object_callback(Datum arg, int cacheid, uint32 hashvalue)
+{
+	dlist_mutable_iter iter;
+
+	dlist_foreach_modify(iter, &orca_plan_cache_lru)
+	{
+		OrcaPlanCacheEntry *entry =
+			dlist_container(OrcaPlanCacheEntry, lru_node, iter.cur);
+		ListCell   *lc;
+
+		foreach(lc, entry->plan->invalItems)
+		{
+			PlanInvalItem *item = (PlanInvalItem *) lfirst(lc);
+
+			if (item->cacheId != cacheid)
+				continue;
+			/* a zero hash value means the whole syscache was flushed */
+			if (hashvalue == 0 || item->hashValue == hashvalue)
+			{
+				orca_plan_cache_remove(entry);
+				orca_plan_cache_invalidations++;
+				break;
+			}
+		}
+	}
+}
+
+/*
+ * Syscache invalidation callback for catalogs that plans do not record
+ * dependencies on: drop all plans.
+ */
+static void
+orca_plan_cache_sys_callback(Datum arg, int cacheid, uint32 hashvalue)
+{
+	dlist_mutable_iter iter;
+
+	dlist_foreach_modify(iter, &orca_plan_cache_lru)
+	{
+		orca_plan_cache_remove(dlist_container(OrcaPlanCacheEntry, lru_node,
+											   iter.cur));
+		orca_plan_cache_invalidations++;
+	}
+}
+
+static void
+orca_plan_cache_init(void)
+{
+	HASHCTL		ctl;
+
+	if (orca_plan_cache_hash != NULL)
+		return;
+
+	orca_plan_cache_context = AllocSetContextCreate(TopMemoryContext,
+													"GPORCA plan cache",
+													ALLOCSET_DEFAULT_SIZES);
+
+	ctl.keysize = sizeof(uint64);
+	ctl.entrysize = sizeof(OrcaPlanCacheBucket);
+	ctl.hcxt = orca_plan_cache_context;
+	orca_plan_cache_hash = hash_create("GPORCA plan cache", 64, &ctl,
+									   HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+	/* the catalogs plancache.c watches */
+	CacheRegisterRelcacheCallback(orca_plan_cache_rel_callback, (Datum) 0);
+	CacheRegisterSyscacheCallback(PROCOID, orca_plan_cache_object_callback,
+								  (Datum) 0);
+	CacheRegisterSyscacheCallback(TYPEOID, orca_plan_cache_object_callback,
+								  (Datum) 0);
+	CacheRegisterSyscacheCallback(NAMESPACEOID, orca_plan_cache_sys_callback,
+								  (Datum) 0);
+	CacheRegisterSyscacheCallback(OPEROID, orca_plan_cache_sys_callback,
+								  (Datum) 0);
+	CacheRegisterSyscacheCallback(AMOPOPID, orca_plan_cache_sys_callback,
+								  (Datum) 0);
+	CacheRegisterSyscacheCallback(FOREIGNSERVEROID,
+								  orca_plan_cache_sys_callback, (Datum) 0);
+	CacheRegisterSyscacheCallback(FOREIGNDATAWRAPPEROID,
+								  orca_plan_cache_sys_callback, (Datum) 0);
+
+	/* and the other catalogs the ORCA metadata cache is built from */
+	CacheRegisterSyscacheCallback(AGGFNOID, orca_plan_cache_sys_callback,
+								  (Datum) 0);
+	CacheRegisterSyscacheCallback(CASTSOURCETARGET,
+								  orca_plan_cache_sys_callback, (Datum) 0);
+	CacheRegisterSyscacheCallback(CONSTROID, orca_plan_cache_sys_callback,
+								  (Datum) 0);
+	CacheRegisterSyscacheCallback(OPFAMILYOID, orca_plan_cache_sys_callback,
+								  (Datum) 0);
+}
+
+/*
+ * Can the plan of the given query be looked up in, or added to, the cache?
+ */
+static bool
+orca_plan_cache_usable(Query *parse, int cursorOptions,
+					   ParamListInfo boundParams)
+{
+	if (optimizer_plan_cache_size <= 0)
+		return false;
+
+	/* with compute_query_id = auto, the cache needs query identifiers */
+	EnableQueryId();
+
+	return parse->queryId != UINT64CONST(0) &&
+		parse->commandType == CMD_SELECT &&
+		parse->utilityStmt == NULL &&
+		parse->parentStmtType == PARENTSTMTTYPE_NONE &&
+		parse->rowMarks == NIL &&
+		!parse->hasModifyingCTE &&
+		boundParams == NULL;
+}
+
+/*
+ * orca_plan_cache_lookup
+ *		Return a copy of the cached plan of the query, or NULL
+ */
+PlannedStmt *
+orca_plan_cache_lookup(Query *parse, int cursorOptions,
+					   ParamListInfo boundParams)
+{
+	OrcaPlanCacheBucket *bucket;
+	dlist_mutable_iter iter;
+
+	if (!orca_plan_cache_usable(parse, cursorOptions, boundParams))
+		return NULL;
+
+	orca_plan_cache_init();
+
+	bucket = hash_search(orca_plan_cache_hash, &parse->queryId, HASH_FIND,
+						 NULL);
+	if (bucket != NULL)
+	{
+		dlist_foreach_modify(iter, &bucket->entries)
+		{
+			OrcaPlanCacheEntry *entry =
+				dlist_container(OrcaPlanCacheEntry, bucket_node, iter.cur);
+
+			if (entry->cursorOptions != cursorOptions ||
+				!equal(entry->query, parse))
+				continue;
+
+			if (entry->guc_assignment_count != guc_assignment_count ||
+				entry->numsegments != getgpsegmentCount())
+			{
+				/* this may free the bucket, too */
+				orca_plan_cache_remove(entry);
+				orca_plan_cache_invalidations++;
+				break;
+			}
+
+			dlist_move_head(&orca_plan_cache_lru, &entry->lru_node);
+			orca_plan_cache_hits++;
+
+			return copyObject(entry->plan);
+		}
+	}
+
+	orca_plan_cache_misses++;
+
+	return NULL;
+}
+
+/*
+ * orca_plan_cache_insert
+ *		Remember the plan ORCA produced for the query
+ */
+void
+orca_plan_cache_insert(Query *parse, int cursorOptions,
+					   ParamListInfo boundParams, PlannedStmt *plan)
+{
+	OrcaPlanCacheEntry *entry;
+	OrcaPlanCacheBucket *bucket;
+	MemoryContext context;
+	MemoryContext oldcontext;
+	bool		found;
+
+	if (!orca_plan_cache_usable(parse, cursorOptions, boundParams) ||
+		plan->oneoffPlan || plan->transientPlan)
+		return;
+
+	orca_plan_cache_init();
+
+	while (orca_plan_cache_entries >= optimizer_plan_cache_size)
+	{
+		orca_plan_cache_remove(dlist_tail_element(OrcaPlanCacheEntry, lru_node,
+												  &orca_plan_cache_lru));
+		orca_plan_cache_evictions++;
+	}
+
+	context = AllocSetContextCreate(orca_plan_cache_context,
+									"GPORCA cached plan",
+									ALLOCSET_SMALL_SIZES);
+	oldcontext = MemoryContextSwitchTo(context);
+
+	entry = palloc(sizeof(OrcaPlanCacheEntry));
+	entry->context = context;
+	entry->queryId = parse->queryId;
+	entry->query = copyObject(parse);
+	entry->cursorOptions = cursorOptions;
+	entry->plan = copyObject(plan);
+	entry->guc_assignment_count = guc_assignment_count;
+	entry->numsegments = getgpsegmentCount();
+
+	MemoryContextSwitchTo(oldcontext);
+
+	bucket = hash_search(orca_plan_cache_hash, &parse->queryId, HASH_ENTER,
+						 &found);
+	if (!found)
+		dlist_init(&bucket->entries);
+	dlist_push_head(&bucket->entries, &entry->bucket_node);
+	dlist_push_head(&orca_plan_cache_lru, &entry->lru_node);
+	orca_plan_cache_entries++;
+}
+
+/*
+ * OrcaPlanCacheStats
+ *		Usage statistics of the plan cache of the current session
+ */
+Datum
+OrcaPlanCacheStats(PG_FUNCTION_ARGS)
+{
+	TupleDesc	tupdesc;
+	Datum		values[5];
+	bool		nulls[5];
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	MemSet(nulls, 0, sizeof(nulls));
+	values[0] = Int64GetDatum(orca_plan_cache_entries);
+	values[1] = Int64GetDatum(orca_plan_cache_hits);
+	values[2] = Int64GetDatum(orca_plan_cache_misses);
+	values[3] = Int64GetDatum(orca_plan_cache_invalidations);
+	values[4] = Int64GetDatum(orca_plan_cache_evictions);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
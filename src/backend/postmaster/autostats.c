@@ -40,7 +40,7 @@
 /*
  * Forward declarations.
  */
-static void autostats_issue_analyze(Oid relationOid);
+static void autostats_issue_analyze(AutoStatsCmdType cmdType, Oid relationOid);
 static bool autostats_on_change_check(AutoStatsCmdType cmdType, uint64 ntuples);
 static bool autostats_on_no_stats_check(AutoStatsCmdType cmdType, Oid relationOid);
 
@@ -48,7 +48,7 @@ static bool autostats_on_no_stats_check(AutoStatsCmdType cmdType, Oid relationOi
  * Auto-stats employs this sub-routine to issue an analyze on a specific relation.
  */
 static void
-autostats_issue_analyze(Oid relationOid)
+autostats_issue_analyze(AutoStatsCmdType cmdType, Oid relationOid)
 {
 	VacuumStmt *analyzeStmt;
 	VacuumRelation *relation;
@@ -71,6 +71,16 @@ autostats_issue_analyze(Oid relationOid)
 		}
 	}
 
+	/*
+	 * The rows appended by INSERT or COPY may be merged into the existing
+	 * statistics, from the sketches the segments built while inserting them.
+	 * ANALYZE the table when they cannot.
+	 */
+	if (gp_autostats_incremental &&
+		(cmdType == AUTOSTATS_CMDTYPE_INSERT || cmdType == AUTOSTATS_CMDTYPE_COPY) &&
+		analyze_appended_rows(relationOid))
+		return;
+
 	/* Set up an ANALYZE command */
 	relation = makeVacuumRelation(NULL, relationOid, NIL);
 	analyzeStmt = makeNode(VacuumStmt);
@@ -365,7 +375,7 @@ auto_stats(AutoStatsCmdType cmdType, Oid relationOid, uint64 ntuples, bool inFun
 			 ntuples);
 	}
 
-	autostats_issue_analyze(relationOid);
+	autostats_issue_analyze(cmdType, relationOid);
 
 	if (log_duration)
 	{
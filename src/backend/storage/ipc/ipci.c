@@ -61,6 +61,7 @@
 #include "utils/backend_cancel.h"
 #include "utils/resource_manager.h"
 #include "utils/faultinjector.h"
+#include "utils/sharedmdcache.h"
 #include "utils/sharedsnapshot.h"
 #include "utils/gpexpand.h"
 #include "utils/snapmgr.h"
@@ -210,6 +211,7 @@ CreateSharedMemoryAndSemaphores(void)
 		size = add_size(size, CancelBackendMsgShmemSize());
 		size = add_size(size, WorkFileShmemSize());
 		size = add_size(size, ShareInputShmemSize());
+		size = add_size(size, SharedMDCacheShmemSize());
 
 #ifdef FAULT_INJECTOR
 		size = add_size(size, FaultInjector_ShmemSize());
@@ -393,6 +395,7 @@ CreateSharedMemoryAndSemaphores(void)
 	BackendCancelShmemInit();
 	WorkFileShmemInit();
 	ShareInputShmemInit();
+	SharedMDCacheShmemInit();
 
 	/*
 	 * Set up Instrumentation free list
@@ -177,7 +177,9 @@ static const char *const BuiltinTrancheNames[] = {
 	/* LWTRANCHE_PER_XACT_PREDICATE_LIST: */
 	"PerXactPredicateList",
 	/* LWTRANCHE_DISTRIBUTEDLOG_BUFFERS */
-	"DistributedLogBuffer"
+	"DistributedLogBuffer",
+	/* LWTRANCHE_SHARED_MDCACHE_DSA */
+	"SharedMDCacheDSA"
 };
 
 StaticAssertDecl(lengthof(BuiltinTrancheNames) ==
@@ -8,6 +8,10 @@
  *
  * gp_opt_version: This function wraps LibraryVersion. 
  *
+ * gp_opt_get_mdcache_stats: This function wraps MDCacheStats.
+ *
+ * gp_opt_get_plan_cache_stats: This function wraps OrcaPlanCacheStats.
+ *
  * Copyright(c) 2012 - present, EMC/Greenplum
  */
 
@@ -85,3 +89,35 @@ gp_opt_version(PG_FUNCTION_ARGS pg_attribute_unused())
 	return CStringGetTextDatum("Server has been compiled without ORCA");
 #endif
 }
+
+extern Datum MDCacheStats(PG_FUNCTION_ARGS);
+
+/*
+* Returns the usage statistics of the optimizer metadata cache.
+*/
+Datum
+gp_opt_get_mdcache_stats(PG_FUNCTION_ARGS)
+{
+#ifdef USE_ORCA
+	return MDCacheStats(fcinfo);
+#else
+	PG_RETURN_NULL();
+#endif
+}
+
+#ifdef USE_ORCA
+extern Datum OrcaPlanCacheStats(PG_FUNCTION_ARGS);
+#endif
+
+/*
+* Returns the usage statistics of the optimizer plan cache.
+*/
+Datum
+gp_opt_get_plan_cache_stats(PG_FUNCTION_ARGS)
+{
+#ifdef USE_ORCA
+	return OrcaPlanCacheStats(fcinfo);
+#else
+	PG_RETURN_NULL();
+#endif
+}
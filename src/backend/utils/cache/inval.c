@@ -129,6 +129,7 @@
 #include "utils/memutils.h"
 #include "utils/rel.h"
 #include "utils/relmapper.h"
+#include "utils/sharedmdcache.h"
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
 
@@ -1002,6 +1003,7 @@ ProcessCommittedInvalidationMessages(SharedInvalidationMessage *msgs,
 	}
 
 	SendSharedInvalidMessages(msgs, nmsgs);
+	SharedMDCacheInvalidate(msgs, nmsgs);
 
 	if (RelcacheInitFileInval)
 		RelationCacheInitFilePostInvalidate();
@@ -1056,6 +1058,8 @@ AtEOXact_Inval(bool isCommit)
 
 		ProcessInvalidationMessagesMulti(&transInvalInfo->PriorCmdInvalidMsgs,
 										 SendSharedInvalidMessages);
+		ProcessInvalidationMessagesMulti(&transInvalInfo->PriorCmdInvalidMsgs,
+										 SharedMDCacheInvalidate);
 
 		if (transInvalInfo->RelcacheInitFileInval)
 			RelationCacheInitFilePostInvalidate();
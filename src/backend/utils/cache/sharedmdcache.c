@@ -0,0 +1,672 @@
+/*-------------------------------------------------------------------------
+ *
+ * sharedmdcache.c
+ *	  Cache of ORCA metadata objects shared by all backends.
+ *
+ * ORCA keeps the metadata objects it translates from the catalogs in a
+ * backend-private cache (CMDCache), so every new session translates the same
+ * relations, statistics and operators again on its first queries. When
+ * optimizer_shared_mdcache_size is set, the translated objects are also
+ * published here, as DXL documents keyed by their serialized mdid, and other
+ * backends parse the DXL instead of going through the catalogs.
+ *
+ * The documents live in a DSA area created in place in the main shared
+ * memory segment, so the cache never grows beyond its configured size. When
+ * the area or the lookup table is full, arbitrary entries are evicted to
+ * make room for new ones.
+ *
+ * Every entry records the catalog changes that make it stale: a relcache
+ * invalidation of one relation, and syscache invalidations of up to two
+ * catalog tuples (see SharedMDCacheDeps). Invalidations are applied by the
+ * backend that committed them, once, right after sending them to the other
+ * backends (see SharedMDCacheInvalidate()). They do not walk the cache: each
+ * one bumps a generation counter, and stamps the new generation on the
+ * dependency it matches. Every entry is stamped with the generation its
+ * publisher saw before translating it, and an entry is stale when any of its
+ * dependencies has been invalidated since. Stale entries are skipped by
+ * lookups, and replaced or evicted when room is needed. Changes that cannot
+ * be attributed to individual entries (changes to pg_amop, pg_cast or
+ * pg_opfamily, or a flush of a whole catalog) make every entry stale.
+ *
+ * A second table counts the entries depending on each catalog key, and
+ * holds the generation of its last invalidation. Invalidations of keys that
+ * no entry depends on are not remembered individually; the last one is
+ * recorded instead, and a new dependency is assumed to have been invalidated
+ * then.
+ *
+ * Portions Copyright (c) 2024-Present HashData, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/utils/cache/sharedmdcache.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/transam.h"
+#include "access/xact.h"
+#include "catalog/catalog.h"
+#include "cdb/cdbvars.h"
+#include "port/atomics.h"
+#include "storage/ipc.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/dsa.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/memutils.h"
+#include "utils/sharedmdcache.h"
+#include "utils/syscache.h"
+
+/*
+ * Expected average size of a DXL document, used to size the lookup table.
+ * Types and operators are well below this, relations and column statistics
+ * with histograms above.
+ */
+#define SHARED_MDCACHE_AVG_ENTRY_SIZE	1024
+
+/* pseudo cache id of relcache invalidations in the dependency table */
+#define SHARED_MDCACHE_RELCACHE		(-1)
+
+/* a relation dependency plus the syscache ones */
+#define SHARED_MDCACHE_MAX_DEPS		(1 + SHARED_MDCACHE_MAX_SYSCACHE_DEPS)
+
+typedef struct SharedMDCacheControl
+{
+	/*
+	 * Number of invalidations applied so far. Only changed while holding
+	 * SharedMDCacheLock exclusively, but read without it.
+	 */
+	pg_atomic_uint64 generation;
+
+	/* generation of the last invalidation of the whole cache */
+	uint64		reset_generation;
+
+	/* generation of the last invalidation that no entry depended on */
+	uint64		untracked_generation;
+
+	/* the DSA area holding the DXL documents follows */
+} SharedMDCacheControl;
+
+typedef struct SharedMDCacheKey
+{
+	Oid			dbid;			/* database of the object */
+	char		mdid[SHARED_MDCACHE_KEY_LEN];	/* serialized mdid */
+} SharedMDCacheKey;
+
+typedef struct SharedMDCacheEntry
+{
+	SharedMDCacheKey key;		/* must be first */
+	dsa_pointer dxl;			/* zero-terminated DXL document */
+	Size		len;			/* length of the document, including the
+								 * terminating zero */
+	uint64		generation;		/* generation before the translation */
+	SharedMDCacheDeps deps;
+} SharedMDCacheEntry;
+
+typedef struct SharedMDCacheDepKey
+{
+	Oid			dbid;			/* database, InvalidOid for shared catalogs */
+	int			cacheid;		/* syscache id, or SHARED_MDCACHE_RELCACHE */
+	uint32		value;			/* syscache hash value, or relation OID */
+} SharedMDCacheDepKey;
+
+typedef struct SharedMDCacheDepEntry
+{
+	SharedMDCacheDepKey key;	/* must be first */
+	int			refcount;		/* number of entries with this dependency */
+	uint64		generation;		/* generation of the last invalidation */
+} SharedMDCacheDepEntry;
+
+/* GUC variable, in kB */
+int			optimizer_shared_mdcache_size = 0;
+
+static SharedMDCacheControl *shared_mdcache = NULL;
+static HTAB *shared_mdcache_hash = NULL;
+static HTAB *shared_mdcache_dep_hash = NULL;
+
+/* this backend's attachment to the DSA area */
+static dsa_area *shared_mdcache_dsa = NULL;
+
+/*
+ * Syscaches whose entries map to cached objects keyed by the same catalog
+ * key. This is the same list as the one the backend-private metadata cache
+ * uses to evict individual entries, see gpdbwrappers.cpp.
+ */
+static const int shared_mdcache_fine_grained_caches[] = {
+	AGGFNOID,					/* pg_aggregate */
+	CONSTROID,					/* pg_constraint */
+	OPEROID,					/* pg_operator */
+	PROCOID,					/* pg_proc */
+	STATRELATTINH,				/* pg_statistics */
+	TYPEOID,					/* pg_type */
+};
+
+/* catalogs whose changes make every entry stale */
+static const int shared_mdcache_coarse_caches[] = {
+	AMOPOPID,					/* pg_amop */
+	CASTSOURCETARGET,			/* pg_cast */
+	OPFAMILYOID,				/* pg_opfamily */
+};
+
+static bool
+shared_mdcache_is_enabled(void)
+{
+	return optimizer_shared_mdcache_size > 0 && Gp_role != GP_ROLE_EXECUTE;
+}
+
+static int
+shared_mdcache_max_entries(void)
+{
+	return Max(optimizer_shared_mdcache_size /
+			   (SHARED_MDCACHE_AVG_ENTRY_SIZE / 1024), 128);
+}
+
+static Size
+shared_mdcache_area_size(void)
+{
+	return Max((Size) optimizer_shared_mdcache_size * 1024,
+			   dsa_minimum_size());
+}
+
+static void *
+shared_mdcache_area_place(void)
+{
+	return (char *) shared_mdcache + MAXALIGN(sizeof(SharedMDCacheControl));
+}
+
+static void
+shared_mdcache_detach(int code, Datum arg)
+{
+	dsa_release_in_place(shared_mdcache_area_place());
+}
+
+static dsa_area *
+shared_mdcache_area(void)
+{
+	if (shared_mdcache_dsa == NULL)
+	{
+		MemoryContext oldcontext = MemoryContextSwitchTo(TopMemoryContext);
+
+		shared_mdcache_dsa = dsa_attach_in_place(shared_mdcache_area_place(),
+												 NULL);
+		dsa_pin_mapping(shared_mdcache_dsa);
+		MemoryContextSwitchTo(oldcontext);
+
+		on_shmem_exit(shared_mdcache_detach, (Datum) 0);
+	}
+
+	return shared_mdcache_dsa;
+}
+
+static void
+shared_mdcache_make_key(const char *mdid, SharedMDCacheKey *key)
+{
+	MemSet(key, 0, sizeof(SharedMDCacheKey));
+	key->dbid = MyDatabaseId;
+	strcpy(key->mdid, mdid);
+}
+
+/* the keys of the dependencies of an object of database 'dbid' */
+static int
+shared_mdcache_dep_keys(const SharedMDCacheDeps *deps, Oid dbid,
+						SharedMDCacheDepKey *keys)
+{
+	int			nkeys = 0;
+
+	/* MemSet, the keys are hashed as blobs */
+	MemSet(keys, 0, SHARED_MDCACHE_MAX_DEPS * sizeof(SharedMDCacheDepKey));
+
+	if (OidIsValid(deps->relid))
+	{
+		keys[nkeys].dbid = IsSharedRelation(deps->relid) ? InvalidOid : dbid;
+		keys[nkeys].cacheid = SHARED_MDCACHE_RELCACHE;
+		keys[nkeys].value = deps->relid;
+		nkeys++;
+	}
+
+	/* none of the fine-grained caches is on a shared catalog */
+	for (int i = 0; i < deps->nsyscache; i++)
+	{
+		keys[nkeys].dbid = dbid;
+		keys[nkeys].cacheid = deps->cacheids[i];
+		keys[nkeys].value = deps->hashvalues[i];
+		nkeys++;
+	}
+
+	return nkeys;
+}
+
+/*
+ * Has any of the given dependencies been invalidated after 'generation'?
+ * Caller must hold SharedMDCacheLock.
+ */
+static bool
+shared_mdcache_deps_changed(SharedMDCacheDepKey *keys, int nkeys,
+							uint64 generation)
+{
+	if (shared_mdcache->reset_generation > generation)
+		return true;
+
+	for (int i = 0; i < nkeys; i++)
+	{
+		SharedMDCacheDepEntry *dep;
+
+		dep = hash_search(shared_mdcache_dep_hash, &keys[i], HASH_FIND, NULL);
+		if ((dep != NULL ? dep->generation :
+			 shared_mdcache->untracked_generation) > generation)
+			return true;
+	}
+
+	return false;
+}
+
+/* caller must hold SharedMDCacheLock exclusively */
+static void
+shared_mdcache_release_deps(SharedMDCacheDepKey *keys, int nkeys)
+{
+	for (int i = 0; i < nkeys; i++)
+	{
+		SharedMDCacheDepEntry *dep;
+
+		dep = hash_search(shared_mdcache_dep_hash, &keys[i], HASH_FIND, NULL);
+		Assert(dep != NULL && dep->refcount > 0);
+		if (--dep->refcount == 0)
+		{
+			/* forget the dependency, but not its last invalidation */
+			shared_mdcache->untracked_generation =
+				Max(shared_mdcache->untracked_generation, dep->generation);
+			hash_search(shared_mdcache_dep_hash, &keys[i], HASH_REMOVE, NULL);
+		}
+	}
+}
+
+/*
+ * Count a new entry in the dependency table. Returns false, without any
+ * changes, if the table is full. Caller must hold SharedMDCacheLock
+ * exclusively.
+ */
+static bool
+shared_mdcache_add_deps(SharedMDCacheDepKey *keys, int nkeys)
+{
+	for (int i = 0; i < nkeys; i++)
+	{
+		SharedMDCacheDepEntry *dep;
+		bool		found;
+
+		dep = hash_search(shared_mdcache_dep_hash, &keys[i], HASH_ENTER_NULL,
+						  &found);
+		if (dep == NULL)
+		{
+			shared_mdcache_release_deps(keys, i);
+			return false;
+		}
+		if (!found)
+		{
+			dep->refcount = 0;
+			dep->generation = shared_mdcache->untracked_generation;
+		}
+		dep->refcount++;
+	}
+
+	return true;
+}
+
+/* caller must hold SharedMDCacheLock exclusively */
+static void
+shared_mdcache_remove_entry(SharedMDCacheEntry *entry)
+{
+	SharedMDCacheDepKey keys[SHARED_MDCACHE_MAX_DEPS];
+	int			nkeys;
+
+	nkeys = shared_mdcache_dep_keys(&entry->deps, entry->key.dbid, keys);
+	shared_mdcache_release_deps(keys, nkeys);
+	dsa_free(shared_mdcache_area(), entry->dxl);
+	hash_search(shared_mdcache_hash, &entry->key, HASH_REMOVE, NULL);
+}
+
+/*
+ * Evict an arbitrary entry to make room for a new one. Returns false if the
+ * cache is empty. Caller must hold SharedMDCacheLock exclusively.
+ */
+static bool
+shared_mdcache_evict_one(void)
+{
+	HASH_SEQ_STATUS status;
+	SharedMDCacheEntry *entry;
+
+	hash_seq_init(&status, shared_mdcache_hash);
+	entry = hash_seq_search(&status);
+	if (entry == NULL)
+		return false;
+
+	shared_mdcache_remove_entry(entry);
+	hash_seq_term(&status);
+
+	return true;
+}
+
+/* caller must hold SharedMDCacheLock exclusively */
+static void
+shared_mdcache_reset(void)
+{
+	shared_mdcache->reset_generation =
+		pg_atomic_add_fetch_u64(&shared_mdcache->generation, 1);
+}
+
+/* caller must hold SharedMDCacheLock exclusively */
+static void
+shared_mdcache_invalidate(Oid dbid, int cacheid, uint32 value)
+{
+	SharedMDCacheDepKey key;
+	SharedMDCacheDepEntry *dep;
+	uint64		generation;
+
+	generation = pg_atomic_add_fetch_u64(&shared_mdcache->generation, 1);
+
+	MemSet(&key, 0, sizeof(key));
+	key.dbid = dbid;
+	key.cacheid = cacheid;
+	key.value = value;
+
+	dep = hash_search(shared_mdcache_dep_hash, &key, HASH_FIND, NULL);
+	if (dep != NULL)
+		dep->generation = generation;
+	else
+		shared_mdcache->untracked_generation = generation;
+}
+
+static bool
+shared_mdcache_is_fine_grained(int cacheid)
+{
+	for (int i = 0; i < lengthof(shared_mdcache_fine_grained_caches); i++)
+	{
+		if (cacheid == shared_mdcache_fine_grained_caches[i])
+			return true;
+	}
+	return false;
+}
+
+static bool
+shared_mdcache_is_coarse(int cacheid)
+{
+	for (int i = 0; i < lengthof(shared_mdcache_coarse_caches); i++)
+	{
+		if (cacheid == shared_mdcache_coarse_caches[i])
+			return true;
+	}
+	return false;
+}
+
+Size
+SharedMDCacheShmemSize(void)
+{
+	Size		size;
+
+	if (!shared_mdcache_is_enabled())
+		return 0;
+
+	size = MAXALIGN(sizeof(SharedMDCacheControl));
+	size = add_size(size, shared_mdcache_area_size());
+	size = add_size(size, hash_estimate_size(shared_mdcache_max_entries(),
+											 sizeof(SharedMDCacheEntry)));
+	size = add_size(size,
+					hash_estimate_size(shared_mdcache_max_entries() *
+									   SHARED_MDCACHE_MAX_DEPS,
+									   sizeof(SharedMDCacheDepEntry)));
+
+	return size;
+}
+
+void
+SharedMDCacheShmemInit(void)
+{
+	HASHCTL		info;
+	bool		found;
+
+	if (!shared_mdcache_is_enabled())
+		return;
+
+	shared_mdcache = ShmemInitStruct("Shared MD cache",
+									 MAXALIGN(sizeof(SharedMDCacheControl)) +
+									 shared_mdcache_area_size(),
+									 &found);
+	if (!found)
+	{
+		dsa_area   *area;
+
+		pg_atomic_init_u64(&shared_mdcache->generation, 0);
+		shared_mdcache->reset_generation = 0;
+		shared_mdcache->untracked_generation = 0;
+
+		/*
+		 * The creator's reference keeps the area alive for the lifetime of
+		 * the shared memory segment; backends attach on first use.
+		 */
+		area = dsa_create_in_place(shared_mdcache_area_place(),
+								   shared_mdcache_area_size(),
+								   LWTRANCHE_SHARED_MDCACHE_DSA, NULL);
+		dsa_set_size_limit(area, shared_mdcache_area_size());
+		dsa_detach(area);
+	}
+
+	info.keysize = sizeof(SharedMDCacheKey);
+	info.entrysize = sizeof(SharedMDCacheEntry);
+	shared_mdcache_hash = ShmemInitHash("Shared MD cache entries",
+										shared_mdcache_max_entries(),
+										shared_mdcache_max_entries(),
+										&info,
+										HASH_ELEM | HASH_BLOBS);
+
+	info.keysize = sizeof(SharedMDCacheDepKey);
+	info.entrysize = sizeof(SharedMDCacheDepEntry);
+	shared_mdcache_dep_hash = ShmemInitHash("Shared MD cache dependencies",
+											shared_mdcache_max_entries() *
+											SHARED_MDCACHE_MAX_DEPS,
+											shared_mdcache_max_entries() *
+											SHARED_MDCACHE_MAX_DEPS,
+											&info,
+											HASH_ELEM | HASH_BLOBS);
+
+}
+
+/*
+ * Is the shared cache available in this backend?
+ *
+ * A transaction that has modified anything may have changed the catalogs,
+ * and must neither see objects translated by others nor publish its own view
+ * of them.
+ */
+bool
+SharedMDCacheEnabled(void)
+{
+	return shared_mdcache != NULL &&
+		!TransactionIdIsValid(GetCurrentTransactionIdIfAny());
+}
+
+/*
+ * Generation to pass to SharedMDCacheInsert() for an object translated from
+ * now on.
+ *
+ * The invalidation messages pending for this backend are processed after
+ * reading the generation. Whatever was invalidated before is then up to date
+ * in our caches, and whatever is invalidated after is newer than the
+ * generation returned.
+ */
+uint64
+SharedMDCacheGeneration(void)
+{
+	uint64		generation;
+
+	Assert(shared_mdcache != NULL);
+
+	generation = pg_atomic_read_u64(&shared_mdcache->generation);
+	pg_memory_barrier();
+	AcceptInvalidationMessages();
+
+	return generation;
+}
+
+/*
+ * Look up the DXL document of the object with the given serialized mdid.
+ * Returns a palloc'd copy, or NULL if the object is not cached or stale.
+ */
+char *
+SharedMDCacheLookup(const char *key)
+{
+	SharedMDCacheKey keybuf;
+	SharedMDCacheEntry *entry;
+	dsa_area   *area;
+	char	   *dxl = NULL;
+
+	Assert(shared_mdcache != NULL);
+
+	if (strlen(key) >= SHARED_MDCACHE_KEY_LEN)
+		return NULL;
+
+	shared_mdcache_make_key(key, &keybuf);
+
+	area = shared_mdcache_area();
+
+	LWLockAcquire(SharedMDCacheLock, LW_SHARED);
+	entry = hash_search(shared_mdcache_hash, &keybuf, HASH_FIND, NULL);
+	if (entry != NULL)
+	{
+		SharedMDCacheDepKey keys[SHARED_MDCACHE_MAX_DEPS];
+		int			nkeys;
+
+		nkeys = shared_mdcache_dep_keys(&entry->deps, entry->key.dbid, keys);
+		if (!shared_mdcache_deps_changed(keys, nkeys, entry->generation))
+		{
+			dxl = palloc(entry->len);
+			memcpy(dxl, dsa_get_address(area, entry->dxl), entry->len);
+		}
+	}
+	LWLockRelease(SharedMDCacheLock);
+
+	return dxl;
+}
+
+/*
+ * Publish the DXL document of an object translated after 'generation' was
+ * read with SharedMDCacheGeneration(). Nothing happens if a catalog change
+ * the object depends on was applied in the meantime, or if another backend
+ * was faster.
+ */
+void
+SharedMDCacheInsert(const char *key, const char *dxl,
+					const SharedMDCacheDeps *deps, uint64 generation)
+{
+	SharedMDCacheKey keybuf;
+	SharedMDCacheDepKey keys[SHARED_MDCACHE_MAX_DEPS];
+	int			nkeys;
+	SharedMDCacheEntry *entry;
+	dsa_area   *area;
+	dsa_pointer dp;
+	Size		len = strlen(dxl) + 1;
+
+	Assert(shared_mdcache != NULL);
+	Assert(deps->nsyscache <= SHARED_MDCACHE_MAX_SYSCACHE_DEPS);
+
+	if (strlen(key) >= SHARED_MDCACHE_KEY_LEN ||
+		len > shared_mdcache_area_size() / 4)
+		return;
+
+	shared_mdcache_make_key(key, &keybuf);
+	nkeys = shared_mdcache_dep_keys(deps, MyDatabaseId, keys);
+
+	area = shared_mdcache_area();
+
+	LWLockAcquire(SharedMDCacheLock, LW_EXCLUSIVE);
+
+	if (shared_mdcache_deps_changed(keys, nkeys, generation))
+		goto done;
+
+	/* replace a stale entry, keep a valid one */
+	entry = hash_search(shared_mdcache_hash, &keybuf, HASH_FIND, NULL);
+	if (entry != NULL)
+	{
+		if (!shared_mdcache_deps_changed(keys, nkeys, entry->generation))
+			goto done;
+		shared_mdcache_remove_entry(entry);
+	}
+
+	while (hash_get_num_entries(shared_mdcache_hash) >=
+		   shared_mdcache_max_entries())
+	{
+		if (!shared_mdcache_evict_one())
+			goto done;
+	}
+
+	while (!DsaPointerIsValid(dp = dsa_allocate_extended(area, len,
+														 DSA_ALLOC_NO_OOM)))
+	{
+		if (!shared_mdcache_evict_one())
+			goto done;
+	}
+	memcpy(dsa_get_address(area, dp), dxl, len);
+
+	if (!shared_mdcache_add_deps(keys, nkeys))
+	{
+		dsa_free(area, dp);
+		goto done;
+	}
+
+	entry = hash_search(shared_mdcache_hash, &keybuf, HASH_ENTER_NULL, NULL);
+	if (entry == NULL)
+	{
+		shared_mdcache_release_deps(keys, nkeys);
+		dsa_free(area, dp);
+		goto done;
+	}
+	entry->dxl = dp;
+	entry->len = len;
+	entry->generation = generation;
+	entry->deps = *deps;
+
+done:
+	LWLockRelease(SharedMDCacheLock);
+}
+
+/*
+ * Apply the invalidation messages of a committed transaction, just sent to
+ * the other backends.
+ *
+ * Only the backend that committed the changes calls this, so each message is
+ * applied once, and the other backends never touch the shared cache when
+ * they process it.
+ */
+void
+SharedMDCacheInvalidate(const SharedInvalidationMessage *msgs, int nmsgs)
+{
+	if (shared_mdcache == NULL || nmsgs == 0)
+		return;
+
+	LWLockAcquire(SharedMDCacheLock, LW_EXCLUSIVE);
+	for (int i = 0; i < nmsgs; i++)
+	{
+		const SharedInvalidationMessage *msg = &msgs[i];
+
+		if (msg->id >= 0)
+		{
+			if (shared_mdcache_is_fine_grained(msg->cc.id))
+				shared_mdcache_invalidate(msg->cc.dbId, msg->cc.id,
+										  msg->cc.hashValue);
+			else if (shared_mdcache_is_coarse(msg->cc.id))
+				shared_mdcache_reset();
+		}
+		else if (msg->id == SHAREDINVALRELCACHE_ID)
+		{
+			/* an invalid relid means all the relations of the database */
+			if (OidIsValid(msg->rc.relId))
+				shared_mdcache_invalidate(msg->rc.dbId, SHARED_MDCACHE_RELCACHE,
+										  msg->rc.relId);
+			else
+				shared_mdcache_reset();
+		}
+		else if (msg->id == SHAREDINVALCATALOG_ID)
+			shared_mdcache_reset();
+	}
+	LWLockRelease(SharedMDCacheLock);
+}
@@ -268,6 +268,31 @@ datumstreamread_advancelarge(DatumStreamRead * acc)
 	}
 }
 
+/*
+ * Decode up to 'maxvalues' of the datums following the current position in
+ * the current block, leaving the stream positioned on the last datum
+ * returned, as if datumstreamread_advance() and datumstreamread_get() had
+ * been called for each of them. Returns the number of datums decoded; 0
+ * means the block is exhausted and datumstreamread_block() must be called.
+ *
+ * Datums passed by reference point into the block buffer, so they stay
+ * valid only until the next block is read.
+ */
+int
+datumstreamread_get_batch(DatumStreamRead * acc, Datum *values, bool *nulls,
+						  int maxvalues)
+{
+	if (acc->largeObjectState == DatumStreamLargeObjectState_None)
+		return DatumStreamBlockRead_GetBatch(&acc->blockRead, values, nulls,
+											 maxvalues);
+
+	/* A large object is the only datum in its block */
+	if (maxvalues <= 0 || datumstreamread_advancelarge(acc) == 0)
+		return 0;
+	datumstreamread_getlarge(acc, &values[0], &nulls[0]);
+	return 1;
+}
+
 int
 datumstreamread_nthlarge(DatumStreamRead * acc)
 {
@@ -1437,6 +1462,78 @@ datumstreamread_rewind_block(DatumStreamRead * datumStream)
 	datumstreamread_block_get_ready(datumStream);
 }
 
+/*
+ * Return the number of datums left in the current block after the current
+ * position, i.e. how many times datumstreamread_advance() can be called
+ * before it reports the end of the block.
+ */
+int64
+datumstreamread_remaining(DatumStreamRead * acc)
+{
+	switch (acc->largeObjectState)
+	{
+		case DatumStreamLargeObjectState_None:
+			return Max(acc->blockRead.logical_row_count - acc->blockRead.nth - 1, 0);
+
+		case DatumStreamLargeObjectState_HaveAoContent:
+			return 1;
+
+		default:
+			return 0;
+	}
+}
+
+/*
+ * Move the stream forward by 'nrows' datums, without returning them.
+ *
+ * Blocks that lie entirely within the skipped range are passed over by
+ * looking at their headers only, without reading or decompressing their
+ * content. Blocks written before 4.0 don't store a reliable row count in
+ * the header, so their content is always read.
+ *
+ * Returns the number of datums that could not be skipped because the end
+ * of the segment file was reached, normally 0.
+ */
+int64
+datumstreamread_skip(DatumStreamRead * acc, int64 nrows)
+{
+	while (nrows > 0)
+	{
+		int64		remaining = datumstreamread_remaining(acc);
+		int64		nextFirstRowNum;
+
+		if (remaining > 0)
+		{
+			int64		n = Min(remaining, nrows);
+
+			for (int64 i = 0; i < n; i++)
+				datumstreamread_advance(acc);
+			nrows -= n;
+			continue;
+		}
+
+		nextFirstRowNum = acc->blockFirstRowNum + acc->blockRowCount;
+		if (!datumstreamread_block_info(acc))
+			break;
+
+		if (acc->getBlockInfo.firstRow >= 0 &&
+			acc->getBlockInfo.rowCnt <= nrows)
+		{
+			AppendOnlyStorageRead_SkipCurrentBlock(&acc->ao_read);
+			nrows -= acc->getBlockInfo.rowCnt;
+		}
+		else
+		{
+			/* See datumstreamread_block() */
+			if (acc->getBlockInfo.firstRow < 0)
+				acc->blockFirstRowNum = nextFirstRowNum;
+			datumstreamread_block_content(acc);
+		}
+	}
+
+	return nrows;
+}
+
 /*
  * Find the specified row in the current block.
  *
@@ -419,6 +419,116 @@ DatumStreamBlockRead_Finish(
 	/* Place holder. */
 }
 
+/*
+ * Decode up to 'maxvalues' of the datums following the current position of
+ * the block into the 'values' and 'nulls' arrays, leaving the block
+ * positioned on the last datum returned. Returns the number of datums
+ * decoded; 0 means the block is exhausted.
+ *
+ * This is equivalent to calling DatumStreamBlockRead_Advance() and
+ * DatumStreamBlockRead_Get() in a loop, but the common cases are decoded
+ * without the per-datum bookkeeping: a Dense block of fixed-width
+ * pass-by-value datums without NULLs, RLE_TYPE or delta compression is
+ * copied out with a straight loop over the datum array, and the copies of
+ * an RLE_TYPE repeated item are filled in all at once.
+ */
+int
+DatumStreamBlockRead_GetBatch(DatumStreamBlockRead * dsr,
+							  Datum *values, bool *nulls, int maxvalues)
+{
+	int			n = 0;
+
+	if (dsr->datumStreamVersion != DatumStreamVersion_Original &&
+		!dsr->has_null &&
+		!dsr->rle_block_was_compressed &&
+		!dsr->delta_block_was_compressed &&
+		dsr->typeInfo.byval &&
+		!Debug_appendonly_print_scan_tuple)
+	{
+		int32		datumlen = dsr->typeInfo.datumlen;
+		uint8	   *p;
+
+		Assert(dsr->physical_datum_index == dsr->nth);
+
+		n = Min(maxvalues, dsr->logical_row_count - dsr->nth - 1);
+		if (n <= 0)
+			return DatumStreamBlockRead_Advance(dsr);
+
+		p = dsr->datum_beginp + (dsr->physical_datum_index + 1) * datumlen;
+
+		/*
+		 * Performance is so critical we don't use a switch statement in the
+		 * loops; keep them simple enough for the compiler to vectorize.
+		 */
+		if (datumlen == 8)
+		{
+			for (int i = 0; i < n; i++)
+				values[i] = ((Datum *) p)[i];
+		}
+		else if (datumlen == 4)
+		{
+			Assert(IsAligned(p, 4));
+			for (int i = 0; i < n; i++)
+				values[i] = ((uint32 *) p)[i];
+		}
+		else if (datumlen == 2)
+		{
+			Assert(IsAligned(p, 2));
+			for (int i = 0; i < n; i++)
+				values[i] = ((uint16 *) p)[i];
+		}
+		else
+		{
+			Assert(datumlen == 1);
+			for (int i = 0; i < n; i++)
+				values[i] = p[i];
+		}
+		memset(nulls, false, n * sizeof(bool));
+
+		dsr->nth += n;
+		dsr->physical_datum_index += n;
+		dsr->datump = dsr->datum_beginp + dsr->physical_datum_index * datumlen;
+
+		return n;
+	}
+
+	while (n < maxvalues)
+	{
+		if (DatumStreamBlockRead_Advance(dsr) == 0)
+			break;
+
+		DatumStreamBlockRead_Get(dsr, &values[n], &nulls[n]);
+		n++;
+
+		/*
+		 * Expand the rest of an RLE_TYPE repeated item in one go. This
+		 * mirrors what DatumStreamBlockRead_AdvanceDense() does for each
+		 * copy: the item pointers and bit-maps stay on the repeated item.
+		 */
+		if (dsr->datumStreamVersion != DatumStreamVersion_Original &&
+			dsr->rle_in_repeated_item)
+		{
+			int32		run;
+
+			run = Min(dsr->rle_repeated_item_count, maxvalues - n);
+			run = Min(run, dsr->logical_row_count - dsr->nth - 1);
+
+			for (int i = 0; i < run; i++)
+				values[n + i] = values[n - 1];
+			memset(&nulls[n], false, run * sizeof(bool));
+
+			n += run;
+			dsr->nth += run;
+			dsr->rle_repeated_item_count -= run;
+			dsr->rle_total_repeat_items_read += run;
+			if (dsr->rle_repeated_item_count <= 0)
+				dsr->rle_in_repeated_item = false;
+		}
+	}
+
+	return n;
+}
+
 /*
  * Dense routines.
  */
@@ -0,0 +1,211 @@
+/*-------------------------------------------------------------------------
+*
+* gcompress.c
+*	  Block compression of the data sent between gpfdist and the segments.
+*
+* Both sides compress whole blocks, so a block can be uncompressed as soon as
+* it has arrived, and each side only has to buffer one block at a time. The
+* methods that are not built in are never negotiated: gcompress_lookup()
+* does not know them.
+*
+* The compression contexts are kept across calls, so these functions must
+* only be called from one thread.
+*
+* Portions Copyright (c) 2023, HashData Technology Limited.
+*
+*--------------------------------------------------------------------------
+*/
+#include "c.h"
+
+#include <string.h>
+
+#include <fstream/gcompress.h>
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef USE_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef USE_ZSTD
+/*
+ * The data is compressed on the fly, so favour speed over ratio. Level 1
+ * still shrinks text rows several times.
+ */
+#define GCOMPRESS_ZSTD_LEVEL	1
+
+static ZSTD_CCtx *zstd_cctx = NULL;
+static ZSTD_DCtx *zstd_dctx = NULL;
+#endif
+
+/*
+ * Find a compression method by name. Return GCOMPRESS_NONE for the unknown
+ * ones and the ones that are not built in.
+ */
+gcompress_method
+gcompress_lookup(const char *name)
+{
+	if (name == NULL)
+		return GCOMPRESS_NONE;
+#ifdef USE_ZSTD
+	if (strcmp(name, "zstd") == 0)
+		return GCOMPRESS_ZSTD;
+#endif
+#ifdef USE_LZ4
+	if (strcmp(name, "lz4") == 0)
+		return GCOMPRESS_LZ4;
+#endif
+	return GCOMPRESS_NONE;
+}
+
+const char *
+gcompress_name(gcompress_method method)
+{
+	switch (method)
+	{
+		case GCOMPRESS_ZSTD:
+			return "zstd";
+		case GCOMPRESS_LZ4:
+			return "lz4";
+		default:
+			return "none";
+	}
+}
+
+/*
+ * Size of the buffer needed to compress len bytes, including the block
+ * header.
+ */
+int
+gcompress_bound(gcompress_method method, int len)
+{
+	switch (method)
+	{
+#ifdef USE_ZSTD
+		case GCOMPRESS_ZSTD:
+			return GCOMPRESS_HEADER_SIZE + (int) ZSTD_compressBound(len);
+#endif
+#ifdef USE_LZ4
+		case GCOMPRESS_LZ4:
+			return GCOMPRESS_HEADER_SIZE + LZ4_compressBound(len);
+#endif
+		default:
+			return GCOMPRESS_HEADER_SIZE + len;
+	}
+}
+
+/*
+ * Compress srclen bytes of src into a block in dst. Return the size of the
+ * block, or -1 on failure.
+ */
+int
+gcompress_block(gcompress_method method, const char *src, int srclen,
+				char *dst, int dstlen)
+{
+	unsigned char *hdr = (unsigned char *) dst;
+	int			len = -1;
+
+	if (srclen < 0 || dstlen < GCOMPRESS_HEADER_SIZE)
+		return -1;
+
+	hdr[0] = (srclen >> 24) & 0xff;
+	hdr[1] = (srclen >> 16) & 0xff;
+	hdr[2] = (srclen >> 8) & 0xff;
+	hdr[3] = srclen & 0xff;
+	dst += GCOMPRESS_HEADER_SIZE;
+	dstlen -= GCOMPRESS_HEADER_SIZE;
+
+	switch (method)
+	{
+#ifdef USE_ZSTD
+		case GCOMPRESS_ZSTD:
+			{
+				size_t		n;
+
+				if (zstd_cctx == NULL && (zstd_cctx = ZSTD_createCCtx()) == NULL)
+					return -1;
+				n = ZSTD_compressCCtx(zstd_cctx, dst, dstlen, src, srclen,
+									  GCOMPRESS_ZSTD_LEVEL);
+				if (!ZSTD_isError(n))
+					len = (int) n;
+				break;
+			}
+#endif
+#ifdef USE_LZ4
+		case GCOMPRESS_LZ4:
+			len = LZ4_compress_default(src, dst, srclen, dstlen);
+			if (len == 0 && srclen > 0)
+				len = -1;
+			break;
+#endif
+		default:
+			break;
+	}
+
+	return len < 0 ? -1 : GCOMPRESS_HEADER_SIZE + len;
+}
+
+/*
+ * Length of the uncompressed data of a block, or -1 if srclen bytes are too
+ * short to hold a block.
+ */
+int
+gcompress_raw_length(const char *src, int srclen)
+{
+	const unsigned char *hdr = (const unsigned char *) src;
+	uint32		len;
+
+	if (srclen < GCOMPRESS_HEADER_SIZE)
+		return -1;
+
+	len = ((uint32) hdr[0] << 24) | ((uint32) hdr[1] << 16) |
+		((uint32) hdr[2] << 8) | (uint32) hdr[3];
+
+	return len > PG_INT32_MAX ? -1 : (int) len;
+}
+
+/*
+ * Uncompress the block of srclen bytes in src into dst, which must hold
+ * gcompress_raw_length() bytes. Return the length of the uncompressed data,
+ * or -1 if the block is corrupted.
+ */
+int
+gdecompress_block(gcompress_method method, const char *src, int srclen,
+				  char *dst, int dstlen)
+{
+	int			rawlen = gcompress_raw_length(src, srclen);
+	int			len = -1;
+
+	if (rawlen < 0 || rawlen > dstlen)
+		return -1;
+
+	src += GCOMPRESS_HEADER_SIZE;
+	srclen -= GCOMPRESS_HEADER_SIZE;
+
+	switch (method)
+	{
+#ifdef USE_ZSTD
+		case GCOMPRESS_ZSTD:
+			{
+				size_t		n;
+
+				if (zstd_dctx == NULL && (zstd_dctx = ZSTD_createDCtx()) == NULL)
+					return -1;
+				n = ZSTD_decompressDCtx(zstd_dctx, dst, rawlen, src, srclen);
+				if (!ZSTD_isError(n))
+					len = (int) n;
+				break;
+			}
+#endif
+#ifdef USE_LZ4
+		case GCOMPRESS_LZ4:
+			len = LZ4_decompress_safe(src, dst, srclen, rawlen);
+			break;
+#endif
+		default:
+			break;
+	}
+
+	return len == rawlen ? len : -1;
+}
@@ -5133,6 +5133,13 @@ static int	size_guc_variables;
 
 static bool guc_dirty;			/* true if need to do commit/abort work */
 
+/*
+ * Incremented whenever a variable may have been assigned a new value, so
+ * that caches of planner output can tell that the settings they were built
+ * under have changed.
+ */
+uint64		guc_assignment_count = 0;
+
 static bool reporting_enabled;	/* true to enable GUC_REPORT */
 
 static bool report_needed;		/* true if any GUC_REPORT reports are needed */
@@ -6276,6 +6283,8 @@ ResetAllOptions(void)
 {
 	int			i;
 
+	guc_assignment_count++;
+
 	for (i = 0; i < num_guc_variables; i++)
 	{
 		struct config_generic *gconf = guc_variables[i];
@@ -6750,6 +6759,9 @@ AtEOXact_GUC(bool isCommit, int nestLevel)
 			gconf->stack = prev;
 			pfree(stack);
 
+			if (changed)
+				guc_assignment_count++;
+
 			/* Report new value if we changed it */
 			if (changed && (gconf->flags & GUC_REPORT))
 			{
@@ -7848,6 +7860,9 @@ set_config_option(const char *name, const char *value,
 		changeVal = false;
 	}
 
+	if (changeVal)
+		guc_assignment_count++;
+
 	/*
 	 * Evaluate value and set variable.
 	 */
@@ -38,6 +38,7 @@
 #include "commands/defrem.h"
 #include "commands/vacuum.h"
 #include "commands/variable.h"
+#include "fstream/gcompress.h"
 #include "miscadmin.h"
 #include "optimizer/cost.h"
 #include "optimizer/planmain.h"
@@ -57,6 +58,7 @@
 #include "utils/resscheduler.h"
 #include "utils/resgroup.h"
 #include "utils/resource_manager.h"
+#include "utils/sharedmdcache.h"
 #include "utils/varlena.h"
 #include "utils/vmem_tracker.h"
 #include "catalog/index.h"
@@ -143,11 +145,12 @@ bool		Test_print_direct_dispatch_info = false;
 bool        Test_print_prefetch_joinqual = false;
 bool		Test_copy_qd_qe_split = false;
 bool		gp_permit_relation_node_change = false;
-int			gp_max_local_distributed_cache = 1024;
+int			gp_max_local_distributed_cache = 4096;
 bool		gp_appendonly_verify_block_checksums = true;
 bool		gp_appendonly_verify_write_block = false;
 bool		gp_appendonly_compaction = true;
 int			gp_appendonly_compaction_threshold = 0;
+int			gp_aocs_scan_batch_size = 128;
 bool		enable_parallel = false;
 bool		enable_parallel_semi_join = true;
 bool		enable_parallel_dedup_semi_join = true;
@@ -241,6 +244,7 @@ bool		gp_resource_group_bypass_direct_dispatch;
 /* Metrics collector debug GUC */
 bool		vmem_process_interrupt = false;
 bool		execute_pruned_plan = false;
+bool		gp_dispatch_pruned_plan = true;
 
 /* Upgrade & maintenance GUCs */
 bool		gp_maintenance_mode;
@@ -275,6 +279,7 @@ bool		gp_enable_agg_pushdown = false;
 bool		gp_dynamic_partition_pruning = true;
 bool		gp_log_dynamic_partition_pruning = false;
 bool		gp_cte_sharing = false;
+int			gp_shareinput_stream_chunk_tuples = 0;
 bool		gp_enable_relsize_collection = false;
 bool		gp_recursive_cte = true;
 bool		gp_eager_two_phase_agg = false;
@@ -287,11 +292,13 @@ bool		optimizer_log;
 int			optimizer_log_failure;
 bool		optimizer_control = true;
 bool		optimizer_trace_fallback;
+bool		optimizer_parallel_fallback;
 bool		optimizer_partition_selection_log;
 int			optimizer_minidump;
 int			optimizer_cost_model;
 bool		optimizer_metadata_caching;
 int			optimizer_mdcache_size;
+int			optimizer_plan_cache_size;
 bool		optimizer_use_gpdb_allocators;
 
 /* Optimizer debugging GUCs */
@@ -352,6 +359,9 @@ bool		optimizer_enable_mergejoin;
 bool		optimizer_prune_unused_columns;
 bool		optimizer_enable_redistribute_nestloop_loj_inner_child;
 bool		optimizer_force_comprehensive_join_implementation;
+bool		optimizer_enable_extended_stats;
+bool		optimizer_enable_memoize;
+bool		optimizer_enable_incremental_sort;
 bool		optimizer_enable_replicated_table;
 
 /* Optimizer plan enumeration related GUCs */
@@ -443,6 +453,7 @@ bool		gp_external_enable_filter_pushdown = true;
 bool		gp_enable_global_deadlock_detector = false;
 
 bool gp_enable_predicate_pushdown;
+bool gp_enable_aocs_block_skipping;
 int  gp_predicate_pushdown_sample_rows;
 
 bool        enable_offload_entry_to_qe = false;
@@ -531,6 +542,17 @@ static const struct config_enum_entry gp_autostats_modes[] = {
 	{NULL, 0}
 };
 
+static const struct config_enum_entry gpfdist_compression_options[] = {
+	{"none", GCOMPRESS_NONE},
+#ifdef USE_ZSTD
+	{"zstd", GCOMPRESS_ZSTD},
+#endif
+#ifdef USE_LZ4
+	{"lz4", GCOMPRESS_LZ4},
+#endif
+	{NULL, 0}
+};
+
 static const struct config_enum_entry gp_interconnect_fc_methods[] = {
 	{"loss", INTERCONNECT_FC_METHOD_LOSS},
 	{"capacity", INTERCONNECT_FC_METHOD_CAPACITY},
@@ -666,6 +688,15 @@ struct config_bool ConfigureNamesBool_gp[] =
 		&gp_enable_predicate_pushdown,
 		true, NULL, NULL
 	},
+	{
+		{"gp_enable_aocs_block_skipping", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables skipping whole blocks of AOCS tables that cannot satisfy the pushed-down quals."),
+			NULL
+		},
+		&gp_enable_aocs_block_skipping,
+		true,
+		NULL, NULL, NULL
+	},
 	{
 		{"debug_print_prelim_plan", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Prints the preliminary execution plan to server log."),
@@ -714,6 +745,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_hashagg_streambottom", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Stream partially aggregated groups instead of spilling them."),
+			gettext_noop("The first stage of a multi-stage hashed aggregation emits its "
+						 "groups when it runs out of memory or the grouping keys are "
+						 "nearly unique, and lets the next stage combine them.")
+		},
+		&gp_hashagg_streambottom,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_enable_multiphase_limit", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enables the planner's use of two phase limit plans."),
@@ -1067,6 +1110,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_compress_tuples", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Compress large tuples sent through the interconnect."),
+			gettext_noop("Trades sender CPU for network bandwidth. Compression is "
+						 "skipped for a while when tuples do not compress well.")
+		},
+		&gp_interconnect_compress_tuples,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_log_stats", PGC_USERSET, QUERY_TUNING_OTHER,
 			gettext_noop("Emit statistics from the UDP-IC at the end of every statement."),
@@ -1570,6 +1624,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		false,
 		NULL, NULL, NULL
 	},
+	{
+		{"gp_statistics_use_sketches", PGC_USERSET, STATS_ANALYZE,
+			gettext_noop("Build the statistics of distributed tables from sketches of all their rows, computed on the segments."),
+			gettext_noop("Columns that the sketches cannot describe, and tables that are not "
+						 "distributed, still use a sample of rows.")
+		},
+		&gp_statistics_use_sketches,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"gp_resqueue_priority", PGC_POSTMASTER, RESOURCES_MGM,
 			gettext_noop("Enables priority scheduling."),
@@ -1888,6 +1952,18 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_parallel_fallback", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Use the Postgres planner for queries that could run in parallel within a segment."),
+			gettext_noop("GPORCA does not produce parallel plans. When enable_parallel is on, "
+						 "parallel safe queries over large enough tables are planned by the "
+						 "Postgres planner instead.")
+		},
+		&optimizer_parallel_fallback,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_partition_selection_log", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Log optimizer partition selection."),
@@ -2762,6 +2838,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_dispatch_pruned_plan", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Dispatch to each gang only the plan nodes of its own slice."),
+			gettext_noop("Only takes effect when execute_pruned_plan is on."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&gp_dispatch_pruned_plan,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"pljava_classpath_insecure", PGC_POSTMASTER, CUSTOM_OPTIONS,
 			gettext_noop("Allow pljava_classpath to be set by user per session"),
@@ -2971,6 +3058,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_autostats_incremental", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Merge the rows appended to append-optimized tables into their statistics, instead of analyzing them again."),
+			gettext_noop("The segments sketch the rows as they are inserted. Auto-stats merges the sketches into statistics built with gp_statistics_use_sketches, and analyzes the table otherwise.")
+		},
+		&gp_autostats_incremental,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_enable_redistribute_nestloop_loj_inner_child", PGC_USERSET, DEVELOPER_OPTIONS,
 		 gettext_noop("Enable nested loops left join plans with redistributed inner child in the optimizer."),
@@ -2991,6 +3088,36 @@ struct config_bool ConfigureNamesBool_gp[] =
 		 false,
 		 NULL, NULL, NULL
 	},
+	{
+		{"optimizer_enable_extended_stats", PGC_USERSET, QUERY_TUNING_METHOD,
+		 gettext_noop("Enable the use of extended statistics (functional dependencies and multi-column ndistinct) by GPORCA."),
+		 NULL,
+		 GUC_NOT_IN_SAMPLE
+		 },
+		 &optimizer_enable_extended_stats,
+		 true,
+		 NULL, NULL, NULL
+	},
+	{
+		{"optimizer_enable_memoize", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable GPORCA to cache the inner side of index nested loop joins with Memoize nodes."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_memoize,
+		false,
+		NULL, NULL, NULL
+	},
+	{
+		{"optimizer_enable_incremental_sort", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable GPORCA to use incremental sort steps on inputs sorted by a prefix of the required order."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_incremental_sort,
+		false,
+		NULL, NULL, NULL
+	},
 	/* for tasks schedule */
 	{
 		{"task_use_background_worker", PGC_POSTMASTER, TASK_SCHEDULE_OPTIONS,
@@ -3194,7 +3321,7 @@ struct config_int ConfigureNamesInt_gp[] =
 			NULL
 		},
 		&gp_max_local_distributed_cache,
-		1024, 0, INT_MAX,
+		4096, 0, INT_MAX,
 		NULL, NULL, NULL
 	},
 
@@ -3313,6 +3440,18 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_shareinput_stream_chunk_tuples", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of tuples in the first chunk streamed by a cross-slice shared scan."),
+			gettext_noop("When non-zero, the producer of a cross-slice ShareInputScan publishes its result "
+						 "in chunks of growing size, and consumers start reading as soon as the first "
+						 "chunk is complete. Zero materializes the whole result before any consumer starts.")
+		},
+		&gp_shareinput_stream_chunk_tuples,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_appendonly_compaction_threshold", PGC_USERSET, APPENDONLY_TABLES,
 			gettext_noop("Threshold of the ratio of dirty data in a segment file over which the file"
@@ -3324,6 +3463,16 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_aocs_scan_batch_size", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Number of values of a column decoded at a time by append-optimized column-oriented table scans."),
+			gettext_noop("Zero decodes the values one at a time.")
+		},
+		&gp_aocs_scan_batch_size,
+		128, 0, 8192,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_appendonly_insert_files", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Number of segment files to insert for appendonly table within a transaction."
@@ -3541,6 +3690,16 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_recv_batch_size", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Sets the maximum number of packets received with one system call in the UDP interconnect"),
+			NULL
+		},
+		&Gp_interconnect_recv_batch_size,
+		16, 1, MAX_INTERCONNECT_RECV_BATCH,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_timer_period", PGC_USERSET, GP_ARRAY_TUNING,
 			gettext_noop("Sets the timer period (in ms) for UDP interconnect"),
@@ -3967,6 +4126,16 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gp_motion_send_batch_size", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Sets the number of tuples a redistribute motion hashes and sends as a batch."),
+			gettext_noop("0 sends each tuple as soon as it is produced.")
+		},
+		&gp_motion_send_batch_size,
+		64, 0, 1024,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_reject_percent_threshold", PGC_USERSET, GP_ERROR_HANDLING,
 			gettext_noop("Reject limit in percent starts calculating after this number of rows processed"),
@@ -4296,6 +4465,27 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_plan_cache_size", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of GPORCA plans of repeated queries kept per session."),
+			gettext_noop("0 disables the plan cache.")
+		},
+		&optimizer_plan_cache_size,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_shared_mdcache_size", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the size of the MDCache shared by all backends on the coordinator."),
+			gettext_noop("0 disables the shared MDCache."),
+			GUC_UNIT_KB
+		},
+		&optimizer_shared_mdcache_size,
+		0, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"memory_profiler_dataset_size", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Set the size in GB"),
@@ -4979,6 +5169,17 @@ struct config_enum ConfigureNamesEnum_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"gpfdist_compression", PGC_USERSET, EXTERNAL_TABLES,
+			gettext_noop("Sets the compression of the data sent between gpfdist and the segments."),
+			gettext_noop("Valid values are \"none\", \"zstd\" and \"lz4\", if built with them. "
+						 "The data is sent uncompressed if gpfdist does not support the compression.")
+		},
+		&gpfdist_compression,
+		GCOMPRESS_NONE, gpfdist_compression_options,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_fc_method", PGC_USERSET, GP_ARRAY_TUNING,
 			gettext_noop("Sets the flow control method used for UDP interconnect."),
@@ -36,6 +36,7 @@
 #include <gpfxdist.h>
 #endif
 #include <fstream/fstream.h>
+#include <fstream/gcompress.h>
 
 #ifndef WIN32
 #include <unistd.h>
@@ -88,6 +89,7 @@ struct block_t
 	blockhdr_t 	hdr;
 	int 		bot, top;
 	char*      	data;
+	char*		zdata;		/* spare buffer to compress data into, NULL if not compressed */
 };
 
 /*  Get session id for this request */
@@ -134,6 +136,13 @@ static void flush_ssl_buffer(int fd, short event, void* arg);
  not property terminated, then gpfdist encountered some error, and caller
  should check the gpfdist error log.
 
+ X-GP-COMPRESSION - compression the client asks for ("zstd" or "lz4"). If
+ gpfdist supports it, it repeats the header in its response, and then:
+ for GET (PROTO 1), the data blocks are sent as 'Z' blocks instead of 'D'
+ blocks; for POST, the body of the request is a compressed block. A
+ compressed block is the length of the uncompressed data, 4 bytes in
+ network order, followed by the compressed data.
+
  **************/
 
 typedef struct gnet_request_t gnet_request_t;
@@ -161,6 +170,9 @@ static void percent_encoding_to_char(char* p, char* pp, char* path);
 #define GPFDIST_MAX_LINE_MESSAGE     "Error: -m max row length must be between 32KB and 1MB"
 #endif
 
+/* largest compressed POST body, and largest data in it, that is accepted */
+#define GPFDIST_MAX_COMPRESSED_LENGTH (1024*1024*1024)
+
 
 /*	Struct of command line options */
 static struct
@@ -183,7 +195,8 @@ static struct
 	struct transform* trlist; /* transforms from config file */
 	const char* ssl; /* path to certificates in case we use gpfdist with ssl */
 	int			w; /* The time used for session timeout in seconds */
-} opt = { 8080, 8080, 0, 0, 0, ".", 0, 0, -1, 5, 0, 32768, 0, 256, 0, 0, 0, 0 };
+	int			j; /* number of threads to read ahead GET sessions, 0 to read inline */
+} opt = { 8080, 8080, 0, 0, 0, ".", 0, 0, -1, 5, 0, 32768, 0, 256, 0, 0, 0, 0, 0 };
 
 
 typedef union address
@@ -242,6 +255,10 @@ struct session_t
 	struct timeval 	tm;             /* timeout for struct event */
 	struct event   	ev;             /* event we are watching for this session*/
 	apr_hash_t		*requests;
+	struct readahead_t *readahead;	/* read-ahead of a GET session, NULL if read inline */
+	gcompress_method compression;	/* compression on the wire */
+	apr_int64_t		raw_bytes;		/* data bytes sent or received, before compression */
+	apr_int64_t		wire_bytes;		/* data bytes sent or received on the wire */
 };
 
 typedef struct session_free_res session_free_res;
@@ -291,6 +308,7 @@ struct request_t
 	int				is_final;	/* the final POST request. a signal from client to end session */
 	int				segid;		/* the segment id of the segdb with the request */
 	int				totalsegs;	/* the total number of segdbs */
+	gcompress_method compression; /* compression negotiated with the client */
 
 	struct
 	{
@@ -307,6 +325,7 @@ struct request_t
 	block_t	outblock;	/* next block to send out */
 	char*           line_delim_str;
 	int             line_delim_length;
+	request_t*		next_waiter;	/* next request waiting for the same read-ahead */
 
 #ifdef USE_SSL
 	/* SSL related */
@@ -375,6 +394,7 @@ static int request_set_transform(request_t *r);
 #endif
 static void handle_post_request(request_t *r, int header_end);
 static void handle_get_request(request_t *r);
+static int request_write_data(request_t *r, char *buf, int len, const char **errmsg);
 
 static int gpfdist_socket_send(const request_t *r, const void *buf, const size_t buflen);
 static int (*gpfdist_send)(const request_t *r, const void *buf, const size_t buflen); /* function pointer */
@@ -405,6 +425,15 @@ static void delay_watchdog_timer(void);
 #ifndef WIN32
 static apr_time_t shutdown_time;
 static void* watchdog_thread(void*);
+
+static struct readahead_t* readahead_start(apr_pool_t* pool, fstream_t* fstream,
+										   const char* line_delim_str, int line_delim_length);
+static int readahead_wait(struct readahead_t* ra, request_t* r);
+static int readahead_get_block(struct readahead_t* ra, block_t* retblock,
+							   struct fstream_filename_and_offset* fos, const char** ferror);
+static void readahead_stop(struct readahead_t* ra);
+static void readahead_wakeup(int fd, short event, void* arg);
+static void* readahead_worker(void*);
 #endif
 
 /*
@@ -462,12 +491,12 @@ static void block_fill_header(const request_t *r, block_t* b,
 	gdebug(r, "L %lu", (unsigned long)local_ntohll(len8));
 #endif
 
-	/* DATA: 'D' + len */
-	*p++ = 'D';
+	/* DATA: 'D' + len, or 'Z' + len if the data is compressed */
+	*p++ = (r->compression == GCOMPRESS_NONE ? 'D' : 'Z');
 	len = htonl(b->top-b->bot);
 	memcpy(p, &len, 4);
 	p += 4;
-	gdebug(r, "D %u", (unsigned int)ntohl(len));
+	gdebug(r, "%c %u", p[-5], (unsigned int)ntohl(len));
 	h->htop = p - h->hbyte;
 	if (h->htop > sizeof(h->hbyte))
 		gfatal(NULL, "assert failed, h->htop = %d, max = %d", h->htop,
@@ -522,7 +551,7 @@ static void usage_error(const char* msg, int print_usage)
 		{
 			fprintf(stderr,
 					"gpfdist -- file distribution web server\n\n"
-						"usage: gpfdist [--ssl <certificates_directory>] [-d <directory>] [-p <http(s)_port>] [-l <log_file>] [-t <timeout>] [-v | -V | -s] [-m <maxlen>] [-w <timeout>]"
+						"usage: gpfdist [--ssl <certificates_directory>] [-d <directory>] [-p <http(s)_port>] [-l <log_file>] [-t <timeout>] [-v | -V | -s] [-m <maxlen>] [-w <timeout>] [-j <threads>]"
 #ifdef GPFXDIST
 					    "[-c file]"
 #endif
@@ -541,6 +570,9 @@ static void usage_error(const char* msg, int print_usage)
 						"        -l logfn   : log filename\n"
 						"        -t tm      : timeout in seconds \n"
 						"        -m maxlen  : max data row length expected, in bytes. default is 32768\n"
+#ifndef WIN32
+						"        -j threads : threads to read and decompress files ahead of sending, default is 0\n"
+#endif
 #ifdef USE_SSL
 						"        --ssl dir  : start HTTPS server. Use the certificates from the specified directory\n"
 #endif
@@ -611,6 +643,7 @@ static void parse_command_line(int argc, const char* const argv[],
 #endif
 	{ "version", 256, 0, "print version number" },
 	{ NULL, 'w', 1, "wait for session timeout in seconds" },
+	{ NULL, 'j', 1, "threads to read ahead the files of sessions" },
 	{ 0 } };
 
 	status = apr_getopt_init(&os, pool, argc, argv);
@@ -695,6 +728,9 @@ static void parse_command_line(int argc, const char* const argv[],
 		case 'w':
 			opt.w = atoi(arg);
 			break;
+		case 'j':
+			opt.j = atoi(arg);
+			break;
 		}
 	}
 
@@ -716,6 +752,13 @@ static void parse_command_line(int argc, const char* const argv[],
 	if (!is_valid_session_timeout(opt.w))
 		usage_error("Error: -w timeout must be between 1 and 7200, or 0 for no timeout", 0);
 
+	if (!is_valid_readahead_threads(opt.j))
+		usage_error("Error: -j threads must be between 0 and 64", 0);
+#ifdef WIN32
+	if (opt.j > 0)
+		usage_error("Error: -j is not supported on this platform", 0);
+#endif
+
 	/* validate max row length */
     if (! ((GPFDIST_MAX_LINE_LOWER_LIMIT <= opt.m) && (opt.m <= GPFDIST_MAX_LINE_UPPER_LIMIT)))
     	usage_error(GPFDIST_MAX_LINE_MESSAGE, 0);
@@ -902,12 +945,18 @@ static apr_status_t http_ok(request_t* r)
 		"Expires: 0\r\n"
 		"X-GPFDIST-VERSION: " GP_VERSION "\r\n"
 		"X-GP-PROTO: %d\r\n"
+		"%s%s%s"
 		"Cache-Control: no-cache\r\n"
 		"Connection: close\r\n\r\n";
 	char buf[1024];
 	int m, n;
 
-	n = apr_snprintf(buf, sizeof(buf), fmt, r->gp_proto);
+	/* acknowledge the compression, if any */
+	if (r->compression != GCOMPRESS_NONE)
+		n = apr_snprintf(buf, sizeof(buf), fmt, r->gp_proto,
+						 "X-GP-COMPRESSION: ", gcompress_name(r->compression), "\r\n");
+	else
+		n = apr_snprintf(buf, sizeof(buf), fmt, r->gp_proto, "", "", "");
 	if (n >= sizeof(buf) - 1)
 		gfatal(r, "internal error - buffer overflow during http_ok");
 
@@ -922,6 +971,15 @@ static apr_status_t http_ok(request_t* r)
 	return 0;
 }
 
+/* uncompressed data bytes of a session per byte sent on the wire */
+static double session_compression_ratio(const session_t* s)
+{
+	if (s->wire_bytes == 0)
+		return 1.0;
+
+	return (double) s->raw_bytes / s->wire_bytes;
+}
+
 static void log_gpfdist_status()
 {
 	char buf[1024];
@@ -942,8 +1000,10 @@ static void log_gpfdist_status()
 			continue;
 		}
 		const char *ferror = (s->fstream == NULL ? NULL : fstream_get_error(s->fstream));
-		gprint(NULL, "session %d: tid=%s, fs_error=%s, is_error=%d, nrequest=%d is_get=%d, maxsegs=%d\n",
-				i, s->tid, (ferror == NULL ? "N/A" : ferror), s->is_error, s->nrequest, s->is_get, s->maxsegs);
+		gprint(NULL, "session %d: tid=%s, fs_error=%s, is_error=%d, nrequest=%d is_get=%d, maxsegs=%d, "
+				"compression=%s, ratio=%.2f\n",
+				i, s->tid, (ferror == NULL ? "N/A" : ferror), s->is_error, s->nrequest, s->is_get, s->maxsegs,
+				gcompress_name(s->compression), session_compression_ratio(s));
 		session_active_segs_dump(s);
 	}
 
@@ -1099,6 +1159,41 @@ static apr_status_t send_gpfdist_status(request_t* r)
 		return APR_EGENERAL;
 	}
 
+	/* one line per session, with the bytes it moved before and after compression */
+	apr_hash_index_t* hi;
+	for (hi = apr_hash_first(r->pool, gcb.session.tab); hi; hi = apr_hash_next(hi))
+	{
+		void *entry;
+		apr_hash_this(hi, 0, 0, &entry);
+		session_t *s = (session_t*) entry;
+		if (s == NULL)
+			continue;
+
+		n = apr_snprintf(buf, sizeof(buf), "session %s compression %s "
+#ifdef WIN32
+						 "raw_bytes %ld wire_bytes %ld "
+#else
+						 "raw_bytes %"APR_INT64_T_FMT" wire_bytes %"APR_INT64_T_FMT" "
+#endif
+						 "ratio %.2f\r\n",
+						 s->tid, gcompress_name(s->compression),
+#ifdef WIN32
+						 (long) s->raw_bytes, (long) s->wire_bytes,
+#else
+						 s->raw_bytes, s->wire_bytes,
+#endif
+						 session_compression_ratio(s));
+		if (n >= sizeof buf - 1)
+			gfatal(r, "internal error - buffer overflow during send_gpfdist_status");
+
+		m = local_send(r, buf, n);
+		if (m != n)
+		{
+			gprint(r, "%s - socket error\n", r->peer);
+			return APR_EGENERAL;
+		}
+	}
+
 	return 0;
 }
 
@@ -1350,32 +1445,81 @@ session_get_block(const request_t* r, block_t* retblock, char* line_delim_str, i
 		return 0;
 	}
 
-	gcb.read_bytes -= fstream_get_compressed_position(session->fstream);
+#ifndef WIN32
+	if (session->readahead)
+	{
+		const char* ferror;
 
-	/* read data from our filestream as a chunk with whole data rows */
+		/* take the next block read ahead by a worker thread */
+		size = readahead_get_block(session->readahead, retblock, &fos, &ferror);
+		delay_watchdog_timer();
 
-	size = fstream_read(session->fstream, retblock->data, opt.m, &fos, whole_rows, line_delim_str, line_delim_length);
-	delay_watchdog_timer();
+		if (size == 0)
+		{
+			gprintln(NULL, "session_get_block: end session due to EOF");
+			session_end(session, 0);
+			return 0;
+		}
 
-	if (size == 0)
-	{
-		gprintln(NULL, "session_get_block: end session due to EOF");
-		gcb.read_bytes += fstream_get_compressed_size(session->fstream);
-		session_end(session, 0);
-		return 0;
+		if (size < 0)
+		{
+			gwarning(NULL, "session_get_block end session due to %s", ferror);
+			session_end(session, 1);
+			return ferror;
+		}
 	}
+	else
+#endif
+	{
+		gcb.read_bytes -= fstream_get_compressed_position(session->fstream);
 
-	gcb.read_bytes += fstream_get_compressed_position(session->fstream);
+		/* read data from our filestream as a chunk with whole data rows */
 
-	if (size < 0)
-	{
-		const char* ferror = fstream_get_error(session->fstream);
-		gwarning(NULL, "session_get_block end session due to %s", ferror);
-		session_end(session, 1);
-		return ferror;
+		size = fstream_read(session->fstream, retblock->data, opt.m, &fos, whole_rows, line_delim_str, line_delim_length);
+		delay_watchdog_timer();
+
+		if (size == 0)
+		{
+			gprintln(NULL, "session_get_block: end session due to EOF");
+			gcb.read_bytes += fstream_get_compressed_size(session->fstream);
+			session_end(session, 0);
+			return 0;
+		}
+
+		gcb.read_bytes += fstream_get_compressed_position(session->fstream);
+
+		if (size < 0)
+		{
+			const char* ferror = fstream_get_error(session->fstream);
+			gwarning(NULL, "session_get_block end session due to %s", ferror);
+			session_end(session, 1);
+			return ferror;
+		}
 	}
 
 	retblock->top = size;
+	session->raw_bytes += size;
+
+	/* compress the data into the spare buffer, and send that one */
+	if (r->compression != GCOMPRESS_NONE)
+	{
+		char*	zdata = retblock->zdata;
+
+		size = gcompress_block(r->compression, retblock->data, size, zdata,
+							   gcompress_bound(r->compression, opt.m));
+		if (size < 0)
+		{
+			gwarning(NULL, "session_get_block end session due to failure to compress data");
+			retblock->top = 0;
+			session_end(session, 1);
+			return "failed to compress data";
+		}
+
+		retblock->zdata = retblock->data;
+		retblock->data = zdata;
+		retblock->top = size;
+	}
+	session->wire_bytes += retblock->top;
 
 	/* fill the block header with meta data for the client to parse and use */
 	block_fill_header(r, retblock, &fos);
@@ -1391,6 +1535,15 @@ static void session_end(session_t* session, int error)
 	if (error)
 		session->is_error = error;
 
+#ifndef WIN32
+	/* no worker may read the fstream once it is closed */
+	if (session->readahead)
+	{
+		readahead_stop(session->readahead);
+		session->readahead = NULL;
+	}
+#endif
+
 	if (session->fstream)
 	{
 		gprintln(NULL, "close fstream");
@@ -1418,6 +1571,14 @@ static void session_free(session_t* session, session_free_res* res)
 {
 	gprintln(NULL, "free session %s", session->key);
 
+#ifndef WIN32
+	if (session->readahead)
+	{
+		readahead_stop(session->readahead);
+		session->readahead = NULL;
+	}
+#endif
+
 	if (session->fstream)
 	{
 #ifdef GPFXDIST
@@ -1714,6 +1875,7 @@ static int session_attach(request_t* r)
 		session->fstream = fstream;
 		session->pool = pool;
 		session->is_get = r->is_get;
+		session->compression = r->compression;
 		session->active_segids[r->segid] = 1; /* mark this segid as active */
 		session->maxsegs = r->totalsegs;
 		session->requests = apr_hash_make(pool);
@@ -1722,6 +1884,13 @@ static int session_attach(request_t* r)
 		if (session->tid == 0 || session->path == 0 || session->key == 0)
 			gfatal(r, "out of memory in session_attach");
 
+#ifndef WIN32
+		/* let the worker threads read the data stream ahead of the requests */
+		if (opt.j > 0 && session->is_get)
+			session->readahead = readahead_start(pool, fstream, r->line_delim_str,
+												 r->line_delim_length);
+#endif
+
 		/* insert into hashtable */
 		apr_hash_set(gcb.session.tab, session->key, APR_HASH_KEY_STRING, session);
 
@@ -1839,7 +2008,18 @@ static void do_write(int fd, short event, void* arg)
 		/* get a block (or find a remaining block) */
 		if (r->outblock.top == r->outblock.bot)
 		{
-			const char* ferror = session_get_block(r, &r->outblock, r->line_delim_str, r->line_delim_length);
+			const char* ferror;
+
+#ifndef WIN32
+			/*
+			 * If the workers have not read the next block yet, stop here; the
+			 * request is set up to write again once the block is ready.
+			 */
+			if (r->session->readahead && !readahead_wait(r->session->readahead, r))
+				return;
+#endif
+
+			ferror = session_get_block(r, &r->outblock, r->line_delim_str, r->line_delim_length);
 
 			if (ferror)
 			{
@@ -3021,6 +3201,15 @@ void percent_encoding_to_char(char* p, char* pp, char* path)
 
 static void handle_get_request(request_t *r)
 {
+	/* a compressed block can be larger than its data, make room for it */
+	if (r->compression != GCOMPRESS_NONE)
+	{
+		int zsize = gcompress_bound(r->compression, opt.m);
+
+		r->outblock.data = palloc_safe(r, r->pool, zsize, "out of memory when allocating buffer: %d bytes", zsize);
+		r->outblock.zdata = palloc_safe(r, r->pool, zsize, "out of memory when allocating buffer: %d bytes", zsize);
+	}
+
 	/* setup to receive EV_WRITE events to write to socket */
 	if (setup_write(r))
 	{
@@ -3047,6 +3236,7 @@ static void handle_post_request(request_t *r, int header_end)
 	char *data_start = 0;
 	int data_bytes_in_req = 0;
 	int wrote = 0;
+	const char *errmsg = NULL;
 	session_t *session = r->session;
 
 	/*
@@ -3130,8 +3320,23 @@ static void handle_post_request(request_t *r, int header_end)
 			}
 	}
 
-	/* create a buffer to hold the incoming raw data */
-	r->in.dbufmax = opt.m; /* size of max line size */
+	/*
+	 * create a buffer to hold the incoming raw data. A compressed body is a
+	 * single block, that can only be uncompressed once it has all arrived.
+	 */
+	if (r->compression != GCOMPRESS_NONE)
+	{
+		if (r->in.davailable < 0 || r->in.davailable > GPFDIST_MAX_COMPRESSED_LENGTH)
+		{
+			gwarning(r, "reject compressed request of %d bytes", r->in.davailable);
+			http_error(r, FDIST_BAD_REQUEST, "invalid request (compressed data too large)");
+			request_end(r, 1, 0, 0);
+			return;
+		}
+		r->in.dbufmax = r->in.davailable;
+	}
+	else
+		r->in.dbufmax = opt.m; /* size of max line size */
 	r->in.dbuftop = 0;
 	r->in.dbuf = palloc_safe(r, r->pool, r->in.dbufmax, "out of memory when allocating r->in.dbuf: %d bytes", r->in.dbufmax);
 
@@ -3154,12 +3359,12 @@ static void handle_post_request(request_t *r, int header_end)
 		/* only write it out if no more data is expected */
 		if(r->in.davailable == 0)
 		{
-			wrote = fstream_write(session->fstream, r->in.dbuf, data_bytes_in_req, 1, r->line_delim_str, r->line_delim_length);
+			wrote = request_write_data(r, r->in.dbuf, data_bytes_in_req, &errmsg);
 			delay_watchdog_timer();
 			if(wrote == -1)
 			{
 				/* write error */
-				http_error(r, FDIST_INTERNAL_ERROR, fstream_get_error(session->fstream));
+				http_error(r, FDIST_INTERNAL_ERROR, errmsg);
 				request_end(r, 1, 0, 0);
 				return;
 			}
@@ -3221,15 +3426,15 @@ static void handle_post_request(request_t *r, int header_end)
 			if (r->in.dbufmax == r->in.dbuftop || r->in.davailable == 0)
 			{
 				/* only write up to end of last row */
-				wrote = fstream_write(session->fstream, r->in.dbuf, r->in.dbuftop, 1, r->line_delim_str, r->line_delim_length);
+				wrote = request_write_data(r, r->in.dbuf, r->in.dbuftop, &errmsg);
 				gdebug(r, "wrote %d bytes to file", wrote);
 				delay_watchdog_timer();
 
 				if (wrote == -1)
 				{
 					/* write error */
-					gwarning(r, "handle_post_request, write error: %s", fstream_get_error(session->fstream));
-					http_error(r, FDIST_INTERNAL_ERROR, fstream_get_error(session->fstream));
+					gwarning(r, "handle_post_request, write error: %s", errmsg);
+					http_error(r, FDIST_INTERNAL_ERROR, errmsg);
 					request_end(r, 1, 0, 0);
 					return;
 				}
@@ -3258,6 +3463,57 @@ done_processing_request:
 	request_end(r, 0, 0, 1);
 }
 
+/*
+ * request_write_data
+ *
+ * Write the data of a POST request to the session's file, up to the end of
+ * its last complete row. A compressed body is uncompressed first, and is
+ * always consumed as a whole. Return the number of bytes of buf consumed,
+ * or -1 with *errmsg set on failure.
+ */
+static int request_write_data(request_t *r, char *buf, int len, const char **errmsg)
+{
+	session_t*	session = r->session;
+	char*		data = buf;
+	int			datalen = len;
+	int			wrote;
+
+	if (r->compression != GCOMPRESS_NONE)
+	{
+		datalen = gcompress_raw_length(buf, len);
+		if (datalen < 0 || datalen > GPFDIST_MAX_COMPRESSED_LENGTH)
+		{
+			*errmsg = "invalid compressed data";
+			return -1;
+		}
+
+		data = palloc_safe(r, r->pool, datalen + 1, "out of memory when uncompressing data: %d bytes", datalen);
+		if (gdecompress_block(r->compression, buf, len, data, datalen) != datalen)
+		{
+			*errmsg = "failed to uncompress data";
+			return -1;
+		}
+	}
+
+	wrote = fstream_write(session->fstream, data, datalen, 1, r->line_delim_str, r->line_delim_length);
+	if (wrote == -1)
+	{
+		*errmsg = fstream_get_error(session->fstream);
+		return -1;
+	}
+
+	if (r->compression != GCOMPRESS_NONE)
+	{
+		session->raw_bytes += datalen;
+		session->wire_bytes += len;
+		return len;
+	}
+
+	session->raw_bytes += wrote;
+	session->wire_bytes += wrote;
+	return wrote;
+}
+
 static int request_set_path(request_t *r, const char* d, char* p, char* pp, char* path)
 {
 	r->path = 0;
@@ -3452,6 +3708,8 @@ static int request_parse_gp_headers(request_t *r, int opt_g)
 		}
 		else if (0 == strcasecmp("X-GP-LINE-DELIM-LENGTH", r->in.req->hname[i]))
 			r->line_delim_length = atoi(r->in.req->hvalue[i]);
+		else if (0 == strcasecmp("X-GP-COMPRESSION", r->in.req->hname[i]))
+			r->compression = gcompress_lookup(r->in.req->hvalue[i]);
 #ifdef GPFXDIST
 		else if (0 == strcasecmp("X-GP-TRANSFORM", r->in.req->hname[i]))
 			r->trans.name = r->in.req->hvalue[i];
@@ -3507,6 +3765,10 @@ static int request_parse_gp_headers(request_t *r, int opt_g)
 	if (opt_g != -1) /* override?  */
 		r->gp_proto = opt_g;
 
+	/* PROTO-0 sends the data as is, there are no blocks to compress */
+	if (r->is_get && r->gp_proto != 1)
+		r->compression = GCOMPRESS_NONE;
+
 	if (xid && cid && sn)
 	{
 		r->tid = apr_psprintf(r->pool, "%s.%s.%s.%d", xid, cid, sn, r->gp_proto);
@@ -3779,6 +4041,39 @@ int gpfdist_init(int argc, const char* const argv[])
 			pthread_create(&watchdog, 0, watchdog_thread, 0);
 		}
 	}
+
+	if (opt.j > 0)
+	{
+		if (pipe(readahead_pool.wakeup) != 0 ||
+			fcntl(readahead_pool.wakeup[0], F_SETFL, O_NONBLOCK) == -1 ||
+			fcntl(readahead_pool.wakeup[1], F_SETFL, O_NONBLOCK) == -1)
+		{
+			fprintf(stderr, "failed to create read-ahead pipe: %s\n", strerror(errno));
+			return -1;
+		}
+		event_set(&readahead_pool.wakeup_ev, readahead_pool.wakeup[0], EV_READ | EV_PERSIST,
+				  readahead_wakeup, 0);
+		if (event_add(&readahead_pool.wakeup_ev, 0))
+		{
+			fprintf(stderr, "cannot set up event on read-ahead pipe: %s\n", strerror(errno));
+			return -1;
+		}
+	}
+
+	for (int i = 0; i < opt.j; i++)
+	{
+		pthread_t	worker;
+		int			err = pthread_create(&worker, 0, readahead_worker, 0);
+
+		if (err != 0)
+		{
+			fprintf(stderr, "failed to create read-ahead thread: %s\n", strerror(err));
+			return -1;
+		}
+		pthread_detach(worker);
+	}
+	if (opt.j > 0)
+		gprintln(NULL, "Reading ahead with %d threads", opt.j);
 #endif
 	return 0;
 }
@@ -4545,6 +4840,306 @@ pcalloc_safe(request_t *r, apr_pool_t *pool, apr_size_t size, const char *fmt, .
 }
 
 #ifndef WIN32
+/*
+ * Read-ahead of GET sessions
+ *
+ * With -j, a pool of worker threads reads the data streams of the GET
+ * sessions into rings of blocks with whole rows, ahead of the requests. The
+ * decompression and the row splitting then run on the workers, for several
+ * sessions at a time, while the event loop only sends out the ready blocks.
+ * A data stream is read by one worker at a time, as fstream is not thread
+ * safe, so the files of a single session are still read one after another.
+ *
+ * The event loop never waits for the workers. A request whose next block is
+ * not read yet is parked on the read-ahead, and the worker that reads the
+ * block writes to a pipe watched by the event loop, which then sets up the
+ * parked requests to write again.
+ */
+#define READAHEAD_BLOCKS 4
+
+typedef struct readahead_block_t readahead_block_t;
+struct readahead_block_t
+{
+	char*			data;
+	int				size;		/* 0 at the end of the stream, < 0 on error */
+	apr_int64_t		read_bytes;	/* compressed bytes read for this block */
+	struct fstream_filename_and_offset fos;
+};
+
+typedef struct readahead_t readahead_t;
+struct readahead_t
+{
+	fstream_t*		fstream;
+	const char*		line_delim_str;
+	int				line_delim_length;
+	readahead_block_t blocks[READAHEAD_BLOCKS];
+	int				head;		/* next block to send */
+	int				count;		/* # blocks read and not sent yet */
+	int				busy;		/* a worker is reading the fstream */
+	int				done;		/* no more blocks to read */
+	int				waiting;	/* requests wait for the next block */
+	char			ferror[FILE_ERROR_SZ];	/* error string copy from fstream */
+	readahead_t*	next;		/* next in readahead_pool.list */
+	request_t*		waiters;	/* requests parked until a block is read */
+};
+
+static struct
+{
+	pthread_mutex_t	mutex;
+	pthread_cond_t	work;		/* a block was freed, or a read-ahead started */
+	pthread_cond_t	ready;		/* a worker let a fstream go */
+	readahead_t*	list;		/* read-aheads of the active sessions */
+	int				wakeup[2];	/* pipe written when a block is read for waiting requests */
+	struct event	wakeup_ev;	/* event of the read end of the pipe */
+} readahead_pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+					 PTHREAD_COND_INITIALIZER, NULL, { -1, -1 } };
+
+/*
+ * readahead_rearm
+ *
+ * Set up a list of parked requests to write again.
+ */
+static void readahead_rearm(request_t* waiters)
+{
+	while (waiters)
+	{
+		request_t*	r = waiters;
+
+		waiters = r->next_waiter;
+		r->next_waiter = NULL;
+		if (setup_write(r))
+			request_end(r, 1, 0, 0);
+	}
+}
+
+/*
+ * readahead_wakeup
+ *
+ * Callback when a worker has read a block for a session with waiting
+ * requests.
+ */
+static void readahead_wakeup(int fd, short event, void* arg)
+{
+	char			buf[64];
+	readahead_t*	ra;
+	request_t*		waiters = NULL;
+
+	while (read(fd, buf, sizeof(buf)) > 0)
+		;
+
+	pthread_mutex_lock(&readahead_pool.mutex);
+	for (ra = readahead_pool.list; ra; ra = ra->next)
+	{
+		request_t**	tail;
+
+		if (!ra->waiters || ra->count == 0)
+			continue;
+
+		for (tail = &ra->waiters; *tail; tail = &(*tail)->next_waiter)
+			;
+		*tail = waiters;
+		waiters = ra->waiters;
+		ra->waiters = NULL;
+	}
+	pthread_mutex_unlock(&readahead_pool.mutex);
+
+	readahead_rearm(waiters);
+}
+
+/*
+ * readahead_start
+ *
+ * Start reading ahead the data stream of a new session. Everything is
+ * allocated from the session pool by the event loop, the workers never
+ * touch the apr pools.
+ */
+static readahead_t* readahead_start(apr_pool_t* pool, fstream_t* fstream,
+									const char* line_delim_str, int line_delim_length)
+{
+	readahead_t*	ra = apr_pcalloc(pool, sizeof(readahead_t));
+	int				i;
+
+	if (!ra)
+		gfatal(NULL, "out of memory in readahead_start");
+
+	ra->fstream = fstream;
+	ra->line_delim_str = apr_pstrdup(pool, line_delim_str ? line_delim_str : "");
+	ra->line_delim_length = line_delim_length;
+	for (i = 0; i < READAHEAD_BLOCKS; i++)
+	{
+		ra->blocks[i].data = apr_palloc(pool, opt.m);
+		if (!ra->blocks[i].data)
+			gfatal(NULL, "out of memory when allocating buffer: %d bytes", opt.m);
+	}
+
+	pthread_mutex_lock(&readahead_pool.mutex);
+	ra->next = readahead_pool.list;
+	readahead_pool.list = ra;
+	pthread_cond_signal(&readahead_pool.work);
+	pthread_mutex_unlock(&readahead_pool.mutex);
+
+	return ra;
+}
+
+/*
+ * readahead_wait
+ *
+ * Return 1 if the next block of the session is ready. Otherwise park the
+ * request until a worker has read it, and return 0.
+ */
+static int readahead_wait(readahead_t* ra, request_t* r)
+{
+	int			ready;
+
+	pthread_mutex_lock(&readahead_pool.mutex);
+	ready = (ra->count > 0);
+	if (!ready)
+	{
+		ra->waiting = 1;
+		r->next_waiter = ra->waiters;
+		ra->waiters = r;
+	}
+	pthread_mutex_unlock(&readahead_pool.mutex);
+
+	return ready;
+}
+
+/*
+ * readahead_get_block
+ *
+ * Copy the next block of the session, which readahead_wait() found ready,
+ * into retblock. Return the size of the block, 0 at the end of the stream,
+ * or < 0 on error with *ferror set to the error string.
+ */
+static int readahead_get_block(readahead_t* ra, block_t* retblock,
+							   struct fstream_filename_and_offset* fos, const char** ferror)
+{
+	readahead_block_t*	block;
+	int					size;
+
+	pthread_mutex_lock(&readahead_pool.mutex);
+	if (ra->count == 0)
+		gfatal(NULL, "internal error - no read-ahead block ready");
+
+	block = &ra->blocks[ra->head];
+	size = block->size;
+	gcb.read_bytes += block->read_bytes;
+	block->read_bytes = 0;
+
+	/* the last block stays in the ring, the session ends after it */
+	if (size > 0)
+	{
+		memcpy(retblock->data, block->data, size);
+		*fos = block->fos;
+		ra->head = (ra->head + 1) % READAHEAD_BLOCKS;
+		ra->count--;
+		pthread_cond_signal(&readahead_pool.work);
+	}
+	pthread_mutex_unlock(&readahead_pool.mutex);
+
+	*ferror = ra->ferror;
+	return size;
+}
+
+/*
+ * readahead_stop
+ *
+ * Stop reading ahead for a session that is about to close its fstream, and
+ * wait for the worker that may be reading it. That worker reads at most one
+ * block. The requests still waiting for a block are set up to write again,
+ * and find the session ended.
+ */
+static void readahead_stop(readahead_t* ra)
+{
+	readahead_t**	prev;
+	request_t*		waiters;
+
+	pthread_mutex_lock(&readahead_pool.mutex);
+	ra->done = 1;
+	while (ra->busy)
+		pthread_cond_wait(&readahead_pool.ready, &readahead_pool.mutex);
+
+	for (prev = &readahead_pool.list; *prev; prev = &(*prev)->next)
+	{
+		if (*prev == ra)
+		{
+			*prev = ra->next;
+			break;
+		}
+	}
+	waiters = ra->waiters;
+	ra->waiters = NULL;
+	pthread_mutex_unlock(&readahead_pool.mutex);
+
+	readahead_rearm(waiters);
+}
+
+static void* readahead_worker(void* p)
+{
+	for (;;)
+	{
+		readahead_t*		ra;
+		readahead_t*		next = NULL;
+		readahead_block_t*	block;
+		apr_int64_t			position;
+		int					wakeup;
+
+		/* pick the session with the fewest blocks ready */
+		pthread_mutex_lock(&readahead_pool.mutex);
+		for (;;)
+		{
+			for (ra = readahead_pool.list; ra; ra = ra->next)
+			{
+				if (ra->busy || ra->done || ra->count == READAHEAD_BLOCKS)
+					continue;
+				if (!next || ra->count < next->count)
+					next = ra;
+			}
+			if (next)
+				break;
+			pthread_cond_wait(&readahead_pool.work, &readahead_pool.mutex);
+		}
+		next->busy = 1;
+		block = &next->blocks[(next->head + next->count) % READAHEAD_BLOCKS];
+		pthread_mutex_unlock(&readahead_pool.mutex);
+
+		/* read data from the filestream as a chunk with whole data rows */
+		position = fstream_get_compressed_position(next->fstream);
+		block->size = fstream_read(next->fstream, block->data, opt.m, &block->fos, 1,
+								   next->line_delim_str, next->line_delim_length);
+		if (block->size == 0)
+			block->read_bytes = fstream_get_compressed_size(next->fstream) - position;
+		else
+			block->read_bytes = fstream_get_compressed_position(next->fstream) - position;
+		if (block->size < 0)
+			apr_cpystrn(next->ferror, fstream_get_error(next->fstream), sizeof(next->ferror));
+
+		pthread_mutex_lock(&readahead_pool.mutex);
+		next->busy = 0;
+		next->count++;
+		if (block->size <= 0)
+			next->done = 1;
+		wakeup = next->waiting;
+		next->waiting = 0;
+		pthread_cond_broadcast(&readahead_pool.ready);
+		pthread_mutex_unlock(&readahead_pool.mutex);
+
+		/*
+		 * Wake up the event loop. If the pipe is full, a wakeup is pending
+		 * already, and it handles this block too.
+		 */
+		if (wakeup)
+		{
+			char	c = 0;
+
+			while (write(readahead_pool.wakeup[1], &c, 1) < 0 && errno == EINTR)
+				;
+		}
+	}
+
+	return NULL;
+}
+
 static void* watchdog_thread(void* p)
 {
 	apr_time_t		duration;
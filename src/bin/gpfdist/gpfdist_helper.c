@@ -33,3 +33,13 @@ bool is_valid_listen_queue_size(int listen_queue_size)
 	else
 		return true;
 }
+
+bool is_valid_readahead_threads(int readahead_threads)
+{
+	if (readahead_threads < 0)
+		return false;
+	else if (readahead_threads > 64)
+		return false;
+	else
+		return true;
+}
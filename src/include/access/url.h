@@ -124,5 +124,6 @@ extern size_t url_custom_fwrite(void *ptr, size_t size, URL_FILE *file, CopyToSt
 /* GUC */
 extern int readable_external_table_timeout;
 extern int gpfdist_retry_timeout;
+extern int gpfdist_compression;
 
 #endif
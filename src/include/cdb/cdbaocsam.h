@@ -203,6 +203,17 @@ typedef struct AOCSScanDescData
 	int				aos_sample_rows;
 	int				aos_scaned_rows;
 	int				*aos_qual_rows;
+	/* per-column conditions for skipping whole blocks, indexed by attno */
+	struct AOCSBlockSkipInfo **aos_blockskip;
+	/* number of blocks passed over by aocs_skip_blocks() */
+	int64			aos_blocks_skipped;
+
+	/*
+	 * Per-column batches of decoded values, indexed by attno, or NULL if
+	 * the columns are decoded one value at a time.
+	 */
+	struct AOCSColumnBatch *aos_batches;
+	int				aos_batch_size;
 
 	/*
 	 * The total number of bytes read, compressed, across all segment files, and
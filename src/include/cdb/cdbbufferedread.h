@@ -18,6 +18,7 @@
 #ifndef CDBBUFFEREDREAD_H
 #define CDBBUFFEREDREAD_H
 
+#include "portability/instr_time.h"
 #include "storage/fd.h"
 #include "storage/relfilenode.h"
 typedef struct BufferedRead
@@ -80,6 +81,31 @@ typedef struct BufferedRead
 	bool				haveTemporaryLimitInEffect;
 	int64				temporaryLimitFileLen;
 
+	/*
+	 * Read-ahead.  After each large read, we ask the kernel to start reading
+	 * the next prefetchDepth large reads' worth of the file, so that the I/O
+	 * overlaps with our processing of the current one.  prefetchDepth comes
+	 * from the effective_io_concurrency setting of the file's tablespace.
+	 */
+	int					prefetchDepth;
+	int64				prefetchPosition;
+							/*
+							 * The file position up to which read-ahead has
+							 * been requested.
+							 */
+	int64				prefetchRequests;
+	int64				prefetchBytes;
+	int64				largeReads;
+	int64				prefetchHits;
+	instr_time			readTime;
+							/*
+							 * Counters for the current file: number and total
+							 * length of the read-ahead requests, number of
+							 * large reads and of those that had been entirely
+							 * requested ahead, and time spent waiting in reads
+							 * (only with track_io_timing).
+							 */
+
 } BufferedRead;
 
 /*
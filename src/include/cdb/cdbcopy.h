@@ -24,6 +24,13 @@
 
 #define COPYOUT_CHUNK_SIZE 16 * 1024
 
+/*
+ * In COPY FROM, data for each segment is collected into a buffer of about
+ * this size before it is handed to libpq, so that many small rows go out as
+ * one CopyData message.
+ */
+#define COPYIN_CHUNK_SIZE 64 * 1024
+
 struct CdbDispatcherState;
 struct CopyFromStateData;
 struct CopyToStateData;
@@ -34,6 +41,7 @@ typedef struct CdbCopy
 	bool		copy_in;		/* direction: true for COPY FROM false for COPY TO */
 
 	StringInfoData	copy_out_buf;/* holds a chunk of data from the database */
+	StringInfoData	*copy_in_bufs;/* per-segment data not yet sent, COPY FROM only */
 
 	List		*seglist;    	/* segs that currently take part in copy.
 								 * for copy out, once a segment gave away all it's
@@ -58,6 +58,7 @@ typedef struct DispatcherInternalFuncs
 	bool (*checkForCancel)(struct CdbDispatcherState *ds);
 	int* (*getWaitSocketFds)(struct CdbDispatcherState *ds, int *nsocks);
 	void* (*makeDispatchParams)(int maxSlices, int largestGangSize, char *queryText, int queryTextLen);
+	void (*setQueryText)(struct CdbDispatcherState *ds, char *queryText, int queryTextLen);
 	bool (*checkAckMessage)(struct CdbDispatcherState *ds, const char* message, int timeout_sec);
 	void (*checkResults)(struct CdbDispatcherState *ds, DispatchWaitMode waitMode);
 	void (*dispatchToGang)(struct CdbDispatcherState *ds, struct Gang *gp, int sliceIndex);
@@ -202,6 +203,17 @@ cdbdisp_makeDispatchParams(CdbDispatcherState *ds,
 						   char *queryText,
 						   int queryTextLen);
 
+/*
+ * cdbdisp_setDispatchQueryText:
+ *
+ * Replace the query text sent by the following cdbdisp_dispatchToGang()
+ * calls. The text must stay valid until cdbdisp_waitDispatchFinish().
+ */
+void
+cdbdisp_setDispatchQueryText(CdbDispatcherState *ds,
+							 char *queryText,
+							 int queryTextLen);
+
 bool cdbdisp_checkForCancel(CdbDispatcherState * ds);
 int *cdbdisp_getWaitSocketFds(CdbDispatcherState *ds, int *nsocks);
 
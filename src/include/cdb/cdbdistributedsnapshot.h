@@ -49,7 +49,8 @@ typedef struct DistributedSnapshotWithLocalMapping
 
 	/*
 	 * Cache to perform quick check for localXid, populated after reverse
-	 * mapping distributed xid to local xid.
+	 * mapping distributed xid to local xid. inProgressMappedLocalXids is
+	 * kept sorted, so min/max are its first and last entries.
 	 */
 	TransactionId minCachedLocalXid;
 	TransactionId maxCachedLocalXid;
@@ -71,6 +72,8 @@ extern DistributedSnapshotCommitted DistributedSnapshotWithLocalMapping_Committe
 	TransactionId 							localXid,
 	bool isVacuumCheck);
 
+extern void DistributedSnapshotWithLocalMapping_ShowStats(char *nameStr);
+
 extern void DistributedSnapshot_Reset(
 	DistributedSnapshot *distributedSnapshot);
 
@@ -128,6 +128,12 @@ extern void SendStopMessage(MotionLayerState *mlStates,
 extern void UpdateMotionExpectedReceivers(MotionLayerState *mlStates,
 										  struct SliceTable *sliceTable);
 
+/*
+ * Tuple bytes before and after compression, for EXPLAIN ANALYZE.
+ */
+extern bool GetMotionCompressionStats(MotionLayerState *mlStates, int16 motNodeID,
+									  uint64 *raw_bytes, uint64 *sent_bytes);
+
 /*
  * Return a pointer to the internal "end-of-stream" message
  */
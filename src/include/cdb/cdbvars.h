@@ -376,6 +376,20 @@ extern int	Gp_interconnect_queue_depth;
  *
  */
 extern int	Gp_interconnect_snd_queue_depth;
+
+/*
+ * Parameter Gp_interconnect_recv_batch_size
+ *
+ * The run-time parameter Gp_interconnect_recv_batch_size controls the
+ * maximum number of packets the receive thread picks up from the socket
+ * with a single system call.
+ *
+ * This guc is specific to the UDP-interconnect.
+ *
+ */
+#define MAX_INTERCONNECT_RECV_BATCH 32
+extern int	Gp_interconnect_recv_batch_size;
+
 extern int	Gp_interconnect_timer_period;
 extern int	Gp_interconnect_timer_checking_period;
 extern int	Gp_interconnect_default_rtt;
@@ -403,6 +417,15 @@ extern bool gp_interconnect_aggressive_retry; /* fast-track app-level retry */
  */
 extern bool gp_interconnect_full_crc;
 
+/*
+ * Parameter gp_interconnect_compress_tuples
+ *
+ * Compress large tuples before handing them to the interconnect.  The
+ * sender stops trying for a while when the data turns out to be
+ * incompressible.
+ */
+extern bool gp_interconnect_compress_tuples;
+
 /*
  * Parameter gp_interconnect_log_stats
  *
@@ -668,6 +691,8 @@ extern bool gp_dynamic_partition_pruning;
 
 /* Sharing of plan fragments for common table expressions */
 extern bool gp_cte_sharing;
+/* Size of the first chunk streamed by a cross-slice ShareInputScan; 0 disables */
+extern int gp_shareinput_stream_chunk_tuples;
 /* Enable RECURSIVE clauses in common table expressions */
 extern bool gp_recursive_cte;
 
@@ -685,12 +710,22 @@ extern int gp_max_plan_size;
  */
 extern int gp_hashagg_default_nbatches;
 
+/*
+ * Let the first, partial, stage of a hashed aggregation emit its groups
+ * when it runs out of memory or isn't reducing its input, instead of
+ * spilling them to disk.
+ */
+extern bool gp_hashagg_streambottom;
+
 /* Get statistics for partitioned parent from a child */
 extern bool 	gp_statistics_pullup_from_child_partition;
 
 /* Extract numdistinct from foreign key relationship */
 extern bool		gp_statistics_use_fkeys;
 
+/* Build column statistics from sketches computed on the segments */
+extern bool		gp_statistics_use_sketches;
+
 /* Allow user to force tow stage agg */
 extern bool     gp_eager_two_phase_agg;
 
@@ -702,6 +737,9 @@ extern bool     gp_force_random_redistribution;
 /* Analyze tools */
 extern int gp_motion_slice_noop;
 
+/* Number of tuples a redistribute Motion routes and sends together */
+extern int gp_motion_send_batch_size;
+
 /* Disable setting of hint-bits while reading db pages */
 extern bool gp_disable_tuple_hints;
 
@@ -738,6 +776,7 @@ extern int	gp_autostats_mode;
 extern int	gp_autostats_mode_in_functions;
 extern int	gp_autostats_on_change_threshold;
 extern bool	gp_autostats_allow_nonowner;
+extern bool	gp_autostats_incremental;
 extern bool	log_autostats;
 
 
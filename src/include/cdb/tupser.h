@@ -57,6 +57,17 @@ typedef struct SerTupInfo
 
 	/* true if tupdesc contains record types */
 	bool		has_record_types;
+
+	/*
+	 * State for compressing tuple bodies, see SerializeTuple().  The byte
+	 * counters cover every tuple body sent while compression was enabled.
+	 */
+	MemoryContext compress_cxt;	/* where compress_buf lives */
+	char	   *compress_buf;
+	int			compress_buflen;
+	int			compress_skip;	/* tuples to send before trying again */
+	uint64		compress_raw_bytes;	/* tuple bytes before compression */
+	uint64		compress_sent_bytes;	/* tuple bytes actually sent */
 }	SerTupInfo;
 
 /*
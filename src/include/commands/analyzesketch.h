@@ -0,0 +1,114 @@
+/*-------------------------------------------------------------------------
+ *
+ * analyzesketch.h
+ *
+ *	  Column sketches, built on the segments by a scan of all the rows of a
+ *	  table, and merged on the dispatcher into the statistics of the table.
+ *
+ * Portions Copyright (c) 2023, HashData Technology Limited.
+ *
+ * src/include/commands/analyzesketch.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef ANALYZESKETCH_H
+#define ANALYZESKETCH_H
+
+#include "cdb/cdbvars.h"
+#include "executor/tuptable.h"
+#include "nodes/nodes.h"
+#include "utils/relcache.h"
+
+/*
+ * The sizes of the sketches of a column are multiples of its statistics
+ * target.
+ *
+ * SKETCH_HEAVY_HITTERS_FACTOR: number of counters of the heavy hitters
+ * sketch. A value that is more frequent than 1 / (factor * target) of the
+ * rows of a segment is never missed.
+ *
+ * SKETCH_QUANTILES_FACTOR: capacity of the top level of the quantiles
+ * sketch. The sketch holds at most three times that many values, and its
+ * rank error is about 1.7 / (factor * target).
+ *
+ * SKETCH_POINTS_FACTOR: number of values the quantiles sketch is
+ * summarized to, to be sent to the dispatcher.
+ *
+ * SKETCH_CORRELATION_FACTOR: number of rows of the sample the correlation
+ * is computed from.
+ */
+#define SKETCH_HEAVY_HITTERS_FACTOR	10
+#define SKETCH_QUANTILES_FACTOR		20
+#define SKETCH_POINTS_FACTOR		10
+#define SKETCH_CORRELATION_FACTOR	30
+
+/*
+ * The sketches of a column on one segment, in the form they are sent to the
+ * dispatcher.
+ *
+ * Values wider than WIDTH_THRESHOLD are only counted, like ANALYZE leaves
+ * them out of the sample; all the other values are added to every sketch.
+ */
+typedef struct ColumnSketch
+{
+	AttrNumber	attnum;
+	double		totalrows;		/* # of rows scanned */
+	double		nullrows;		/* # of NULLs */
+	double		toowiderows;	/* # of values wider than WIDTH_THRESHOLD */
+	double		totalwidth;		/* total width of the non-null values */
+	bool		corrnull;		/* no correlation, fewer than 2 values */
+	float4		correlation;	/* correlation of the sample of the rows */
+	bytea	   *hll;			/* GpHLLCounter of the values */
+
+	/*
+	 * Misra-Gries heavy hitters. The counts are lower bounds; the count of
+	 * any value, listed or not, is at most mcverror higher.
+	 */
+	int			nmcvs;
+	Datum	   *mcvs;
+	double	   *mcvcounts;
+	double		mcverror;
+
+	/*
+	 * Weighted values summarizing the quantiles sketch, in ascending order.
+	 * The first and the last ones are the minimum and the maximum.
+	 */
+	int			npoints;
+	Datum	   *points;
+	double	   *pointweights;
+} ColumnSketch;
+
+/* The state of the sketches of a set of columns, while rows are added */
+typedef struct ColumnSketchSet ColumnSketchSet;
+
+extern void build_column_sketches(Relation onerel, int nattrs,
+								  AttrNumber *attnums, int stattarget,
+								  ColumnSketch **sketches);
+extern ColumnSketchSet *column_sketches_begin(Relation onerel, int nattrs,
+											  AttrNumber *attnums,
+											  int stattarget);
+extern void column_sketches_add(ColumnSketchSet *set, TupleTableSlot *slot);
+extern void column_sketches_end(ColumnSketchSet *set, ColumnSketch **sketches);
+
+/*
+ * Are the rows appended to append-optimized tables sketched for auto-stats?
+ * See appended_rows_begin().
+ */
+static inline bool
+appended_rows_sketched(void)
+{
+	return gp_autostats_incremental && Gp_role == GP_ROLE_EXECUTE &&
+		(gp_autostats_mode == GP_AUTOSTATS_ON_CHANGE ||
+		 gp_autostats_mode_in_functions == GP_AUTOSTATS_ON_CHANGE);
+}
+
+extern void appended_rows_begin(Relation rel, CmdType operation);
+extern void appended_rows_end(Relation rel);
+extern void sketch_appended_rows(Relation rel, TupleTableSlot **slots,
+								 int nslots);
+extern void take_appended_sketches(Relation rel, int nattrs,
+								   AttrNumber *attnums,
+								   ColumnSketch **sketches);
+extern void discard_appended_sketches(Oid relid);
+
+#endif							/* ANALYZESKETCH_H */
@@ -186,6 +186,7 @@ typedef struct VacAttrStats
 	bool		corrnull;	  /* whether correlation value is null */
 	bool		partitiontbl_qd; /* analyze is on QD and the policy of table is partitioned */
 	float4		corrval;	  /* correlation gathered from segments */
+	List	   *sketches;	  /* ColumnSketches gathered from segments */
 } VacAttrStats;
 
 typedef enum VacuumOption
@@ -355,6 +356,26 @@ typedef struct
 	int			totalAttr;
 } gp_acquire_correlation_context;
 
+typedef struct
+{
+	/* Table being sketched */
+	Relation	onerel;
+
+	/* Sketches of the requested columns, see commands/analyzesketch.c */
+	int			nsketches;
+	struct ColumnSketch **sketches;
+
+	/*
+	 * Result tuple descriptor. Each returned row holds the sketches of one
+	 * column.
+	 */
+	TupleDesc	outDesc;
+#define NUM_COLUMN_SKETCH_COLS 12
+
+	/* SRF state, to track which rows have already been returned. */
+	int			index;
+} gp_acquire_column_sketches_context;
+
 /* GUC parameters */
 extern PGDLLIMPORT int default_statistics_target;	/* PGDLLIMPORT for PostGIS */
 extern int	vacuum_freeze_min_age;
@@ -419,6 +440,7 @@ extern bool vacuumStatement_IsTemporary(Relation onerel);
 extern void analyze_rel(Oid relid, RangeVar *relation,
 						VacuumParams *params, List *va_cols, bool in_outer_xact,
 						BufferAccessStrategy bstrategy, gp_acquire_sample_rows_context *ctx);
+extern bool analyze_appended_rows(Oid relid);
 
 /* in commands/vacuumlazy.c */
 extern void lazy_vacuum_rel_heap(Relation onerel,
@@ -445,6 +467,8 @@ extern int acquire_inherited_sample_rows(Relation onerel, int elevel,
 /* in commands/analyzefuncs.c */
 extern Datum gp_acquire_sample_rows(PG_FUNCTION_ARGS);
 extern Datum gp_acquire_correlations(PG_FUNCTION_ARGS);
+extern Datum gp_acquire_column_sketches(PG_FUNCTION_ARGS);
+extern Datum gp_acquire_appended_sketches(PG_FUNCTION_ARGS);
 extern Oid gp_acquire_sample_rows_col_type(Oid typid);
 
 extern bool gp_vacuum_needs_update_stats(void);
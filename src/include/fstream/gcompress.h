@@ -0,0 +1,43 @@
+/*-------------------------------------------------------------------------
+ *
+ * gcompress.h
+ *	  Block compression of the data sent between gpfdist and the segments.
+ *
+ * Portions Copyright (c) 2023, HashData Technology Limited.
+ *
+ * src/include/fstream/gcompress.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef GCOMPRESS_H
+#define GCOMPRESS_H
+
+#include "c.h"
+
+/*
+ * Compression methods of the gpfdist protocol. The values are also the ones
+ * of the gpfdist_compression GUC, so do not renumber them.
+ */
+typedef enum gcompress_method
+{
+	GCOMPRESS_NONE = 0,
+	GCOMPRESS_ZSTD,
+	GCOMPRESS_LZ4
+} gcompress_method;
+
+/*
+ * A compressed block starts with the length of the uncompressed data, 4 bytes
+ * in network order, followed by the compressed data.
+ */
+#define GCOMPRESS_HEADER_SIZE	4
+
+extern gcompress_method gcompress_lookup(const char *name);
+extern const char *gcompress_name(gcompress_method method);
+extern int	gcompress_bound(gcompress_method method, int len);
+extern int	gcompress_block(gcompress_method method, const char *src, int srclen,
+							char *dst, int dstlen);
+extern int	gcompress_raw_length(const char *src, int srclen);
+extern int	gdecompress_block(gcompress_method method, const char *src, int srclen,
+							  char *dst, int dstlen);
+
+#endif							/* GCOMPRESS_H */
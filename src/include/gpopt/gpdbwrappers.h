@@ -23,6 +23,7 @@ extern "C" {
 #include "parser/parse_coerce.h"
 #include "utils/faultinjector.h"
 #include "utils/lsyscache.h"
+#include "utils/sharedmdcache.h"
 }
 
 #include "gpos/types.h"
@@ -57,6 +58,8 @@ struct Motion;
 struct Var;
 struct Const;
 struct ArrayExpr;
+struct MVDependencies;
+struct MVNDistinct;
 
 #include "gpopt/utils/RelationWrapper.h"
 
@@ -206,6 +209,18 @@ void FreeAttrStatsSlot(AttStatsSlot *sslot);
 // attribute statistics
 HeapTuple GetAttStats(Oid relid, AttrNumber attnum);
 
+// return a list of extended statistics object oids for a given relation
+List *GetRelationStatExtList(Relation relation);
+
+// has the given kind of extended statistics been built for the object
+bool IsExtStatsKindBuilt(Oid stat_oid, char kind);
+
+// functional dependencies of an extended statistics object
+MVDependencies *GetMVDependencies(Oid stat_oid);
+
+// multi-column ndistinct coefficients of an extended statistics object
+MVNDistinct *GetMVNDistinct(Oid stat_oid);
+
 // does a function exist with the given oid
 bool FunctionExists(Oid oid);
 
@@ -717,10 +732,45 @@ FaultInjectorType_e InjectFaultInOptTasks(const char *fault_name);
 	gpos::ULONG CountLeafPartTables(Oid oidRelation);
 #endif
 
+// pseudo cache id used for relcache invalidations of the metadata cache
+constexpr int MDCacheRelcacheInvalidation = -1;
+
+// a catalog change that affects specific entries of the metadata cache
+struct MDCacheInvalidation
+{
+	// syscache id, or MDCacheRelcacheInvalidation
+	int cacheid;
+
+	// syscache hash value of the changed tuple's key
+	uint32 hashvalue;
+
+	// changed relation for relcache invalidations
+	Oid relid;
+};
+
 // Does the metadata cache need to be reset (because of a catalog
-// table has been changed?)
+// table has been changed in a way that cannot be tracked per entry?)
 bool MDCacheNeedsReset(void);
 
+// fetch and clear the invalidations of individual metadata cache entries
+MDCacheInvalidation *MDCacheConsumeInvalidations(int *num_invalidations);
+
+// syscache hash value of the given keys
+uint32 GetSysCacheHashValue(int cacheid, Datum key1, Datum key2, Datum key3);
+
+// can the metadata cache shared by all backends be used now?
+bool SharedMDCacheEnabled(void);
+
+// generation of the shared metadata cache before translating an object
+uint64 SharedMDCacheGeneration(void);
+
+// DXL of a metadata object in the shared metadata cache, or NULL
+char *SharedMDCacheLookup(const char *key);
+
+// publish the DXL of a metadata object in the shared metadata cache
+void SharedMDCacheInsert(const char *key, const char *dxl,
+						 const SharedMDCacheDeps *deps, uint64 generation);
+
 // returns true if a query cancel is requested in GPDB
 bool IsAbortRequested(void);
 
@@ -564,6 +564,12 @@ private:
 		CDXLColRefArray *pdrgdxlcrOuterRefs, CDXLTranslateContext *dxltrctxLeft,
 		CDXLTranslateContext *dxltrctxRight);
 
+	// cache the inner plan of an index nested loop join by the values of
+	// its nest params
+	Plan *TranslateMemoize(Plan *inner_plan,
+						   CDXLColRefArray *pdrgdxlcrOuterRefs,
+						   CDXLTranslateContext *dxltrctxRight);
+
 	// create final target list for update
 	static List *CreateDirectCopyTargetList(List *target_list);
 };
@@ -32,7 +32,9 @@ extern "C" {
 #include "naucrates/md/CDXLColStats.h"
 #include "naucrates/md/CMDAggregateGPDB.h"
 #include "naucrates/md/CMDCheckConstraintGPDB.h"
+#include "naucrates/md/CMDDependency.h"
 #include "naucrates/md/CMDFunctionGPDB.h"
+#include "naucrates/md/CMDNDistinct.h"
 #include "naucrates/md/CMDPartConstraintGPDB.h"
 #include "naucrates/md/CMDRelationExternalGPDB.h"
 #include "naucrates/md/CMDRelationGPDB.h"
@@ -187,6 +189,12 @@ private:
 	// retrieve relstats object from the relcache
 	static IMDCacheObject *RetrieveRelStats(CMemoryPool *mp, IMDId *mdid);
 
+	// retrieve the functional dependencies and multi-column ndistinct
+	// coefficients of the extended statistics defined on a relation
+	static void RetrieveRelExtStats(CMemoryPool *mp, Relation rel,
+									CMDDependencyArray *dependencies,
+									CMDNDistinctArray *ndistincts);
+
 	// retrieve column stats object from the relcache
 	static IMDCacheObject *RetrieveColStats(CMemoryPool *mp,
 											CMDAccessor *md_accessor,
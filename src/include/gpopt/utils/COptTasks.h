@@ -127,6 +127,9 @@ private:
 	static COptimizerConfig *CreateOptimizerConfig(CMemoryPool *mp,
 												   ICostModel *cost_model);
 
+	// evict metadata cache entries affected by catalog changes
+	static void EvictInvalidatedMDCacheEntries(CMemoryPool *mp);
+
 	// optimize a query to a physical DXL
 	static void *OptimizeTask(void *ptr);
 
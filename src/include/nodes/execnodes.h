@@ -2373,6 +2373,7 @@ typedef struct ShareInputScanState
 
 	Tuplestorestate *ts_state;
 	int			ts_pos;
+	int			ts_chunk;		/* chunk being read, if the input is streamed */
 
 	struct shareinput_local_state *local_state;
 	struct shareinput_Xslice_reference *ref;
@@ -2620,6 +2621,17 @@ typedef struct AggState
 	SharedAggInfo *shared_info; /* one entry per worker */
 	Bitmapset	*aggs_used;	/* which aggs are used in this query */
 
+	/*
+	 * GPDB: streaming hashed aggregation.  Instead of spilling, a partial
+	 * aggregate emits the groups it has and starts over with an empty table.
+	 */
+	bool		hash_streaming;	/* stream rather than spill? */
+	bool		hash_stream_pending;	/* table must be emitted before
+										 * reading more input */
+	bool		hash_stream_small;	/* input is barely reduced, keep the
+									 * table small */
+	uint64		hash_stream_ntuples;	/* input tuples since last emitted */
+	int			hash_stream_passes;	/* times the table was emitted early */
 } AggState;
 
 typedef struct TupleSplitState
@@ -3054,6 +3066,15 @@ typedef struct MotionState
 	struct CdbHash *cdbhashworkers;	/* hash api object for parallel workers */
 	int			numHashSegments;	/* number of segments to use when calculating hash */
 
+	/* For batched hash Motion send, see doSendTupleBatch() */
+	int			sendBatchSize;	/* max tuples in a batch, 0 if not batching */
+	int			numBatchedTuples;	/* tuples currently in the batch */
+	TupleTableSlot **batchSlots;	/* the batched tuples */
+	int16	   *batchRoutes;	/* target route of each batched tuple */
+	int		   *batchOrder;		/* batch indexes, grouped by target route */
+	int			numRoutes;		/* number of possible target routes */
+	int		   *routeCounts;	/* scratch space for grouping, numRoutes + 1 */
+
 	/* For Motion recv */
 	int			routeIdNext;	/* for a sorted motion node, the routeId to get next (same as
 								 * the routeId last returned ) */
@@ -23,6 +23,13 @@
 
 extern PlannedStmt * optimize_query(Query *parse, int cursorOptions, ParamListInfo boundParams);
 
+/* in orcaplancache.c */
+extern PlannedStmt *orca_plan_cache_lookup(Query *parse, int cursorOptions,
+										   ParamListInfo boundParams);
+extern void orca_plan_cache_insert(Query *parse, int cursorOptions,
+								   ParamListInfo boundParams, PlannedStmt *plan);
+extern Datum OrcaPlanCacheStats(PG_FUNCTION_ARGS);
+
 #else
 
 /* Keep compilers quiet in case the build used --disable-orca */
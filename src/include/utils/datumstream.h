@@ -315,6 +315,10 @@ extern int	datumstreamread_block(DatumStreamRead * ds,
 extern void datumstreamread_find(DatumStreamRead * datumStream,
 					 int32 rowNumInBlock);
 extern void datumstreamread_rewind_block(DatumStreamRead * datumStream);
+extern int	datumstreamread_get_batch(DatumStreamRead * acc, Datum *values,
+									  bool *nulls, int maxvalues);
+extern int64 datumstreamread_remaining(DatumStreamRead * acc);
+extern int64 datumstreamread_skip(DatumStreamRead * acc, int64 nrows);
 extern bool datumstreamread_find_block(DatumStreamRead * datumStream,
 						   DatumStreamFetchDesc datumStreamFetchDesc,
 						   int64 rowNum);
@@ -2065,6 +2065,10 @@ DatumStreamBlockRead_Nth(DatumStreamBlockRead * dsr)
 	return dsr->nth;
 }
 
+extern int DatumStreamBlockRead_GetBatch(DatumStreamBlockRead * dsr,
+										 Datum *values, bool *nulls,
+										 int maxvalues);
+
 extern void DatumStreamBlockRead_GetReadyOrig(
 								  DatumStreamBlockRead * dsr,
 								  uint8 * buffer,
@@ -315,6 +315,7 @@ extern bool gp_enable_multiphase_limit;
  * 10% of the tuples are hidden.
  */
 extern int  gp_appendonly_compaction_threshold;
+extern int  gp_aocs_scan_batch_size;
 extern bool gp_heap_require_relhasoids_match;
 extern bool	debug_xlog_record_read;
 extern bool Debug_cancel_print;
@@ -395,6 +396,7 @@ extern bool trace_sort;
 
 extern bool vmem_process_interrupt;
 extern bool execute_pruned_plan;
+extern bool gp_dispatch_pruned_plan;
 
 extern bool gp_enable_relsize_collection;
 
@@ -467,10 +469,12 @@ extern bool optimizer_control;	/* controls whether the user can change the setti
 extern bool	optimizer_log;
 extern int  optimizer_log_failure;
 extern bool	optimizer_trace_fallback;
+extern bool	optimizer_parallel_fallback;
 extern int optimizer_minidump;
 extern int  optimizer_cost_model;
 extern bool optimizer_metadata_caching;
 extern int	optimizer_mdcache_size;
+extern int	optimizer_plan_cache_size;
 
 /* Optimizer debugging GUCs */
 extern bool optimizer_print_query;
@@ -531,6 +535,9 @@ extern bool optimizer_enable_mergejoin;
 extern bool optimizer_prune_unused_columns;
 extern bool optimizer_enable_redistribute_nestloop_loj_inner_child;
 extern bool optimizer_force_comprehensive_join_implementation;
+extern bool optimizer_enable_extended_stats;
+extern bool optimizer_enable_memoize;
+extern bool optimizer_enable_incremental_sort;
 extern bool optimizer_enable_replicated_table;
 
 /* Optimizer plan enumeration related GUCs */
@@ -626,6 +633,7 @@ extern bool gp_enable_global_deadlock_detector;
 extern bool	gp_enable_refresh_fast_path;
 
 extern bool gp_enable_predicate_pushdown;
+extern bool gp_enable_aocs_block_skipping;
 extern int  gp_predicate_pushdown_sample_rows;
 
 extern bool gp_log_endpoints;
@@ -722,6 +730,8 @@ extern const char *GetConfigOption(const char *name, bool missing_ok,
 extern const char *GetConfigOptionResetString(const char *name);
 extern int	GetConfigOptionFlags(const char *name, bool missing_ok);
 extern void ProcessConfigFile(GucContext context);
+extern uint64 guc_assignment_count;
+
 extern void InitializeGUCOptions(void);
 extern void InitializeWalConsistencyChecking(void);
 extern bool SelectConfigFiles(const char *userDoption, const char *progname);
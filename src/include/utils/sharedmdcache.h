@@ -0,0 +1,52 @@
+/*-------------------------------------------------------------------------
+ *
+ * sharedmdcache.h
+ *	  Cache of ORCA metadata objects shared by all backends.
+ *
+ * Portions Copyright (c) 2024-Present HashData, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/utils/sharedmdcache.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef SHAREDMDCACHE_H
+#define SHAREDMDCACHE_H
+
+#include "storage/sinval.h"
+
+/* maximum length of a serialized mdid, including the terminating zero */
+#define SHARED_MDCACHE_KEY_LEN			64
+
+/* maximum number of syscache entries a cached object can depend on */
+#define SHARED_MDCACHE_MAX_SYSCACHE_DEPS	2
+
+/*
+ * The catalog changes that make a cached metadata object stale: a relcache
+ * invalidation of relid, or a syscache invalidation matching one of the
+ * (cacheid, hashvalue) pairs.
+ */
+typedef struct SharedMDCacheDeps
+{
+	Oid			relid;			/* InvalidOid if none */
+	int			nsyscache;
+	int			cacheids[SHARED_MDCACHE_MAX_SYSCACHE_DEPS];
+	uint32		hashvalues[SHARED_MDCACHE_MAX_SYSCACHE_DEPS];
+} SharedMDCacheDeps;
+
+extern int	optimizer_shared_mdcache_size;
+
+extern Size SharedMDCacheShmemSize(void);
+extern void SharedMDCacheShmemInit(void);
+
+extern bool SharedMDCacheEnabled(void);
+extern uint64 SharedMDCacheGeneration(void);
+extern char *SharedMDCacheLookup(const char *key);
+extern void SharedMDCacheInsert(const char *key, const char *dxl,
+								const SharedMDCacheDeps *deps,
+								uint64 generation);
+extern void SharedMDCacheInvalidate(const SharedInvalidationMessage *msgs,
+									int nmsgs);
+
+#endif							/* SHAREDMDCACHE_H */
@@ -49,28 +49,35 @@
 		"gin_fuzzy_search_limit",
 		"gin_pending_list_limit",
 		"gp_allow_date_field_width_5digits",
+		"gp_aocs_scan_batch_size",
 		"gp_appendonly_compaction",
 		"gp_appendonly_compaction_threshold",
 		"gp_appendonly_verify_block_checksums",
 		"gp_appendonly_verify_write_block",
+		"gp_autostats_incremental",
+		"gp_autostats_mode",
+		"gp_autostats_mode_in_functions",
 		"gp_blockdirectory_entry_min_range",
 		"gp_blockdirectory_minipage_size",
 		"gp_debug_linger",
 		"gp_default_storage_options",
 		"gp_detect_data_correctness",
 		"gp_disable_tuple_hints",
+		"gp_enable_aocs_block_skipping",
 		"gp_enable_interconnect_aggressive_retry",
 		"gp_enable_runtime_filter",
 		"gp_enable_segment_copy_checking",
 		"gp_external_enable_filter_pushdown",
 		"gp_hashagg_default_nbatches",
 		"gp_hashagg_groups_per_bucket",
+		"gp_hashagg_streambottom",
 		"gp_hashjoin_tuples_per_bucket",
 		"gp_ignore_error_table",
 		"gp_indexcheck_insert",
 		"gp_initial_bad_row_limit",
 		"gp_interconnect_address_type",
 		"gp_interconnect_cache_future_packets",
+		"gp_interconnect_compress_tuples",
 		"gp_interconnect_debug_retry_interval",
 		"gp_interconnect_default_rtt",
 		"gp_interconnect_fc_method",
@@ -80,6 +87,7 @@
 		"gp_interconnect_min_rto",
 		"gp_interconnect_proxy_addresses",
 		"gp_interconnect_queue_depth",
+		"gp_interconnect_recv_batch_size",
 		"gp_interconnect_setup_timeout",
 		"gp_interconnect_snd_queue_depth",
 		"gp_interconnect_tcp_listener_backlog",
@@ -94,6 +102,7 @@
 		"gp_log_stack_trace_lines",
 		"gp_log_suboverflow_statement",
 		"gp_max_packet_size",
+		"gp_motion_send_batch_size",
 		"gp_motion_slice_noop",
 		"gp_resgroup_debug_wait_queue",
 		"gp_resgroup_memory_policy_auto_fixed_mem",
@@ -101,6 +110,7 @@
 		"gp_resqueue_print_operator_memory_limits",
 		"gp_select_invisible",
 		"gp_sessionstate_loglevel",
+		"gp_shareinput_stream_chunk_tuples",
 		"gp_snapshotadd_timeout",
 		"gp_udp_bufsize_k",
 		"gp_udpic_dropacks_percent",
@@ -114,6 +124,7 @@
 		"gp_workfile_limit_files_per_query",
 		"gp_workfile_limit_per_query",
 		"gp_write_shared_snapshot",
+		"gpfdist_compression",
 		"hash_mem_multiplier",
 		"ignore_system_indexes",
 		"ignore_checksum_failure",
@@ -155,8 +155,6 @@
 		"gp_allow_non_uniform_partitioning_ddl",
 		"gp_auth_time_override",
 		"gp_autostats_allow_nonowner",
-		"gp_autostats_mode",
-		"gp_autostats_mode_in_functions",
 		"gp_autostats_on_change_threshold",
 		"gp_cached_segworkers_threshold",
 		"gp_command_count",
@@ -171,6 +169,7 @@
 		"gp_dispatch_keepalives_count",
 		"gp_dispatch_keepalives_idle",
 		"gp_dispatch_keepalives_interval",
+		"gp_dispatch_pruned_plan",
 		"gp_distinct_grouping_sets_threshold",
 		"gp_dtx_recovery_interval",
 		"gp_dtx_recovery_prepared_period",
@@ -282,6 +281,7 @@
 		"gp_set_proc_affinity",
 		"gp_statistics_pullup_from_child_partition",
 		"gp_statistics_use_fkeys",
+		"gp_statistics_use_sketches",
 		"gp_subtrans_warn_limit",
 		"gp_vmem_idle_resource_timeout",
 		"gp_use_legacy_hashops",
@@ -397,16 +397,19 @@
 		"optimizer_enable_dml_constraints",
 		"optimizer_enable_dynamictablescan",
 		"optimizer_enable_eageragg",
+		"optimizer_enable_extended_stats",
 		"optimizer_enable_gather_on_segment_for_dml",
 		"optimizer_enable_groupagg",
 		"optimizer_enable_hashagg",
 		"optimizer_enable_hashjoin",
 		"optimizer_enable_hashjoin_redistribute_broadcast_children",
+		"optimizer_enable_incremental_sort",
 		"optimizer_enable_indexjoin",
 		"optimizer_enable_indexonlyscan",
 		"optimizer_enable_indexscan",
 		"optimizer_enable_master_only_queries",
 		"optimizer_enable_materialize",
+		"optimizer_enable_memoize",
 		"optimizer_enable_mergejoin",
 		"optimizer_enable_motion_broadcast",
 		"optimizer_enable_motion_gather",
@@ -447,10 +450,12 @@
 		"optimizer_minidump",
 		"optimizer_multilevel_partitioning",
 		"optimizer_nestloop_factor",
+		"optimizer_parallel_fallback",
 		"optimizer_parallel_union",
 		"optimizer_partition_selection_log",
 		"optimizer_penalize_broadcast_threshold",
 		"optimizer_penalize_skew",
+		"optimizer_plan_cache_size",
 		"optimizer_plan_id",
 		"optimizer_print_expression_properties",
 		"optimizer_print_group_properties",
@@ -475,6 +480,7 @@
 		"optimizer_sample_plans",
 		"optimizer_search_strategy_path",
 		"optimizer_segments",
+		"optimizer_shared_mdcache_size",
 		"optimizer_spilling_mem_threshold",
 		"optimizer_sort_factor",
 		"optimizer_trace_fallback",
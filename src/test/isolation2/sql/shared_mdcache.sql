@@ -0,0 +1,36 @@
+-- Tests of the ORCA metadata cache shared by all backends. An object
+-- published by one session must not be handed to the others once the
+-- catalogs it was translated from have changed.
+!\retcode gpconfig -c optimizer_shared_mdcache_size -v 8192 --skipvalidation --masteronly;
+!\retcode gpstop -ari;
+
+1: create table shared_mdcache_t (a int, b int) distributed by (a);
+1: insert into shared_mdcache_t select i, i from generate_series(1, 100) i;
+1: analyze shared_mdcache_t;
+1: create function shared_mdcache_rows(query text) returns int as $$ declare plan json; begin execute 'explain (format json) ' || query into plan; return (plan->0->'Plan'->>'Plan Rows')::int; end $$ language plpgsql;
+
+-- the second session finds the statistics published by the first one
+1: select shared_mdcache_rows('select * from shared_mdcache_t');
+2: select shared_mdcache_rows('select * from shared_mdcache_t');
+
+-- lookup after ANALYZE
+2: insert into shared_mdcache_t select i, i from generate_series(101, 1000) i;
+2: analyze shared_mdcache_t;
+1: select shared_mdcache_rows('select * from shared_mdcache_t');
+3: select shared_mdcache_rows('select * from shared_mdcache_t');
+
+-- lookup after ALTER TABLE
+1: select * from shared_mdcache_t where a = 1;
+2: select * from shared_mdcache_t where a = 1;
+3: alter table shared_mdcache_t add column c int default 7;
+1: select * from shared_mdcache_t where a = 1;
+2: select * from shared_mdcache_t where a = 1;
+3: alter table shared_mdcache_t drop column b;
+1: select * from shared_mdcache_t where a = 1;
+2: select * from shared_mdcache_t where a = 1;
+4: select * from shared_mdcache_t where a = 1;
+
+1: drop table shared_mdcache_t;
+1: drop function shared_mdcache_rows(text);
+!\retcode gpconfig -r optimizer_shared_mdcache_size --skipvalidation --masteronly;
+!\retcode gpstop -ari;
@@ -631,3 +631,21 @@ create table analyze_replicated(tc1 int,tc2 int) distributed replicated;
 insert into analyze_replicated select i, i from generate_series(1,1000) i;
 analyze analyze_replicated;
 drop table analyze_replicated;
+
+-- test analyze from column sketches computed on the segments
+set gp_statistics_use_sketches = on;
+create table analyze_sketches(id int, grp int, opt int, arr int[]) distributed by (id);
+insert into analyze_sketches
+  select i, i % 10, case when i % 10 = 0 then null else i end, array[i]
+  from generate_series(1, 1000) i;
+analyze analyze_sketches;
+select attname, null_frac, n_distinct, most_common_vals, most_common_freqs
+  from pg_stats where tablename = 'analyze_sketches' order by attname;
+select array_length(histogram_bounds::text::int[], 1) as nbounds,
+       (histogram_bounds::text::int[])[1] as lo,
+       (histogram_bounds::text::int[])[101] as hi,
+       correlation > 0.99 as correlated
+  from pg_stats where tablename = 'analyze_sketches' and attname = 'id';
+select reltuples from pg_class where relname = 'analyze_sketches';
+drop table analyze_sketches;
+reset gp_statistics_use_sketches;
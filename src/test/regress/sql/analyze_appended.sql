@@ -0,0 +1,113 @@
+--
+-- Test auto-stats merging the rows appended to an append-optimized table into
+-- its statistics, with gp_autostats_incremental, instead of analyzing it again.
+-- The "merged" line tells the merge from the fallback to ANALYZE.
+--
+-- start_matchsubs
+-- m/^LOG:  In mode on_change, command (INSERT|COPY).* caused Auto-ANALYZE./
+-- s/\(dboid,tableoid\)=\(\d+,\d+\)/\(dboid,tableoid\)=\(XXXXX,XXXXX\)/
+-- m/^LOG:  Auto-stats merged \d+ appended rows into the statistics of tableoid \d+./
+-- s/tableoid \d+/tableoid XXXXX/
+-- end_matchsubs
+set gp_statistics_use_sketches = on;
+set gp_autostats_incremental = on;
+set gp_autostats_mode = on_change;
+set gp_autostats_on_change_threshold = 100;
+
+create table analyze_appended(id int, grp int) with (appendonly=true) distributed by (id);
+create table analyze_appended_co(id int, grp int) with (appendonly=true, orientation=column) distributed by (id);
+insert into analyze_appended select i, i % 10 from generate_series(1, 1000) i;
+insert into analyze_appended_co select i, i % 10 from generate_series(1, 1000) i;
+analyze analyze_appended;
+analyze analyze_appended_co;
+
+set log_autostats = on;
+set client_min_messages = log;
+
+-- The appended rows are merged into the statistics
+insert into analyze_appended select i, i % 10 from generate_series(1001, 2000) i;
+copy analyze_appended_co (id) from program 'seq 1001 2000';
+select relname, reltuples from pg_class
+  where relname in ('analyze_appended', 'analyze_appended_co') order by relname;
+select attname, null_frac, n_distinct, most_common_vals, most_common_freqs
+  from pg_stats where tablename = 'analyze_appended' and attname = 'grp';
+select (histogram_bounds::text::int[])[1] as lo,
+       (histogram_bounds::text::int[])[101] as hi
+  from pg_stats where tablename = 'analyze_appended' and attname = 'id';
+
+-- The segments that appended no rows send empty sketches
+insert into analyze_appended select 1, i % 10 from generate_series(1, 200) i;
+select reltuples from pg_class where relname = 'analyze_appended';
+
+-- The rows inserted below the threshold are merged with the next ones
+begin;
+insert into analyze_appended select i, i % 10 from generate_series(2001, 2050) i;
+insert into analyze_appended select i, i % 10 from generate_series(2051, 2200) i;
+commit;
+select reltuples from pg_class where relname = 'analyze_appended';
+
+-- The rows inserted without auto-stats were not sketched, so ANALYZE them
+begin;
+set local gp_autostats_mode = none;
+insert into analyze_appended select i, i % 10 from generate_series(2201, 2400) i;
+set local gp_autostats_mode = on_change;
+insert into analyze_appended select i, i % 10 from generate_series(2401, 2600) i;
+commit;
+select reltuples from pg_class where relname = 'analyze_appended';
+
+-- The sketches no longer describe the rows once a subtransaction aborts
+begin;
+savepoint s;
+insert into analyze_appended select i, i % 10 from generate_series(2601, 2650) i;
+rollback to savepoint s;
+insert into analyze_appended select i, i % 10 from generate_series(2601, 2800) i;
+commit;
+select reltuples from pg_class where relname = 'analyze_appended';
+
+-- Statistics that were not built from sketches are analyzed again
+set gp_statistics_use_sketches = off;
+analyze analyze_appended_co;
+set gp_statistics_use_sketches = on;
+insert into analyze_appended_co select i, i % 10 from generate_series(2001, 2200) i;
+select reltuples from pg_class where relname = 'analyze_appended_co';
+
+-- So are the tables with extended statistics or expression indexes
+create statistics analyze_appended_stats (dependencies) on id, grp from analyze_appended;
+analyze analyze_appended;
+insert into analyze_appended select i, i % 10 from generate_series(2801, 3000) i;
+drop statistics analyze_appended_stats;
+create index analyze_appended_expr on analyze_appended ((id + 1));
+analyze analyze_appended;
+insert into analyze_appended select i, i % 10 from generate_series(3001, 3200) i;
+select reltuples from pg_class where relname = 'analyze_appended';
+
+-- And the tables with a column that cannot be sketched
+create table analyze_appended_json(id int, doc json) with (appendonly=true) distributed by (id);
+insert into analyze_appended_json select i, '{}' from generate_series(1, 1000) i;
+insert into analyze_appended_json select i, '{}' from generate_series(1001, 1200) i;
+select reltuples from pg_class where relname = 'analyze_appended_json';
+
+-- And the replicated tables and the leaf partitions
+create table analyze_appended_repl(id int, grp int) with (appendonly=true) distributed replicated;
+insert into analyze_appended_repl select i, i % 10 from generate_series(1, 1000) i;
+insert into analyze_appended_repl select i, i % 10 from generate_series(1001, 1200) i;
+select reltuples from pg_class where relname = 'analyze_appended_repl';
+create table analyze_appended_part(id int, grp int) with (appendonly=true) distributed by (id)
+  partition by range (grp);
+create table analyze_appended_part_1 partition of analyze_appended_part
+  for values from (0) to (10) with (appendonly=true);
+insert into analyze_appended_part_1 select i, i % 10 from generate_series(1, 1000) i;
+insert into analyze_appended_part_1 select i, i % 10 from generate_series(1001, 1200) i;
+select reltuples from pg_class where relname = 'analyze_appended_part_1';
+
+reset client_min_messages;
+reset log_autostats;
+drop table analyze_appended;
+drop table analyze_appended_co;
+drop table analyze_appended_json;
+drop table analyze_appended_repl;
+drop table analyze_appended_part;
+reset gp_autostats_on_change_threshold;
+reset gp_autostats_mode;
+reset gp_autostats_incremental;
+reset gp_statistics_use_sketches;
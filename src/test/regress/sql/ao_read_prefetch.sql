@@ -0,0 +1,31 @@
+--
+-- Scans of append-optimized tables ask the kernel to read ahead of their
+-- large reads, see BufferedReadPrefetch(). The ao_read_prefetch_hit fault is
+-- triggered by every large read that had been requested ahead entirely. The
+-- segments read ahead with the default effective_io_concurrency.
+--
+create extension if not exists gp_inject_fault;
+
+create table ao_read_prefetch_row (a int, b int, c text) using ao_row distributed by (a);
+insert into ao_read_prefetch_row select i, i % 100, repeat('x', 20) from generate_series(1, 300000) i;
+create table ao_read_prefetch_column (a int, b int, c text) using ao_column distributed by (a);
+insert into ao_read_prefetch_column select i, i % 100, repeat('x', 20) from generate_series(1, 300000) i;
+
+select gp_inject_fault('ao_read_prefetch_hit', 'skip', dbid)
+  from gp_segment_configuration where role = 'p' and content = 0;
+select count(*), sum(b), max(c) from ao_read_prefetch_row;
+select gp_wait_until_triggered_fault('ao_read_prefetch_hit', 1, dbid)
+  from gp_segment_configuration where role = 'p' and content = 0;
+select gp_inject_fault('ao_read_prefetch_hit', 'reset', dbid)
+  from gp_segment_configuration where role = 'p' and content = 0;
+
+select gp_inject_fault('ao_read_prefetch_hit', 'skip', dbid)
+  from gp_segment_configuration where role = 'p' and content = 0;
+select count(*), sum(b), max(c) from ao_read_prefetch_column;
+select gp_wait_until_triggered_fault('ao_read_prefetch_hit', 1, dbid)
+  from gp_segment_configuration where role = 'p' and content = 0;
+select gp_inject_fault('ao_read_prefetch_hit', 'reset', dbid)
+  from gp_segment_configuration where role = 'p' and content = 0;
+
+drop table ao_read_prefetch_row;
+drop table ao_read_prefetch_column;
@@ -0,0 +1,40 @@
+--
+-- With execute_pruned_plan, each gang only gets, and only initializes, the
+-- part of the plan of its own slice. Run queries with several kinds of
+-- slices with and without it, and compare the results.
+--
+create table pruned_plan_t1 (a int, b int) distributed by (a);
+create table pruned_plan_t2 (a int, b int) distributed by (a);
+create table pruned_plan_t3 (a int) distributed by (a);
+insert into pruned_plan_t1 select i, i % 10 from generate_series(1, 1000) i;
+insert into pruned_plan_t2 select i, i % 100 from generate_series(1, 1000) i;
+analyze pruned_plan_t1;
+analyze pruned_plan_t2;
+
+set execute_pruned_plan = off;
+truncate pruned_plan_t3;
+-- multi-slice join and aggregate
+select t1.b, count(*) from pruned_plan_t1 t1 join pruned_plan_t2 t2 on t1.a = t2.b group by t1.b order by t1.b;
+-- correlated SubPlan
+select count(*) from pruned_plan_t1 t1 where t1.a * 5 < (select sum(t2.a) from pruned_plan_t2 t2 where t2.b = t1.b);
+-- initplan
+select count(*) from pruned_plan_t1 where a > (select avg(a) from pruned_plan_t2);
+-- entry DB reader slice, scanning a catalog table on the coordinator
+insert into pruned_plan_t3 select i from generate_series(1, 100) i, pg_class c where c.oid = 'pg_class'::regclass;
+select count(*), sum(a) from pruned_plan_t3;
+
+set execute_pruned_plan = on;
+truncate pruned_plan_t3;
+-- multi-slice join and aggregate
+select t1.b, count(*) from pruned_plan_t1 t1 join pruned_plan_t2 t2 on t1.a = t2.b group by t1.b order by t1.b;
+-- correlated SubPlan
+select count(*) from pruned_plan_t1 t1 where t1.a * 5 < (select sum(t2.a) from pruned_plan_t2 t2 where t2.b = t1.b);
+-- initplan
+select count(*) from pruned_plan_t1 where a > (select avg(a) from pruned_plan_t2);
+-- entry DB reader slice, scanning a catalog table on the coordinator
+insert into pruned_plan_t3 select i from generate_series(1, 100) i, pg_class c where c.oid = 'pg_class'::regclass;
+select count(*), sum(a) from pruned_plan_t3;
+reset execute_pruned_plan;
+drop table pruned_plan_t1;
+drop table pruned_plan_t2;
+drop table pruned_plan_t3;
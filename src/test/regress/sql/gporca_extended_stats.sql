@@ -0,0 +1,35 @@
+--
+-- Tests of the use of extended statistics (CREATE STATISTICS) by GPORCA
+-- cardinality estimation. The Postgres planner uses functional
+-- dependencies and ndistinct coefficients for filters and grouping, but
+-- not for joins, whatever optimizer_enable_extended_stats is set to.
+--
+create function orca_ext_stats_rows(query text) returns int as $$
+declare
+  plan json;
+begin
+  execute 'explain (format json) ' || query into plan;
+  return (plan->0->'Plan'->>'Plan Rows')::int;
+end
+$$ language plpgsql;
+-- a and b are fully correlated, with 100 distinct values each
+create table orca_ext_stats_t (a int, b int, c int) distributed by (c);
+insert into orca_ext_stats_t select i % 100, i % 100, i from generate_series(1, 10000) i;
+create statistics orca_ext_stats_s (dependencies, ndistinct) on a, b from orca_ext_stats_t;
+analyze orca_ext_stats_t;
+-- Each query is checked against its actual cardinality:
+--   correlated filter: 100 rows
+--   grouping on both columns: 100 groups
+--   join on both columns: 1000000 rows
+set optimizer_enable_extended_stats = on;
+select orca_ext_stats_rows('select * from orca_ext_stats_t where a = 1 and b = 1') between 50 and 200 as filter_accurate;
+select orca_ext_stats_rows('select a, b from orca_ext_stats_t group by a, b') between 50 and 200 as group_by_accurate;
+select orca_ext_stats_rows('select * from orca_ext_stats_t x join orca_ext_stats_t y on x.a = y.a and x.b = y.b') between 500000 and 2000000 as join_accurate;
+-- without extended statistics, GPORCA treats the columns as independent
+set optimizer_enable_extended_stats = off;
+select orca_ext_stats_rows('select * from orca_ext_stats_t where a = 1 and b = 1') between 50 and 200 as filter_accurate;
+select orca_ext_stats_rows('select a, b from orca_ext_stats_t group by a, b') between 50 and 200 as group_by_accurate;
+select orca_ext_stats_rows('select * from orca_ext_stats_t x join orca_ext_stats_t y on x.a = y.a and x.b = y.b') between 500000 and 2000000 as join_accurate;
+reset optimizer_enable_extended_stats;
+drop table orca_ext_stats_t;
+drop function orca_ext_stats_rows(text);
@@ -0,0 +1,24 @@
+--
+-- Tests of the usage statistics of the GPORCA metadata cache. The cache is
+-- only used by GPORCA, so none of the counters move with the Postgres
+-- planner.
+--
+\d gp_opt_mdcache_stats
+create table orca_mdcache_t (a int, b int) distributed by (a);
+insert into orca_mdcache_t select i, i from generate_series(1, 10) i;
+analyze orca_mdcache_t;
+-- The counters are saved in psql variables and compared by the next query.
+-- Run both queries once, so that their own metadata is cached.
+select entries, hits, misses, invalidations, resets from gp_opt_mdcache_stats \gset
+select entries > 0 as cached, hits > :hits as hit, misses > :misses as missed, invalidations > :invalidations as invalidated, resets = :resets as not_reset from gp_opt_mdcache_stats \gset warmup_
+-- a miss on first use of the table, then only hits
+select count(*) from orca_mdcache_t where b > 5;
+select entries, hits, misses, invalidations, resets from gp_opt_mdcache_stats \gset
+select count(*) from orca_mdcache_t where b > 5;
+select entries > 0 as cached, hits > :hits as hit, misses > :misses as missed, invalidations > :invalidations as invalidated, resets = :resets as not_reset from gp_opt_mdcache_stats;
+-- DDL on the table evicts its entries, without resetting the whole cache
+select entries, hits, misses, invalidations, resets from gp_opt_mdcache_stats \gset
+alter table orca_mdcache_t add column c int;
+select count(*) from orca_mdcache_t where b > 5;
+select entries > 0 as cached, hits > :hits as hit, misses > :misses as missed, invalidations > :invalidations as invalidated, resets = :resets as not_reset from gp_opt_mdcache_stats;
+drop table orca_mdcache_t;
@@ -0,0 +1,82 @@
+--
+-- Tests of the Memoize and incremental sort plan alternatives of GPORCA.
+-- Whether a plan uses them is checked, rather than the whole plan, and the
+-- results are compared with the ones of plans without them.
+--
+create function orca_plan_has_node(query text, node text) returns bool as $$
+declare
+  ln text;
+begin
+  for ln in execute 'explain (costs off) ' || query
+  loop
+    if position(node in ln) > 0 then
+      return true;
+    end if;
+  end loop;
+  return false;
+end
+$$ language plpgsql;
+create function orca_rows_out_of_order(query text) returns int as $$
+declare
+  r record;
+  prev record;
+  n int := 0;
+begin
+  for r in execute query
+  loop
+    if prev is not null and (r.a, r.b) < (prev.a, prev.b) then
+      n := n + 1;
+    end if;
+    prev := r;
+  end loop;
+  return n;
+end
+$$ language plpgsql;
+-- Memoize: the inner side of an index nested loop join is probed with only
+-- 10 distinct values
+create table orca_memoize_outer (a int, b int) distributed by (b);
+create table orca_memoize_inner (a int, b int) distributed by (a);
+insert into orca_memoize_outer select i % 10, i from generate_series(1, 10000) i;
+insert into orca_memoize_inner select i, i from generate_series(1, 100000) i;
+create index orca_memoize_inner_a on orca_memoize_inner (a);
+analyze orca_memoize_outer;
+analyze orca_memoize_inner;
+set optimizer_enable_hashjoin = off;
+set enable_hashjoin = off;
+set enable_mergejoin = off;
+set enable_nestloop = on;
+set optimizer_enable_memoize = on;
+select orca_plan_has_node('select count(*), sum(i.b) from orca_memoize_outer o join orca_memoize_inner i on i.a = o.a', 'Memoize');
+select count(*), sum(i.b) from orca_memoize_outer o join orca_memoize_inner i on i.a = o.a;
+set optimizer_enable_memoize = off;
+set enable_memoize = off;
+select orca_plan_has_node('select count(*), sum(i.b) from orca_memoize_outer o join orca_memoize_inner i on i.a = o.a', 'Memoize');
+select count(*), sum(i.b) from orca_memoize_outer o join orca_memoize_inner i on i.a = o.a;
+reset optimizer_enable_memoize;
+reset enable_memoize;
+reset optimizer_enable_hashjoin;
+reset enable_hashjoin;
+reset enable_mergejoin;
+reset enable_nestloop;
+-- Incremental sort: the window function delivers its rows ordered by a, so
+-- only the rows of each of the 100 values of a need sorting by b
+create table orca_incremental_sort_t (a int, b int) distributed by (a);
+insert into orca_incremental_sort_t select i % 100, (i * 7) % 1000 from generate_series(1, 10000) i;
+analyze orca_incremental_sort_t;
+set optimizer_enable_incremental_sort = on;
+set enable_incremental_sort = on;
+select orca_plan_has_node('select a, b, count(*) over (order by a) from orca_incremental_sort_t order by a, b', 'Incremental Sort');
+select orca_rows_out_of_order('select a, b, count(*) over (order by a) from orca_incremental_sort_t order by a, b');
+select count(*), sum(c) from (select a, b, count(*) over (order by a) c from orca_incremental_sort_t order by a, b) s;
+set optimizer_enable_incremental_sort = off;
+set enable_incremental_sort = off;
+select orca_plan_has_node('select a, b, count(*) over (order by a) from orca_incremental_sort_t order by a, b', 'Incremental Sort');
+select orca_rows_out_of_order('select a, b, count(*) over (order by a) from orca_incremental_sort_t order by a, b');
+select count(*), sum(c) from (select a, b, count(*) over (order by a) c from orca_incremental_sort_t order by a, b) s;
+reset optimizer_enable_incremental_sort;
+reset enable_incremental_sort;
+drop table orca_memoize_outer;
+drop table orca_memoize_inner;
+drop table orca_incremental_sort_t;
+drop function orca_plan_has_node(text, text);
+drop function orca_rows_out_of_order(text);
@@ -0,0 +1,16 @@
+--
+-- GPORCA does not build parallel plans, optimizer_parallel_fallback hands
+-- queries that could use one over to the planner.
+--
+begin;
+create table t_orca_parallel(a int, b int) distributed by (a);
+insert into t_orca_parallel select i, i from generate_series(1, 1000) i;
+set local optimizer_trace_fallback = on;
+set local enable_parallel = on;
+set local min_parallel_table_scan_size = 0;
+select count(*) from t_orca_parallel;
+set local optimizer_parallel_fallback = on;
+select count(*) from t_orca_parallel;
+set local enable_parallel = off;
+select count(*) from t_orca_parallel;
+abort;
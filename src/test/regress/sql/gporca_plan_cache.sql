@@ -0,0 +1,36 @@
+--
+-- Tests of the per-session cache of GPORCA plans. The plan cache is only
+-- consulted by GPORCA, so all the counters stay at zero with the Postgres
+-- planner.
+--
+create table orca_plan_cache_t (a int, b int) distributed by (a);
+insert into orca_plan_cache_t select i, i from generate_series(1, 10) i;
+analyze orca_plan_cache_t;
+-- The statistics are read with a locking clause, which keeps the query that
+-- reads them out of the cache.
+create table orca_plan_cache_one (a int) distributed by (a);
+insert into orca_plan_cache_one values (1);
+set optimizer_plan_cache_size = 10;
+-- a miss, then a hit
+select count(*) from orca_plan_cache_t where b > 5;
+select count(*) from orca_plan_cache_t where b > 5;
+select entries, hits, misses, invalidations from gp_opt_plan_cache_stats, orca_plan_cache_one for share of orca_plan_cache_one;
+-- plans are only reused for the same constants
+select count(*) from orca_plan_cache_t where b > 7;
+select entries, hits, misses, invalidations from gp_opt_plan_cache_stats, orca_plan_cache_one for share of orca_plan_cache_one;
+-- DDL on the table drops its plans
+alter table orca_plan_cache_t add column c int;
+select entries, hits, misses, invalidations from gp_opt_plan_cache_stats, orca_plan_cache_one for share of orca_plan_cache_one;
+select count(*) from orca_plan_cache_t where b > 5;
+select count(*) from orca_plan_cache_t where b > 5;
+select entries, hits, misses, invalidations from gp_opt_plan_cache_stats, orca_plan_cache_one for share of orca_plan_cache_one;
+-- so does a change of any configuration parameter
+set work_mem = '8MB';
+select count(*) from orca_plan_cache_t where b > 5;
+select entries, hits, misses, invalidations from gp_opt_plan_cache_stats, orca_plan_cache_one for share of orca_plan_cache_one;
+select count(*) from orca_plan_cache_t where b > 5;
+select entries, hits, misses, invalidations from gp_opt_plan_cache_stats, orca_plan_cache_one for share of orca_plan_cache_one;
+reset work_mem;
+reset optimizer_plan_cache_size;
+drop table orca_plan_cache_t;
+drop table orca_plan_cache_one;
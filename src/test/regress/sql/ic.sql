@@ -163,6 +163,20 @@ SELECT SUM(length(long_tval)) AS sum_len_tval
           FROM small_table ORDER BY dkey LIMIT 20) foo
             JOIN (SELECT * FROM small_table ORDER BY dkey LIMIT 100) bar USING(jkey);
 
+-- Redistribute all tuples, receiving the packets one at a time, and in
+-- batches of the largest size
+SET gp_interconnect_recv_batch_size TO 1;
+SELECT SUM(length(long_tval)) AS sum_len_tval
+  FROM (SELECT jkey, repeat(tval, 10000) AS long_tval
+          FROM small_table ORDER BY dkey LIMIT 20) foo
+            JOIN (SELECT * FROM small_table ORDER BY dkey LIMIT 100) bar USING(jkey);
+SET gp_interconnect_recv_batch_size TO 32;
+SELECT SUM(length(long_tval)) AS sum_len_tval
+  FROM (SELECT jkey, repeat(tval, 10000) AS long_tval
+          FROM small_table ORDER BY dkey LIMIT 20) foo
+            JOIN (SELECT * FROM small_table ORDER BY dkey LIMIT 100) bar USING(jkey);
+RESET gp_interconnect_recv_batch_size;
+
 -- MPP-21916
 CREATE TABLE a (i INT, j INT) DISTRIBUTED BY (i);
 INSERT INTO a (SELECT i, i * i FROM generate_series(1, 10) as i);
@@ -98,3 +98,82 @@ $$) order by id;
 CREATE TABLE motion_noatts ();
 INSERT INTO motion_noatts SELECT;
 SELECT * FROM motion_noatts;
+
+-- Same again, with the tuples compressed before they're sent. The short row
+-- is sent uncompressed, the others go through both the direct and the
+-- chunked codepaths.
+set gp_interconnect_compress_tuples = on;
+select * from abbreviate_result($$
+  select id, plain, main, external, extended from motiondata
+$$) order by id;
+
+-- Report what EXPLAIN ANALYZE shows of the compression of each Motion.
+create function motion_compression(query text) returns table (raw bigint, sent bigint)
+language plpgsql as $$
+declare
+  line text;
+  m text[];
+begin
+  for line in execute 'explain (analyze, costs off, timing off, summary off) ' || query
+  loop
+    m := regexp_match(line, 'Interconnect compression: (\d+) bytes compressed to (\d+) bytes');
+    if m is not null then
+      raw := m[1]::bigint;
+      sent := m[2]::bigint;
+      return next;
+    end if;
+  end loop;
+end;
+$$;
+
+-- Tuples that don't compress well are sent as is, through Redistribute and
+-- Gather Motions. The bytes are random, so every attempt to compress fails
+-- and backs off.
+create table motion_compress (id int, b bytea) distributed by (id);
+insert into motion_compress
+  select i, (select string_agg(decode(md5(i::text || j::text), 'hex'), ''::bytea)
+             from generate_series(1, 20) j)
+  from generate_series(1, 3000) i;
+select count(*), count(distinct a.b) from motion_compress a join motion_compress c on a.b = c.b;
+select count(*) > 0 as reported, bool_and(sent = raw) as sent_as_is
+  from motion_compression('select * from motion_compress a join motion_compress c on a.b = c.b');
+
+-- Tuples that compress well shrink.
+select count(*) > 0 as reported, bool_and(sent < raw / 4) as compressed
+  from motion_compression('select id, repeat(md5(id::text), 20) from motion_compress');
+drop table motion_compress;
+drop function motion_compression(text);
+reset gp_interconnect_compress_tuples;
+
+-- Redistribute Motions send their tuples in batches. Check that the same
+-- rows arrive with and without batching, and with a batch size that leaves
+-- a partial batch at the end of the stream.
+create table motion_batch (a int, b int8, c text) distributed by (a);
+insert into motion_batch select i, i * 7, 'row' || i from generate_series(1, 1000) i;
+set gp_motion_send_batch_size = 0;
+select count(*), sum(a), sum(b) from
+  (select m1.a, b from motion_batch m1 join motion_batch m2 using (b)) s;
+set gp_motion_send_batch_size = 7;
+select count(*), sum(a), sum(b) from
+  (select m1.a, b from motion_batch m1 join motion_batch m2 using (b)) s;
+select c, count(*) from motion_batch group by c order by c limit 3;
+reset gp_motion_send_batch_size;
+
+-- The hash keys of batched tuples are computed from the batch's copies of
+-- the tuples, not from the slots of the Motion's child. Redistribute rows
+-- straight from a heap Seq Scan, with and without JIT compiled expressions,
+-- and check that they land where the unbatched Motion puts them.
+set gp_motion_send_batch_size = 0;
+create table motion_batch_unbatched (a int, b int8, c text) distributed by (b);
+insert into motion_batch_unbatched select * from motion_batch;
+set gp_motion_send_batch_size = 7;
+create table motion_batch_batched (a int, b int8, c text) distributed by (b);
+insert into motion_batch_batched select * from motion_batch;
+set jit = on;
+set jit_above_cost = 0;
+insert into motion_batch_batched select * from motion_batch;
+reset jit_above_cost;
+reset jit;
+select count(*) from motion_batch_batched x join motion_batch_unbatched y
+  on x.a = y.a and x.gp_segment_id = y.gp_segment_id;
+reset gp_motion_send_batch_size;
@@ -120,3 +120,20 @@ where
 	(data_hour = date_trunc('day',data_hour) and stat.schema_name || '.' ||stat.table_name not in (select table_nm_23 from tbls_daily_report_23))
 	and (stat.schema_name || '.' ||stat.table_name not in (select table_nm_onl_act from tbls_w_onl_actl_data))
 	or (stat.schema_name || '.' ||stat.table_name in (select table_nm_onl_act from tbls_w_onl_actl_data));
+
+-- Stream the result of a cross-slice shared scan in small chunks, so that the
+-- consumers have to move across chunk boundaries, and may catch up with the
+-- producer. Both sides of the join are redistributed, which puts the Shared
+-- Scan producer and its consumers in different slices.
+SET gp_cte_sharing = on;
+SET gp_shareinput_stream_chunk_tuples = 3;
+EXPLAIN (COSTS OFF)
+WITH cte AS (SELECT * FROM bar)
+SELECT c1.c, c2.d FROM cte c1 JOIN cte c2 ON c1.d = c2.d AND c1.c + c2.c > 190;
+WITH cte AS (SELECT * FROM bar)
+SELECT c1.c, c2.d FROM cte c1 JOIN cte c2 ON c1.d = c2.d AND c1.c + c2.c > 190;
+-- and with an empty input, which still publishes one chunk
+WITH cte AS (SELECT * FROM bar WHERE c < 0)
+SELECT count(*) FROM cte c1 JOIN cte c2 ON c1.c = c2.d;
+RESET gp_shareinput_stream_chunk_tuples;
+RESET gp_cte_sharing;
@@ -13,6 +13,8 @@ create language plpython3u;
 
 -- force multistage to increase likelihood of spilling
 set optimizer_force_multistage_agg = on;
+-- and keep the first stage from streaming its groups instead of spilling
+set gp_hashagg_streambottom = off;
 
 -- set workfile is created to true if all segment did it.
 create or replace function hashagg_spill.is_workfile_created(explain_query text)
@@ -55,6 +57,7 @@ select * from hashagg_spill.is_workfile_created('explain (analyze, verbose) sele
 
 reset all;
 set search_path to hashagg_spill;
+set gp_hashagg_streambottom = off;
 
 -- Test agg spilling scenarios
 create table aggspill (i int, j int, t text) distributed by (i);
@@ -73,6 +76,13 @@ select * from hashagg_spill.is_workfile_created('explain (analyze, verbose)
 select count(*) from (select i, count(*) from aggspill group by i,j having count(*) = 2) g');
 select count(*) from (select i, count(*) from aggspill group by i,j having count(*) = 2) g;
 
+-- Let the first stage stream its groups instead of spilling. The grouping
+-- keys are nearly unique, so it soon stops trying to reduce its input.
+set gp_hashagg_streambottom = on;
+select count(*) from (select j, count(*) from aggspill group by j having count(*) = 2) g;
+select count(*) from (select j, count(*) from aggspill group by j having count(*) = 1) g;
+set gp_hashagg_streambottom = off;
+
 reset optimizer_force_multistage_agg;
 
 -- Test the spilling of aggstates
@@ -39,6 +39,13 @@ DisableXform(PG_FUNCTION_ARGS)
 	PG_RETURN_VOID();
 }
 
+Datum
+MDCacheStats(PG_FUNCTION_ARGS)
+{
+	elog(ERROR, "mock implementation of MDCacheStats called");
+	PG_RETURN_VOID();
+}
+
 void
 InitGPOPT ()
 {